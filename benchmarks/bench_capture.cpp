@@ -0,0 +1,222 @@
+#include <asam_cmp_capture_module/capture_fb.h>
+#include <asam_cmp_capture_module/encoder_bank.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+
+#include <coreobjects/unit_factory.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/data_rule_factory.h>
+#include <opendaq/dimension_factory.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/range_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <opendaq/signal_factory.h>
+
+#include <Packet.h>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+#include "include/null_ethernet_adapter.h"
+#include "include/synthetic_load.h"
+
+using namespace daq;
+using namespace synthetic_load;
+using modules::asam_cmp_capture_module::CaptureFb;
+using modules::asam_cmp_capture_module::CaptureFbInit;
+using modules::asam_cmp_capture_module::EncoderBank;
+
+namespace
+{
+
+const ASAM::CMP::DataContext dataContext{64, 1500};
+
+#pragma pack(push, 1)
+struct CANData
+{
+    uint32_t arbId;
+    uint8_t length;
+    uint8_t data[64];
+};
+#pragma pack(pop)
+
+// Capture Module FB with one stream fed by a signal owned by the benchmark. The stream processes
+// the packets on the scheduler, so every iteration waits until the encoded frames reach the adapter.
+class CaptureStreamBench
+{
+public:
+    CaptureStreamBench(Load load, size_t samplesCount)
+        : adapter(std::make_shared<NullEthernetAdapter>())
+        , ethernetWrapper(adapter)
+        , selectedDevice(NullEthernetAdapter::deviceName)
+    {
+        auto logger = Logger();
+        context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+
+        captureFb = createWithImplementation<IFunctionBlock, CaptureFb>(
+            ModuleInfoPtr(), context, nullptr, "capture", CaptureFbInit{ethernetWrapper, selectedDevice});
+        captureFb.getPropertyValue("AddInterface").execute();
+        FunctionBlockPtr interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+        interfaceFb.setPropertyValue("PayloadType", getPayloadTypeIndex(load));
+        interfaceFb.getPropertyValue("AddStream").execute();
+        FunctionBlockPtr streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+        createSignals(load);
+        createPacket(load, samplesCount);
+        streamFb.getInputPorts().getItemAt(0).connect(valueSignal);
+    }
+
+    // Sends the packet and waits until the stream has handed the frames to the adapter
+    void process()
+    {
+        const auto expected = adapter->batchesSent.load(std::memory_order_acquire) + 1;
+        valueSignal.sendPacket(dataPacket);
+        while (adapter->batchesSent.load(std::memory_order_acquire) < expected)
+            std::this_thread::yield();
+    }
+
+    uint64_t getBytesSent() const
+    {
+        return adapter->bytesSent.load(std::memory_order_relaxed);
+    }
+
+private:
+    void createSignals(Load load)
+    {
+        auto domainDescriptor = DataDescriptorBuilder()
+                                    .setSampleType(SampleType::Int64)
+                                    .setUnit(Unit("s", -1, "seconds", "time"))
+                                    .setTickResolution(Ratio(1, 1'000'000))
+                                    .setOrigin("1970-01-01T00:00:00Z")
+                                    .setName("Time");
+        DataDescriptorPtr valueDescriptor;
+
+        if (load == Load::analog)
+        {
+            domainDescriptor.setRule(LinearDataRule(1000, 0));
+            valueDescriptor = DataDescriptorBuilder()
+                                  .setSampleType(SampleType::Int16)
+                                  .setValueRange(Range(-32768, 32767))
+                                  .setName("AI")
+                                  .build();
+        }
+        else
+        {
+            const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+            const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+            const auto dataDescriptor =
+                DataDescriptorBuilder()
+                    .setName("Data")
+                    .setSampleType(SampleType::UInt8)
+                    .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+                    .build();
+            valueDescriptor = DataDescriptorBuilder()
+                                  .setSampleType(SampleType::Struct)
+                                  .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+                                  .setName("CAN")
+                                  .build();
+        }
+
+        domainSignal = SignalWithDescriptor(context, domainDescriptor.build(), nullptr, "time");
+        valueSignal = SignalWithDescriptor(context, valueDescriptor, nullptr, "value");
+        valueSignal.setDomainSignal(domainSignal);
+    }
+
+    void createPacket(Load load, size_t samplesCount)
+    {
+        const auto domainPacket = DataPacket(domainSignal.getDescriptor(), samplesCount, 0);
+        dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), samplesCount);
+
+        if (load == Load::analog)
+        {
+            auto* samples = static_cast<int16_t*>(dataPacket.getRawData());
+            for (size_t i = 0; i < samplesCount; ++i)
+                samples[i] = static_cast<int16_t>(i);
+            return;
+        }
+
+        const size_t dataSize = getPayloadSize(load);
+        auto* frames = static_cast<CANData*>(dataPacket.getRawData());
+        auto* timestamps = static_cast<int64_t*>(domainPacket.getRawData());
+        for (size_t i = 0; i < samplesCount; ++i)
+        {
+            frames[i].arbId = static_cast<uint32_t>(i % 0x800);
+            frames[i].length = static_cast<uint8_t>(dataSize);
+            for (size_t j = 0; j < dataSize; ++j)
+                frames[i].data[j] = static_cast<uint8_t>(i + j);
+            timestamps[i] = static_cast<int64_t>(i);
+        }
+    }
+
+private:
+    std::shared_ptr<NullEthernetAdapter> adapter;
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
+    StringPtr selectedDevice;
+    ContextPtr context;
+    FunctionBlockPtr captureFb;
+    SignalConfigPtr domainSignal;
+    SignalConfigPtr valueSignal;
+    DataPacketPtr dataPacket;
+};
+
+}
+
+static void EncoderBankEncode(benchmark::State& state, Load load)
+{
+    EncoderBank encoders;
+    encoders.init(deviceId);
+    const auto packets = createPackets(load, static_cast<size_t>(state.range(0)));
+
+    uint64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto frames = encoders.encode(streamId, packets.begin(), packets.end(), dataContext);
+        for (const auto& frame : frames)
+            bytes += frame.size();
+        benchmark::DoNotOptimize(frames.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * packets.size());
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK_CAPTURE(EncoderBankEncode, Can, Load::can)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(EncoderBankEncode, CanFd, Load::canFd)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(EncoderBankEncode, Analog, Load::analog)->Arg(1)->Arg(100);
+BENCHMARK_CAPTURE(EncoderBankEncode, Ethernet, Load::ethernet)->Arg(1)->Arg(100);
+
+// Measures StreamFb::processDataPacket together with the scheduler hand-off from the input port
+static void CaptureStreamProcessDataPacket(benchmark::State& state, Load load)
+{
+    const size_t samplesCount = load == Load::analog ? analogSamplesCount : static_cast<size_t>(state.range(0));
+    CaptureStreamBench bench(load, samplesCount);
+    bench.process();
+
+    const uint64_t bytesBefore = bench.getBytesSent();
+    for (auto _ : state)
+        bench.process();
+
+    // An analog packet is encoded into a single message
+    const size_t messagesCount = load == Load::analog ? 1 : samplesCount;
+    state.SetItemsProcessed(state.iterations() * messagesCount);
+    state.SetBytesProcessed(bench.getBytesSent() - bytesBefore);
+}
+BENCHMARK_CAPTURE(CaptureStreamProcessDataPacket, Can, Load::can)->Arg(1)->Arg(100)->Arg(1000)->UseRealTime();
+BENCHMARK_CAPTURE(CaptureStreamProcessDataPacket, CanFd, Load::canFd)->Arg(1)->Arg(100)->Arg(1000)->UseRealTime();
+BENCHMARK_CAPTURE(CaptureStreamProcessDataPacket, Analog, Load::analog)->UseRealTime();
+
+// EthernetPcppImpl::sendPacket up to the point where the frame is handed to the device
+static void EthernetPcppBuildFrame(benchmark::State& state)
+{
+    const std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0xAA);
+    const pcpp::MacAddress sourceMac("02:00:00:00:00:01");
+    const auto nullDevice = [](pcpp::Packet& packet) { return packet.getRawPacket()->getRawDataLen() > 0; };
+
+    for (auto _ : state)
+    {
+        const bool sent = asam_cmp_common_lib::EthernetPcppImpl::buildFrame(sourceMac, data.data(), data.size(), nullDevice);
+        benchmark::DoNotOptimize(sent);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(EthernetPcppBuildFrame)->Arg(64)->Arg(512)->Arg(1486);
@@ -0,0 +1,142 @@
+#include <asam_cmp_data_sink/capture_fb.h>
+#include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/data_sink_module_fb.h>
+
+#include <coretypes/intfs.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/module_info_factory.h>
+#include <opendaq/scheduler_factory.h>
+
+#include <RawPacket.h>
+#include <benchmark/benchmark.h>
+
+#include "include/null_ethernet_adapter.h"
+#include "include/synthetic_load.h"
+
+using namespace daq;
+using namespace synthetic_load;
+using modules::asam_cmp_data_sink_module::CapturePacketsPublisher;
+using modules::asam_cmp_data_sink_module::DataPacketsPublisher;
+using modules::asam_cmp_data_sink_module::DataSinkModuleFb;
+using modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+using modules::asam_cmp_data_sink_module::SequenceCounterStatistics;
+
+namespace
+{
+
+class CountingSubscriber : public ImplementationOf<IAsamCmpPacketsSubscriber>
+{
+public:
+    void receive(const std::shared_ptr<ASAM::CMP::Packet>& /*packet*/) override
+    {
+        ++packetsReceived;
+    }
+
+    void receive(const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& packets) override
+    {
+        packetsReceived += packets.size();
+    }
+
+    void receive(const SequenceCounterStatistics& /*statistics*/) override
+    {
+    }
+
+public:
+    size_t packetsReceived{0};
+};
+
+}
+
+// Frames are delivered through the capture callback, so the measurement covers DataSinkModuleFb::decode,
+// the sequence counter check and the lookup in the publishers without subscribers
+static void DataSinkDecode(benchmark::State& state, Load load)
+{
+    const size_t messagesCount = static_cast<size_t>(state.range(0));
+    auto adapter = std::make_shared<NullEthernetAdapter>();
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper = adapter;
+
+    auto logger = Logger();
+    const auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr);
+    const auto dataSinkModuleFb = createWithImplementation<IFunctionBlock, DataSinkModuleFb>(
+        ModuleInfo(VersionInfo(0, 0, 0), "", ""), context, nullptr, "asam_cmp_data_sink_module", ethernetWrapper);
+
+    const auto frames = createEthernetFrames(load, messagesCount);
+    std::vector<pcpp::RawPacket> rawPackets;
+    rawPackets.reserve(frames.size());
+    uint64_t frameBytes = 0;
+    for (const auto& frame : frames)
+    {
+        rawPackets.emplace_back(frame.data(), static_cast<int>(frame.size()), timespec{}, false, pcpp::LINKTYPE_ETHERNET);
+        frameBytes += frame.size();
+    }
+
+    for (auto _ : state)
+    {
+        for (auto& rawPacket : rawPackets)
+            adapter->deliver(&rawPacket);
+    }
+
+    state.SetItemsProcessed(state.iterations() * messagesCount);
+    state.SetBytesProcessed(state.iterations() * frameBytes);
+}
+BENCHMARK_CAPTURE(DataSinkDecode, Can, Load::can)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(DataSinkDecode, CanFd, Load::canFd)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(DataSinkDecode, Analog, Load::analog)->Arg(1)->Arg(100);
+BENCHMARK_CAPTURE(DataSinkDecode, Ethernet, Load::ethernet)->Arg(1)->Arg(100);
+
+// Items are messages delivered, so a message published to N subscribers counts N times
+static void PublisherPublish(benchmark::State& state)
+{
+    const size_t subscribersCount = static_cast<size_t>(state.range(0));
+    DataPacketsPublisher publisher;
+    std::vector<std::unique_ptr<CountingSubscriber>> subscribers;
+    subscribers.reserve(subscribersCount);
+    for (size_t i = 0; i < subscribersCount; ++i)
+    {
+        subscribers.push_back(std::make_unique<CountingSubscriber>());
+        publisher.subscribe({deviceId, interfaceId, streamId}, subscribers.back().get());
+    }
+
+    // Subscribers of other endpoints share the buckets of the hash map
+    CountingSubscriber otherSubscriber;
+    for (uint8_t otherStreamId = streamId + 1; otherStreamId < 64; ++otherStreamId)
+        publisher.subscribe({deviceId, interfaceId, otherStreamId}, &otherSubscriber);
+
+    const auto packet = std::make_shared<ASAM::CMP::Packet>(createPacket(Load::can, 0));
+    for (auto _ : state)
+        publisher.publish({deviceId, interfaceId, streamId}, packet);
+
+    state.SetItemsProcessed(state.iterations() * subscribersCount);
+    state.SetBytesProcessed(state.iterations() * subscribersCount * getPayloadSize(Load::can));
+}
+BENCHMARK(PublisherPublish)->Arg(1)->Arg(100)->Arg(10000);
+
+// Converts the received messages into openDAQ packets of the Stream FB output signal
+static void DataSinkStreamReceive(benchmark::State& state, Load load)
+{
+    const size_t messagesCount = static_cast<size_t>(state.range(0));
+    DataPacketsPublisher publisher;
+    CapturePacketsPublisher capturePacketsPublisher;
+
+    auto logger = Logger();
+    const auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr);
+    const auto captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::CaptureFb>(
+        ModuleInfoPtr(), context, nullptr, "capture_module_0", publisher, capturePacketsPublisher);
+    captureFb.getPropertyValue("AddInterface").execute();
+    const FunctionBlockPtr interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    interfaceFb.setPropertyValue("PayloadType", getPayloadTypeIndex(load));
+    interfaceFb.getPropertyValue("AddStream").execute();
+    const FunctionBlockPtr streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    const auto subscriber = streamFb.as<IAsamCmpPacketsSubscriber>(true);
+
+    const auto packets = createSharedPackets(load, messagesCount);
+    for (auto _ : state)
+        subscriber->receive(packets);
+
+    state.SetItemsProcessed(state.iterations() * messagesCount);
+    state.SetBytesProcessed(state.iterations() * messagesCount * getPayloadSize(load));
+}
+BENCHMARK_CAPTURE(DataSinkStreamReceive, Can, Load::can)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(DataSinkStreamReceive, CanFd, Load::canFd)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(DataSinkStreamReceive, Analog, Load::analog)->Arg(1)->Arg(100);
+BENCHMARK_CAPTURE(DataSinkStreamReceive, Ethernet, Load::ethernet)->Arg(1)->Arg(100);
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <atomic>
+
+// Network adapter that accepts every frame and only counts it, so the benchmarks measure
+// the module code without the cost of a network interface
+class NullEthernetAdapter : public daq::asam_cmp_common_lib::EthernetPcppItf
+{
+public:
+    daq::ListPtr<daq::StringPtr> getEthernetDevicesNamesList() override
+    {
+        return daq::List<daq::IString>(deviceName);
+    }
+
+    daq::ListPtr<daq::StringPtr> getEthernetDevicesDescriptionsList() override
+    {
+        return daq::List<daq::IString>(deviceName);
+    }
+
+    bool sendPacket(const std::vector<uint8_t>& data) override
+    {
+        framesSent.fetch_add(1, std::memory_order_relaxed);
+        bytesSent.fetch_add(data.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t sendPackets(const std::vector<std::vector<uint8_t>>& frames) override
+    {
+        for (const auto& frame : frames)
+            sendPacket(frame);
+        batchesSent.fetch_add(1, std::memory_order_release);
+        return frames.size();
+    }
+
+    void startCapture(daq::asam_cmp_common_lib::PcppPacketReceivedCallbackType packetReceivedCb) override
+    {
+        packetReceivedCallback = std::move(packetReceivedCb);
+    }
+
+    void stopCapture() override
+    {
+        packetReceivedCallback = nullptr;
+    }
+
+    bool isDeviceCapturing() const override
+    {
+        return static_cast<bool>(packetReceivedCallback);
+    }
+
+    bool setDevice(const daq::StringPtr& /*deviceName*/) override
+    {
+        return true;
+    }
+
+    daq::asam_cmp_common_lib::CaptureStatistics getCaptureStatistics() const override
+    {
+        return {};
+    }
+
+    // Delivers a frame to the receive callback registered by the data sink
+    void deliver(pcpp::RawPacket* packet)
+    {
+        packetReceivedCallback(packet, nullptr, nullptr);
+    }
+
+public:
+    static constexpr const char* deviceName = "null";
+
+    std::atomic<uint64_t> framesSent{0};
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> batchesSent{0};
+
+private:
+    daq::asam_cmp_common_lib::PcppPacketReceivedCallbackType packetReceivedCallback;
+};
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp/packet.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Synthetic ASAM CMP traffic shared by the benchmarks
+namespace synthetic_load
+{
+    enum class Load
+    {
+        can,
+        canFd,
+        analog,
+        ethernet
+    };
+
+    constexpr uint16_t deviceId = 1;
+    constexpr uint32_t interfaceId = 1;
+    constexpr uint8_t streamId = 1;
+
+    constexpr size_t canDataSize = 8;
+    constexpr size_t canFdDataSize = 64;
+    constexpr size_t analogSamplesCount = 256;
+    constexpr size_t ethernetFrameSize = 512;
+
+    // Returns the size of the data carried by one message of the load
+    size_t getPayloadSize(Load load);
+
+    // Returns the PayloadType selection index of the Interface FBs for the load
+    int getPayloadTypeIndex(Load load);
+
+    // Returns a data message, index is used to vary the content
+    ASAM::CMP::Packet createPacket(Load load, size_t index);
+    std::vector<ASAM::CMP::Packet> createPackets(Load load, size_t count);
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> createSharedPackets(Load load, size_t count);
+
+    // Encodes count messages into Ethernet frames as they arrive at a data sink
+    std::vector<std::vector<uint8_t>> createEthernetFrames(Load load, size_t count);
+}
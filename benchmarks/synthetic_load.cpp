@@ -0,0 +1,151 @@
+#include "include/synthetic_load.h"
+
+#include <asam_cmp/analog_payload.h>
+#include <asam_cmp/can_fd_payload.h>
+#include <asam_cmp/can_payload.h>
+#include <asam_cmp/encoder.h>
+#include <asam_cmp/ethernet_payload.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+
+#include <numeric>
+
+namespace synthetic_load
+{
+
+namespace
+{
+    template <typename T>
+    std::vector<T> createRamp(size_t count, size_t index)
+    {
+        std::vector<T> data(count);
+        std::iota(data.begin(), data.end(), static_cast<T>(index));
+        return data;
+    }
+}
+
+size_t getPayloadSize(Load load)
+{
+    switch (load)
+    {
+        case Load::can:
+            return canDataSize;
+        case Load::canFd:
+            return canFdDataSize;
+        case Load::analog:
+            return analogSamplesCount * sizeof(int16_t);
+        case Load::ethernet:
+            return ethernetFrameSize;
+    }
+    return 0;
+}
+
+int getPayloadTypeIndex(Load load)
+{
+    switch (load)
+    {
+        case Load::can:
+            return 1;
+        case Load::canFd:
+            return 2;
+        case Load::analog:
+            return 3;
+        case Load::ethernet:
+            return 4;
+    }
+    return 0;
+}
+
+ASAM::CMP::Packet createPacket(Load load, size_t index)
+{
+    ASAM::CMP::Packet packet;
+    packet.setDeviceId(deviceId);
+    packet.setInterfaceId(interfaceId);
+    packet.setStreamId(streamId);
+    packet.setTimestamp(1'000'000 * index);
+
+    switch (load)
+    {
+        case Load::can:
+        {
+            const auto data = createRamp<uint8_t>(canDataSize, index);
+            ASAM::CMP::CanPayload payload;
+            payload.setId(static_cast<uint32_t>(index % 0x800));
+            payload.setData(data.data(), static_cast<uint8_t>(data.size()));
+            packet.setPayload(payload);
+            break;
+        }
+        case Load::canFd:
+        {
+            const auto data = createRamp<uint8_t>(canFdDataSize, index);
+            ASAM::CMP::CanFdPayload payload;
+            payload.setId(static_cast<uint32_t>(index % 0x800));
+            payload.setData(data.data(), static_cast<uint8_t>(data.size()));
+            packet.setPayload(payload);
+            break;
+        }
+        case Load::analog:
+        {
+            const auto data = createRamp<int16_t>(analogSamplesCount, index);
+            ASAM::CMP::AnalogPayload payload;
+            payload.setData(reinterpret_cast<const uint8_t*>(data.data()), data.size() * sizeof(int16_t));
+            payload.setSampleDt(ASAM::CMP::AnalogPayload::SampleDt::aInt16);
+            payload.setUnit(ASAM::CMP::AnalogPayload::Unit::ampere);
+            payload.setSampleInterval(0.001f);
+            payload.setSampleScalar(1.0f / 3276.8f);
+            payload.setSampleOffset(0.0f);
+            packet.setPayload(payload);
+            break;
+        }
+        case Load::ethernet:
+        {
+            const auto data = createRamp<uint8_t>(ethernetFrameSize, index);
+            ASAM::CMP::EthernetPayload payload;
+            payload.setData(data.data(), static_cast<uint16_t>(data.size()));
+            packet.setPayload(payload);
+            break;
+        }
+    }
+
+    return packet;
+}
+
+std::vector<ASAM::CMP::Packet> createPackets(Load load, size_t count)
+{
+    std::vector<ASAM::CMP::Packet> packets;
+    packets.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        packets.push_back(createPacket(load, i));
+    return packets;
+}
+
+std::vector<std::shared_ptr<ASAM::CMP::Packet>> createSharedPackets(Load load, size_t count)
+{
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> packets;
+    packets.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        packets.push_back(std::make_shared<ASAM::CMP::Packet>(createPacket(load, i)));
+    return packets;
+}
+
+std::vector<std::vector<uint8_t>> createEthernetFrames(Load load, size_t count)
+{
+    namespace virtual_adapter = daq::asam_cmp_common_lib::virtual_adapter;
+
+    ASAM::CMP::Encoder encoder;
+    encoder.setDeviceId(deviceId);
+    encoder.setStreamId(streamId);
+
+    const auto packets = createPackets(load, count);
+    const auto cmpFrames = encoder.encode(packets.begin(), packets.end(), {64, 1500});
+
+    std::vector<std::vector<uint8_t>> frames;
+    frames.reserve(cmpFrames.size());
+    for (const auto& cmpFrame : cmpFrames)
+    {
+        auto& frame = frames.emplace_back(virtual_adapter::ethernetHeader.begin(), virtual_adapter::ethernetHeader.end());
+        frame.insert(frame.end(), cmpFrame.begin(), cmpFrame.end());
+    }
+    return frames;
+}
+
+}
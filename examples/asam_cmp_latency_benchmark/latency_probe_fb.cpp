@@ -0,0 +1,57 @@
+#include "latency_probe_fb.h"
+
+#include <opendaq/function_block_type_factory.h>
+#include <algorithm>
+
+using namespace daq;
+
+LatencyProbeFb::LatencyProbeFb(
+    const ContextPtr& ctx, const StringPtr& localId, size_t streamCount, uint64_t samplePeriodUs, LatencyRecorder& recorder)
+    : FunctionBlock(FunctionBlockType("AsamCmpLatencyProbe", "AsamCmpLatencyProbe", "ASAM CMP latency probe"), ctx, nullptr, localId)
+    , samplePeriodNs(samplePeriodUs * 1000)
+    , recorder(recorder)
+{
+    for (size_t i = 0; i < streamCount; ++i)
+        inputPorts.push_back(createAndAddInputPort("input" + std::to_string(i), PacketReadyNotification::SameThread));
+}
+
+void LatencyProbeFb::onPacketReceived(const InputPortPtr& port)
+{
+    const auto it = std::find(inputPorts.begin(), inputPorts.end(), port);
+    if (it == inputPorts.end())
+        return;
+    const size_t stream = static_cast<size_t>(std::distance(inputPorts.begin(), it));
+
+    const auto connection = port.getConnection();
+    if (!connection.assigned())
+        return;
+
+    PacketPtr packet = connection.dequeue();
+    while (packet.assigned())
+    {
+        if (packet.getType() == PacketType::Data)
+            processDataPacket(stream, packet);
+        packet = connection.dequeue();
+    }
+}
+
+void LatencyProbeFb::processDataPacket(size_t stream, const DataPacketPtr& packet)
+{
+    // The data sink timestamps are in nanoseconds and were produced from the sample index by the generator
+    const auto domainPacket = packet.getDomainPacket();
+    if (!domainPacket.assigned())
+        return;
+
+    const size_t sampleCount = packet.getSampleCount();
+    const auto domainRule = domainPacket.getDataDescriptor().getRule();
+    if (domainRule.assigned() && domainRule.getType() == DataRuleType::Linear)
+    {
+        const uint64_t offset = domainPacket.getOffset();
+        recorder.onReceived(stream, offset / samplePeriodNs, sampleCount);
+        return;
+    }
+
+    const auto* timestamps = static_cast<const uint64_t*>(domainPacket.getRawData());
+    for (size_t i = 0; i < sampleCount; ++i)
+        recorder.onReceived(stream, timestamps[i] / samplePeriodNs, 1);
+}
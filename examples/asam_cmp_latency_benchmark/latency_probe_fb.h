@@ -0,0 +1,39 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <opendaq/function_block_impl.h>
+#include <opendaq/data_packet_ptr.h>
+
+#include "latency_recorder.h"
+
+// Function block with one input port per stream (in stream order) that is connected to the data signal of a data sink
+// Stream FB. Packets are handled on the thread that sends them, so the measured latency doesn't include
+// any reader or scheduler delay of the probe itself.
+class LatencyProbeFb final : public daq::FunctionBlock
+{
+public:
+    LatencyProbeFb(const daq::ContextPtr& ctx, const daq::StringPtr& localId, size_t streamCount, uint64_t samplePeriodUs, LatencyRecorder& recorder);
+
+private:
+    void onPacketReceived(const daq::InputPortPtr& port) override;
+    void processDataPacket(size_t stream, const daq::DataPacketPtr& packet);
+
+private:
+    const uint64_t samplePeriodNs;
+    LatencyRecorder& recorder;
+    std::vector<daq::InputPortPtr> inputPorts;
+};
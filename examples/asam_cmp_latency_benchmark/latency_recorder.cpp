@@ -0,0 +1,82 @@
+#include "latency_recorder.h"
+
+#include <chrono>
+
+LatencyRecorder::LatencyRecorder(size_t streamCount, size_t samplesPerStream)
+    : samplesPerStream(samplesPerStream)
+    , injectionTimes(streamCount, std::vector<uint64_t>(samplesPerStream, 0))
+{
+}
+
+void LatencyRecorder::onInjected(size_t stream, uint64_t firstSample, size_t count) noexcept
+{
+    const uint64_t time = now();
+    uint64_t expected = 0;
+    firstInjectionTime.compare_exchange_strong(expected, time, std::memory_order_relaxed);
+
+    auto& times = injectionTimes[stream];
+    for (uint64_t sample = firstSample; sample < firstSample + count && sample < samplesPerStream; ++sample)
+        times[sample] = time;
+    injectedCount.fetch_add(count, std::memory_order_relaxed);
+}
+
+void LatencyRecorder::onReceived(size_t stream, uint64_t firstSample, size_t count) noexcept
+{
+    const uint64_t time = now();
+
+    // The injection time is written before the packet is sent, and the packet crosses several
+    // synchronized queues on its way here, so it is visible without further synchronization
+    size_t expectedCount = 0;
+    if (stream < injectionTimes.size())
+    {
+        const auto& times = injectionTimes[stream];
+        for (uint64_t sample = firstSample; sample < firstSample + count && sample < samplesPerStream; ++sample)
+        {
+            if (times[sample] == 0)
+                continue;
+            histogram.record(time - times[sample]);
+            ++expectedCount;
+        }
+    }
+
+    receivedCount.fetch_add(expectedCount, std::memory_order_relaxed);
+    unexpectedCount.fetch_add(count - expectedCount, std::memory_order_relaxed);
+
+    uint64_t last = lastReceiveTime.load(std::memory_order_relaxed);
+    while (last < time && !lastReceiveTime.compare_exchange_weak(last, time, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t LatencyRecorder::getInjectedCount() const noexcept
+{
+    return injectedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyRecorder::getReceivedCount() const noexcept
+{
+    return receivedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyRecorder::getUnexpectedCount() const noexcept
+{
+    return unexpectedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyRecorder::getActiveTime() const noexcept
+{
+    const uint64_t first = firstInjectionTime.load(std::memory_order_relaxed);
+    const uint64_t last = lastReceiveTime.load(std::memory_order_relaxed);
+    return last > first ? last - first : 0;
+}
+
+const daq::asam_cmp_common_lib::LatencyHistogram& LatencyRecorder::getHistogram() const noexcept
+{
+    return histogram;
+}
+
+uint64_t LatencyRecorder::now() noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Keeps the injection time of every sample of every stream and turns the arrival of a sample at the
+// data sink into a latency. Samples are identified by their index within the stream, which the harness
+// derives from the sample timestamp.
+class LatencyRecorder
+{
+public:
+    LatencyRecorder(size_t streamCount, size_t samplesPerStream);
+
+    // Called by the generator before the samples are sent
+    void onInjected(size_t stream, uint64_t firstSample, size_t count) noexcept;
+    // Called by the probe when the samples leave the data sink
+    void onReceived(size_t stream, uint64_t firstSample, size_t count) noexcept;
+
+    uint64_t getInjectedCount() const noexcept;
+    uint64_t getReceivedCount() const noexcept;
+    uint64_t getUnexpectedCount() const noexcept;
+    // Time between the first injected and the last received sample in nanoseconds
+    uint64_t getActiveTime() const noexcept;
+    const daq::asam_cmp_common_lib::LatencyHistogram& getHistogram() const noexcept;
+
+    static uint64_t now() noexcept;
+
+private:
+    const size_t samplesPerStream;
+    std::vector<std::vector<uint64_t>> injectionTimes;
+    daq::asam_cmp_common_lib::LatencyHistogram histogram;
+
+    std::atomic<uint64_t> injectedCount{0};
+    std::atomic<uint64_t> receivedCount{0};
+    std::atomic<uint64_t> unexpectedCount{0};
+    std::atomic<uint64_t> firstInjectionTime{0};
+    std::atomic<uint64_t> lastReceiveTime{0};
+};
@@ -0,0 +1,328 @@
+#include <asam_cmp_capture_module/capture_module_fb.h>
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+#include <asam_cmp_data_sink/data_sink_module_fb.h>
+
+#include <opendaq/context_factory.h>
+#include <opendaq/module_info_factory.h>
+#include <opendaq/scheduler_factory.h>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "latency_probe_fb.h"
+#include "latency_recorder.h"
+#include "signal_generator.h"
+
+using namespace daq;
+
+namespace
+{
+
+// An analog message must fit into one 1500 byte frame together with the CMP headers
+constexpr size_t maxAnalogSamplesPerPacket = 700;
+constexpr size_t maxStreamCount = 128;
+
+struct Options
+{
+    GeneratorConfig generator;
+    uint64_t rate{10000};
+    std::string jsonFile{"asam_cmp_latency.json"};
+};
+
+struct Results
+{
+    uint64_t injected;
+    uint64_t received;
+    uint64_t unexpected;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+    double samplesPerSecond;
+    double bytesPerSecond;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: asam_cmp_latency_benchmark [options]\n"
+                 "  --payload <can|canfd|analog>   payload type of the streams (can)\n"
+                 "  --rate <samples/s>             sample rate of every stream (10000)\n"
+                 "  --streams <count>              number of streams (1)\n"
+                 "  --samples-per-packet <count>   samples sent to a stream at once (10)\n"
+                 "  --duration <s>                 duration of the measurement (10)\n"
+                 "  --json <file>                  file the JSON report is written to (asam_cmp_latency.json)\n";
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string name = argv[i];
+        if (name == "--help" || name == "-h")
+        {
+            printUsage();
+            std::exit(0);
+        }
+        if (i + 1 >= argc)
+            throw std::invalid_argument("Missing value of " + name);
+
+        const std::string value = argv[++i];
+        if (name == "--payload")
+        {
+            if (value == "can")
+                options.generator.payload = PayloadKind::can;
+            else if (value == "canfd")
+                options.generator.payload = PayloadKind::canFd;
+            else if (value == "analog")
+                options.generator.payload = PayloadKind::analog;
+            else
+                throw std::invalid_argument("Unknown payload type " + value);
+        }
+        else if (name == "--rate")
+            options.rate = std::stoull(value);
+        else if (name == "--streams")
+            options.generator.streamCount = std::stoul(value);
+        else if (name == "--samples-per-packet")
+            options.generator.samplesPerPacket = std::stoul(value);
+        else if (name == "--duration")
+            options.generator.duration = std::chrono::milliseconds(static_cast<int64_t>(std::stod(value) * 1000));
+        else if (name == "--json")
+            options.jsonFile = value;
+        else
+            throw std::invalid_argument("Unknown option " + name);
+    }
+
+    if (options.rate == 0 || options.rate > 1'000'000)
+        throw std::invalid_argument("The rate must be between 1 and 1000000 samples/s");
+    if (options.generator.streamCount == 0 || options.generator.streamCount > maxStreamCount)
+        throw std::invalid_argument("The number of streams must be between 1 and " + std::to_string(maxStreamCount));
+    if (options.generator.samplesPerPacket == 0)
+        throw std::invalid_argument("At least one sample per packet is required");
+    if (options.generator.payload == PayloadKind::analog && options.generator.samplesPerPacket > maxAnalogSamplesPerPacket)
+        throw std::invalid_argument("At most " + std::to_string(maxAnalogSamplesPerPacket) + " analog samples fit into a packet");
+    if (options.generator.duration.count() <= 0)
+        throw std::invalid_argument("The duration must be positive");
+
+    // Timestamps have microsecond resolution, so the sample period is rounded to whole microseconds
+    options.generator.samplePeriodUs = (1'000'000 + options.rate / 2) / options.rate;
+    options.rate = 1'000'000 / options.generator.samplePeriodUs;
+    return options;
+}
+
+FunctionBlockPtr getChildFunctionBlock(const FunctionBlockPtr& parent, const std::string& localId)
+{
+    for (const auto& fb : parent.getFunctionBlocks())
+    {
+        if (fb.getLocalId() == localId)
+            return fb;
+    }
+    throw std::runtime_error("Function block " + localId + " not found");
+}
+
+void selectNetworkAdapter(const FunctionBlockPtr& networkManager, const std::string& adapterName)
+{
+    const ListPtr<IString> names = networkManager.getProperty("NetworkAdaptersNames").getSelectionValues();
+    for (SizeT i = 0; i < names.getCount(); ++i)
+    {
+        if (names[i].toStdString() == adapterName)
+        {
+            networkManager.setPropertyValue("NetworkAdapters", static_cast<Int>(i));
+            return;
+        }
+    }
+    throw std::runtime_error("Network adapter " + adapterName + " not found");
+}
+
+// Waits until every injected sample has arrived or nothing has arrived for a second
+void waitForDrain(const LatencyRecorder& recorder)
+{
+    auto lastProgress = std::chrono::steady_clock::now();
+    uint64_t lastCount = recorder.getReceivedCount() + recorder.getUnexpectedCount();
+    while (lastCount < recorder.getInjectedCount() && std::chrono::steady_clock::now() - lastProgress < std::chrono::seconds(1))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const uint64_t count = recorder.getReceivedCount() + recorder.getUnexpectedCount();
+        if (count != lastCount)
+        {
+            lastCount = count;
+            lastProgress = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+Results collectResults(const LatencyRecorder& recorder, PayloadKind payload)
+{
+    const auto& histogram = recorder.getHistogram();
+    Results results{};
+    results.injected = recorder.getInjectedCount();
+    results.received = recorder.getReceivedCount();
+    results.unexpected = recorder.getUnexpectedCount();
+    results.p50 = histogram.getValueAtPercentile(50.0);
+    results.p99 = histogram.getValueAtPercentile(99.0);
+    results.p999 = histogram.getValueAtPercentile(99.9);
+    results.max = histogram.getMax();
+
+    const double activeTime = recorder.getActiveTime() / 1e9;
+    results.samplesPerSecond = activeTime > 0 ? results.received / activeTime : 0;
+    results.bytesPerSecond = results.samplesPerSecond * SignalGenerator::getPayloadSize(payload);
+    return results;
+}
+
+double getLossRatio(const Results& results)
+{
+    const uint64_t lost = results.injected > results.received ? results.injected - results.received : 0;
+    return results.injected > 0 ? static_cast<double>(lost) / results.injected : 0;
+}
+
+void printTable(const Options& options, const Results& results)
+{
+    const auto& config = options.generator;
+    const uint64_t lost = results.injected > results.received ? results.injected - results.received : 0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\nASAM CMP capture to data sink over " << asam_cmp_common_lib::EthernetLoopbackImpl::deviceName << "\n";
+    std::cout << std::left;
+    std::cout << std::setw(24) << "payload" << SignalGenerator::getPayloadName(config.payload) << "\n";
+    std::cout << std::setw(24) << "streams" << config.streamCount << "\n";
+    std::cout << std::setw(24) << "rate per stream" << options.rate << " samples/s\n";
+    std::cout << std::setw(24) << "samples per packet" << config.samplesPerPacket << "\n";
+    std::cout << std::setw(24) << "duration" << config.duration.count() / 1000.0 << " s\n";
+    std::cout << std::setw(24) << "latency p50" << results.p50 / 1000.0 << " us\n";
+    std::cout << std::setw(24) << "latency p99" << results.p99 / 1000.0 << " us\n";
+    std::cout << std::setw(24) << "latency p99.9" << results.p999 / 1000.0 << " us\n";
+    std::cout << std::setw(24) << "latency max" << results.max / 1000.0 << " us\n";
+    std::cout << std::setw(24) << "throughput" << results.samplesPerSecond << " samples/s, " << results.bytesPerSecond / 1e6
+              << " MB/s\n";
+    std::cout << std::setw(24) << "lost samples" << lost << " of " << results.injected << " (" << std::setprecision(3)
+              << getLossRatio(results) * 100 << " %)\n";
+    if (results.unexpected > 0)
+        std::cout << std::setw(24) << "unexpected samples" << results.unexpected << "\n";
+}
+
+void writeJson(const Options& options, const Results& results)
+{
+    const auto& config = options.generator;
+    std::ofstream file(options.jsonFile);
+    if (!file)
+        throw std::runtime_error("Failed to open " + options.jsonFile);
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\n"
+         << "  \"transport\": \"" << asam_cmp_common_lib::EthernetLoopbackImpl::deviceName << "\",\n"
+         << "  \"payload\": \"" << SignalGenerator::getPayloadName(config.payload) << "\",\n"
+         << "  \"streams\": " << config.streamCount << ",\n"
+         << "  \"rate_per_stream\": " << options.rate << ",\n"
+         << "  \"samples_per_packet\": " << config.samplesPerPacket << ",\n"
+         << "  \"duration_s\": " << config.duration.count() / 1000.0 << ",\n"
+         << "  \"latency_ns\": {\n"
+         << "    \"p50\": " << results.p50 << ",\n"
+         << "    \"p99\": " << results.p99 << ",\n"
+         << "    \"p99_9\": " << results.p999 << ",\n"
+         << "    \"max\": " << results.max << "\n"
+         << "  },\n"
+         << "  \"throughput\": {\n"
+         << "    \"samples_per_second\": " << results.samplesPerSecond << ",\n"
+         << "    \"bytes_per_second\": " << results.bytesPerSecond << "\n"
+         << "  },\n"
+         << "  \"injected_samples\": " << results.injected << ",\n"
+         << "  \"received_samples\": " << results.received << ",\n"
+         << "  \"unexpected_samples\": " << results.unexpected << ",\n"
+         << "  \"loss_ratio\": " << std::setprecision(6) << getLossRatio(results) << "\n"
+         << "}\n";
+    std::cout << "\nJSON report written to " << options.jsonFile << "\n";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+    const auto& config = options.generator;
+
+    auto logger = Logger();
+    const auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+    const auto moduleInfo = ModuleInfo(VersionInfo(0, 0, 0), "AsamCmpLatencyBenchmark", "");
+
+    // Both modules are linked into this binary and connected through the in-process loopback adapter
+    const auto captureModuleFb = modules::asam_cmp_capture_module::CaptureModuleFb::create(moduleInfo, context, nullptr, "capture");
+    const auto dataSinkModuleFb = modules::asam_cmp_data_sink_module::DataSinkModuleFb::create(moduleInfo, context, nullptr, "data_sink");
+    selectNetworkAdapter(captureModuleFb, asam_cmp_common_lib::EthernetLoopbackImpl::deviceName);
+    selectNetworkAdapter(dataSinkModuleFb, asam_cmp_common_lib::EthernetLoopbackImpl::deviceName);
+
+    const auto captureFb = getChildFunctionBlock(captureModuleFb, "Capture");
+    captureFb.getPropertyValue("AddInterface").execute();
+    const FunctionBlockPtr interfaceFb = captureFb.getFunctionBlocks()[0];
+    interfaceFb.setPropertyValue("PayloadType", SignalGenerator::getPayloadTypeIndex(config.payload));
+    for (size_t i = 0; i < config.streamCount; ++i)
+        interfaceFb.getPropertyValue("AddStream").execute();
+
+    // The data sink side is configured from the capture side instead of waiting for its status messages
+    const auto dataSinkFb = getChildFunctionBlock(dataSinkModuleFb, "DataSink");
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    const FunctionBlockPtr sinkCaptureFb = dataSinkFb.getFunctionBlocks()[0];
+    sinkCaptureFb.setPropertyValue("DeviceId", captureFb.getPropertyValue("DeviceId"));
+    sinkCaptureFb.getPropertyValue("AddInterface").execute();
+    const FunctionBlockPtr sinkInterfaceFb = sinkCaptureFb.getFunctionBlocks()[0];
+    sinkInterfaceFb.setPropertyValue("InterfaceId", interfaceFb.getPropertyValue("InterfaceId"));
+    sinkInterfaceFb.setPropertyValue("PayloadType", SignalGenerator::getPayloadTypeIndex(config.payload));
+    for (size_t i = 0; i < config.streamCount; ++i)
+        sinkInterfaceFb.getPropertyValue("AddStream").execute();
+
+    LatencyRecorder recorder(config.streamCount, SignalGenerator::getSamplesPerStream(config));
+    SignalGenerator generator(context, config, recorder);
+    const auto probe = createWithImplementation<IFunctionBlock, LatencyProbeFb>(
+        context, "probe", config.streamCount, config.samplePeriodUs, recorder);
+
+    for (size_t i = 0; i < config.streamCount; ++i)
+    {
+        const FunctionBlockPtr streamFb = interfaceFb.getFunctionBlocks()[i];
+        const FunctionBlockPtr sinkStreamFb = sinkInterfaceFb.getFunctionBlocks()[i];
+        sinkStreamFb.setPropertyValue("StreamId", streamFb.getPropertyValue("StreamId"));
+
+        streamFb.getInputPorts()[0].connect(generator.getSignal(i));
+        probe.getInputPorts()[i].connect(sinkStreamFb.getSignals()[0]);
+    }
+
+    // Let the streams process the descriptor changes before the measurement starts
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    std::cout << "Running " << config.streamCount << " " << SignalGenerator::getPayloadName(config.payload) << " stream(s) at "
+              << options.rate << " samples/s for " << config.duration.count() / 1000.0 << " s\n";
+    generator.run();
+    waitForDrain(recorder);
+
+    const auto results = collectResults(recorder, config.payload);
+    printTable(options, results);
+    try
+    {
+        writeJson(options, results);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    for (size_t i = 0; i < config.streamCount; ++i)
+    {
+        interfaceFb.getFunctionBlocks()[i].getInputPorts()[0].disconnect();
+        probe.getInputPorts()[i].disconnect();
+    }
+
+    return 0;
+}
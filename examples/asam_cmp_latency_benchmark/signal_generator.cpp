@@ -0,0 +1,186 @@
+#include "signal_generator.h"
+
+#include <coreobjects/unit_factory.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/data_rule_factory.h>
+#include <opendaq/dimension_factory.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/range_factory.h>
+#include <opendaq/signal_factory.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace daq;
+
+namespace
+{
+#pragma pack(push, 1)
+    struct CANData
+    {
+        uint32_t arbId;
+        uint8_t length;
+        uint8_t data[64];
+    };
+#pragma pack(pop)
+
+    DataDescriptorPtr createCanDescriptor()
+    {
+        const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+        const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+        const auto dataDescriptor =
+            DataDescriptorBuilder()
+                .setName("Data")
+                .setSampleType(SampleType::UInt8)
+                .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+                .build();
+
+        return DataDescriptorBuilder()
+            .setSampleType(SampleType::Struct)
+            .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+            .setName("CAN")
+            .build();
+    }
+}
+
+SignalGenerator::SignalGenerator(const ContextPtr& context, const GeneratorConfig& config, LatencyRecorder& recorder)
+    : config(config)
+    , recorder(recorder)
+{
+    createSignals(context);
+}
+
+const SignalConfigPtr& SignalGenerator::getSignal(size_t stream) const
+{
+    return valueSignals[stream];
+}
+
+size_t SignalGenerator::getSamplesPerStream(const GeneratorConfig& config)
+{
+    const uint64_t packetPeriodUs = config.samplePeriodUs * config.samplesPerPacket;
+    const uint64_t packetsCount = std::chrono::duration_cast<std::chrono::microseconds>(config.duration).count() / packetPeriodUs + 1;
+    return packetsCount * config.samplesPerPacket;
+}
+
+void SignalGenerator::run()
+{
+    const auto packetPeriod = std::chrono::microseconds(config.samplePeriodUs * config.samplesPerPacket);
+    const size_t samplesPerStream = getSamplesPerStream(config);
+
+    // Packets that are late because the generator fell behind are sent immediately, so the offered
+    // load stays at the configured rate as long as the generator can keep up
+    const auto start = std::chrono::steady_clock::now();
+    auto nextSend = start;
+    for (uint64_t firstSample = 0; firstSample + config.samplesPerPacket <= samplesPerStream; firstSample += config.samplesPerPacket)
+    {
+        std::this_thread::sleep_until(nextSend);
+        for (size_t stream = 0; stream < valueSignals.size(); ++stream)
+            sendPacket(stream, firstSample);
+        nextSend += packetPeriod;
+    }
+}
+
+size_t SignalGenerator::getPayloadSize(PayloadKind payload)
+{
+    switch (payload)
+    {
+        case PayloadKind::can:
+            return 8;
+        case PayloadKind::canFd:
+            return 64;
+        case PayloadKind::analog:
+            return sizeof(int16_t);
+    }
+    return 0;
+}
+
+int SignalGenerator::getPayloadTypeIndex(PayloadKind payload)
+{
+    switch (payload)
+    {
+        case PayloadKind::can:
+            return 1;
+        case PayloadKind::canFd:
+            return 2;
+        case PayloadKind::analog:
+            return 3;
+    }
+    return 0;
+}
+
+std::string SignalGenerator::getPayloadName(PayloadKind payload)
+{
+    switch (payload)
+    {
+        case PayloadKind::can:
+            return "CAN";
+        case PayloadKind::canFd:
+            return "CAN-FD";
+        case PayloadKind::analog:
+            return "Analog";
+    }
+    return "";
+}
+
+void SignalGenerator::createSignals(const ContextPtr& context)
+{
+    auto domainDescriptor = DataDescriptorBuilder()
+                                .setSampleType(SampleType::Int64)
+                                .setUnit(Unit("s", -1, "seconds", "time"))
+                                .setTickResolution(Ratio(1, 1'000'000))
+                                .setOrigin("1970-01-01T00:00:00Z")
+                                .setName("Time");
+    DataDescriptorPtr valueDescriptor;
+    if (config.payload == PayloadKind::analog)
+    {
+        domainDescriptor.setRule(LinearDataRule(static_cast<Int>(config.samplePeriodUs), 0));
+        valueDescriptor = DataDescriptorBuilder().setSampleType(SampleType::Int16).setValueRange(Range(-32768, 32767)).setName("AI").build();
+    }
+    else
+    {
+        valueDescriptor = createCanDescriptor();
+    }
+
+    for (size_t i = 0; i < config.streamCount; ++i)
+    {
+        const auto id = std::to_string(i);
+        domainSignals.push_back(SignalWithDescriptor(context, domainDescriptor.build(), nullptr, "time" + id));
+        valueSignals.push_back(SignalWithDescriptor(context, valueDescriptor, nullptr, "value" + id));
+        valueSignals.back().setDomainSignal(domainSignals.back());
+    }
+}
+
+void SignalGenerator::sendPacket(size_t stream, uint64_t firstSample)
+{
+    const size_t count = config.samplesPerPacket;
+    const auto& domainSignal = domainSignals[stream];
+    const auto& valueSignal = valueSignals[stream];
+
+    const Int offset = config.payload == PayloadKind::analog ? static_cast<Int>(firstSample * config.samplePeriodUs) : 0;
+    const auto domainPacket = DataPacket(domainSignal.getDescriptor(), count, offset);
+    const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), count);
+
+    if (config.payload == PayloadKind::analog)
+    {
+        auto* samples = static_cast<int16_t*>(dataPacket.getRawData());
+        for (size_t i = 0; i < count; ++i)
+            samples[i] = static_cast<int16_t>(firstSample + i);
+    }
+    else
+    {
+        const size_t dataSize = getPayloadSize(config.payload);
+        auto* frames = static_cast<CANData*>(dataPacket.getRawData());
+        auto* timestamps = static_cast<int64_t*>(domainPacket.getRawData());
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t sample = firstSample + i;
+            frames[i].arbId = static_cast<uint32_t>(sample % 0x800);
+            frames[i].length = static_cast<uint8_t>(dataSize);
+            memset(frames[i].data, static_cast<int>(sample), dataSize);
+            timestamps[i] = static_cast<int64_t>(sample * config.samplePeriodUs);
+        }
+    }
+
+    recorder.onInjected(stream, firstSample, count);
+    valueSignal.sendPacket(dataPacket);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <opendaq/context_ptr.h>
+#include <opendaq/signal_config_ptr.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "latency_recorder.h"
+
+enum class PayloadKind
+{
+    can,
+    canFd,
+    analog
+};
+
+struct GeneratorConfig
+{
+    PayloadKind payload{PayloadKind::can};
+    size_t streamCount{1};
+    uint64_t samplePeriodUs{100};
+    size_t samplesPerPacket{10};
+    std::chrono::milliseconds duration{10000};
+};
+
+// Synthetic input signals for the capture Stream FBs. Sample i of a stream is timestamped with
+// i * samplePeriodUs microseconds, which lets the probe find the sample again at the data sink output.
+class SignalGenerator
+{
+public:
+    SignalGenerator(const daq::ContextPtr& context, const GeneratorConfig& config, LatencyRecorder& recorder);
+
+    const daq::SignalConfigPtr& getSignal(size_t stream) const;
+    // Sends packets at the configured rate until the duration has elapsed
+    void run();
+
+    static size_t getSamplesPerStream(const GeneratorConfig& config);
+    static size_t getPayloadSize(PayloadKind payload);
+    static int getPayloadTypeIndex(PayloadKind payload);
+    static std::string getPayloadName(PayloadKind payload);
+
+private:
+    void createSignals(const daq::ContextPtr& context);
+    void sendPacket(size_t stream, uint64_t firstSample);
+
+private:
+    const GeneratorConfig config;
+    LatencyRecorder& recorder;
+    std::vector<daq::SignalConfigPtr> valueSignals;
+    std::vector<daq::SignalConfigPtr> domainSignals;
+};
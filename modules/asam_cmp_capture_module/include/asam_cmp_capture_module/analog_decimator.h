@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Decimates a sample stream by an integer factor with a linear phase FIR anti-alias filter. Only every
+// factor-th output of the filter is computed, which is the polyphase form of the decimating filter: each
+// output costs one dot product of the taps with the input history, and the dot product runs as a SIMD kernel.
+// The filter delays the signal by getDelay() input samples.
+class AnalogDecimator final
+{
+public:
+    static constexpr size_t maxFactor = 1000;
+
+    // Throws std::invalid_argument if factor is below 2 or above maxFactor
+    explicit AnalogDecimator(size_t factor);
+
+    size_t getFactor() const noexcept;
+    size_t getTapCount() const noexcept;
+    // Group delay of the filter in input samples
+    size_t getDelay() const noexcept;
+    // Index of the input sample of the next process() call that produces the first output sample
+    size_t getNextOutputIndex() const noexcept;
+    // Upper bound of the number of output samples of a process() call with count input samples
+    size_t getMaxOutputCount(size_t count) const noexcept;
+
+    // Filters count input samples and writes the decimated samples to output, returns their number
+    template <typename T>
+    size_t process(const T* input, size_t count, double* output);
+
+    // Restarts with an empty history, the first samples after a reset prime the history
+    void reset() noexcept;
+
+private:
+    size_t filter(double* output);
+
+private:
+    size_t factor;
+    std::vector<double> taps;
+    // Filter history of taps.size() - 1 samples followed by the samples of the current call
+    std::vector<double> samples;
+    size_t nextOutput{0};
+    bool primed{false};
+};
+
+template <typename T>
+size_t AnalogDecimator::process(const T* input, size_t count, double* output)
+{
+    if (count == 0)
+        return 0;
+
+    const size_t historySize = taps.size() - 1;
+    if (!primed)
+    {
+        // Start from a settled filter instead of a step from zero
+        samples.assign(historySize, static_cast<double>(input[0]));
+        primed = true;
+    }
+
+    samples.resize(historySize + count);
+    double* newSamples = samples.data() + historySize;
+    for (size_t i = 0; i < count; ++i)
+        newSamples[i] = static_cast<double>(input[i]);
+
+    return filter(output);
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
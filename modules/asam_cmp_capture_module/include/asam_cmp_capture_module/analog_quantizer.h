@@ -0,0 +1,49 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Converts values to raw samples of a CMP analog payload, raw = round((value - offset) / scale), saturated to the
+// range of the raw type. NaN is converted to the minimum. Where SSE2 is available blocks of samples are converted
+// with a vector kernel ending in a saturating pack.
+void quantizeAnalogSamples(const double* values, size_t count, double scale, double offset, int16_t* output);
+void quantizeAnalogSamples(const double* values, size_t count, double scale, double offset, int32_t* output);
+
+// Other value types are converted to double in blocks on the stack
+template <typename T, typename Raw>
+void quantizeAnalogSamples(const T* values, size_t count, double scale, double offset, Raw* output)
+{
+    static_assert(std::is_arithmetic_v<T>);
+
+    constexpr size_t blockSize = 256;
+    double block[blockSize];
+    for (size_t i = 0; i < count; i += blockSize)
+    {
+        const size_t blockCount = std::min(blockSize, count - i);
+        for (size_t j = 0; j < blockCount; ++j)
+            block[j] = static_cast<double>(values[i + j]);
+        quantizeAnalogSamples(block, blockCount, scale, offset, output + i);
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
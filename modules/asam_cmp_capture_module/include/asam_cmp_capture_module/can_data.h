@@ -0,0 +1,35 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <cstdint>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Sample of a CAN / CAN FD input signal, see createCanDataDescriptor()
+#pragma pack(push, 1)
+struct CANData
+{
+    uint32_t arbId;
+    uint8_t length;
+    uint8_t data[64];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(CANData) == 69);
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
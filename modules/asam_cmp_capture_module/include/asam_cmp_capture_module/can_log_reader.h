@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/can_data.h>
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_common_lib/mapped_file.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Streaming parser of SocketCAN candump logs (candump -l) and Vector ASC traces. The file is memory
+// mapped and parsed line by line, so reading does not allocate. Lines that are not CAN or CAN FD data
+// frames (remote and error frames, other events, malformed lines) are skipped and counted.
+class CanLogReader final
+{
+public:
+    enum class Format
+    {
+        candump,
+        vectorAsc
+    };
+
+    struct Frame
+    {
+        // Log timestamp in nanoseconds, absolute for candump, relative to the start of the measurement for ASC
+        uint64_t timestamp;
+        // Interface name for candump, channel number for ASC; points into the mapped file
+        std::string_view channel;
+        bool canFd;
+        CANData data;
+    };
+
+public:
+    // Throws if the file can't be opened; the format is detected from the extension and the content
+    explicit CanLogReader(const std::string& fileName);
+    CanLogReader(const std::string& fileName, Format format);
+
+    Format getFormat() const noexcept;
+
+    // Returns false at the end of the file
+    bool next(Frame& frame);
+    void rewind() noexcept;
+
+    uint64_t getSkippedLines() const noexcept;
+
+    static Format detectFormat(std::string_view fileName, std::string_view content);
+    static bool parseCandumpLine(std::string_view line, Frame& frame);
+
+private:
+    enum class LineType
+    {
+        frame,
+        header,
+        skipped
+    };
+
+    std::string_view nextLine() noexcept;
+    LineType parseAscLine(std::string_view line, Frame& frame);
+    bool parseAscFrame(std::string_view line, Frame& frame) const;
+
+private:
+    const asam_cmp_common_lib::MappedFile file;
+    const std::string_view text;
+    const Format format;
+    size_t position{0};
+    uint64_t skippedLines{0};
+
+    // ASC header state
+    bool ascDecimalBase{false};
+    bool ascRelativeTimestamps{false};
+    uint64_t ascLastTimestamp{0};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
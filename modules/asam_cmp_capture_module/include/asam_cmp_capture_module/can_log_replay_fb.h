@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/can_log_reader.h>
+#include <asam_cmp_capture_module/common.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/signal_config_ptr.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Replays a candump or Vector ASC log as a CAN / CAN FD signal in the input format of the capture Stream FBs.
+// Frames are collected into packets of up to SamplesPerPacket samples. With original timing a packet is also
+// sent once its first frame has waited MaxPacketDelay, so batching does not hold frames of a slow bus back.
+class CanLogReplayFb final : public FunctionBlock
+{
+public:
+    enum class Mode
+    {
+        AsFastAsPossible,
+        OriginalTiming
+    };
+
+    struct Options
+    {
+        // Detected from the file when not set
+        std::optional<CanLogReader::Format> format;
+        Mode mode{Mode::AsFastAsPossible};
+        double speed{1.0};
+        size_t samplesPerPacket{1000};
+        std::chrono::nanoseconds maxPacketDelay{std::chrono::milliseconds(10)};
+        // Empty replays the frames of all channels
+        std::string channel;
+        bool loop{false};
+    };
+
+public:
+    explicit CanLogReplayFb(const ModuleInfoPtr& moduleInfo, const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+    ~CanLogReplayFb() override;
+
+    static FunctionBlockTypePtr CreateType(const ModuleInfoPtr& moduleInfo);
+
+    // Throws if the file can't be opened or the options are invalid
+    void startReplay(const std::string& fileName, const Options& options);
+    void stopReplay();
+
+private:
+    void initProperties();
+    void createSignals();
+    void startReplayFromProperties();
+
+    void replayLoop();
+    void appendFrame(const CanLogReader::Frame& frame, uint64_t timestamp);
+    void flushPacket();
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+private:
+    SignalConfigPtr valueSignal;
+    SignalConfigPtr domainSignal;
+
+    Options options;
+    std::unique_ptr<CanLogReader> reader;
+    std::thread replayThread;
+    std::vector<CANData> pendingFrames;
+    std::vector<int64_t> pendingTimestamps;
+
+    // Set under stopSync so that a timed wait can't miss it, read without the lock between frames
+    std::mutex stopSync;
+    std::condition_variable stopCv;
+    std::atomic<bool> stopRequested{false};
+
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> replayedFrames{0};
+    std::atomic<uint64_t> skippedLines{0};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_common_lib/can_id_map.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Limits CAN IDs to one transmitted frame per configured interval. A frame arriving within the interval of its
+// ID becomes the pending frame of the ID, replacing an older pending frame, so the latest value is sent. The
+// limiter has no timer: release() sends the pending frames whose interval has elapsed, the owner calls it for
+// later frames and once getNextRelease() is reached. Time is given by the frame timestamps in nanoseconds.
+class CanRateLimiter final
+{
+public:
+    struct Frame
+    {
+        uint64_t timestamp;
+        uint32_t arbId;
+        uint8_t length;
+        uint8_t data[64];
+    };
+
+public:
+    CanRateLimiter() = default;
+    // Comma separated "ids:interval" items with IDs and ID ranges in the CanIdFilter format and the interval in
+    // milliseconds, e.g. "0x7DF:100, 0x700-0x7FF:20". Throws std::invalid_argument for malformed items.
+    explicit CanRateLimiter(const std::string& list);
+
+    bool isEmpty() const noexcept;
+
+    // Returns true if the frame is to be sent now, otherwise the limiter keeps it as the pending frame of its ID.
+    // Frames are admitted before release() is called for their timestamp.
+    bool admit(uint32_t arbId, const uint8_t* data, uint8_t length, uint64_t timestamp);
+
+    // Calls onFrame(const Frame&) for the pending frames whose interval has elapsed at timestamp
+    template <typename OnFrame>
+    void release(uint64_t timestamp, OnFrame&& onFrame);
+
+    // Earliest timestamp release() may send a pending frame at, UINT64_MAX without pending frames
+    uint64_t getNextRelease() const noexcept;
+
+    // Number of frames replaced by a newer frame of their ID since the last call
+    uint64_t takeDroppedFrames() noexcept;
+
+private:
+    struct IdState
+    {
+        uint64_t interval;
+        uint64_t nextAllowed;
+        bool pending;
+        Frame frame;
+    };
+
+private:
+    asam_cmp_common_lib::CanIdMap limitedIds;
+    std::vector<uint64_t> intervals;
+    std::unordered_map<uint32_t, IdState> states;
+    // IDs with a pending frame, entries whose frame was replaced by a sent frame are removed on release
+    std::vector<uint32_t> pendingIds;
+    uint64_t nextRelease{UINT64_MAX};
+    uint64_t droppedFrames{0};
+};
+
+template <typename OnFrame>
+void CanRateLimiter::release(uint64_t timestamp, OnFrame&& onFrame)
+{
+    if (timestamp < nextRelease)
+        return;
+
+    nextRelease = UINT64_MAX;
+    for (size_t i = 0; i < pendingIds.size();)
+    {
+        auto& state = states[pendingIds[i]];
+        if (state.pending && timestamp < state.nextAllowed)
+        {
+            nextRelease = std::min(nextRelease, state.nextAllowed);
+            ++i;
+            continue;
+        }
+
+        if (state.pending)
+        {
+            onFrame(state.frame);
+            state.pending = false;
+            state.nextAllowed = timestamp + state.interval;
+        }
+        pendingIds[i] = pendingIds.back();
+        pendingIds.pop_back();
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -18,6 +18,9 @@
 #include <asam_cmp_common_lib/id_manager.h>
 #include <asam_cmp/device_status.h>
 #include <asam_cmp_capture_module/encoder_bank.h>
+#include <asam_cmp_capture_module/frame_pacer.h>
+#include <asam_cmp_capture_module/traffic_shaper.h>
+#include <asam_cmp_capture_module/transmit_queue.h>
 #include <asam_cmp_capture_module/common.h>
 #include <asam_cmp_common_lib/capture_common_fb.h>
 #include <asam_cmp/capture_module_payload.h>
@@ -51,6 +54,8 @@ public:
 private:
     void initProperties();
     void initEncoders();
+    void updateShaperInternal();
+    void updateTransmitQueueInternal();
     void initStatusPacket();
     void updateCaptureData();
 
@@ -66,6 +71,7 @@ private:
 private:
     const bool allowJumboFrames;
     EncoderBank encoders;
+    TrafficShaper shaper;
     ASAM::CMP::Packet captureStatusPacket;
     ASAM::CMP::DeviceStatus captureStatus;
 
@@ -76,6 +82,8 @@ private:
     bool stopStatusSending;
     std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
     const StringPtr& selectedEthernetDeviceName;
+    TransmitQueue transmitQueue;
+    FramePacer pacer;
 };
 
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -18,6 +18,7 @@
 #include <asam_cmp_capture_module/common.h>
 #include <asam_cmp/packet.h>
 #include <asam_cmp/encoder.h>
+#include <asam_cmp_common_lib/trace.h>
 #include <array>
 #include <mutex>
 
@@ -47,6 +48,7 @@ std::vector<std::vector<uint8_t>> EncoderBank::encode(uint8_t encoderInd,
                                          ForwardIterator end,
                                          const ASAM::CMP::DataContext& dataContext)
 {
+    ASAM_CMP_TRACE_SCOPE("capture::EncoderBank::encode");
     std::scoped_lock lock{encoderSyncs[encoderInd]};
     return encoders[encoderInd].encode(begin, end, dataContext);
 }
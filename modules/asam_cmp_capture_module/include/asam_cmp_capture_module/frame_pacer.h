@@ -0,0 +1,77 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_capture_module/traffic_shaper.h>
+#include <asam_cmp_capture_module/transmit_queue.h>
+#include <asam_cmp_capture_module/transmit_statistics.h>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Sends the frames scheduled by the traffic shaper at their departure times from a thread of its own, so streams
+// hand off shaped frames instead of waiting in the scheduler thread that delivers their input packets
+class FramePacer final
+{
+public:
+    using Clock = TrafficShaper::Clock;
+
+public:
+    explicit FramePacer(TransmitQueue& transmitQueue);
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // Queues the frames that have a departure time and counts them in statistics once they are sent
+    void enqueue(TransmitQueue::Lane lane,
+                 const std::vector<std::vector<uint8_t>>& frames,
+                 const std::vector<Clock::time_point>& departures,
+                 TransmitStatistics& statistics);
+    // Discards the queued frames of statistics and waits until a frame of it being sent is done
+    void cancel(const TransmitStatistics& statistics);
+
+    size_t getQueuedCount() const;
+
+private:
+    struct Entry
+    {
+        TransmitQueue::Lane lane;
+        std::vector<uint8_t> frame;
+        TransmitStatistics* statistics;
+    };
+
+    void paceLoop();
+
+private:
+    TransmitQueue& transmitQueue;
+
+    mutable std::mutex sync;
+    std::condition_variable cv;
+    // Ordered by departure, frames of the same departure in the order they were queued
+    std::multimap<Clock::time_point, Entry> queue;
+    const TransmitStatistics* sending{nullptr};
+    bool stopPacing{false};
+    std::thread paceThread;
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
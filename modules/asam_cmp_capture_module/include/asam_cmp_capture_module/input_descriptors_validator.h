@@ -24,6 +24,20 @@ BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 bool hasCorrectSampleType(const SampleType& sampleType);
 bool hasCorrectPostScaling(const ScalingPtr& postScaling);
 bool hasCorrectValueRange(const RangePtr& range);
+// Struct of ArbId, Length and Data[64] fields matching CANData
+DataDescriptorPtr createCanDataDescriptor();
+// Sample layouts accepted on CAN and CAN FD inputs
+enum class CanInputLayout
+{
+    invalid,
+    // CANData struct with Data[64]
+    canData,
+    // Compact classic CAN struct with Data[8]
+    classicCanData,
+    // Compact binary CAN FD samples
+    compactCanFd
+};
+CanInputLayout getCanInputLayout(const DataDescriptorPtr& inputDataDescriptor);
 bool validateInputDescriptor(DataDescriptorPtr inputDataDescriptor, const ASAM::CMP::PayloadType& type);
 
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -20,6 +20,10 @@
 #include <asam_cmp_capture_module/common.h>
 #include <asam_cmp_common_lib/id_manager.h>
 #include <asam_cmp_capture_module/encoder_bank.h>
+#include <asam_cmp_capture_module/frame_pacer.h>
+#include <asam_cmp_capture_module/traffic_shaper.h>
+#include <asam_cmp_capture_module/transmit_queue.h>
+#include <asam_cmp_capture_module/transmit_statistics.h>
 #include <opendaq/context_factory.h>
 #include <opendaq/function_block_impl.h>
 #include <asam_cmp_capture_module/common.h>
@@ -40,6 +44,9 @@ struct InterfaceFbInit
     const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper;
     const bool& allowJumboFrames;
     const StringPtr& selectedDeviceName;
+    TrafficShaper& shaper;
+    TransmitQueue& transmitQueue;
+    FramePacer& pacer;
 };
 
 class InterfaceFb final : public asam_cmp_common_lib::InterfaceCommonFb
@@ -59,6 +66,7 @@ private:
     void removeStreamInternal(size_t nInd) override;
     void initStatusPacket();
     void updateInterfaceData();
+    void updateShaperInternal();
 
     void updateInterfaceIdInternal() override;
     void updatePayloadTypeInternal() override;
@@ -76,6 +84,13 @@ private:
     const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper;
     const bool& allowJumboFrames;
     const StringPtr& selectedDeviceName;
+
+    TransmitStatistics statistics;
+    TrafficShaper& shaper;
+    TransmitQueue& transmitQueue;
+    FramePacer& pacer;
+    // Shapes the frames of the streams of the interface before the adapter bucket of the shaper
+    TokenBucket txBucket;
 };
 
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/signal_config_ptr.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Produces synthetic CAN, CAN FD or analog signals in the input format of the capture Stream FBs.
+// Samples are generated once into a buffer of several packets, which is then replayed cyclically,
+// so that a packet costs one copy and the generator keeps up with rates far beyond a real bus.
+class LoadGeneratorFb final : public FunctionBlock
+{
+public:
+    enum class Payload
+    {
+        can,
+        canFd,
+        analog
+    };
+
+    enum class ArbIdDistribution
+    {
+        constant,
+        sequential,
+        uniform
+    };
+
+    struct Settings
+    {
+        Payload payload{Payload::can};
+        uint64_t messageRate{1000};
+        size_t samplesPerPacket{100};
+        size_t minPayloadSize{8};
+        size_t maxPayloadSize{8};
+        ArbIdDistribution arbIdDistribution{ArbIdDistribution::sequential};
+        uint32_t firstArbId{0};
+        uint32_t arbIdCount{1};
+        uint32_t seed{0};
+    };
+
+public:
+    explicit LoadGeneratorFb(const ModuleInfoPtr& moduleInfo, const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+    ~LoadGeneratorFb() override;
+
+    static FunctionBlockTypePtr CreateType(const ModuleInfoPtr& moduleInfo);
+
+    // Precomputed samples of packetsCount packets of settings.samplesPerPacket samples each
+    static std::vector<uint8_t> createPattern(const Settings& settings, size_t packetsCount);
+    static size_t getSampleSize(Payload payload);
+    // Time of the sample relative to the first one, in microseconds
+    static uint64_t getSampleTime(const Settings& settings, uint64_t sampleIndex);
+
+private:
+    void initProperties();
+    void createSignals();
+    void buildSignalDescriptors();
+    void settingsChanged();
+    void settingsChangedInternal();
+    void readSettings();
+
+    void start();
+    void stop();
+    void generate();
+    void sendPacket(uint64_t packetIndex, uint64_t startTime);
+
+private:
+    static constexpr size_t minPatternSamples = 4096;
+
+    SignalConfigPtr valueSignal;
+    SignalConfigPtr domainSignal;
+
+    Settings settings;
+    std::vector<uint8_t> pattern;
+    size_t patternPackets{1};
+
+    std::thread generatorThread;
+    std::mutex stopSync;
+    std::condition_variable stopCv;
+    bool stopRequested{false};
+
+    std::atomic<uint64_t> generatedSamples{0};
+    std::atomic<uint64_t> generatedPackets{0};
+    std::atomic<uint64_t> latePackets{0};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -15,16 +15,30 @@
  */
 
 #pragma once
+#include <asam_cmp/analog_payload.h>
 #include <asam_cmp/encoder.h>
 #include <asam_cmp/payload_type.h>
 #include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_common_lib/can_id_filter.h>
 #include <asam_cmp_common_lib/id_manager.h>
 #include <asam_cmp_common_lib/stream_common_fb_impl.h>
+#include <asam_cmp_capture_module/analog_decimator.h>
+#include <asam_cmp_capture_module/can_rate_limiter.h>
 #include <asam_cmp_capture_module/encoder_bank.h>
+#include <asam_cmp_capture_module/frame_pacer.h>
+#include <asam_cmp_capture_module/input_descriptors_validator.h>
+#include <asam_cmp_capture_module/traffic_shaper.h>
+#include <asam_cmp_capture_module/transmit_queue.h>
+#include <asam_cmp_capture_module/transmit_statistics.h>
 #include <opendaq/context_factory.h>
 #include <opendaq/function_block_impl.h>
 #include <opendaq/data_packet_ptr.h>
 #include <opendaq/event_packet_ptr.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include <vector>
 
 
 namespace daq::asam_cmp_common_lib
@@ -43,10 +57,24 @@ struct StreamInit
     const bool& allowJumboFrames;
     const EncoderBankPtr encoderBank;
     std::function<void()> parentInterfaceUpdater;
+    TransmitStatistics* interfaceStatistics;
+    TrafficShaper& shaper;
+    TokenBucket& interfaceBucket;
+    TransmitQueue& transmitQueue;
+    FramePacer& pacer;
 };
 
 class StreamFb final : public asam_cmp_common_lib::StreamCommonFb
 {
+public:
+    // Raw sample type of internally scaled analog data, Auto selects Int16 if it meets SamplePrecision
+    enum class SampleResolution
+    {
+        Auto,
+        Int16,
+        Int32
+    };
+
 public:
     explicit StreamFb(const ModuleInfoPtr& moduleInfo,
                       const ContextPtr& ctx,
@@ -54,7 +82,11 @@ public:
                       const StringPtr& localId,
                       const asam_cmp_common_lib::StreamCommonInit& init,
                       const StreamInit& internalInit);
-    ~StreamFb() override = default;
+    ~StreamFb() override;
+
+protected:
+    void removed() override;
+
 private:
     void setPayloadType(ASAM::CMP::PayloadType type) override;
 
@@ -62,12 +94,18 @@ private:
     void updateStreamIdInternal() override;
 
     void initProperties();
+    void updateSampleResolutionInternal();
+    void updateDecimationInternal();
+    void createAnalogDecimator();
+    void updateCanIdFilterInternal();
+    void updateCanMinIntervalsInternal();
 
     void initStatuses();
     void setInputStatus(const StringPtr& value);
     void onAnalogSignalConnected();
     void configureScaledAnalogSignal();
     void configureMinMaxAnalogSignal();
+    bool useInt16AnalogSamples() const;
     void onAnalogSignalDisconnected();
 
     void onPacketReceived(const InputPortPtr& port) override;
@@ -78,7 +116,24 @@ private:
     void processDataPacket(const DataPacketPtr& packet);
     template <typename CanPayloadType>
     void processCanPacket(const DataPacketPtr& packet);
+    template <typename CanPayloadType>
+    void addCanPacket(std::vector<ASAM::CMP::Packet>& packets, uint32_t arbId, uint8_t length, const uint8_t* data, uint64_t timestamp);
+    void sendCanPackets(std::vector<ASAM::CMP::Packet>& packets, std::chrono::steady_clock::time_point encodeStart);
+    template <typename CanPayloadType>
+    void releasePendingCanFrames();
+    void scheduleCanRelease();
+    void canReleaseLoop();
     void processAnalogPacket(const DataPacketPtr& packet);
+    size_t decimateAnalogPacket(const DataPacketPtr& packet, uint64_t& rawTime);
+    template <typename SetSegmentData>
+    void sendAnalogSegments(ASAM::CMP::AnalogPayload& payload,
+                            size_t sampleCount,
+                            uint64_t rawTime,
+                            uint64_t timeScale,
+                            SetSegmentData&& setSegmentData);
+    void sendFrames(const std::vector<std::vector<uint8_t>>& frames);
+    void sendShapedFrames(const std::vector<std::vector<uint8_t>>& frames);
+    TransmitQueue::Lane getTransmitLane() const;
 
     void processEventPacket(const EventPacketPtr& packet);
     ASAM::CMP::DataContext createEncoderDataContext() const;
@@ -94,11 +149,31 @@ private:
     DataDescriptorPtr inputDataDescriptor;
     DataDescriptorPtr inputDomainDataDescriptor;
     SampleType inputSampleType;
+    CanInputLayout canInputLayout{CanInputLayout::invalid};
     bool isConfigured;
 
+    asam_cmp_common_lib::CanIdFilter canIdFilter;
+    // Whether canIdFilter lists the IDs to send or the IDs to drop
+    bool canIdFilterAllows{true};
+    CanRateLimiter canRateLimiter;
+    // Timestamp in nanoseconds of the latest rate limited frame and its arrival, to release pending frames in time
+    uint64_t lastCanTimestamp{0};
+    std::chrono::steady_clock::time_point lastCanArrival;
+    std::thread canReleaseThread;
+    std::mutex canReleaseSync;
+    std::condition_variable canReleaseCv;
+    std::chrono::steady_clock::time_point canReleaseDeadline{std::chrono::steady_clock::time_point::max()};
+    bool stopCanRelease{false};
+
     std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
     const bool allowJumboFrames;
     ASAM::CMP::DataContext dataContext;
+    TransmitStatistics statistics;
+    TrafficShaper& shaper;
+    TokenBucket& interfaceBucket;
+    TransmitQueue& transmitQueue;
+    FramePacer& pacer;
+    std::vector<TrafficShaper::Clock::time_point> departures;
 
     //for analog data
     double analogDataDeltaTime;
@@ -108,6 +183,16 @@ private:
     double analogDataOffset;
     size_t analogDataSampleDt = 32;
     bool analogDataHasInternalPostScaling;
+    SampleResolution sampleResolution{SampleResolution::Auto};
+    // Largest acceptable quantization step in the unit of the signal, 0 keeps Int32 in Auto mode
+    double samplePrecision{0};
+    // Domain delta of the input signal in ticks
+    int64_t analogInputDelta{0};
+    size_t decimationFactor{1};
+    std::unique_ptr<AnalogDecimator> analogDecimator;
+    std::vector<double> decimatedSamples;
+    // Quantized samples of the analog segment being encoded
+    std::vector<uint8_t> analogSegmentData;
 };
 
 END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
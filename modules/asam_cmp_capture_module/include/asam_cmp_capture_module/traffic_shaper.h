@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Token bucket of a transmit link. Instead of counting tokens the bucket keeps the time at which it is full
+// again, so the departure time of a frame follows from the frames reserved before it.
+class TokenBucket final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    // A rate of 0 disables the limit. Refills the bucket.
+    void setRate(double bitsPerSecond, size_t burstBytes) noexcept;
+    bool isLimited() const noexcept;
+
+    // Earliest time not before earliest at which the bucket holds the tokens of a frame of the given size
+    Clock::time_point getDeparture(size_t bytes, Clock::time_point earliest) const noexcept;
+    // Takes the tokens of a frame sent at departure
+    void consume(size_t bytes, Clock::time_point departure) noexcept;
+
+private:
+    std::chrono::nanoseconds getTransmitTime(size_t bytes) const noexcept;
+
+private:
+    double nanosecondsPerByte{0};
+    std::chrono::nanoseconds burstTime{0};
+    Clock::time_point fullAt{};
+};
+
+// Paces the frames of the streams of a capture module through the token bucket of their interface and the
+// token bucket of the adapter. Frames that could not be sent within the maximum latency are dropped instead
+// of building up a queue.
+class TrafficShaper final
+{
+public:
+    using Clock = TokenBucket::Clock;
+
+    // Frames due within one slot are sent back to back, so pacing does not sleep for every frame
+    static constexpr std::chrono::microseconds pacingSlot{100};
+    // Departure time of a dropped frame
+    static constexpr Clock::time_point dropped = Clock::time_point::max();
+
+public:
+    TokenBucket& getAdapterBucket() noexcept;
+    // Sets the rate of the adapter bucket or of an interface bucket
+    void setRate(TokenBucket& bucket, double bitsPerSecond, size_t burstBytes);
+    void setMaxLatency(std::chrono::nanoseconds latency);
+
+    bool isLimited(const TokenBucket& interfaceBucket);
+
+    // Assigns each frame the time it may be sent at, or dropped. Dropped frames take no tokens.
+    void schedule(TokenBucket& interfaceBucket,
+                  const std::vector<std::vector<uint8_t>>& frames,
+                  Clock::time_point now,
+                  std::vector<Clock::time_point>& departures);
+
+    // Size of a frame on the wire: Ethernet header, padding, FCS, preamble and inter-frame gap
+    static size_t getWireSize(size_t cmpFrameSize) noexcept;
+
+private:
+    std::mutex sync;
+    TokenBucket adapterBucket;
+    std::chrono::nanoseconds maxLatency{std::chrono::milliseconds(100)};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Grants the network adapter to one sender at a time, in the order of the priority lanes of the waiting senders.
+// A batch is sent in runs of at most maxBatchRun frames with a grant each, so a lane waits at most for the run in
+// progress. Frames can be tagged with an 802.1Q priority per lane, so switches on the path keep the order.
+class TransmitQueue final
+{
+public:
+    // In priority order
+    enum class Lane : uint8_t
+    {
+        status,
+        analog,
+        can
+    };
+
+    enum class Scheduling
+    {
+        // A lane is granted only if no lane of higher priority waits
+        strict,
+        // Status is strict, analog gets analogWeight frames for every CAN frame while both wait
+        weighted
+    };
+
+    static constexpr size_t laneCount = 3;
+    // Frames of a batch sent under one grant, the sendmmsg batch of the UDP adapter
+    static constexpr size_t maxBatchRun = 64;
+
+public:
+    explicit TransmitQueue(std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper);
+
+    void setScheduling(Scheduling newScheduling, size_t newAnalogWeight);
+    // Tags the frames of each lane with the VLAN ID and the priority code point of the lane
+    void setVlanTagging(bool enabled, uint16_t vlanId, const std::array<uint8_t, laneCount>& priorities);
+
+    bool send(Lane lane, const std::vector<uint8_t>& frame);
+    // Returns the number of frames sent, sending stops at the first failure. Waiting lanes of higher priority
+    // are granted between the runs.
+    size_t send(Lane lane, const std::vector<std::vector<uint8_t>>& frames);
+
+    size_t getWaitingCount(Lane lane) const;
+
+private:
+    class Grant;
+
+    bool canGrant(size_t lane) const;
+
+private:
+    const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
+
+    mutable std::mutex sync;
+    std::condition_variable released;
+    bool busy{false};
+    std::array<size_t, laneCount> waiting{};
+    Scheduling scheduling{Scheduling::strict};
+    size_t analogWeight{4};
+    // Analog frames sent since the last CAN grant
+    size_t analogFrames{0};
+
+    bool vlanTagging{false};
+    std::array<asam_cmp_common_lib::VlanTag, laneCount> vlanTags{};
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_capture_module/common.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <coreobjects/property_object_ptr.h>
+#include <atomic>
+#include <chrono>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Transmit counters of a Stream FB or an Interface FB. Stream statistics forward every update
+// to the statistics of their parent interface, so the interface reports the sum over its streams.
+class TransmitStatistics final
+{
+public:
+    explicit TransmitStatistics(TransmitStatistics* parent = nullptr);
+
+    void onSamplesReceived(uint64_t count) noexcept;
+    void onMessagesEncoded(uint64_t count) noexcept;
+    void onFrameSent(uint64_t bytes) noexcept;
+    void onSendFailure() noexcept;
+    void onCanFrameSkipped() noexcept;
+    void onCanFramesFiltered(uint64_t count) noexcept;
+    void onCanFramesThrottled(uint64_t count) noexcept;
+    // Frames dropped by the traffic shaper because they exceeded its maximum latency
+    void onFramesShaped(uint64_t count) noexcept;
+    void recordEncodeTime(std::chrono::steady_clock::duration duration) noexcept;
+    void recordSendTime(std::chrono::steady_clock::duration duration) noexcept;
+
+    void reset() noexcept;
+
+    // Adds read-only statistics properties and the ResetStatistics procedure to the function block
+    void addProperties(const PropertyObjectPtr& objPtr);
+
+private:
+    void addCounterProperty(const PropertyObjectPtr& objPtr, const StringPtr& name, const std::atomic<uint64_t>& counter);
+    void addLatencyProperty(const PropertyObjectPtr& objPtr,
+                            const StringPtr& name,
+                            const asam_cmp_common_lib::LatencyHistogram& histogram,
+                            double percentile);
+
+private:
+    TransmitStatistics* parent;
+
+    std::atomic<uint64_t> samplesReceived{0};
+    std::atomic<uint64_t> messagesEncoded{0};
+    std::atomic<uint64_t> framesSent{0};
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> sendFailures{0};
+    std::atomic<uint64_t> skippedCanFrames{0};
+    std::atomic<uint64_t> filteredCanFrames{0};
+    std::atomic<uint64_t> throttledCanFrames{0};
+    std::atomic<uint64_t> shapedFrames{0};
+
+    asam_cmp_common_lib::LatencyHistogram encodeTime;
+    asam_cmp_common_lib::LatencyHistogram sendTime;
+};
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
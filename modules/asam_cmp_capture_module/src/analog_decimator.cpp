@@ -0,0 +1,136 @@
+#include <asam_cmp_capture_module/analog_decimator.h>
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASAM_CMP_DECIMATOR_SSE2
+#endif
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    // Taps per unit of the decimation factor, sets the transition width of the filter
+    constexpr size_t tapsPerFactor = 16;
+    // Cutoff relative to the Nyquist frequency of the decimated stream
+    constexpr double relativeCutoff = 0.8;
+    constexpr double pi = 3.14159265358979323846;
+
+    // Windowed sinc low pass with a Blackman window, normalized to unity gain at DC
+    std::vector<double> designLowPass(size_t factor)
+    {
+        const size_t tapCount = tapsPerFactor * factor + 1;
+        const double cutoff = relativeCutoff * 0.5 / static_cast<double>(factor);
+        const double center = static_cast<double>(tapCount - 1) / 2;
+
+        std::vector<double> taps(tapCount);
+        double sum = 0;
+        for (size_t i = 0; i < tapCount; ++i)
+        {
+            const double x = static_cast<double>(i) - center;
+            const double sinc = x == 0 ? 2 * cutoff : std::sin(2 * pi * cutoff * x) / (pi * x);
+            const double phase = 2 * pi * static_cast<double>(i) / static_cast<double>(tapCount - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);
+            taps[i] = sinc * window;
+            sum += taps[i];
+        }
+
+        for (auto& tap : taps)
+            tap /= sum;
+        return taps;
+    }
+
+    // Four independent accumulators hide the latency of the additions
+    double dotProduct(const double* a, const double* b, size_t count)
+    {
+        size_t i = 0;
+#ifdef ASAM_CMP_DECIMATOR_SSE2
+        __m128d sum0 = _mm_setzero_pd();
+        __m128d sum1 = _mm_setzero_pd();
+        for (; i + 4 <= count; i += 4)
+        {
+            sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+            sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        }
+        const __m128d sum = _mm_add_pd(sum0, sum1);
+        double result = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+#else
+        double sums[4]{};
+        for (; i + 4 <= count; i += 4)
+        {
+            sums[0] += a[i] * b[i];
+            sums[1] += a[i + 1] * b[i + 1];
+            sums[2] += a[i + 2] * b[i + 2];
+            sums[3] += a[i + 3] * b[i + 3];
+        }
+        double result = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+#endif
+        for (; i < count; ++i)
+            result += a[i] * b[i];
+        return result;
+    }
+}
+
+AnalogDecimator::AnalogDecimator(size_t factor)
+    : factor(factor)
+{
+    if (factor < 2 || factor > maxFactor)
+        throw std::invalid_argument("Decimation factor must be between 2 and " + std::to_string(maxFactor));
+
+    taps = designLowPass(factor);
+}
+
+size_t AnalogDecimator::getFactor() const noexcept
+{
+    return factor;
+}
+
+size_t AnalogDecimator::getTapCount() const noexcept
+{
+    return taps.size();
+}
+
+size_t AnalogDecimator::getDelay() const noexcept
+{
+    return (taps.size() - 1) / 2;
+}
+
+size_t AnalogDecimator::getNextOutputIndex() const noexcept
+{
+    return nextOutput;
+}
+
+size_t AnalogDecimator::getMaxOutputCount(size_t count) const noexcept
+{
+    return count / factor + 1;
+}
+
+void AnalogDecimator::reset() noexcept
+{
+    samples.clear();
+    nextOutput = 0;
+    primed = false;
+}
+
+size_t AnalogDecimator::filter(double* output)
+{
+    // The taps are symmetric, so the history can be used in its natural order
+    const size_t historySize = taps.size() - 1;
+    const size_t count = samples.size() - historySize;
+
+    size_t outputCount = 0;
+    size_t i = nextOutput;
+    for (; i < count; i += factor)
+        output[outputCount++] = dotProduct(samples.data() + i, taps.data(), taps.size());
+    nextOutput = i - count;
+
+    memmove(samples.data(), samples.data() + count, historySize * sizeof(double));
+    samples.resize(historySize);
+    return outputCount;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,87 @@
+#include <asam_cmp_capture_module/analog_quantizer.h>
+
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASAM_CMP_QUANTIZER_SSE2
+#endif
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    template <typename Raw>
+    Raw quantize(double value, double inverseScale, double offset)
+    {
+        constexpr double minValue = std::numeric_limits<Raw>::min();
+        constexpr double maxValue = std::numeric_limits<Raw>::max();
+
+        double raw = std::nearbyint((value - offset) * inverseScale);
+        // Written so that NaN fails the first comparison
+        if (!(raw >= minValue))
+            raw = minValue;
+        if (raw > maxValue)
+            raw = maxValue;
+        return static_cast<Raw>(raw);
+    }
+
+#ifdef ASAM_CMP_QUANTIZER_SSE2
+    // Converts two values to int32 lanes. maxpd returns its second operand for NaN, which maps NaN to the minimum.
+    // cvtpd rounds to nearest even like nearbyint in the default rounding mode.
+    inline __m128i quantizePair(const double* values, __m128d inverseScale, __m128d offset, __m128d minValue, __m128d maxValue)
+    {
+        __m128d raw = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(values), offset), inverseScale);
+        raw = _mm_min_pd(_mm_max_pd(raw, minValue), maxValue);
+        return _mm_cvtpd_epi32(raw);
+    }
+#endif
+}
+
+void quantizeAnalogSamples(const double* values, size_t count, double scale, double offset, int16_t* output)
+{
+    const double inverseScale = 1.0 / scale;
+    size_t i = 0;
+#ifdef ASAM_CMP_QUANTIZER_SSE2
+    const __m128d inverseScales = _mm_set1_pd(inverseScale);
+    const __m128d offsets = _mm_set1_pd(offset);
+    const __m128d minValue = _mm_set1_pd(std::numeric_limits<int16_t>::min());
+    const __m128d maxValue = _mm_set1_pd(std::numeric_limits<int16_t>::max());
+    for (; i + 8 <= count; i += 8)
+    {
+        // Each conversion fills the low two int32 lanes, the packs saturate them to eight int16 values
+        const __m128i q0 = quantizePair(values + i, inverseScales, offsets, minValue, maxValue);
+        const __m128i q1 = quantizePair(values + i + 2, inverseScales, offsets, minValue, maxValue);
+        const __m128i q2 = quantizePair(values + i + 4, inverseScales, offsets, minValue, maxValue);
+        const __m128i q3 = quantizePair(values + i + 6, inverseScales, offsets, minValue, maxValue);
+        const __m128i low = _mm_unpacklo_epi64(q0, q1);
+        const __m128i high = _mm_unpacklo_epi64(q2, q3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+    }
+#endif
+    for (; i < count; ++i)
+        output[i] = quantize<int16_t>(values[i], inverseScale, offset);
+}
+
+void quantizeAnalogSamples(const double* values, size_t count, double scale, double offset, int32_t* output)
+{
+    const double inverseScale = 1.0 / scale;
+    size_t i = 0;
+#ifdef ASAM_CMP_QUANTIZER_SSE2
+    const __m128d inverseScales = _mm_set1_pd(inverseScale);
+    const __m128d offsets = _mm_set1_pd(offset);
+    const __m128d minValue = _mm_set1_pd(std::numeric_limits<int32_t>::min());
+    const __m128d maxValue = _mm_set1_pd(std::numeric_limits<int32_t>::max());
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i q0 = quantizePair(values + i, inverseScales, offsets, minValue, maxValue);
+        const __m128i q1 = quantizePair(values + i + 2, inverseScales, offsets, minValue, maxValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_unpacklo_epi64(q0, q1));
+    }
+#endif
+    for (; i < count; ++i)
+        output[i] = quantize<int32_t>(values[i], inverseScale, offset);
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
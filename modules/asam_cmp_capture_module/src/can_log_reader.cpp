@@ -0,0 +1,328 @@
+#include <asam_cmp_capture_module/can_log_reader.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    constexpr uint32_t extendedIdMask = 0x1FFFFFFF;
+    constexpr uint32_t candumpErrorFlag = 0x20000000;
+    constexpr size_t maxCanLength = 8;
+    constexpr size_t maxCanFdLength = 64;
+
+    class Tokenizer
+    {
+    public:
+        explicit Tokenizer(std::string_view text)
+            : rest(text)
+        {
+        }
+
+        std::string_view next() noexcept
+        {
+            const size_t begin = rest.find_first_not_of(" \t");
+            if (begin == std::string_view::npos)
+            {
+                rest = {};
+                return {};
+            }
+
+            rest.remove_prefix(begin);
+            const size_t end = std::min(rest.find_first_of(" \t"), rest.size());
+            const auto token = rest.substr(0, end);
+            rest.remove_prefix(end);
+            return token;
+        }
+
+    private:
+        std::string_view rest;
+    };
+
+    template <typename T>
+    bool parseInteger(std::string_view text, T& value, int base)
+    {
+        if (text.empty())
+            return false;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    // Seconds with an optional fraction of up to 9 digits, to nanoseconds
+    bool parseSeconds(std::string_view text, uint64_t& nanoseconds)
+    {
+        const size_t dot = text.find('.');
+        uint64_t seconds = 0;
+        if (!parseInteger(text.substr(0, dot), seconds, 10))
+            return false;
+
+        uint64_t fraction = 0;
+        if (dot != std::string_view::npos)
+        {
+            auto fractionText = text.substr(dot + 1, 9);
+            if (!fractionText.empty() && !parseInteger(fractionText, fraction, 10))
+                return false;
+            for (size_t i = fractionText.size(); i < 9; ++i)
+                fraction *= 10;
+        }
+
+        nanoseconds = seconds * 1'000'000'000 + fraction;
+        return true;
+    }
+
+    bool isValidCanFdLength(size_t length)
+    {
+        return length <= 8 || length == 12 || length == 16 || length == 20 || length == 24 || length == 32 || length == 48 || length == 64;
+    }
+
+    bool startsWith(std::string_view text, std::string_view prefix)
+    {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+
+    bool parseId(std::string_view text, int base, uint32_t& id)
+    {
+        if (!text.empty() && (text.back() == 'x' || text.back() == 'X'))
+            text.remove_suffix(1);
+        return parseInteger(text, id, base) && id <= extendedIdMask;
+    }
+}
+
+CanLogReader::CanLogReader(const std::string& fileName)
+    : file(fileName, true)
+    , text(reinterpret_cast<const char*>(file.getData()), file.getSize())
+    , format(detectFormat(fileName, text))
+{
+}
+
+CanLogReader::CanLogReader(const std::string& fileName, Format format)
+    : file(fileName, true)
+    , text(reinterpret_cast<const char*>(file.getData()), file.getSize())
+    , format(format)
+{
+}
+
+CanLogReader::Format CanLogReader::getFormat() const noexcept
+{
+    return format;
+}
+
+uint64_t CanLogReader::getSkippedLines() const noexcept
+{
+    return skippedLines;
+}
+
+CanLogReader::Format CanLogReader::detectFormat(std::string_view fileName, std::string_view content)
+{
+    const size_t dot = fileName.rfind('.');
+    if (dot != std::string_view::npos)
+    {
+        std::string extension(fileName.substr(dot + 1));
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension == "asc")
+            return Format::vectorAsc;
+    }
+
+    // candump -l lines start with the timestamp in parentheses
+    const size_t first = content.find_first_not_of(" \t\r\n");
+    if (first != std::string_view::npos && content[first] == '(')
+        return Format::candump;
+    return Format::vectorAsc;
+}
+
+void CanLogReader::rewind() noexcept
+{
+    position = 0;
+    ascDecimalBase = false;
+    ascRelativeTimestamps = false;
+    ascLastTimestamp = 0;
+}
+
+std::string_view CanLogReader::nextLine() noexcept
+{
+    const size_t end = std::min(text.find('\n', position), text.size());
+    auto line = text.substr(position, end - position);
+    position = std::min(end + 1, text.size());
+
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    return line;
+}
+
+bool CanLogReader::next(Frame& frame)
+{
+    while (position < text.size())
+    {
+        const auto line = nextLine();
+        if (line.find_first_not_of(" \t") == std::string_view::npos)
+            continue;
+
+        if (format == Format::candump)
+        {
+            if (parseCandumpLine(line, frame))
+                return true;
+            ++skippedLines;
+            continue;
+        }
+
+        switch (parseAscLine(line, frame))
+        {
+            case LineType::frame:
+                return true;
+            case LineType::skipped:
+                ++skippedLines;
+                break;
+            case LineType::header:
+                break;
+        }
+    }
+
+    return false;
+}
+
+bool CanLogReader::parseCandumpLine(std::string_view line, Frame& frame)
+{
+    // (1436509052.249713) can0 12345678#DEADBEEF, CAN FD frames use ## followed by a flags digit
+    Tokenizer tokens(line);
+    const auto timestamp = tokens.next();
+    if (timestamp.size() < 3 || timestamp.front() != '(' || timestamp.back() != ')' ||
+        !parseSeconds(timestamp.substr(1, timestamp.size() - 2), frame.timestamp))
+        return false;
+
+    frame.channel = tokens.next();
+    const auto body = tokens.next();
+    const size_t separator = body.find('#');
+    if (frame.channel.empty() || separator == std::string_view::npos)
+        return false;
+
+    const auto idText = body.substr(0, separator);
+    uint32_t id = 0;
+    if ((idText.size() != 3 && idText.size() != 8) || !parseInteger(idText, id, 16))
+        return false;
+    if (idText.size() == 8 && (id & candumpErrorFlag) != 0)
+        return false;
+
+    auto data = body.substr(separator + 1);
+    frame.canFd = !data.empty() && data.front() == '#';
+    if (frame.canFd)
+    {
+        if (data.size() < 2)
+            return false;
+        data.remove_prefix(2);
+    }
+    else if (!data.empty() && (data.front() == 'R' || data.front() == 'r'))
+    {
+        return false;
+    }
+
+    memset(&frame.data, 0, sizeof(CANData));
+    frame.data.arbId = id & extendedIdMask;
+
+    size_t length = 0;
+    for (size_t i = 0; i < data.size();)
+    {
+        if (data[i] == '.')
+        {
+            ++i;
+            continue;
+        }
+
+        if (i + 2 > data.size() || length == maxCanFdLength || !parseInteger(data.substr(i, 2), frame.data.data[length], 16))
+            return false;
+        ++length;
+        i += 2;
+    }
+
+    if (length > (frame.canFd ? maxCanFdLength : maxCanLength) || (frame.canFd && !isValidCanFdLength(length)))
+        return false;
+
+    frame.data.length = static_cast<uint8_t>(length);
+    return true;
+}
+
+CanLogReader::LineType CanLogReader::parseAscLine(std::string_view line, Frame& frame)
+{
+    Tokenizer tokens(line);
+    const auto first = tokens.next();
+
+    if (startsWith(first, "//") || first == "date" || first == "Begin" || first == "End" || first == "internal" || first == "no")
+        return LineType::header;
+
+    if (first == "base")
+    {
+        // base hex|dec  timestamps absolute|relative
+        ascDecimalBase = tokens.next() == "dec";
+        tokens.next();
+        ascRelativeTimestamps = tokens.next() == "relative";
+        return LineType::header;
+    }
+
+    if (!parseAscFrame(line, frame))
+        return LineType::skipped;
+
+    if (ascRelativeTimestamps)
+    {
+        frame.timestamp += ascLastTimestamp;
+        ascLastTimestamp = frame.timestamp;
+    }
+    return LineType::frame;
+}
+
+bool CanLogReader::parseAscFrame(std::string_view line, Frame& frame) const
+{
+    // CAN:    <time> <channel> <id>[x] <Rx|Tx> d <dlc> <data bytes> ...
+    // CAN FD: <time> CANFD <channel> <Rx|Tx> <id>[x] [<symbolic name>] <brs> <esi> <dlc> <data length> <data bytes> ...
+    const int base = ascDecimalBase ? 10 : 16;
+    Tokenizer tokens(line);
+    if (!parseSeconds(tokens.next(), frame.timestamp))
+        return false;
+
+    uint32_t id = 0;
+    size_t length = 0;
+    auto token = tokens.next();
+    frame.canFd = token == "CANFD";
+    if (frame.canFd)
+    {
+        frame.channel = tokens.next();
+        tokens.next();
+        if (!parseId(tokens.next(), base, id))
+            return false;
+
+        token = tokens.next();
+        if (token != "0" && token != "1")
+            token = tokens.next();
+        tokens.next();
+        tokens.next();
+        if (!parseInteger(tokens.next(), length, 10) || !isValidCanFdLength(length))
+            return false;
+    }
+    else
+    {
+        frame.channel = token;
+        uint32_t channelNumber = 0;
+        if (!parseInteger(frame.channel, channelNumber, 10) || !parseId(tokens.next(), base, id))
+            return false;
+
+        tokens.next();
+        if (tokens.next() != "d" || !parseInteger(tokens.next(), length, 16) || length > maxCanFdLength)
+            return false;
+        length = std::min(length, maxCanLength);
+    }
+
+    memset(&frame.data, 0, sizeof(CANData));
+    frame.data.arbId = id;
+    frame.data.length = static_cast<uint8_t>(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (!parseInteger(tokens.next(), frame.data.data[i], base))
+            return false;
+    }
+
+    return true;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,280 @@
+#include <asam_cmp_capture_module/can_log_replay_fb.h>
+#include <asam_cmp_capture_module/input_descriptors_validator.h>
+#include <coreobjects/callable_info_factory.h>
+#include <coreobjects/eval_value_factory.h>
+#include <coreobjects/property_object_protected_ptr.h>
+#include <coreobjects/unit_factory.h>
+#include <coretypes/listobject_factory.h>
+#include <coretypes/procedure_factory.h>
+#include <opendaq/component_type_private.h>
+#include <opendaq/custom_log.h>
+#include <opendaq/packet_factory.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    // Gap inserted between the last frame of a pass and the first frame of the next one when looping
+    constexpr uint64_t loopGapNs = 1000;
+}
+
+CanLogReplayFb::CanLogReplayFb(const ModuleInfoPtr& moduleInfo,
+                               const ContextPtr& ctx,
+                               const ComponentPtr& parent,
+                               const StringPtr& localId)
+    : FunctionBlock(CreateType(moduleInfo), ctx, parent, localId)
+{
+    initProperties();
+    createSignals();
+}
+
+CanLogReplayFb::~CanLogReplayFb()
+{
+    stopReplay();
+}
+
+FunctionBlockTypePtr CanLogReplayFb::CreateType(const ModuleInfoPtr& moduleInfo)
+{
+    auto fbType = FunctionBlockType("AsamCmpCanLogReplay", "AsamCmpCanLogReplay", "Replay of candump and Vector ASC CAN logs");
+
+    checkErrorInfo(fbType.asPtr<IComponentTypePrivate>(true)->setModuleInfo(moduleInfo));
+    return fbType;
+}
+
+void CanLogReplayFb::initProperties()
+{
+    StringPtr propName = "ReplayFile";
+    objPtr.addProperty(StringPropertyBuilder(propName, "").build());
+
+    propName = "LogFormat";
+    objPtr.addProperty(SelectionPropertyBuilder(propName, List<IString>("Auto", "candump", "Vector ASC"), 0).build());
+
+    propName = "ReplayMode";
+    objPtr.addProperty(SelectionPropertyBuilder(propName, List<IString>("AsFastAsPossible", "OriginalTiming"), 0).build());
+
+    propName = "ReplaySpeed";
+    objPtr.addProperty(FloatPropertyBuilder(propName, 1.0)
+                           .setMinValue(0.001)
+                           .setMaxValue(1000.0)
+                           .setVisible(EvalValue("$ReplayMode == 1"))
+                           .build());
+
+    propName = "MaxPacketDelay";
+    objPtr.addProperty(IntPropertyBuilder(propName, 10)
+                           .setMinValue(0)
+                           .setMaxValue(10000)
+                           .setUnit(Unit("ms"))
+                           .setVisible(EvalValue("$ReplayMode == 1"))
+                           .build());
+
+    propName = "SamplesPerPacket";
+    objPtr.addProperty(IntPropertyBuilder(propName, 1000).setMinValue(1).setMaxValue(100000).build());
+
+    propName = "Channel";
+    objPtr.addProperty(StringPropertyBuilder(propName, "").build());
+
+    propName = "ReplayLoop";
+    objPtr.addProperty(BoolPropertyBuilder(propName, false).build());
+
+    propName = "StartReplay";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { startReplayFromProperties(); }));
+
+    propName = "StopReplay";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { stopReplay(); }));
+
+    propName = "ReplayActive";
+    objPtr.addProperty(BoolPropertyBuilder(propName, false).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { args.setValue(running.load(std::memory_order_acquire)); };
+
+    propName = "ReplayedFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(static_cast<Int>(replayedFrames.load(std::memory_order_relaxed))); };
+
+    propName = "SkippedLines";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(static_cast<Int>(skippedLines.load(std::memory_order_relaxed))); };
+}
+
+void CanLogReplayFb::createSignals()
+{
+    valueSignal = createAndAddSignal("value");
+    domainSignal = createAndAddSignal("time", nullptr, false);
+
+    valueSignal.setDescriptor(createCanDataDescriptor());
+    domainSignal.setDescriptor(DataDescriptorBuilder()
+                                   .setSampleType(SampleType::Int64)
+                                   .setUnit(Unit("s", -1, "seconds", "time"))
+                                   .setTickResolution(Ratio(1, 1'000'000'000))
+                                   .setOrigin("1970-01-01T00:00:00Z")
+                                   .setName("Time CAN")
+                                   .build());
+    valueSignal.setDomainSignal(domainSignal);
+}
+
+void CanLogReplayFb::startReplayFromProperties()
+{
+    auto lock = this->getRecursiveConfigLock();
+
+    const std::string fileName = objPtr.getPropertyValue("ReplayFile").asPtr<IString>().toStdString();
+
+    Options replayOptions;
+    const Int format = objPtr.getPropertyValue("LogFormat");
+    if (format != 0)
+        replayOptions.format = format == 1 ? CanLogReader::Format::candump : CanLogReader::Format::vectorAsc;
+    replayOptions.mode = static_cast<Int>(objPtr.getPropertyValue("ReplayMode")) == 1 ? Mode::OriginalTiming : Mode::AsFastAsPossible;
+    replayOptions.speed = static_cast<Float>(objPtr.getPropertyValue("ReplaySpeed"));
+    replayOptions.maxPacketDelay = std::chrono::milliseconds(static_cast<Int>(objPtr.getPropertyValue("MaxPacketDelay")));
+    replayOptions.samplesPerPacket = static_cast<Int>(objPtr.getPropertyValue("SamplesPerPacket"));
+    replayOptions.channel = objPtr.getPropertyValue("Channel").asPtr<IString>().toStdString();
+    replayOptions.loop = objPtr.getPropertyValue("ReplayLoop");
+
+    try
+    {
+        startReplay(fileName, replayOptions);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Replay of \"{}\" failed: {}", fileName, e.what());
+        throw;
+    }
+}
+
+void CanLogReplayFb::startReplay(const std::string& fileName, const Options& replayOptions)
+{
+    stopReplay();
+
+    if (replayOptions.mode == Mode::OriginalTiming && !(replayOptions.speed > 0))
+        throw std::invalid_argument("Replay speed must be positive");
+    if (replayOptions.samplesPerPacket == 0)
+        throw std::invalid_argument("Samples per packet must be positive");
+
+    reader = replayOptions.format ? std::make_unique<CanLogReader>(fileName, *replayOptions.format) : std::make_unique<CanLogReader>(fileName);
+    options = replayOptions;
+    pendingFrames.clear();
+    pendingFrames.reserve(options.samplesPerPacket);
+    pendingTimestamps.clear();
+    pendingTimestamps.reserve(options.samplesPerPacket);
+
+    stopRequested = false;
+    replayedFrames = 0;
+    skippedLines = 0;
+    running = true;
+    replayThread = std::thread(&CanLogReplayFb::replayLoop, this);
+}
+
+void CanLogReplayFb::stopReplay()
+{
+    {
+        std::scoped_lock lock{stopSync};
+        stopRequested = true;
+    }
+    stopCv.notify_all();
+
+    if (replayThread.joinable())
+        replayThread.join();
+
+    reader.reset();
+}
+
+void CanLogReplayFb::replayLoop()
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint64_t startTimestamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    const double speed = options.mode == Mode::OriginalTiming ? options.speed : 1.0;
+
+    // Time of a frame relative to the first replayed frame, kept monotonic across loop passes and unordered log lines
+    uint64_t passOffset = 0;
+    uint64_t passFirstTimestamp = 0;
+    uint64_t passFrames = 0;
+    uint64_t lastRelativeTime = 0;
+    std::chrono::steady_clock::time_point pendingSince;
+
+    CanLogReader::Frame frame;
+    while (!stopRequested.load(std::memory_order_relaxed))
+    {
+        if (!reader->next(frame))
+        {
+            if (!options.loop || passFrames == 0)
+                break;
+
+            reader->rewind();
+            passOffset = lastRelativeTime + loopGapNs;
+            passFrames = 0;
+            continue;
+        }
+
+        skippedLines.store(reader->getSkippedLines(), std::memory_order_relaxed);
+        if (!options.channel.empty() && frame.channel != options.channel)
+            continue;
+
+        if (passFrames++ == 0)
+            passFirstTimestamp = frame.timestamp;
+        const uint64_t logOffset = frame.timestamp > passFirstTimestamp ? frame.timestamp - passFirstTimestamp : 0;
+        lastRelativeTime = std::max(lastRelativeTime, passOffset + logOffset);
+
+        const auto scaledTime = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(lastRelativeTime) / speed));
+        auto now = std::chrono::steady_clock::now();
+        if (options.mode == Mode::OriginalTiming)
+        {
+            const auto due = startTime + scaledTime;
+            if (!pendingFrames.empty() && due - pendingSince > options.maxPacketDelay)
+                flushPacket();
+            if (!waitUntil(due))
+                break;
+            now = due;
+        }
+
+        if (pendingFrames.empty())
+            pendingSince = now;
+        appendFrame(frame, startTimestamp + static_cast<uint64_t>(scaledTime.count()));
+        if (pendingFrames.size() >= options.samplesPerPacket)
+            flushPacket();
+    }
+
+    flushPacket();
+    skippedLines.store(reader->getSkippedLines(), std::memory_order_relaxed);
+    running.store(false, std::memory_order_release);
+}
+
+void CanLogReplayFb::appendFrame(const CanLogReader::Frame& frame, uint64_t timestamp)
+{
+    pendingFrames.push_back(frame.data);
+    pendingTimestamps.push_back(static_cast<int64_t>(timestamp));
+}
+
+void CanLogReplayFb::flushPacket()
+{
+    const size_t count = pendingFrames.size();
+    if (count == 0)
+        return;
+
+    const auto domainPacket = DataPacket(domainSignal.getDescriptor(), count);
+    const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), count);
+    memcpy(dataPacket.getRawData(), pendingFrames.data(), count * sizeof(CANData));
+    memcpy(domainPacket.getRawData(), pendingTimestamps.data(), count * sizeof(int64_t));
+
+    valueSignal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    replayedFrames.fetch_add(count, std::memory_order_relaxed);
+    pendingFrames.clear();
+    pendingTimestamps.clear();
+}
+
+bool CanLogReplayFb::waitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock lock{stopSync};
+    return !stopCv.wait_until(lock, deadline, [this] { return stopRequested.load(std::memory_order_relaxed); });
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,112 @@
+#include <asam_cmp_capture_module/can_rate_limiter.h>
+#include <asam_cmp_common_lib/can_id_filter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    constexpr uint64_t maxIntervalMs = 3'600'000;
+
+    std::string trim(const std::string& text)
+    {
+        const auto begin = text.find_first_not_of(" \t");
+        if (begin == std::string::npos)
+            return {};
+        return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+    }
+}
+
+CanRateLimiter::CanRateLimiter(const std::string& list)
+{
+    size_t position = 0;
+    while (position < list.size())
+    {
+        const auto begin = list.find_first_not_of(", \t", position);
+        if (begin == std::string::npos)
+            break;
+        position = list.find(',', begin);
+        const auto item = list.substr(begin, position == std::string::npos ? std::string::npos : position - begin);
+
+        const auto separator = item.rfind(':');
+        if (separator == std::string::npos)
+            throw std::invalid_argument("Missing interval in \"" + item + "\"");
+
+        const auto interval = trim(item.substr(separator + 1));
+        if (interval.empty() || interval.size() > 7 || interval.find_first_not_of("0123456789") != std::string::npos)
+            throw std::invalid_argument("Invalid interval in \"" + item + "\"");
+        const uint64_t intervalMs = std::stoull(interval);
+        if (intervalMs == 0 || intervalMs > maxIntervalMs)
+            throw std::invalid_argument("Interval in \"" + item + "\" is out of range");
+
+        const auto ranges = asam_cmp_common_lib::CanIdFilter::parseList(item.substr(0, separator));
+        if (ranges.empty())
+            throw std::invalid_argument("Missing CAN ID in \"" + item + "\"");
+        for (const auto& [first, last] : ranges)
+            limitedIds.add(first, last, intervals.size());
+        intervals.push_back(intervalMs * 1'000'000);
+    }
+}
+
+bool CanRateLimiter::isEmpty() const noexcept
+{
+    return limitedIds.isEmpty();
+}
+
+bool CanRateLimiter::admit(uint32_t arbId, const uint8_t* data, uint8_t length, uint64_t timestamp)
+{
+    const auto rule = limitedIds.find(arbId);
+    if (rule == asam_cmp_common_lib::CanIdMap::notFound)
+        return true;
+
+    auto [it, inserted] = states.try_emplace(arbId);
+    auto& state = it->second;
+    if (inserted)
+        state.interval = intervals[rule];
+
+    if (timestamp >= state.nextAllowed)
+    {
+        // A newer frame supersedes a pending frame that was not released yet
+        if (state.pending)
+        {
+            state.pending = false;
+            ++droppedFrames;
+        }
+        state.nextAllowed = timestamp + state.interval;
+        return true;
+    }
+
+    if (state.pending)
+    {
+        ++droppedFrames;
+    }
+    else
+    {
+        state.pending = true;
+        pendingIds.push_back(arbId);
+        nextRelease = std::min(nextRelease, state.nextAllowed);
+    }
+
+    state.frame.timestamp = timestamp;
+    state.frame.arbId = arbId;
+    state.frame.length = std::min<uint8_t>(length, sizeof(state.frame.data));
+    memcpy(state.frame.data, data, state.frame.length);
+    return false;
+}
+
+uint64_t CanRateLimiter::getNextRelease() const noexcept
+{
+    return nextRelease;
+}
+
+uint64_t CanRateLimiter::takeDroppedFrames() noexcept
+{
+    const auto dropped = droppedFrames;
+    droppedFrames = 0;
+    return dropped;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
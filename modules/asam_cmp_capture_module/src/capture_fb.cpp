@@ -2,6 +2,8 @@
 #include <asam_cmp_capture_module/interface_fb.h>
 #include <coreobjects/callable_info_factory.h>
 #include <coreobjects/argument_info_factory.h>
+#include <coreobjects/unit_factory.h>
+#include <array>
 #include <set>
 #include <fmt/format.h>
 #include <asam_cmp/cmp_header.h>
@@ -18,6 +20,8 @@ CaptureFb::CaptureFb(const ModuleInfoPtr& moduleInfo,
     , allowJumboFrames(false)
     , ethernetWrapper(init.ethernetWrapper)
     , selectedEthernetDeviceName(init.selectedDeviceName)
+    , transmitQueue(ethernetWrapper)
+    , pacer(transmitQueue)
 {
     initStatusPacket();
     initProperties();
@@ -43,6 +47,83 @@ void CaptureFb::initProperties()
     softwareVersion = "DefaultSoftwareVersion";
     objPtr.setPropertyValue("SoftwareVersion", softwareVersion);
     objPtr.endUpdate();
+
+    auto propName = "TxRateLimit";
+    auto prop = FloatPropertyBuilder(propName, 0.0).setMinValue(0.0).setUnit(Unit("Mbit/s")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateShaperInternal(); };
+
+    propName = "TxBurstSize";
+    prop = IntPropertyBuilder(propName, 15000).setMinValue(1500).setMaxValue(100'000'000).setUnit(Unit("B")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateShaperInternal(); };
+
+    propName = "TxMaxLatency";
+    prop = IntPropertyBuilder(propName, 100).setMinValue(1).setMaxValue(1000).setUnit(Unit("ms")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateShaperInternal(); };
+
+    propName = "TxScheduling";
+    prop = SelectionPropertyBuilder(propName, List<IString>("Strict", "Weighted"), 0).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateTransmitQueueInternal(); };
+
+    propName = "TxAnalogWeight";
+    prop = IntPropertyBuilder(propName, 4).setMinValue(1).setMaxValue(100).setVisible(EvalValue("$TxScheduling == 1")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateTransmitQueueInternal(); };
+
+    propName = "VlanTagging";
+    prop = BoolPropertyBuilder(propName, false).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateTransmitQueueInternal(); };
+
+    propName = "VlanId";
+    prop = IntPropertyBuilder(propName, 0).setMinValue(0).setMaxValue(4094).setVisible(EvalValue("$VlanTagging == true")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateTransmitQueueInternal(); };
+
+    // 802.1Q priority code points of the lanes: status above real-time analog data above bulk CAN data
+    const std::pair<const char*, Int> priorities[] = {{"StatusPriority", 6}, {"AnalogPriority", 5}, {"CanPriority", 0}};
+    for (const auto& [name, defaultPriority] : priorities)
+    {
+        prop = IntPropertyBuilder(name, defaultPriority).setMinValue(0).setMaxValue(7).setVisible(EvalValue("$VlanTagging == true")).build();
+        objPtr.addProperty(prop);
+        objPtr.getOnPropertyValueWrite(name) +=
+            [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateTransmitQueueInternal(); };
+    }
+}
+
+void CaptureFb::updateTransmitQueueInternal()
+{
+    const auto scheduling = static_cast<TransmitQueue::Scheduling>(static_cast<Int>(objPtr.getPropertyValue("TxScheduling")));
+    const Int analogWeight = objPtr.getPropertyValue("TxAnalogWeight");
+    const bool vlanTagging = objPtr.getPropertyValue("VlanTagging");
+    const Int vlanId = objPtr.getPropertyValue("VlanId");
+    const std::array<uint8_t, TransmitQueue::laneCount> priorities{
+        static_cast<uint8_t>(static_cast<Int>(objPtr.getPropertyValue("StatusPriority"))),
+        static_cast<uint8_t>(static_cast<Int>(objPtr.getPropertyValue("AnalogPriority"))),
+        static_cast<uint8_t>(static_cast<Int>(objPtr.getPropertyValue("CanPriority")))};
+
+    transmitQueue.setScheduling(scheduling, static_cast<size_t>(analogWeight));
+    transmitQueue.setVlanTagging(vlanTagging, static_cast<uint16_t>(vlanId), priorities);
+}
+
+void CaptureFb::updateShaperInternal()
+{
+    const Float rate = objPtr.getPropertyValue("TxRateLimit");
+    const Int burst = objPtr.getPropertyValue("TxBurstSize");
+    const Int maxLatency = objPtr.getPropertyValue("TxMaxLatency");
+
+    shaper.setRate(shaper.getAdapterBucket(), rate * 1e6, static_cast<size_t>(burst));
+    shaper.setMaxLatency(std::chrono::milliseconds(maxLatency));
 }
 
 void CaptureFb::propertyChanged()
@@ -86,7 +167,8 @@ void CaptureFb::addInterfaceInternal(){
     std::scoped_lock lock{statusSync};
 
     auto newId = interfaceIdManager.getFirstUnusedId();
-    InterfaceFbInit init{&encoders, captureStatus, statusSync, ethernetWrapper, allowJumboFrames, selectedEthernetDeviceName};
+    InterfaceFbInit init{
+        &encoders, captureStatus, statusSync, ethernetWrapper, allowJumboFrames, selectedEthernetDeviceName, shaper, transmitQueue, pacer};
     addInterfaceWithParams<InterfaceFb>(newId, init);
 }
 
@@ -117,7 +199,7 @@ void CaptureFb::statusLoop()
             auto encodeAndSend = [&](const ASAM::CMP::Packet& packet) {
                 auto encodedData = encoders.encode(1, packet, encoderContext);
                 for (const auto& e : encodedData)
-                    ethernetWrapper->sendPacket(e);
+                    transmitQueue.send(TransmitQueue::Lane::status, e);
             };
 
             encodeAndSend(captureStatus.getPacket());
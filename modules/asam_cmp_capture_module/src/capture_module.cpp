@@ -3,6 +3,8 @@
 #include <asam_cmp_capture_module/capture_module.h>
 #include <asam_cmp_capture_module/version.h>
 #include <asam_cmp_capture_module/capture_module_fb.h>
+#include <asam_cmp_capture_module/load_generator_fb.h>
+#include <asam_cmp_capture_module/can_log_replay_fb.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
@@ -21,6 +23,12 @@ DictPtr<IString, IFunctionBlockType> CaptureModule::onGetAvailableFunctionBlockT
     auto typeCaptureModule = CaptureModuleFb::CreateType(moduleInfo);
     types.set(typeCaptureModule.getId(), typeCaptureModule);
 
+    auto typeLoadGenerator = LoadGeneratorFb::CreateType(moduleInfo);
+    types.set(typeLoadGenerator.getId(), typeLoadGenerator);
+
+    auto typeCanLogReplay = CanLogReplayFb::CreateType(moduleInfo);
+    types.set(typeCanLogReplay.getId(), typeCanLogReplay);
+
     return types;
 }
 
@@ -35,6 +43,12 @@ FunctionBlockPtr CaptureModule::onCreateFunctionBlock(const StringPtr& id,
         return fb;
     }
 
+    if (id == LoadGeneratorFb::CreateType(moduleInfo).getId())
+        return createWithImplementation<IFunctionBlock, LoadGeneratorFb>(moduleInfo, context, parent, localId);
+
+    if (id == CanLogReplayFb::CreateType(moduleInfo).getId())
+        return createWithImplementation<IFunctionBlock, CanLogReplayFb>(moduleInfo, context, parent, localId);
+
     LOG_W("Function block \"{}\" not found", id);
     throw NotFoundException("Function block not found");
 }
@@ -2,7 +2,7 @@
 
 #include <asam_cmp_capture_module/capture_fb.h>
 #include <asam_cmp_capture_module/capture_module_fb.h>
-#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/ethernet_composite_impl.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
@@ -14,7 +14,7 @@ CaptureModuleFb::CaptureModuleFb(const ModuleInfoPtr& moduleInfo,const ContextPt
 
 FunctionBlockPtr CaptureModuleFb::create(const ModuleInfoPtr& moduleInfo, const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId)
 {
-    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ptr = std::make_shared<asam_cmp_common_lib::EthernetPcppImpl>();
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ptr = asam_cmp_common_lib::EthernetCompositeImpl::createDefault();
     auto fb = createWithImplementation<IFunctionBlock, CaptureModuleFb>(moduleInfo, ctx, parent, localId, ptr);
     return fb;
 }
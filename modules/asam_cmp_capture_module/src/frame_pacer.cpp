@@ -0,0 +1,96 @@
+#include <asam_cmp_capture_module/frame_pacer.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+FramePacer::FramePacer(TransmitQueue& transmitQueue)
+    : transmitQueue(transmitQueue)
+{
+    paceThread = std::thread{&FramePacer::paceLoop, this};
+}
+
+FramePacer::~FramePacer()
+{
+    {
+        std::scoped_lock lock{sync};
+        stopPacing = true;
+    }
+    cv.notify_all();
+
+    paceThread.join();
+}
+
+void FramePacer::enqueue(TransmitQueue::Lane lane,
+                         const std::vector<std::vector<uint8_t>>& frames,
+                         const std::vector<Clock::time_point>& departures,
+                         TransmitStatistics& statistics)
+{
+    {
+        std::scoped_lock lock{sync};
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            if (departures[i] != TrafficShaper::dropped)
+                queue.emplace(departures[i], Entry{lane, frames[i], &statistics});
+        }
+    }
+    cv.notify_all();
+}
+
+void FramePacer::cancel(const TransmitStatistics& statistics)
+{
+    std::unique_lock lock{sync};
+    for (auto it = queue.begin(); it != queue.end();)
+    {
+        if (it->second.statistics == &statistics)
+            it = queue.erase(it);
+        else
+            ++it;
+    }
+
+    cv.wait(lock, [&] { return sending != &statistics; });
+}
+
+size_t FramePacer::getQueuedCount() const
+{
+    std::scoped_lock lock{sync};
+    return queue.size();
+}
+
+void FramePacer::paceLoop()
+{
+    std::unique_lock lock{sync};
+    while (!stopPacing)
+    {
+        if (queue.empty())
+        {
+            cv.wait(lock);
+            continue;
+        }
+
+        // Frames due within one slot are sent back to back
+        const auto departure = queue.begin()->first;
+        if (departure > Clock::now() + TrafficShaper::pacingSlot)
+        {
+            cv.wait_until(lock, departure);
+            continue;
+        }
+
+        auto entry = std::move(queue.begin()->second);
+        queue.erase(queue.begin());
+        sending = entry.statistics;
+        lock.unlock();
+
+        const auto sendStart = std::chrono::steady_clock::now();
+        const bool sent = transmitQueue.send(entry.lane, entry.frame);
+        entry.statistics->recordSendTime(std::chrono::steady_clock::now() - sendStart);
+        if (sent)
+            entry.statistics->onFrameSent(entry.frame.size());
+        else
+            entry.statistics->onSendFailure();
+
+        lock.lock();
+        sending = nullptr;
+        cv.notify_all();
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -1,9 +1,31 @@
 #include <asam_cmp_capture_module/input_descriptors_validator.h>
+#include <asam_cmp_common_lib/compact_can_layout.h>
 #include <opendaq/dimension_factory.h>
 #include <unordered_set>
 
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
+DataDescriptorPtr createCanDataDescriptor()
+{
+    const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+
+    const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+
+    const auto dataDescriptor =
+        DataDescriptorBuilder()
+            .setName("Data")
+            .setSampleType(SampleType::UInt8)
+            .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+            .build();
+
+    const auto canMsgDescriptor = DataDescriptorBuilder()
+                                      .setSampleType(SampleType::Struct)
+                                      .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+                                      .setName("CAN")
+                                      .build();
+    return canMsgDescriptor;
+}
+
 namespace
 {
 
@@ -49,28 +71,8 @@ namespace
         return true;
     }
 
-    DataDescriptorPtr buildCanStructureReference()
-    {
-        const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
-
-        const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
-
-        const auto dataDescriptor =
-            DataDescriptorBuilder()
-                .setName("Data")
-                .setSampleType(SampleType::UInt8)
-                .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
-                .build();
-
-        const auto canMsgDescriptor = DataDescriptorBuilder()
-                                          .setSampleType(SampleType::Struct)
-                                          .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
-                                          .setName("CAN")
-                                          .build();
-        return canMsgDescriptor;
-    }
-
-    DataDescriptorPtr canStructureReference = buildCanStructureReference();
+    const DataDescriptorPtr canStructureReference = createCanDataDescriptor();
+    const DataDescriptorPtr classicCanStructureReference = asam_cmp_common_lib::compact_can::createClassicCanDescriptor();
 
     bool validateStructureSampleType(DataDescriptorPtr inputDataDescriptor, DataDescriptorPtr referenceDataDescriptor)
     {
@@ -142,14 +144,27 @@ bool hasCorrectPostScaling(const ScalingPtr& postScaling)
            postScalingParams.hasKey("scale");
 }
 
+CanInputLayout getCanInputLayout(const DataDescriptorPtr& inputDataDescriptor)
+{
+    if (asam_cmp_common_lib::compact_can::isCanFdDescriptor(inputDataDescriptor))
+        return CanInputLayout::compactCanFd;
+
+    if (validateStructureSampleType(inputDataDescriptor, canStructureReference))
+        return CanInputLayout::canData;
+
+    if (validateStructureSampleType(inputDataDescriptor, classicCanStructureReference))
+        return CanInputLayout::classicCanData;
+
+    return CanInputLayout::invalid;
+}
+
 bool validateInputDescriptor(DataDescriptorPtr inputDataDescriptor, const ASAM::CMP::PayloadType& type)
 {
     switch (type.getType())
     {
         case ASAM::CMP::PayloadType::can:
-            return validateStructureSampleType(inputDataDescriptor, canStructureReference);
         case ASAM::CMP::PayloadType::canFd:
-            return validateStructureSampleType(inputDataDescriptor, canStructureReference);
+            return getCanInputLayout(inputDataDescriptor) != CanInputLayout::invalid;
         case ASAM::CMP::PayloadType::analog:
             return validateAnalogSampleType(inputDataDescriptor);
         default:
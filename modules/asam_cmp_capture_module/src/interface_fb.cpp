@@ -2,6 +2,7 @@
 #include <asam_cmp_capture_module/interface_fb.h>
 #include <asam_cmp_capture_module/stream_fb.h>
 #include <coreobjects/argument_info_factory.h>
+#include <coreobjects/unit_factory.h>
 #include <coreobjects/callable_info_factory.h>
 #include <coretypes/listobject_factory.h>
 
@@ -23,6 +24,9 @@ InterfaceFb::InterfaceFb(const ModuleInfoPtr& moduleInfo,
     , ethernetWrapper(internalInit.ethernetWrapper)
     , allowJumboFrames(internalInit.allowJumboFrames)
     , selectedDeviceName(internalInit.selectedDeviceName)
+    , shaper(internalInit.shaper)
+    , transmitQueue(internalInit.transmitQueue)
+    , pacer(internalInit.pacer)
 {
     initProperties();
     initStatusPacket();
@@ -36,7 +40,7 @@ void InterfaceFb::addStreamInternal()
     auto newId = streamIdManager.getFirstUnusedId();
     StreamInit internalInit{streamIdsList, statusSync, interfaceId, ethernetWrapper, allowJumboFrames, encoders, [&]() {
                                 this->updateInterfaceData();
-                            }};
+                            }, &statistics, shaper, txBucket, transmitQueue, pacer};
     addStreamWithParams<StreamFb>(newId, internalInit);
 
     streamIdsList.insert(newId);
@@ -60,6 +64,27 @@ void InterfaceFb::initProperties()
     objPtr.addProperty(prop);
     objPtr.getOnPropertyValueWrite(propName) +=
         [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { propertyChangedIfNotUpdating(); };
+
+    propName = "TxRateLimit";
+    prop = FloatPropertyBuilder(propName, 0.0).setMinValue(0.0).setUnit(Unit("Mbit/s")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateShaperInternal(); };
+
+    propName = "TxBurstSize";
+    prop = IntPropertyBuilder(propName, 15000).setMinValue(1500).setMaxValue(100'000'000).setUnit(Unit("B")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateShaperInternal(); };
+
+    statistics.addProperties(objPtr);
+}
+
+void InterfaceFb::updateShaperInternal()
+{
+    const Float rate = objPtr.getPropertyValue("TxRateLimit");
+    const Int burst = objPtr.getPropertyValue("TxBurstSize");
+    shaper.setRate(txBucket, rate * 1e6, static_cast<size_t>(burst));
 }
 
 void InterfaceFb::updateInterfaceIdInternal()
@@ -0,0 +1,315 @@
+#include <asam_cmp_capture_module/can_data.h>
+#include <asam_cmp_capture_module/input_descriptors_validator.h>
+#include <asam_cmp_capture_module/load_generator_fb.h>
+#include <coreobjects/eval_value_factory.h>
+#include <coreobjects/unit_factory.h>
+#include <coretypes/listobject_factory.h>
+#include <opendaq/component_type_private.h>
+#include <opendaq/custom_log.h>
+#include <opendaq/data_rule_factory.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/range_factory.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+namespace
+{
+    constexpr uint32_t maxArbId = 0x1FFFFFFF;
+    constexpr uint64_t microsecondsPerSecond = 1'000'000;
+    constexpr std::string_view IsCanPayload{"$PayloadType < 2"};
+    constexpr std::string_view HasArbIdRange{"$PayloadType < 2 && $ArbIdDistribution > 0"};
+
+    size_t roundUpToCanFdLength(size_t length)
+    {
+        constexpr std::array<size_t, 7> fdLengths{12, 16, 20, 24, 32, 48, 64};
+        if (length <= 8)
+            return length;
+        return *std::lower_bound(fdLengths.begin(), fdLengths.end(), length);
+    }
+
+    uint64_t getAnalogSamplePeriod(uint64_t messageRate)
+    {
+        return std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(static_cast<double>(microsecondsPerSecond) / messageRate)));
+    }
+
+    void fillCanPattern(uint8_t* buffer, size_t count, const LoadGeneratorFb::Settings& settings)
+    {
+        std::mt19937 random(settings.seed);
+        const size_t maxLength = settings.payload == LoadGeneratorFb::Payload::can ? 8 : 64;
+        const size_t minSize = std::min(settings.minPayloadSize, maxLength);
+        const size_t maxSize = std::clamp(settings.maxPayloadSize, minSize, maxLength);
+        std::uniform_int_distribution<size_t> sizeDistribution(minSize, maxSize);
+        std::uniform_int_distribution<uint32_t> idDistribution(0, settings.arbIdCount - 1);
+
+        auto* frames = reinterpret_cast<CANData*>(buffer);
+        for (size_t i = 0; i < count; ++i)
+        {
+            CANData& frame = frames[i];
+            memset(&frame, 0, sizeof(CANData));
+
+            switch (settings.arbIdDistribution)
+            {
+                case LoadGeneratorFb::ArbIdDistribution::constant:
+                    frame.arbId = settings.firstArbId;
+                    break;
+                case LoadGeneratorFb::ArbIdDistribution::sequential:
+                    frame.arbId = settings.firstArbId + static_cast<uint32_t>(i % settings.arbIdCount);
+                    break;
+                case LoadGeneratorFb::ArbIdDistribution::uniform:
+                    frame.arbId = settings.firstArbId + idDistribution(random);
+                    break;
+            }
+
+            size_t length = sizeDistribution(random);
+            if (settings.payload == LoadGeneratorFb::Payload::canFd)
+                length = roundUpToCanFdLength(length);
+            frame.length = static_cast<uint8_t>(length);
+            for (size_t j = 0; j < length; ++j)
+                frame.data[j] = static_cast<uint8_t>(i + j);
+        }
+    }
+
+    void fillAnalogPattern(uint8_t* buffer, size_t count)
+    {
+        // One sine period over the whole pattern, so that the cyclic replay has no discontinuity
+        constexpr double twoPi = 6.283185307179586;
+        auto* samples = reinterpret_cast<int16_t*>(buffer);
+        for (size_t i = 0; i < count; ++i)
+            samples[i] = static_cast<int16_t>(std::lround(32767.0 * std::sin(twoPi * static_cast<double>(i) / count)));
+    }
+}
+
+LoadGeneratorFb::LoadGeneratorFb(const ModuleInfoPtr& moduleInfo,
+                                 const ContextPtr& ctx,
+                                 const ComponentPtr& parent,
+                                 const StringPtr& localId)
+    : FunctionBlock(CreateType(moduleInfo), ctx, parent, localId)
+{
+    initProperties();
+    createSignals();
+    settingsChangedInternal();
+}
+
+LoadGeneratorFb::~LoadGeneratorFb()
+{
+    stop();
+}
+
+FunctionBlockTypePtr LoadGeneratorFb::CreateType(const ModuleInfoPtr& moduleInfo)
+{
+    auto fbType = FunctionBlockType("AsamCmpLoadGenerator", "AsamCmpLoadGenerator", "Synthetic CAN, CAN FD and analog load generator");
+
+    checkErrorInfo(fbType.asPtr<IComponentTypePrivate>(true)->setModuleInfo(moduleInfo));
+    return fbType;
+}
+
+size_t LoadGeneratorFb::getSampleSize(Payload payload)
+{
+    return payload == Payload::analog ? sizeof(int16_t) : sizeof(CANData);
+}
+
+uint64_t LoadGeneratorFb::getSampleTime(const Settings& settings, uint64_t sampleIndex)
+{
+    if (settings.payload == Payload::analog)
+        return sampleIndex * getAnalogSamplePeriod(settings.messageRate);
+
+    // Split to avoid overflow of sampleIndex * 1'000'000 on long runs
+    const uint64_t rate = settings.messageRate;
+    return sampleIndex / rate * microsecondsPerSecond + sampleIndex % rate * microsecondsPerSecond / rate;
+}
+
+std::vector<uint8_t> LoadGeneratorFb::createPattern(const Settings& settings, size_t packetsCount)
+{
+    const size_t samplesCount = packetsCount * settings.samplesPerPacket;
+    std::vector<uint8_t> buffer(samplesCount * getSampleSize(settings.payload));
+
+    if (settings.payload == Payload::analog)
+        fillAnalogPattern(buffer.data(), samplesCount);
+    else
+        fillCanPattern(buffer.data(), samplesCount, settings);
+
+    return buffer;
+}
+
+void LoadGeneratorFb::initProperties()
+{
+    auto addSettingProperty = [this](const PropertyPtr& prop)
+    {
+        objPtr.addProperty(prop);
+        objPtr.getOnPropertyValueWrite(prop.getName()) +=
+            [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { settingsChanged(); };
+    };
+
+    addSettingProperty(SelectionPropertyBuilder("PayloadType", List<IString>("CAN", "CAN FD", "Analog"), 0).build());
+    addSettingProperty(IntPropertyBuilder("MessageRate", 1000).setMinValue(1).setMaxValue(1000000).setUnit(Unit("Hz")).build());
+    addSettingProperty(IntPropertyBuilder("SamplesPerPacket", 100).setMinValue(1).setMaxValue(10000).build());
+    addSettingProperty(
+        IntPropertyBuilder("MinPayloadSize", 8).setMinValue(0).setMaxValue(64).setUnit(Unit("B")).setVisible(EvalValue(IsCanPayload.data())).build());
+    addSettingProperty(
+        IntPropertyBuilder("MaxPayloadSize", 8).setMinValue(0).setMaxValue(64).setUnit(Unit("B")).setVisible(EvalValue(IsCanPayload.data())).build());
+    addSettingProperty(SelectionPropertyBuilder("ArbIdDistribution", List<IString>("Constant", "Sequential", "Uniform"), 1)
+                           .setVisible(EvalValue(IsCanPayload.data()))
+                           .build());
+    addSettingProperty(
+        IntPropertyBuilder("FirstArbId", 0).setMinValue(0).setMaxValue(maxArbId).setVisible(EvalValue(IsCanPayload.data())).build());
+    addSettingProperty(
+        IntPropertyBuilder("ArbIdCount", 1).setMinValue(1).setMaxValue(maxArbId + 1).setVisible(EvalValue(HasArbIdRange.data())).build());
+    addSettingProperty(IntPropertyBuilder("Seed", 0).setMinValue(0).setMaxValue(std::numeric_limits<uint32_t>::max()).build());
+    addSettingProperty(BoolPropertyBuilder("Active", false).build());
+
+    auto addCounterProperty = [this](const StringPtr& name, const std::atomic<uint64_t>& counter)
+    {
+        objPtr.addProperty(IntPropertyBuilder(name, 0).setReadOnly(true).build());
+        objPtr.getOnPropertyValueRead(name) += [&counter](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+        { args.setValue(static_cast<Int>(counter.load(std::memory_order_relaxed))); };
+    };
+
+    addCounterProperty("GeneratedSamples", generatedSamples);
+    addCounterProperty("GeneratedPackets", generatedPackets);
+    addCounterProperty("LatePackets", latePackets);
+}
+
+void LoadGeneratorFb::createSignals()
+{
+    valueSignal = createAndAddSignal("value");
+    domainSignal = createAndAddSignal("time", nullptr, false);
+    valueSignal.setDomainSignal(domainSignal);
+}
+
+void LoadGeneratorFb::buildSignalDescriptors()
+{
+    auto domainDescriptor = DataDescriptorBuilder()
+                                .setSampleType(SampleType::Int64)
+                                .setUnit(Unit("s", -1, "seconds", "time"))
+                                .setTickResolution(Ratio(1, microsecondsPerSecond))
+                                .setOrigin("1970-01-01T00:00:00Z")
+                                .setName("Time");
+
+    if (settings.payload == Payload::analog)
+    {
+        domainDescriptor.setRule(LinearDataRule(static_cast<Int>(getAnalogSamplePeriod(settings.messageRate)), 0));
+        valueSignal.setDescriptor(
+            DataDescriptorBuilder().setSampleType(SampleType::Int16).setValueRange(Range(-32768, 32767)).setName("Analog").build());
+    }
+    else
+    {
+        valueSignal.setDescriptor(createCanDataDescriptor());
+    }
+
+    domainSignal.setDescriptor(domainDescriptor.build());
+}
+
+void LoadGeneratorFb::readSettings()
+{
+    settings.payload = static_cast<Payload>(static_cast<Int>(objPtr.getPropertyValue("PayloadType")));
+    settings.messageRate = static_cast<Int>(objPtr.getPropertyValue("MessageRate"));
+    settings.samplesPerPacket = static_cast<Int>(objPtr.getPropertyValue("SamplesPerPacket"));
+    settings.minPayloadSize = static_cast<Int>(objPtr.getPropertyValue("MinPayloadSize"));
+    settings.maxPayloadSize = static_cast<Int>(objPtr.getPropertyValue("MaxPayloadSize"));
+    settings.arbIdDistribution = static_cast<ArbIdDistribution>(static_cast<Int>(objPtr.getPropertyValue("ArbIdDistribution")));
+    settings.firstArbId = static_cast<uint32_t>(static_cast<Int>(objPtr.getPropertyValue("FirstArbId")));
+    settings.arbIdCount = static_cast<uint32_t>(
+        std::min<Int>(objPtr.getPropertyValue("ArbIdCount"), static_cast<Int>(maxArbId - settings.firstArbId) + 1));
+    settings.seed = static_cast<uint32_t>(static_cast<Int>(objPtr.getPropertyValue("Seed")));
+}
+
+void LoadGeneratorFb::settingsChanged()
+{
+    auto lock = this->getRecursiveConfigLock();
+    settingsChangedInternal();
+}
+
+void LoadGeneratorFb::settingsChangedInternal()
+{
+    stop();
+    readSettings();
+
+    patternPackets = (minPatternSamples + settings.samplesPerPacket - 1) / settings.samplesPerPacket;
+    pattern = createPattern(settings, patternPackets);
+    buildSignalDescriptors();
+
+    if (static_cast<bool>(objPtr.getPropertyValue("Active")))
+        start();
+}
+
+void LoadGeneratorFb::start()
+{
+    generatedSamples = 0;
+    generatedPackets = 0;
+    latePackets = 0;
+
+    stopRequested = false;
+    generatorThread = std::thread(&LoadGeneratorFb::generate, this);
+}
+
+void LoadGeneratorFb::stop()
+{
+    if (!generatorThread.joinable())
+        return;
+
+    {
+        std::scoped_lock lock{stopSync};
+        stopRequested = true;
+    }
+    stopCv.notify_all();
+    generatorThread.join();
+}
+
+void LoadGeneratorFb::generate()
+{
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t startTime = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    const uint64_t packetPeriod = getSampleTime(settings, settings.samplesPerPacket);
+
+    std::unique_lock lock{stopSync};
+    for (uint64_t packetIndex = 0;; ++packetIndex)
+    {
+        // A packet is due when its last sample has been "measured"
+        const auto due = start + std::chrono::microseconds(getSampleTime(settings, (packetIndex + 1) * settings.samplesPerPacket));
+        if (stopCv.wait_until(lock, due, [this] { return stopRequested; }))
+            return;
+
+        if (std::chrono::steady_clock::now() - due > std::chrono::microseconds(packetPeriod))
+            latePackets.fetch_add(1, std::memory_order_relaxed);
+
+        lock.unlock();
+        sendPacket(packetIndex, startTime);
+        lock.lock();
+    }
+}
+
+void LoadGeneratorFb::sendPacket(uint64_t packetIndex, uint64_t startTime)
+{
+    const size_t count = settings.samplesPerPacket;
+    const uint64_t firstSample = packetIndex * count;
+    const size_t bytes = count * getSampleSize(settings.payload);
+
+    const Int offset = static_cast<Int>(startTime + getSampleTime(settings, firstSample));
+    const auto domainPacket = DataPacket(domainSignal.getDescriptor(), count, settings.payload == Payload::analog ? offset : 0);
+    const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignal.getDescriptor(), count);
+
+    memcpy(dataPacket.getRawData(), pattern.data() + (packetIndex % patternPackets) * bytes, bytes);
+
+    if (settings.payload != Payload::analog)
+    {
+        auto* timestamps = static_cast<int64_t*>(domainPacket.getRawData());
+        for (size_t i = 0; i < count; ++i)
+            timestamps[i] = static_cast<int64_t>(startTime + getSampleTime(settings, firstSample + i));
+    }
+
+    valueSignal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+
+    generatedSamples.fetch_add(count, std::memory_order_relaxed);
+    generatedPackets.fetch_add(1, std::memory_order_relaxed);
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -7,14 +7,22 @@
 #include <opendaq/event_packet_params.h>
 #include <opendaq/sample_type_traits.h>
 #include <coretypes/enumeration_type_factory.h>
+#include <asam_cmp_capture_module/analog_decimator.h>
+#include <asam_cmp_capture_module/analog_quantizer.h>
+#include <asam_cmp_capture_module/can_data.h>
 #include <asam_cmp_capture_module/input_descriptors_validator.h>
 #include <asam_cmp_capture_module/dispatch.h>
 #include <asam_cmp/can_payload.h>
 #include <asam_cmp/can_fd_payload.h>
 #include <asam_cmp/analog_payload.h>
+#include <asam_cmp_common_lib/compact_can_layout.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_common_lib/trace.h>
 #include <asam_cmp_common_lib/unit_converter.h>
 
+#include <algorithm>
+#include <limits>
+
 BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
 
 constexpr std::string_view InputDisconnected{"Disconnected"};
@@ -40,6 +48,11 @@ StreamFb::StreamFb(const ModuleInfoPtr& moduleInfo,
     , ethernetWrapper(internalInit.ethernetWrapper)
     , allowJumboFrames(internalInit.allowJumboFrames)
     , dataContext(createEncoderDataContext())
+    , statistics(internalInit.interfaceStatistics)
+    , shaper(internalInit.shaper)
+    , interfaceBucket(internalInit.interfaceBucket)
+    , transmitQueue(internalInit.transmitQueue)
+    , pacer(internalInit.pacer)
 {
     createInputPort();
     initStatuses();
@@ -69,6 +82,118 @@ void StreamFb::initProperties()
     propName = "Offset";
     prop = FloatPropertyBuilder(propName, 0).setVisible(EvalValue(IsClientRange.data())).setReadOnly(true).build();
     objPtr.addProperty(prop);
+
+    propName = "DecimationFactor";
+    prop = IntPropertyBuilder(propName, 1).setMinValue(1).setMaxValue(static_cast<Int>(AnalogDecimator::maxFactor)).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateDecimationInternal(); };
+
+    propName = "SampleResolution";
+    prop = SelectionPropertyBuilder(propName, List<IString>("Auto", "16", "32"), 0).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateSampleResolutionInternal(); };
+
+    propName = "SamplePrecision";
+    prop = FloatPropertyBuilder(propName, 0.0).setMinValue(0.0).setVisible(EvalValue("$SampleResolution == 0")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateSampleResolutionInternal(); };
+
+    propName = "CanIdFilter";
+    prop = StringPropertyBuilder(propName, "").build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateCanIdFilterInternal(); };
+
+    propName = "CanIdFilterMode";
+    prop = SelectionPropertyBuilder(propName, List<IString>("Allow", "Deny"), 0).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateCanIdFilterInternal(); };
+
+    propName = "CanMinIntervals";
+    prop = StringPropertyBuilder(propName, "").build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateCanMinIntervalsInternal(); };
+
+    statistics.addProperties(objPtr);
+}
+
+void StreamFb::updateDecimationInternal()
+{
+    const size_t factor = static_cast<Int>(objPtr.getPropertyValue("DecimationFactor"));
+
+    auto lock = getRecursiveConfigLock();
+    decimationFactor = factor;
+    createAnalogDecimator();
+}
+
+void StreamFb::createAnalogDecimator()
+{
+    if (decimationFactor > 1)
+        analogDecimator = std::make_unique<AnalogDecimator>(decimationFactor);
+    else
+        analogDecimator.reset();
+
+    constexpr double invertedTickResolution = 1'000'000;
+    analogDataDeltaTime = static_cast<double>(analogInputDelta * decimationFactor) / invertedTickResolution;
+}
+
+void StreamFb::updateSampleResolutionInternal()
+{
+    const auto resolution = static_cast<SampleResolution>(static_cast<Int>(objPtr.getPropertyValue("SampleResolution")));
+    const Float precision = objPtr.getPropertyValue("SamplePrecision");
+
+    auto lock = getRecursiveConfigLock();
+    sampleResolution = resolution;
+    samplePrecision = precision;
+
+    // Internal scaling is derived from the resolution, a connected signal is configured again
+    if (isConfigured && payloadType == ASAM::CMP::PayloadType::analog)
+        onAnalogSignalConnected();
+}
+
+void StreamFb::updateCanIdFilterInternal()
+{
+    const std::string list = objPtr.getPropertyValue("CanIdFilter").asPtr<IString>().toStdString();
+    const bool allows = static_cast<Int>(objPtr.getPropertyValue("CanIdFilterMode")) == 0;
+    try
+    {
+        asam_cmp_common_lib::CanIdFilter newFilter(list);
+
+        auto lock = getRecursiveConfigLock();
+        canIdFilter = std::move(newFilter);
+        canIdFilterAllows = allows;
+    }
+    catch (const std::invalid_argument& e)
+    {
+        LOG_W("CAN ID filter \"{}\" is not applied: {}", list, e.what())
+    }
+}
+
+void StreamFb::updateCanMinIntervalsInternal()
+{
+    const std::string list = objPtr.getPropertyValue("CanMinIntervals").asPtr<IString>().toStdString();
+    try
+    {
+        CanRateLimiter newLimiter(list);
+
+        // Frames still held back by the previous limiter are not sent
+        auto lock = getRecursiveConfigLock();
+        statistics.onCanFramesThrottled(canRateLimiter.takeDroppedFrames());
+        canRateLimiter = std::move(newLimiter);
+
+        // Pending frames of a stream that goes quiet are released by a thread of the stream
+        if (!canRateLimiter.isEmpty() && !canReleaseThread.joinable())
+            canReleaseThread = std::thread(&StreamFb::canReleaseLoop, this);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        LOG_W("CAN minimum intervals \"{}\" are not applied: {}", list, e.what())
+    }
 }
 
 void StreamFb::createInputPort()
@@ -179,6 +304,14 @@ void StreamFb::configureMinMaxAnalogSignal()
         analogDataSampleDt = (sampleType == SampleType::Int16 ? 16 : 32);
         analogDataHasInternalPostScaling = false;
     }
+    else if (useInt16AnalogSamples())
+    {
+        // The full Int16 range covers [min, max]
+        analogDataSampleDt = 16;
+        analogDataScale = (analogDataMax - analogDataMin) / std::numeric_limits<uint16_t>::max();
+        analogDataOffset = analogDataMin - std::numeric_limits<int16_t>::min() * analogDataScale;
+        analogDataHasInternalPostScaling = true;
+    }
     else
     {
         analogDataSampleDt = 32;
@@ -195,13 +328,26 @@ void StreamFb::configureMinMaxAnalogSignal()
     objPtr.endUpdate();
 }
 
+bool StreamFb::useInt16AnalogSamples() const
+{
+    switch (sampleResolution)
+    {
+        case SampleResolution::Int16:
+            return true;
+        case SampleResolution::Int32:
+            return false;
+        default:
+            // Int16 if its quantization step over the value range is within the requested precision
+            return samplePrecision > 0 && (analogDataMax - analogDataMin) / std::numeric_limits<uint16_t>::max() <= samplePrecision;
+    }
+}
+
 void StreamFb::onAnalogSignalConnected()
 {
     objPtr.asPtr<IPropertyObjectProtected>(true).setProtectedPropertyValue("IsConnectedAnalogSignal", true);
 
-    constexpr double invertedTickResolution = 1'000'000;
-    int64_t delta = inputDomainDataDescriptor.getRule().getParameters().get("delta");
-    analogDataDeltaTime = delta / invertedTickResolution;
+    analogInputDelta = inputDomainDataDescriptor.getRule().getParameters().get("delta");
+    createAnalogDecimator();
 
     if (hasCorrectPostScaling(inputDataDescriptor.getPostScaling()))
     {
@@ -228,8 +374,30 @@ void StreamFb::onDisconnected(const InputPortPtr& inputPort)
     }
 }
 
+StreamFb::~StreamFb()
+{
+    {
+        std::scoped_lock lock{canReleaseSync};
+        stopCanRelease = true;
+    }
+    canReleaseCv.notify_one();
+    if (canReleaseThread.joinable())
+        canReleaseThread.join();
+}
+
+void StreamFb::removed()
+{
+    asam_cmp_common_lib::StreamCommonFb::removed();
+
+    // Frames still queued in the pacer are counted in the statistics of the stream, nothing is sent after this
+    auto lock = this->getRecursiveConfigLock2();
+    isConfigured = false;
+    pacer.cancel(statistics);
+}
+
 void StreamFb::onPacketReceived(const InputPortPtr& port)
 {
+    ASAM_CMP_TRACE_SCOPE("capture::StreamFb::onPacketReceived");
     auto lock = this->getRecursiveConfigLock2();
 
     PacketPtr packet;
@@ -284,6 +452,9 @@ void StreamFb::configure()
         if (!validateInputDescriptor(inputDataDescriptor, payloadType))
             throw std::runtime_error("Invalid data descriptor fields structure");
 
+        if (payloadType == ASAM::CMP::PayloadType::can || payloadType == ASAM::CMP::PayloadType::canFd)
+            canInputLayout = getCanInputLayout(inputDataDescriptor);
+
         if (payloadType == ASAM::CMP::PayloadType::analog)
             onAnalogSignalConnected();
 
@@ -307,9 +478,15 @@ void StreamFb::processEventPacket(const EventPacketPtr& packet)
     }
 }
 
+constexpr int minFrameSize{64}, maxFrameSize{1500};
+
+// CMP header, Data Message header and an upper bound of the analog payload header of one message
+constexpr size_t analogMessageOverhead = 8 + 16 + 20;
+// Analog segments encoded before their frames are sent
+constexpr size_t analogSegmentsPerSend = 16;
+
 ASAM::CMP::DataContext StreamFb::createEncoderDataContext() const
 {
-    constexpr int minFrameSize{64}, maxFrameSize{1500};
     assert(!allowJumboFrames);
     return {minFrameSize, maxFrameSize};
 }
@@ -320,21 +497,40 @@ template <>
 constexpr size_t maxCanDataSize<ASAM::CMP::CanPayload> = 8;
 
 template <typename CanPayloadType>
-void StreamFb::processCanPacket(const DataPacketPtr& packet)
+void StreamFb::addCanPacket(std::vector<ASAM::CMP::Packet>& packets, uint32_t arbId, uint8_t length, const uint8_t* data, uint64_t timestamp)
 {
-    static_assert(std::is_base_of_v<ASAM::CMP::CanPayloadBase, CanPayloadType>);
-
-#pragma pack(push, 1)
-    struct CANData
+    if (length > maxCanDataSize<CanPayloadType>)
     {
-        uint32_t arbId;
-        uint8_t length;
-        uint8_t data[64];
-    };
-#pragma pack(pop)
+        statistics.onCanFrameSkipped();
+        return;
+    }
 
-    auto* canData = reinterpret_cast<CANData*>(packet.getData());
-    const size_t sampleCount = packet.getSampleCount();
+    CanPayloadType payload{};
+    payload.setData(data, length);
+    payload.setId(arbId);
+
+    packets.emplace_back();
+    packets.back().setInterfaceId(interfaceId);
+    packets.back().setPayload(payload);
+    packets.back().setTimestamp(timestamp);
+}
+
+void StreamFb::sendCanPackets(std::vector<ASAM::CMP::Packet>& packets, std::chrono::steady_clock::time_point encodeStart)
+{
+    if (packets.empty())
+        return;
+
+    const auto frames = encoders->encode(streamId, packets.begin(), packets.end(), dataContext);
+    statistics.onMessagesEncoded(packets.size());
+    statistics.recordEncodeTime(std::chrono::steady_clock::now() - encodeStart);
+
+    sendFrames(frames);
+}
+
+template <typename CanPayloadType>
+void StreamFb::processCanPacket(const DataPacketPtr& packet)
+{
+    static_assert(std::is_base_of_v<ASAM::CMP::CanPayloadBase, CanPayloadType>);
 
     uint64_t* rawTimeBuffer = reinterpret_cast<uint64_t*>(packet.getDomainPacket().getRawData());
     if (rawTimeBuffer == nullptr)
@@ -343,120 +539,378 @@ void StreamFb::processCanPacket(const DataPacketPtr& packet)
     RatioPtr timeResolution = packet.getDomainPacket().getDataDescriptor().getTickResolution();
     size_t timeScale = 1'000'000'000 / timeResolution.getDenominator();
 
-    std::vector<ASAM::CMP::Packet> packets;
-    packets.reserve(sampleCount);
+    const auto encodeStart = std::chrono::steady_clock::now();
 
-    for (size_t i = 0; i < sampleCount; i++)
+    std::vector<ASAM::CMP::Packet> packets;
+    auto encodeFrame = [&](uint32_t arbId, uint8_t length, const uint8_t* data, uint64_t timestamp)
+    { addCanPacket<CanPayloadType>(packets, arbId, length, data, timestamp); };
+
+    // Filtering and rate limiting happen before encoding, so dropped frames cost no encoder or link time
+    uint64_t filteredFrames = 0;
+    const bool filterIds = !canIdFilter.isEmpty();
+    const bool limitRate = !canRateLimiter.isEmpty();
+    uint64_t latestTimestamp = lastCanTimestamp;
+    auto addFrame = [&](uint32_t arbId, uint8_t length, const uint8_t* data, uint64_t timestamp)
     {
-        if (canData->length <= maxCanDataSize<CanPayloadType>)
+        if (filterIds && canIdFilter.contains(arbId) != canIdFilterAllows)
+        {
+            ++filteredFrames;
+            return;
+        }
+
+        const uint64_t timestampNs = timestamp * timeScale;
+        if (limitRate)
         {
-            CanPayloadType payload{};
-            payload.setData(canData->data, canData->length);
-            payload.setId(canData->arbId);
-
-            packets.emplace_back();
-            packets.back().setInterfaceId(interfaceId);
-            packets.back().setPayload(payload);
-            packets.back().setTimestamp((*rawTimeBuffer) * timeScale);
+            latestTimestamp = std::max(latestTimestamp, timestampNs);
+            // Admitted first, so a frame past the interval of its ID supersedes the pending frame of the ID
+            const bool admitted = canRateLimiter.admit(arbId, data, length, timestampNs);
+            canRateLimiter.release(timestampNs,
+                                   [&](const CanRateLimiter::Frame& frame)
+                                   { encodeFrame(frame.arbId, frame.length, frame.data, frame.timestamp); });
+            if (!admitted)
+                return;
         }
-        canData++;
-        rawTimeBuffer++;
+
+        encodeFrame(arbId, length, data, timestampNs);
+    };
+
+    if (canInputLayout == CanInputLayout::compactCanFd)
+    {
+        // A binary sample packs several frames, each with its own timestamp
+        size_t frameCount = 0;
+        const bool valid = asam_cmp_common_lib::compact_can::forEachCanFdFrame(
+            static_cast<const uint8_t*>(packet.getData()),
+            packet.getRawDataSize(),
+            [&](const asam_cmp_common_lib::compact_can::CanFdFrame& frame, const uint8_t* data)
+            {
+                ++frameCount;
+                addFrame(frame.arbId, frame.length, data, frame.timestamp);
+            });
+        statistics.onSamplesReceived(frameCount);
+        if (!valid)
+            LOG_W("Dropped the rest of a truncated compact CAN FD sample")
     }
+    else
+    {
+        const size_t sampleCount = packet.getSampleCount();
+        statistics.onSamplesReceived(sampleCount);
+        packets.reserve(sampleCount);
 
-    for (auto& rawFrame : encoders->encode(streamId, packets.begin(), packets.end(), dataContext))
-        ethernetWrapper->sendPacket(rawFrame);
+        auto addFrames = [&](auto* canData)
+        {
+            for (size_t i = 0; i < sampleCount; i++, canData++, rawTimeBuffer++)
+            {
+                if (canData->length > sizeof(canData->data))
+                    statistics.onCanFrameSkipped();
+                else
+                    addFrame(canData->arbId, canData->length, canData->data, *rawTimeBuffer);
+            }
+        };
+        if (canInputLayout == CanInputLayout::classicCanData)
+            addFrames(reinterpret_cast<const asam_cmp_common_lib::compact_can::ClassicCanData*>(packet.getData()));
+        else
+            addFrames(reinterpret_cast<const CANData*>(packet.getData()));
+    }
+
+    if (filteredFrames != 0)
+        statistics.onCanFramesFiltered(filteredFrames);
+    if (limitRate)
+    {
+        statistics.onCanFramesThrottled(canRateLimiter.takeDroppedFrames());
+        lastCanTimestamp = latestTimestamp;
+        lastCanArrival = std::chrono::steady_clock::now();
+        scheduleCanRelease();
+    }
+
+    sendCanPackets(packets, encodeStart);
 }
 
-template <SampleType SrcType>
-void createAnalogPayloadWithInternalScaling(ASAM::CMP::AnalogPayload& payload,
-                                            const daq::DataPacketPtr& packet,
-                                            Float analogDataScale,
-                                            Float analogDataOffset,
-                                            Float analogDataDeltaTime)
+template <typename CanPayloadType>
+void StreamFb::releasePendingCanFrames()
 {
-    payload.setSampleInterval(analogDataDeltaTime);
+    // Time of the stream now, estimated from the arrival of its latest frame
+    const auto encodeStart = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(encodeStart - lastCanArrival).count();
+    const uint64_t timestamp = lastCanTimestamp + static_cast<uint64_t>(std::max<int64_t>(elapsed, 0));
 
-    using SourceType = typename SampleTypeToType<SrcType>::Type;
-    auto* rawData = reinterpret_cast<SourceType*>(packet.getData());
-    const size_t sampleCount = packet.getSampleCount();
+    std::vector<ASAM::CMP::Packet> packets;
+    canRateLimiter.release(timestamp,
+                           [&](const CanRateLimiter::Frame& frame)
+                           { addCanPacket<CanPayloadType>(packets, frame.arbId, frame.length, frame.data, frame.timestamp); });
+    scheduleCanRelease();
+
+    sendCanPackets(packets, encodeStart);
+}
+
+void StreamFb::scheduleCanRelease()
+{
+    const uint64_t nextRelease = canRateLimiter.getNextRelease();
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    if (nextRelease != UINT64_MAX)
+        deadline = lastCanArrival + std::chrono::nanoseconds(nextRelease > lastCanTimestamp ? nextRelease - lastCanTimestamp : 0);
 
-    uint8_t unitId = 0;
-    auto unit = packet.getDataDescriptor().getUnit();
-    if (unit.assigned())
     {
-        unitId = asam_cmp_common_lib::Units::getIdBySymbol(packet.getDataDescriptor().getUnit().getSymbol().toStdString());
+        std::scoped_lock lock{canReleaseSync};
+        canReleaseDeadline = deadline;
     }
-    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(unitId));
-    payload.setSampleDt(ASAM::CMP::AnalogPayload::SampleDt::aInt32);
-    payload.setSampleScalar(analogDataScale);
-    payload.setSampleOffset(analogDataOffset);
+    canReleaseCv.notify_one();
+}
 
-    std::vector<int32_t> scaledData(sampleCount);
-    for (size_t i = 0; i < sampleCount; ++i)
+void StreamFb::canReleaseLoop()
+{
+    std::unique_lock lock{canReleaseSync};
+    while (!stopCanRelease)
     {
-        scaledData[i] = std::round((rawData[i] - analogDataOffset) / analogDataScale);
+        if (canReleaseDeadline == std::chrono::steady_clock::time_point::max())
+        {
+            canReleaseCv.wait(lock);
+            continue;
+        }
+
+        if (std::chrono::steady_clock::now() < canReleaseDeadline)
+        {
+            canReleaseCv.wait_until(lock, canReleaseDeadline);
+            continue;
+        }
+
+        canReleaseDeadline = std::chrono::steady_clock::time_point::max();
+        lock.unlock();
+        {
+            auto configLock = this->getRecursiveConfigLock2();
+            if (isConfigured && !canRateLimiter.isEmpty())
+            {
+                if (payloadType == ASAM::CMP::PayloadType::canFd)
+                    releasePendingCanFrames<ASAM::CMP::CanFdPayload>();
+                else if (payloadType == ASAM::CMP::PayloadType::can)
+                    releasePendingCanFrames<ASAM::CMP::CanPayload>();
+            }
+        }
+        lock.lock();
     }
+}
 
-    payload.setData(reinterpret_cast<uint8_t*>(scaledData.data()), sampleCount * sizeof(int32_t));
+namespace
+{
+uint8_t getAnalogUnitId(const DataPacketPtr& packet)
+{
+    auto unit = packet.getDataDescriptor().getUnit();
+    if (!unit.assigned())
+        return 0;
+    return asam_cmp_common_lib::Units::getIdBySymbol(unit.getSymbol().toStdString());
 }
 
-void createAnalogPayload(ASAM::CMP::AnalogPayload& payload,
-                         const DataPacketPtr& packet,
-                         const DataDescriptorPtr& inputDataDescriptor,
-                         Float analogDataScale,
-                         Float analogDataOffset,
-                         Float analogDataDeltaTime,
-                         Int analogDataSampleDt)
+template <typename T>
+void quantizeAnalogSegment(const T* values, size_t count, Float scale, Float offset, size_t sampleDt, std::vector<uint8_t>& buffer)
 {
-    payload.setSampleInterval(analogDataDeltaTime);
+    if (sampleDt == 16)
+    {
+        buffer.resize(count * sizeof(int16_t));
+        quantizeAnalogSamples(values, count, scale, offset, reinterpret_cast<int16_t*>(buffer.data()));
+    }
+    else
+    {
+        buffer.resize(count * sizeof(int32_t));
+        quantizeAnalogSamples(values, count, scale, offset, reinterpret_cast<int32_t*>(buffer.data()));
+    }
+}
+
+template <SampleType SrcType>
+void quantizeInputSegment(
+    const void* data, size_t first, size_t count, Float scale, Float offset, size_t sampleDt, std::vector<uint8_t>& buffer)
+{
+    using SourceType = typename SampleTypeToType<SrcType>::Type;
+    quantizeAnalogSegment(static_cast<const SourceType*>(data) + first, count, scale, offset, sampleDt, buffer);
+}
 
-    auto* rawData = reinterpret_cast<uint8_t*>(packet.getRawData());
+template <SampleType SrcType>
+void decimateAnalogSamples(AnalogDecimator& decimator, const void* data, size_t sampleCount, double* output, size_t& outputCount)
+{
+    using SourceType = typename SampleTypeToType<SrcType>::Type;
+    outputCount = decimator.process(static_cast<const SourceType*>(data), sampleCount, output);
+}
+}
+
+size_t StreamFb::decimateAnalogPacket(const DataPacketPtr& packet, uint64_t& rawTime)
+{
     const size_t sampleCount = packet.getSampleCount();
-    const auto inputSampleType = inputDataDescriptor.getPostScaling().assigned() ? inputDataDescriptor.getPostScaling().getInputSampleType()
-                                                                                 : inputDataDescriptor.getSampleType();
-    const size_t sampleSize = inputSampleType == SampleType::Int16 ? 2 : 4;
+    const size_t firstOutputIndex = analogDecimator->getNextOutputIndex();
+    decimatedSamples.resize(analogDecimator->getMaxOutputCount(sampleCount));
 
-    uint8_t unitId = 0;
-    auto unit = packet.getDataDescriptor().getUnit();
-    if (unit.assigned())
+    // Samples are filtered in the domain they are sent in: scaled values with internal scaling, raw values otherwise
+    size_t outputCount = 0;
+    if (analogDataHasInternalPostScaling)
+        SAMPLE_TYPE_DISPATCH(inputDataDescriptor.getSampleType(),
+                             decimateAnalogSamples,
+                             *analogDecimator,
+                             packet.getData(),
+                             sampleCount,
+                             decimatedSamples.data(),
+                             outputCount)
+    else if (analogDataSampleDt == 16)
+        outputCount = analogDecimator->process(static_cast<const int16_t*>(packet.getRawData()), sampleCount, decimatedSamples.data());
+    else
+        outputCount = analogDecimator->process(static_cast<const int32_t*>(packet.getRawData()), sampleCount, decimatedSamples.data());
+
+    if (outputCount == 0)
+        return 0;
+
+    // Time of the input sample of the first output, moved back by the delay of the filter
+    const auto firstOutputOffset =
+        (static_cast<int64_t>(firstOutputIndex) - static_cast<int64_t>(analogDecimator->getDelay())) * analogInputDelta;
+    rawTime = static_cast<uint64_t>(std::max<int64_t>(static_cast<int64_t>(rawTime) + firstOutputOffset, 0));
+
+    return outputCount;
+}
+
+template <typename SetSegmentData>
+void StreamFb::sendAnalogSegments(ASAM::CMP::AnalogPayload& payload,
+                                  size_t sampleCount,
+                                  uint64_t rawTime,
+                                  uint64_t timeScale,
+                                  SetSegmentData&& setSegmentData)
+{
+    // Each segment is a complete message in one frame with the timestamp of its first sample,
+    // so a receiver can use it without waiting for the rest of the source packet
+    const size_t samplesPerSegment = (maxFrameSize - analogMessageOverhead) / (analogDataSampleDt / 8);
+    const uint64_t sampleDelta = analogInputDelta * decimationFactor;
+
+    std::vector<ASAM::CMP::Packet> segments;
+    segments.reserve(std::min(analogSegmentsPerSend, (sampleCount + samplesPerSegment - 1) / samplesPerSegment));
+    for (size_t first = 0; first < sampleCount;)
     {
-        unitId = asam_cmp_common_lib::Units::getIdBySymbol(packet.getDataDescriptor().getUnit().getSymbol().toStdString());
+        const auto encodeStart = std::chrono::steady_clock::now();
+
+        segments.clear();
+        for (; first < sampleCount && segments.size() < analogSegmentsPerSend; first += samplesPerSegment)
+        {
+            setSegmentData(payload, first, std::min(samplesPerSegment, sampleCount - first));
+
+            segments.emplace_back();
+            segments.back().setInterfaceId(interfaceId);
+            segments.back().setPayload(payload);
+            segments.back().setTimestamp((rawTime + first * sampleDelta) * timeScale);
+        }
+
+        const auto frames = encoders->encode(streamId, segments.begin(), segments.end(), dataContext);
+        statistics.onMessagesEncoded(segments.size());
+        statistics.recordEncodeTime(std::chrono::steady_clock::now() - encodeStart);
+
+        sendFrames(frames);
     }
-    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(unitId));
+}
+
+void StreamFb::processAnalogPacket(const DataPacketPtr& packet)
+{
+    statistics.onSamplesReceived(packet.getSampleCount());
+
+    auto domainPacket = packet.getDomainPacket();
+    uint64_t rawTime = domainPacket.getOffset();
+    RatioPtr timeResolution = domainPacket.getDataDescriptor().getTickResolution();
+    const uint64_t timeScale = 1'000'000'000 / timeResolution.getDenominator();
+
+    ASAM::CMP::AnalogPayload payload;
+    payload.setSampleInterval(analogDataDeltaTime);
+    payload.setUnit(ASAM::CMP::AnalogPayload::Unit(getAnalogUnitId(packet)));
     payload.setSampleDt(analogDataSampleDt == 16 ? ASAM::CMP::AnalogPayload::SampleDt::aInt16 : ASAM::CMP::AnalogPayload::SampleDt::aInt32);
     payload.setSampleScalar(analogDataScale);
     payload.setSampleOffset(analogDataOffset);
 
-    payload.setData(rawData, sampleCount * sampleSize);
+    // Segments are built from the source buffer: raw data is copied into the payload, other data is quantized
+    // into a buffer of one segment
+    if (analogDecimator)
+    {
+        // Packets shorter than the decimation factor may not complete an output sample
+        const size_t outputCount = decimateAnalogPacket(packet, rawTime);
+        if (outputCount == 0)
+            return;
+
+        // The filter may overshoot the input range, the quantizer saturates instead of wrapping around
+        const Float scale = analogDataHasInternalPostScaling ? analogDataScale : 1.0;
+        const Float offset = analogDataHasInternalPostScaling ? analogDataOffset : 0.0;
+        sendAnalogSegments(payload,
+                           outputCount,
+                           rawTime,
+                           timeScale,
+                           [&](ASAM::CMP::AnalogPayload& segment, size_t first, size_t count)
+                           {
+                               quantizeAnalogSegment(
+                                   decimatedSamples.data() + first, count, scale, offset, analogDataSampleDt, analogSegmentData);
+                               segment.setData(analogSegmentData.data(), analogSegmentData.size());
+                           });
+    }
+    else if (analogDataHasInternalPostScaling)
+    {
+        const auto sampleType = inputDataDescriptor.getSampleType();
+        sendAnalogSegments(payload,
+                           packet.getSampleCount(),
+                           rawTime,
+                           timeScale,
+                           [&](ASAM::CMP::AnalogPayload& segment, size_t first, size_t count)
+                           {
+                               SAMPLE_TYPE_DISPATCH(sampleType,
+                                                    quantizeInputSegment,
+                                                    packet.getData(),
+                                                    first,
+                                                    count,
+                                                    analogDataScale,
+                                                    analogDataOffset,
+                                                    analogDataSampleDt,
+                                                    analogSegmentData)
+                               segment.setData(analogSegmentData.data(), analogSegmentData.size());
+                           });
+    }
+    else
+    {
+        const auto* rawData = static_cast<const uint8_t*>(packet.getRawData());
+        const size_t sampleSize = analogDataSampleDt / 8;
+        sendAnalogSegments(payload,
+                           packet.getSampleCount(),
+                           rawTime,
+                           timeScale,
+                           [&](ASAM::CMP::AnalogPayload& segment, size_t first, size_t count)
+                           { segment.setData(rawData + first * sampleSize, count * sampleSize); });
+    }
 }
 
-void StreamFb::processAnalogPacket(const DataPacketPtr& packet)
+void StreamFb::sendFrames(const std::vector<std::vector<uint8_t>>& frames)
 {
-    ASAM::CMP::AnalogPayload payload;
-    if (analogDataHasInternalPostScaling)
-        SAMPLE_TYPE_DISPATCH(inputDataDescriptor.getSampleType(),
-                             createAnalogPayloadWithInternalScaling,
-                             payload,
-                             packet,
-                             analogDataScale,
-                             analogDataOffset,
-                             analogDataDeltaTime)
-    else
-        createAnalogPayload(
-            payload, packet, inputDataDescriptor, analogDataScale, analogDataOffset, analogDataDeltaTime, analogDataSampleDt);
+    if (frames.empty())
+        return;
+
+    if (shaper.isLimited(interfaceBucket))
+    {
+        sendShapedFrames(frames);
+        return;
+    }
 
-    ASAM::CMP::Packet asamCmpPacket;
-    asamCmpPacket.setInterfaceId(interfaceId);
-    asamCmpPacket.setPayload(payload);
+    const auto sendStart = std::chrono::steady_clock::now();
+    const size_t sent = transmitQueue.send(getTransmitLane(), frames);
+    statistics.recordSendTime(std::chrono::steady_clock::now() - sendStart);
 
-    auto domainPacket = packet.getDomainPacket();
-    uint64_t rawTime = domainPacket.getOffset();
-    RatioPtr timeResolution = packet.getDomainPacket().getDataDescriptor().getTickResolution();
-    size_t timeScale = 1'000'000'000 / timeResolution.getDenominator();
-    asamCmpPacket.setTimestamp(rawTime * timeScale);
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        if (i < sent)
+            statistics.onFrameSent(frames[i].size());
+        else
+            statistics.onSendFailure();
+    }
+}
+
+void StreamFb::sendShapedFrames(const std::vector<std::vector<uint8_t>>& frames)
+{
+    // The pacer of the capture module sends the frames at their departure times, frames the shaper can't send
+    // within the maximum latency are dropped
+    shaper.schedule(interfaceBucket, frames, TrafficShaper::Clock::now(), departures);
+    pacer.enqueue(getTransmitLane(), frames, departures, statistics);
+
+    const auto droppedFrames = std::count(departures.begin(), departures.end(), TrafficShaper::dropped);
+    if (droppedFrames != 0)
+        statistics.onFramesShaped(static_cast<uint64_t>(droppedFrames));
+}
 
-    for (auto& rawFrame : encoders->encode(streamId, asamCmpPacket, dataContext))
-        ethernetWrapper->sendPacket(rawFrame);
+TransmitQueue::Lane StreamFb::getTransmitLane() const
+{
+    return payloadType == ASAM::CMP::PayloadType::analog ? TransmitQueue::Lane::analog : TransmitQueue::Lane::can;
 }
 
 void StreamFb::processDataPacket(const DataPacketPtr& packet)
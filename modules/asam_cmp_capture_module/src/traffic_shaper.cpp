@@ -0,0 +1,93 @@
+#include <asam_cmp_capture_module/traffic_shaper.h>
+
+#include <algorithm>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+void TokenBucket::setRate(double bitsPerSecond, size_t burstBytes) noexcept
+{
+    nanosecondsPerByte = bitsPerSecond > 0 ? 8e9 / bitsPerSecond : 0;
+    burstTime = getTransmitTime(burstBytes);
+    fullAt = Clock::time_point{};
+}
+
+bool TokenBucket::isLimited() const noexcept
+{
+    return nanosecondsPerByte != 0;
+}
+
+TokenBucket::Clock::time_point TokenBucket::getDeparture(size_t bytes, Clock::time_point earliest) const noexcept
+{
+    if (!isLimited())
+        return earliest;
+
+    // The bucket holds the tokens of the frame once it is short of at most burst - bytes
+    return std::max(earliest, fullAt - burstTime + getTransmitTime(bytes));
+}
+
+void TokenBucket::consume(size_t bytes, Clock::time_point departure) noexcept
+{
+    if (isLimited())
+        fullAt = std::max(fullAt, departure) + getTransmitTime(bytes);
+}
+
+std::chrono::nanoseconds TokenBucket::getTransmitTime(size_t bytes) const noexcept
+{
+    return std::chrono::nanoseconds(static_cast<int64_t>(bytes * nanosecondsPerByte));
+}
+
+TokenBucket& TrafficShaper::getAdapterBucket() noexcept
+{
+    return adapterBucket;
+}
+
+void TrafficShaper::setRate(TokenBucket& bucket, double bitsPerSecond, size_t burstBytes)
+{
+    std::scoped_lock lock{sync};
+    bucket.setRate(bitsPerSecond, burstBytes);
+}
+
+void TrafficShaper::setMaxLatency(std::chrono::nanoseconds latency)
+{
+    std::scoped_lock lock{sync};
+    maxLatency = latency;
+}
+
+bool TrafficShaper::isLimited(const TokenBucket& interfaceBucket)
+{
+    std::scoped_lock lock{sync};
+    return adapterBucket.isLimited() || interfaceBucket.isLimited();
+}
+
+void TrafficShaper::schedule(TokenBucket& interfaceBucket,
+                             const std::vector<std::vector<uint8_t>>& frames,
+                             Clock::time_point now,
+                             std::vector<Clock::time_point>& departures)
+{
+    departures.resize(frames.size());
+
+    std::scoped_lock lock{sync};
+    const auto latest = now + maxLatency;
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        const size_t bytes = getWireSize(frames[i].size());
+        const auto departure = adapterBucket.getDeparture(bytes, interfaceBucket.getDeparture(bytes, now));
+        if (departure > latest)
+        {
+            departures[i] = dropped;
+            continue;
+        }
+
+        interfaceBucket.consume(bytes, departure);
+        adapterBucket.consume(bytes, departure);
+        departures[i] = departure;
+    }
+}
+
+size_t TrafficShaper::getWireSize(size_t cmpFrameSize) noexcept
+{
+    constexpr size_t ethernetHeaderSize = 14, minEthernetFrameSize = 60, fcsPreambleAndGap = 4 + 8 + 12;
+    return std::max(cmpFrameSize + ethernetHeaderSize, minEthernetFrameSize) + fcsPreambleAndGap;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,179 @@
+#include <asam_cmp_capture_module/transmit_queue.h>
+
+#include <algorithm>
+#include <optional>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+// Holds the adapter for one run of frames of a lane, the VLAN tag of the lane is taken with the grant
+class TransmitQueue::Grant final
+{
+public:
+    // A lane already counted as waiting is not counted again
+    Grant(TransmitQueue& queue, Lane lane, bool waiting = false)
+        : queue(queue)
+        , lane(lane)
+    {
+        const auto index = static_cast<size_t>(lane);
+
+        std::unique_lock lock{queue.sync};
+        if (!waiting)
+            ++queue.waiting[index];
+        queue.released.wait(lock, [&] { return queue.canGrant(index); });
+        --queue.waiting[index];
+        queue.busy = true;
+
+        // While the other lane waits, weighted runs end when the lane has used its share
+        const bool weighted = queue.scheduling == Scheduling::weighted;
+        if (lane == Lane::analog && weighted && queue.waiting[static_cast<size_t>(Lane::can)] != 0)
+            runLength = queue.analogWeight - queue.analogFrames;
+        else if (lane == Lane::can && weighted && queue.waiting[static_cast<size_t>(Lane::analog)] != 0)
+            runLength = 1;
+
+        if (lane == Lane::can)
+            queue.analogFrames = 0;
+
+        if (queue.vlanTagging)
+            tag = queue.vlanTags[index];
+    }
+
+    ~Grant()
+    {
+        {
+            std::scoped_lock lock{queue.sync};
+            queue.busy = false;
+            if (lane == Lane::analog)
+                queue.analogFrames += sentFrames;
+            if (keepWaiting)
+                ++queue.waiting[static_cast<size_t>(lane)];
+        }
+        queue.released.notify_all();
+    }
+
+    Grant(const Grant&) = delete;
+    Grant& operator=(const Grant&) = delete;
+
+    const asam_cmp_common_lib::VlanTag* getVlanTag() const noexcept
+    {
+        return tag ? &*tag : nullptr;
+    }
+
+    size_t getRunLength() const noexcept
+    {
+        return runLength;
+    }
+
+    // Counted for the weighted scheduling when the grant is released
+    void setSentFrames(size_t count) noexcept
+    {
+        sentFrames = count;
+    }
+
+    // The lane is counted as waiting from the release of the grant, for the next run of a batch
+    void setKeepWaiting() noexcept
+    {
+        keepWaiting = true;
+    }
+
+private:
+    TransmitQueue& queue;
+    const Lane lane;
+    std::optional<asam_cmp_common_lib::VlanTag> tag;
+    size_t runLength{maxBatchRun};
+    size_t sentFrames{0};
+    bool keepWaiting{false};
+};
+
+TransmitQueue::TransmitQueue(std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper)
+    : ethernetWrapper(std::move(ethernetWrapper))
+{
+}
+
+void TransmitQueue::setScheduling(Scheduling newScheduling, size_t newAnalogWeight)
+{
+    {
+        std::scoped_lock lock{sync};
+        scheduling = newScheduling;
+        analogWeight = std::max<size_t>(newAnalogWeight, 1);
+        analogFrames = 0;
+    }
+    released.notify_all();
+}
+
+void TransmitQueue::setVlanTagging(bool enabled, uint16_t vlanId, const std::array<uint8_t, laneCount>& priorities)
+{
+    std::scoped_lock lock{sync};
+    vlanTagging = enabled;
+    for (size_t i = 0; i < laneCount; ++i)
+        vlanTags[i] = {vlanId, priorities[i]};
+}
+
+bool TransmitQueue::send(Lane lane, const std::vector<uint8_t>& frame)
+{
+    Grant grant(*this, lane);
+    const auto tag = grant.getVlanTag();
+    const bool sent = tag ? ethernetWrapper->sendTaggedPacket(frame, *tag) : ethernetWrapper->sendPacket(frame);
+    grant.setSentFrames(sent ? 1 : 0);
+    return sent;
+}
+
+size_t TransmitQueue::send(Lane lane, const std::vector<std::vector<uint8_t>>& frames)
+{
+    size_t sent = 0;
+    bool waiting = false;
+    std::vector<std::vector<uint8_t>> run;
+    while (sent < frames.size())
+    {
+        Grant grant(*this, lane, waiting);
+        const size_t runLength = std::min(grant.getRunLength(), frames.size() - sent);
+
+        // A batch sent in a single run is passed as is
+        const bool wholeBatch = sent == 0 && runLength == frames.size();
+        if (!wholeBatch)
+            run.assign(frames.begin() + sent, frames.begin() + sent + runLength);
+        const auto& runFrames = wholeBatch ? frames : run;
+
+        const auto tag = grant.getVlanTag();
+        const size_t runSent = tag ? ethernetWrapper->sendTaggedPackets(runFrames, *tag) : ethernetWrapper->sendPackets(runFrames);
+        grant.setSentFrames(runSent);
+        sent += runSent;
+        if (runSent < runLength)
+            break;
+
+        // The rest of the batch stays queued, so the scheduling sees the lane between the runs
+        waiting = sent < frames.size();
+        if (waiting)
+            grant.setKeepWaiting();
+    }
+    return sent;
+}
+
+size_t TransmitQueue::getWaitingCount(Lane lane) const
+{
+    std::scoped_lock lock{sync};
+    return waiting[static_cast<size_t>(lane)];
+}
+
+bool TransmitQueue::canGrant(size_t lane) const
+{
+    constexpr auto status = static_cast<size_t>(Lane::status);
+    constexpr auto analog = static_cast<size_t>(Lane::analog);
+    constexpr auto can = static_cast<size_t>(Lane::can);
+
+    if (busy)
+        return false;
+    if (lane == status)
+        return true;
+    if (waiting[status] != 0)
+        return false;
+
+    if (scheduling == Scheduling::strict)
+        return lane == analog || waiting[analog] == 0;
+
+    // Weighted: the lanes take turns while both wait
+    if (lane == analog)
+        return waiting[can] == 0 || analogFrames < analogWeight;
+    return waiting[analog] == 0 || analogFrames >= analogWeight;
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
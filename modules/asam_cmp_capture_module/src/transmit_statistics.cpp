@@ -0,0 +1,144 @@
+#include <asam_cmp_capture_module/transmit_statistics.h>
+#include <coreobjects/callable_info_factory.h>
+#include <coreobjects/property_object_protected_ptr.h>
+#include <coreobjects/unit_factory.h>
+#include <opendaq/function_block_impl.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
+
+TransmitStatistics::TransmitStatistics(TransmitStatistics* parent)
+    : parent(parent)
+{
+}
+
+void TransmitStatistics::onSamplesReceived(uint64_t count) noexcept
+{
+    samplesReceived.fetch_add(count, std::memory_order_relaxed);
+    if (parent)
+        parent->onSamplesReceived(count);
+}
+
+void TransmitStatistics::onMessagesEncoded(uint64_t count) noexcept
+{
+    messagesEncoded.fetch_add(count, std::memory_order_relaxed);
+    if (parent)
+        parent->onMessagesEncoded(count);
+}
+
+void TransmitStatistics::onFrameSent(uint64_t bytes) noexcept
+{
+    framesSent.fetch_add(1, std::memory_order_relaxed);
+    bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+    if (parent)
+        parent->onFrameSent(bytes);
+}
+
+void TransmitStatistics::onSendFailure() noexcept
+{
+    sendFailures.fetch_add(1, std::memory_order_relaxed);
+    if (parent)
+        parent->onSendFailure();
+}
+
+void TransmitStatistics::onCanFrameSkipped() noexcept
+{
+    skippedCanFrames.fetch_add(1, std::memory_order_relaxed);
+    if (parent)
+        parent->onCanFrameSkipped();
+}
+
+void TransmitStatistics::onCanFramesFiltered(uint64_t count) noexcept
+{
+    filteredCanFrames.fetch_add(count, std::memory_order_relaxed);
+    if (parent)
+        parent->onCanFramesFiltered(count);
+}
+
+void TransmitStatistics::onCanFramesThrottled(uint64_t count) noexcept
+{
+    throttledCanFrames.fetch_add(count, std::memory_order_relaxed);
+    if (parent)
+        parent->onCanFramesThrottled(count);
+}
+
+void TransmitStatistics::onFramesShaped(uint64_t count) noexcept
+{
+    shapedFrames.fetch_add(count, std::memory_order_relaxed);
+    if (parent)
+        parent->onFramesShaped(count);
+}
+
+void TransmitStatistics::recordEncodeTime(std::chrono::steady_clock::duration duration) noexcept
+{
+    encodeTime.record(duration);
+    if (parent)
+        parent->recordEncodeTime(duration);
+}
+
+void TransmitStatistics::recordSendTime(std::chrono::steady_clock::duration duration) noexcept
+{
+    sendTime.record(duration);
+    if (parent)
+        parent->recordSendTime(duration);
+}
+
+void TransmitStatistics::reset() noexcept
+{
+    samplesReceived = 0;
+    messagesEncoded = 0;
+    framesSent = 0;
+    bytesSent = 0;
+    sendFailures = 0;
+    skippedCanFrames = 0;
+    filteredCanFrames = 0;
+    throttledCanFrames = 0;
+    shapedFrames = 0;
+    encodeTime.reset();
+    sendTime.reset();
+}
+
+void TransmitStatistics::addProperties(const PropertyObjectPtr& objPtr)
+{
+    addCounterProperty(objPtr, "SamplesReceived", samplesReceived);
+    addCounterProperty(objPtr, "MessagesEncoded", messagesEncoded);
+    addCounterProperty(objPtr, "FramesSent", framesSent);
+    addCounterProperty(objPtr, "BytesSent", bytesSent);
+    addCounterProperty(objPtr, "SendFailures", sendFailures);
+    addCounterProperty(objPtr, "SkippedCanFrames", skippedCanFrames);
+    addCounterProperty(objPtr, "FilteredCanFrames", filteredCanFrames);
+    addCounterProperty(objPtr, "ThrottledCanFrames", throttledCanFrames);
+    addCounterProperty(objPtr, "ShapedFrames", shapedFrames);
+
+    addLatencyProperty(objPtr, "EncodeTimeP50", encodeTime, 50.0);
+    addLatencyProperty(objPtr, "EncodeTimeP99", encodeTime, 99.0);
+    addLatencyProperty(objPtr, "EncodeTimeP999", encodeTime, 99.9);
+    addLatencyProperty(objPtr, "EncodeTimeMax", encodeTime, 100.0);
+    addLatencyProperty(objPtr, "SendTimeP50", sendTime, 50.0);
+    addLatencyProperty(objPtr, "SendTimeP99", sendTime, 99.0);
+    addLatencyProperty(objPtr, "SendTimeP999", sendTime, 99.9);
+    addLatencyProperty(objPtr, "SendTimeMax", sendTime, 100.0);
+
+    StringPtr propName = "ResetStatistics";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { reset(); }));
+}
+
+void TransmitStatistics::addCounterProperty(const PropertyObjectPtr& objPtr, const StringPtr& name, const std::atomic<uint64_t>& counter)
+{
+    // Counters are updated on the packet processing thread, the property reports the current value on read
+    objPtr.addProperty(IntPropertyBuilder(name, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(name) += [&counter](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(static_cast<Int>(counter.load(std::memory_order_relaxed))); };
+}
+
+void TransmitStatistics::addLatencyProperty(const PropertyObjectPtr& objPtr,
+                                            const StringPtr& name,
+                                            const asam_cmp_common_lib::LatencyHistogram& histogram,
+                                            double percentile)
+{
+    objPtr.addProperty(IntPropertyBuilder(name, 0).setReadOnly(true).setUnit(Unit("ns")).build());
+    objPtr.getOnPropertyValueRead(name) += [&histogram, percentile](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(static_cast<Int>(histogram.getValueAtPercentile(percentile))); };
+}
+
+END_NAMESPACE_ASAM_CMP_CAPTURE_MODULE
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/analog_decimator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using daq::modules::asam_cmp_capture_module::AnalogDecimator;
+
+namespace
+{
+    std::vector<double> decimate(AnalogDecimator& decimator, const std::vector<double>& input, size_t chunkSize)
+    {
+        std::vector<double> output;
+        std::vector<double> chunkOutput(decimator.getMaxOutputCount(chunkSize));
+        for (size_t i = 0; i < input.size(); i += chunkSize)
+        {
+            const size_t count = std::min(chunkSize, input.size() - i);
+            const size_t outputCount = decimator.process(input.data() + i, count, chunkOutput.data());
+            output.insert(output.end(), chunkOutput.begin(), chunkOutput.begin() + outputCount);
+        }
+        return output;
+    }
+
+    std::vector<double> sine(double frequency, size_t count)
+    {
+        std::vector<double> samples(count);
+        for (size_t i = 0; i < count; ++i)
+            samples[i] = std::sin(2 * 3.14159265358979323846 * frequency * static_cast<double>(i));
+        return samples;
+    }
+
+    // Amplitude of a sine from the RMS of count samples, count should cover whole periods
+    double amplitude(const std::vector<double>& samples, size_t from, size_t count)
+    {
+        double sum = 0;
+        for (size_t i = from; i < from + count; ++i)
+            sum += samples[i] * samples[i];
+        return std::sqrt(2 * sum / static_cast<double>(count));
+    }
+}
+
+TEST(AnalogDecimatorTest, InvalidFactor)
+{
+    EXPECT_THROW(AnalogDecimator(0), std::invalid_argument);
+    EXPECT_THROW(AnalogDecimator(1), std::invalid_argument);
+    EXPECT_THROW(AnalogDecimator(AnalogDecimator::maxFactor + 1), std::invalid_argument);
+}
+
+TEST(AnalogDecimatorTest, ConstantInput)
+{
+    AnalogDecimator decimator(10);
+    EXPECT_EQ(decimator.getDelay(), (decimator.getTapCount() - 1) / 2);
+
+    const std::vector<int16_t> input(1000, 1234);
+    std::vector<double> output(decimator.getMaxOutputCount(input.size()));
+    ASSERT_EQ(decimator.process(input.data(), input.size(), output.data()), 100u);
+    for (size_t i = 0; i < 100; ++i)
+        ASSERT_NEAR(output[i], 1234.0, 1e-9);
+}
+
+TEST(AnalogDecimatorTest, ChunkingDoesNotChangeOutput)
+{
+    const auto input = sine(0.003, 5000);
+
+    AnalogDecimator whole(7);
+    const auto expected = decimate(whole, input, input.size());
+    ASSERT_EQ(expected.size(), (input.size() + 6) / 7);
+
+    for (size_t chunkSize : {1u, 5u, 7u, 64u, 333u})
+    {
+        AnalogDecimator chunked(7);
+        const auto output = decimate(chunked, input, chunkSize);
+        ASSERT_EQ(output.size(), expected.size()) << chunkSize;
+        for (size_t i = 0; i < output.size(); ++i)
+            ASSERT_DOUBLE_EQ(output[i], expected[i]) << chunkSize;
+    }
+}
+
+TEST(AnalogDecimatorTest, SuppressesAliases)
+{
+    AnalogDecimator decimator(10);
+    const size_t settled = decimator.getTapCount() / 10 + 1;
+
+    // Within the output band, 10 output samples per period
+    const auto passed = decimate(decimator, sine(0.01, 20000), 1000);
+    EXPECT_NEAR(amplitude(passed, settled, 1000), 1.0, 0.01);
+
+    // Above the Nyquist frequency of the output, would alias to 0.02
+    decimator.reset();
+    const auto stopped = decimate(decimator, sine(0.08, 20000), 1000);
+    EXPECT_LT(amplitude(stopped, settled, 1000), 1e-3);
+}
@@ -15,6 +15,8 @@
 #include <opendaq/context_factory.h>
 #include <opendaq/scheduler_factory.h>
 
+#include <optional>
+
 #include "include/ref_channel_impl.h"
 #include "include/time_stub.h"
 
@@ -37,7 +39,7 @@ protected:
         ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(names));
         ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
         ON_CALL(*ethernetWrapper, sendPacket(_))
-            .WillByDefault(WithArgs<0>(Invoke([&](const std::vector<uint8_t>& data) { this->onPacketSendCb(data); })));
+            .WillByDefault(WithArgs<0>(Invoke([&](const std::vector<uint8_t>& data) { this->onPacketSendCb(data); return true; })));
 
         auto logger = Logger();
         context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
@@ -71,7 +73,10 @@ protected:
     }
 
     template <SampleType SrcType>
-    void testAnalogPackets(bool setScale);
+    void testAnalogPackets(bool setScale,
+                           Int sampleResolution = 0,
+                           Float samplePrecision = 0.0,
+                           std::optional<ASAM::CMP::AnalogPayload::SampleDt> expectedSampleDt = std::nullopt);
 
     template <typename T>
     bool checkSamples(const ASAM::CMP::AnalogPayload& analogPayload, size_t& receivedSamples);
@@ -114,7 +119,10 @@ bool AnalogMessagesTest::checkSamples(const ASAM::CMP::AnalogPayload& analogPayl
 }
 
 template <SampleType SrcType>
-void AnalogMessagesTest::testAnalogPackets(bool setScale)
+void AnalogMessagesTest::testAnalogPackets(bool setScale,
+                                           Int sampleResolution,
+                                           Float samplePrecision,
+                                           std::optional<ASAM::CMP::AnalogPayload::SampleDt> expectedSampleDt)
 {
     EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
 
@@ -122,6 +130,8 @@ void AnalogMessagesTest::testAnalogPackets(bool setScale)
     interfaceFb.setPropertyValue("PayloadType", 3);
     createProc();
     auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    streamFb.setPropertyValue("SampleResolution", sampleResolution);
+    streamFb.setPropertyValue("SamplePrecision", samplePrecision);
 
     uint8_t streamId = static_cast<Int>(streamFb.getPropertyValue("StreamId"));
     uint32_t interfaceId = interfaceFb.getPropertyValue("InterfaceId");
@@ -150,6 +160,7 @@ void AnalogMessagesTest::testAnalogPackets(bool setScale)
     chPrivate->collectSamples(curTime);
 
     size_t receivedSamples = 0;
+    bool unexpectedSampleDt = false;
     auto checker = [&]() -> bool
     {
         std::scoped_lock lock{packedReceivedSync};
@@ -178,6 +189,12 @@ void AnalogMessagesTest::testAnalogPackets(bool setScale)
             return false;
 
         const auto& analogPayload = static_cast<ASAM::CMP::AnalogPayload&>(packet.getPayload());
+        if (expectedSampleDt.has_value() && analogPayload.getSampleDt() != expectedSampleDt.value())
+        {
+            unexpectedSampleDt = true;
+            return false;
+        }
+
         if (analogPayload.getSampleDt() == ASAM::CMP::AnalogPayload::SampleDt::aInt16)
         {
             if (!checkSamples<int16_t>(analogPayload, receivedSamples))
@@ -194,13 +211,14 @@ void AnalogMessagesTest::testAnalogPackets(bool setScale)
 
     size_t timeElapsed = 0;
     auto stTime = std::chrono::steady_clock::now();
-    while (!checker() && timeElapsed < 60'000)
+    while (!checker() && !unexpectedSampleDt && timeElapsed < 60'000)
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
         auto curTime1 = std::chrono::steady_clock::now();
         timeElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(curTime1 - stTime).count();
     }
 
+    ASSERT_FALSE(unexpectedSampleDt);
     ASSERT_EQ(receivedSamples, sentAnalogSamples.size());
 }
 
@@ -224,8 +242,179 @@ TEST_F(AnalogMessagesTest, TestAnalogPacketFloat64)
     testAnalogPackets<SampleType::Float64>(false);
 }
 
+TEST_F(AnalogMessagesTest, TestAnalogPacketFloat64Int16)
+{
+    testAnalogPackets<SampleType::Float64>(false, 1, 0.0, ASAM::CMP::AnalogPayload::SampleDt::aInt16);
+}
+
+TEST_F(AnalogMessagesTest, TestAnalogPacketFloat64AutoWithinPrecision)
+{
+    // The Int16 step over the [-10, 10] range of the input is about 0.0003
+    testAnalogPackets<SampleType::Float64>(false, 0, 0.001, ASAM::CMP::AnalogPayload::SampleDt::aInt16);
+}
+
+TEST_F(AnalogMessagesTest, TestAnalogPacketFloat64AutoBeyondPrecision)
+{
+    testAnalogPackets<SampleType::Float64>(false, 0, 0.0001, ASAM::CMP::AnalogPayload::SampleDt::aInt32);
+}
+
 TEST_F(AnalogMessagesTest, TestAnalogPacketScaled)
 {
     testAnalogPackets<SampleType::Float64>(true);
 }
 
+
+TEST_F(AnalogMessagesTest, TestAnalogPacketDecimated)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = interfaceFb.getPropertyValue("AddStream");
+    interfaceFb.setPropertyValue("PayloadType", 3);
+    createProc();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    constexpr size_t decimationFactor = 4;
+    streamFb.setPropertyValue("DecimationFactor", static_cast<Int>(decimationFactor));
+
+    daq::InputChannelStubInit init{
+        0, 200, timeStub.getMicroSecondsSinceDeviceStart(), timeStub.getMicroSecondsFromEpochToDeviceStart(), [&]() {
+            return analogCallback();
+        }};
+    ChannelPtr analogChannel = createWithImplementation<IChannel, InputChannelStubImpl>(this->context, nullptr, "refch", init);
+    analogChannel.asPtr<IInputChannelStub>()->initDescriptors();
+    analogChannel.setPropertyValue("SampleType", static_cast<int>(SampleType::Int32));
+
+    streamFb.getInputPorts().getItemAt(0).connect(analogChannel.getSignals()[0]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    analogChannel.asPtr<IInputChannelStub>()->collectSamples(timeStub.getMicroSecondsSinceDeviceStart());
+
+    size_t receivedSamples = 0;
+    float sampleInterval = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::scoped_lock lock{packedReceivedSync};
+            while (!receivedPackets.empty())
+            {
+                auto packet = receivedPackets.front();
+                receivedPackets.pop();
+                if (packet->getPayload().getType() != ASAM::CMP::PayloadType::analog)
+                    continue;
+
+                const auto& analogPayload = static_cast<ASAM::CMP::AnalogPayload&>(packet->getPayload());
+                receivedSamples += analogPayload.getSamplesCount();
+                sampleInterval = analogPayload.getSampleInterval();
+            }
+        }
+
+        if (!sentAnalogSamples.empty() && receivedSamples * decimationFactor >= sentAnalogSamples.size())
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ASSERT_FALSE(sentAnalogSamples.empty());
+    ASSERT_EQ(receivedSamples, (sentAnalogSamples.size() + decimationFactor - 1) / decimationFactor);
+    ASSERT_GT(sampleInterval, 0.0f);
+}
+
+TEST_F(AnalogMessagesTest, TestAnalogPacketSegmented)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = interfaceFb.getPropertyValue("AddStream");
+    interfaceFb.setPropertyValue("PayloadType", 3);
+    createProc();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+    // A source packet holds more samples than fit in one frame
+    daq::InputChannelStubInit init{
+        0, 50'000, timeStub.getMicroSecondsSinceDeviceStart(), timeStub.getMicroSecondsFromEpochToDeviceStart(), [&]() {
+            return analogCallback();
+        }};
+    ChannelPtr analogChannel = createWithImplementation<IChannel, InputChannelStubImpl>(this->context, nullptr, "refch", init);
+    analogChannel.asPtr<IInputChannelStub>()->initDescriptors();
+    analogChannel.setPropertyValue("SampleType", static_cast<int>(SampleType::Int32));
+
+    streamFb.getInputPorts().getItemAt(0).connect(analogChannel.getSignals()[0]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    analogChannel.asPtr<IInputChannelStub>()->collectSamples(timeStub.getMicroSecondsSinceDeviceStart());
+
+    size_t receivedSamples = 0;
+    size_t receivedMessages = 0;
+    uint64_t nextTimestamp = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        {
+            std::scoped_lock lock{packedReceivedSync};
+            while (!receivedPackets.empty())
+            {
+                auto packet = receivedPackets.front();
+                receivedPackets.pop();
+                if (packet->getPayload().getType() != ASAM::CMP::PayloadType::analog)
+                    continue;
+
+                // Every segment is a complete message, timestamped at its first sample
+                const auto& analogPayload = static_cast<ASAM::CMP::AnalogPayload&>(packet->getPayload());
+                ASSERT_TRUE(checkSamples<int32_t>(analogPayload, receivedSamples));
+                if (receivedMessages != 0)
+                    ASSERT_NEAR(static_cast<double>(packet->getTimestamp()), static_cast<double>(nextTimestamp), 1000.0);
+                nextTimestamp = packet->getTimestamp() +
+                                static_cast<uint64_t>(std::llround(analogPayload.getSamplesCount() * analogPayload.getSampleInterval() * 1e9));
+                ++receivedMessages;
+            }
+        }
+
+        if (!sentAnalogSamples.empty() && receivedSamples >= sentAnalogSamples.size())
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ASSERT_FALSE(sentAnalogSamples.empty());
+    ASSERT_EQ(receivedSamples, sentAnalogSamples.size());
+    ASSERT_GT(receivedMessages, 1u);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("MessagesEncoded")), static_cast<Int>(receivedMessages));
+}
+
+TEST_F(AnalogMessagesTest, TestAnalogPacketShaped)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    // The adapter sends one frame per 12 ms, so only the burst is sent within the maximum latency
+    captureFb.setPropertyValue("TxRateLimit", 1.0);
+    captureFb.setPropertyValue("TxBurstSize", 1500);
+    captureFb.setPropertyValue("TxMaxLatency", 1);
+
+    ProcedurePtr createProc = interfaceFb.getPropertyValue("AddStream");
+    interfaceFb.setPropertyValue("PayloadType", 3);
+    createProc();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+    daq::InputChannelStubInit init{
+        0, 50'000, timeStub.getMicroSecondsSinceDeviceStart(), timeStub.getMicroSecondsFromEpochToDeviceStart(), [&]() {
+            return analogCallback();
+        }};
+    ChannelPtr analogChannel = createWithImplementation<IChannel, InputChannelStubImpl>(this->context, nullptr, "refch", init);
+    analogChannel.asPtr<IInputChannelStub>()->initDescriptors();
+    analogChannel.setPropertyValue("SampleType", static_cast<int>(SampleType::Int32));
+
+    streamFb.getInputPorts().getItemAt(0).connect(analogChannel.getSignals()[0]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    analogChannel.asPtr<IInputChannelStub>()->collectSamples(timeStub.getMicroSecondsSinceDeviceStart());
+
+    auto framesHandled = [&]()
+    {
+        return static_cast<Int>(streamFb.getPropertyValue("FramesSent")) + static_cast<Int>(streamFb.getPropertyValue("ShapedFrames"));
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (framesHandled() < static_cast<Int>(streamFb.getPropertyValue("MessagesEncoded")) || framesHandled() == 0)
+    {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ASSERT_GT(static_cast<Int>(streamFb.getPropertyValue("MessagesEncoded")), 1);
+    ASSERT_GE(static_cast<Int>(streamFb.getPropertyValue("FramesSent")), 1);
+    ASSERT_GT(static_cast<Int>(streamFb.getPropertyValue("ShapedFrames")), 0);
+    ASSERT_EQ(interfaceFb.getPropertyValue("ShapedFrames"), streamFb.getPropertyValue("ShapedFrames"));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/analog_quantizer.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using daq::modules::asam_cmp_capture_module::quantizeAnalogSamples;
+
+TEST(AnalogQuantizerTest, Int16)
+{
+    // Longer than one vector block and not a multiple of it, so both the kernel and the tail are used
+    std::vector<double> values;
+    for (int i = -10; i <= 10; ++i)
+        values.push_back(i * 0.25);
+    values.push_back(1e9);
+    values.push_back(-1e9);
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+
+    std::vector<int16_t> output(values.size());
+    quantizeAnalogSamples(values.data(), values.size(), 0.001, 1.0, output.data());
+
+    for (size_t i = 0; i < 21; ++i)
+        EXPECT_EQ(output[i], static_cast<int16_t>(std::nearbyint((values[i] - 1.0) / 0.001))) << i;
+    EXPECT_EQ(output[21], std::numeric_limits<int16_t>::max());
+    EXPECT_EQ(output[22], std::numeric_limits<int16_t>::min());
+    EXPECT_EQ(output[23], std::numeric_limits<int16_t>::min());
+}
+
+TEST(AnalogQuantizerTest, Int32)
+{
+    std::vector<double> values{0.0, 0.5, 1.5, -2.25, 3e12, -3e12, std::numeric_limits<double>::quiet_NaN()};
+    std::vector<int32_t> output(values.size());
+    quantizeAnalogSamples(values.data(), values.size(), 0.5, 0.0, output.data());
+
+    EXPECT_EQ(output[0], 0);
+    EXPECT_EQ(output[1], 1);
+    EXPECT_EQ(output[2], 3);
+    EXPECT_EQ(output[3], -4);
+    EXPECT_EQ(output[4], std::numeric_limits<int32_t>::max());
+    EXPECT_EQ(output[5], std::numeric_limits<int32_t>::min());
+    EXPECT_EQ(output[6], std::numeric_limits<int32_t>::min());
+}
+
+TEST(AnalogQuantizerTest, ConvertsOtherTypes)
+{
+    std::vector<float> values(1000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<float>(i) - 500.0f;
+
+    std::vector<int16_t> output(values.size());
+    quantizeAnalogSamples(values.data(), values.size(), 1.0 / 64, 0.0, output.data());
+    for (size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(output[i], std::max(-32768, std::min(32767, static_cast<int>(values[i]) * 64))) << i;
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/can_log_reader.h>
+#include <asam_cmp_capture_module/can_log_replay_fb.h>
+#include <asam_cmp_capture_module/input_descriptors_validator.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace daq;
+using daq::modules::asam_cmp_capture_module::CanLogReader;
+using daq::modules::asam_cmp_capture_module::CanLogReplayFb;
+
+class CanLogReaderTest : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        std::filesystem::remove(fileName);
+    }
+
+    void writeFile(const std::string& name, const std::string& content)
+    {
+        fileName = name;
+        std::ofstream file(fileName, std::ios::binary);
+        file << content;
+    }
+
+    std::vector<CanLogReader::Frame> readAll(CanLogReader& reader)
+    {
+        std::vector<CanLogReader::Frame> frames;
+        CanLogReader::Frame frame;
+        while (reader.next(frame))
+            frames.push_back(frame);
+        return frames;
+    }
+
+protected:
+    std::string fileName;
+};
+
+TEST_F(CanLogReaderTest, CandumpLine)
+{
+    CanLogReader::Frame frame;
+    ASSERT_TRUE(CanLogReader::parseCandumpLine("(1436509052.249713) vcan0 044#2A366C2BBA", frame));
+    EXPECT_EQ(frame.timestamp, 1436509052249713000u);
+    EXPECT_EQ(frame.channel, "vcan0");
+    EXPECT_FALSE(frame.canFd);
+    EXPECT_EQ(static_cast<uint32_t>(frame.data.arbId), 0x44u);
+    ASSERT_EQ(frame.data.length, 5);
+    EXPECT_EQ(frame.data.data[0], 0x2A);
+    EXPECT_EQ(frame.data.data[4], 0xBA);
+
+    ASSERT_TRUE(CanLogReader::parseCandumpLine("(1.5) can1 12345678##1000102030405060708090A0B", frame));
+    EXPECT_TRUE(frame.canFd);
+    EXPECT_EQ(frame.timestamp, 1500000000u);
+    EXPECT_EQ(static_cast<uint32_t>(frame.data.arbId), 0x12345678u);
+    ASSERT_EQ(frame.data.length, 12);
+    EXPECT_EQ(frame.data.data[11], 0x0B);
+
+    ASSERT_TRUE(CanLogReader::parseCandumpLine("(2.000000) can0 123#", frame));
+    EXPECT_EQ(frame.data.length, 0);
+}
+
+TEST_F(CanLogReaderTest, CandumpInvalidLines)
+{
+    CanLogReader::Frame frame;
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("(1.0) can0 123#R", frame));
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("(1.0) can0 20000080#0000000000000000", frame));
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("(1.0) can0 123#001122334455667788", frame));
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("(1.0) can0 123##0001122334455667788", frame));
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("(1.0) can0 1234#00", frame));
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("1.0 can0 123#00", frame));
+    EXPECT_FALSE(CanLogReader::parseCandumpLine("(1.0) can0 123#0", frame));
+}
+
+TEST_F(CanLogReaderTest, CandumpFile)
+{
+    writeFile("test_can_log_reader.log",
+              "(100.000001) can0 100#01\r\n"
+              "(100.000002) can0 101#R\n"
+              "\n"
+              "(100.000003) can1 102##3AABB\n");
+
+    CanLogReader reader(fileName);
+    ASSERT_EQ(reader.getFormat(), CanLogReader::Format::candump);
+    auto frames = readAll(reader);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(static_cast<uint32_t>(frames[0].data.arbId), 0x100u);
+    EXPECT_EQ(static_cast<uint32_t>(frames[1].data.arbId), 0x102u);
+    EXPECT_EQ(frames[1].channel, "can1");
+    EXPECT_EQ(reader.getSkippedLines(), 1u);
+
+    reader.rewind();
+    EXPECT_EQ(readAll(reader).size(), 2u);
+}
+
+TEST_F(CanLogReaderTest, AscFile)
+{
+    writeFile("test_can_log_reader.asc",
+              "date Mon Jan 1 00:00:00.000 am 2024\n"
+              "base hex  timestamps absolute\n"
+              "internal events logged\n"
+              "// version 13.0.0\n"
+              "Begin Triggerblock Mon Jan 1 00:00:00.000 am 2024\n"
+              "   0.000000 Start of measurement\n"
+              "   0.015991 1  7E0             Rx   d 8 02 01 0D 00 00 00 00 00  Length = 228000 BitCount = 118 ID = 2016\n"
+              "   0.016500 2  18DAF110x       Tx   d 3 AA BB CC\n"
+              "   0.017000 1  ErrorFrame\n"
+              "   0.018000 CANFD   1 Rx        123  EngineData  1 0 9 12 00 01 02 03 04 05 06 07 08 09 0a 0b   0 0 1000 0 0 0 0 0\n"
+              "   0.019000 CANFD   1 Rx        124  1 0 d 32 00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f 10 11 12 13 14 15 16 17 18 19 1a 1b 1c 1d 1e 1f\n"
+              "End TriggerBlock\n");
+
+    CanLogReader reader(fileName);
+    ASSERT_EQ(reader.getFormat(), CanLogReader::Format::vectorAsc);
+    auto frames = readAll(reader);
+    ASSERT_EQ(frames.size(), 4u);
+
+    EXPECT_EQ(frames[0].timestamp, 15991000u);
+    EXPECT_EQ(frames[0].channel, "1");
+    EXPECT_EQ(static_cast<uint32_t>(frames[0].data.arbId), 0x7E0u);
+    EXPECT_EQ(frames[0].data.length, 8);
+    EXPECT_EQ(frames[0].data.data[2], 0x0D);
+
+    EXPECT_EQ(static_cast<uint32_t>(frames[1].data.arbId), 0x18DAF110u);
+    EXPECT_EQ(frames[1].data.length, 3);
+
+    EXPECT_TRUE(frames[2].canFd);
+    EXPECT_EQ(static_cast<uint32_t>(frames[2].data.arbId), 0x123u);
+    EXPECT_EQ(frames[2].data.length, 12);
+    EXPECT_EQ(frames[2].data.data[11], 0x0B);
+
+    EXPECT_EQ(frames[3].data.length, 32);
+    EXPECT_EQ(frames[3].data.data[31], 0x1F);
+
+    EXPECT_EQ(reader.getSkippedLines(), 2u);
+}
+
+TEST_F(CanLogReaderTest, AscDecimalRelative)
+{
+    writeFile("test_can_log_reader.asc",
+              "base dec  timestamps relative\n"
+              "   1.000000 1  2016 Rx   d 2 10 255\n"
+              "   0.500000 1  2017 Rx   d 1 7\n");
+
+    CanLogReader reader(fileName);
+    auto frames = readAll(reader);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(static_cast<uint32_t>(frames[0].data.arbId), 2016u);
+    EXPECT_EQ(frames[0].data.data[1], 255);
+    EXPECT_EQ(frames[1].timestamp, 1500000000u);
+}
+
+TEST_F(CanLogReaderTest, MissingFileThrows)
+{
+    ASSERT_THROW(CanLogReader("nonexistent.log"), std::runtime_error);
+}
+
+TEST_F(CanLogReaderTest, ReplayFb)
+{
+    writeFile("test_can_log_replay.log",
+              "(1.000000) can0 123#01\n"
+              "(1.000100) can1 124#02\n"
+              "(1.000200) can0 125#0304\n");
+
+    auto logger = Logger();
+    auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+    FunctionBlockPtr replayFb = createWithImplementation<IFunctionBlock, CanLogReplayFb>(ModuleInfoPtr(), context, nullptr, "replay");
+
+    SignalPtr valueSignal = replayFb.getSignals().getItemAt(0);
+    ASSERT_TRUE(modules::asam_cmp_capture_module::validateInputDescriptor(valueSignal.getDescriptor(), ASAM::CMP::PayloadType::can));
+
+    replayFb.setPropertyValue("ReplayFile", fileName);
+    replayFb.setPropertyValue("Channel", "can0");
+    replayFb.setPropertyValue("SamplesPerPacket", 2);
+    ProcedurePtr startProc = replayFb.getPropertyValue("StartReplay");
+    startProc();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (replayFb.getPropertyValue("ReplayActive") && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_FALSE(replayFb.getPropertyValue("ReplayActive"));
+    ASSERT_EQ(static_cast<Int>(replayFb.getPropertyValue("ReplayedFrames")), 2);
+
+    replayFb.setPropertyValue("ReplayFile", "nonexistent.log");
+    ASSERT_ANY_THROW(startProc());
+}
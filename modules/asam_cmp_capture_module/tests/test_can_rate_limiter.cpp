@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/can_rate_limiter.h>
+
+#include <stdexcept>
+#include <vector>
+
+using daq::modules::asam_cmp_capture_module::CanRateLimiter;
+
+namespace
+{
+    constexpr uint64_t ms = 1'000'000;
+
+    // Admits the frame and releases due frames like the Stream FB does, returns the IDs and payloads sent
+    std::vector<std::pair<uint32_t, uint8_t>> feed(CanRateLimiter& limiter, uint32_t arbId, uint8_t value, uint64_t timestamp)
+    {
+        std::vector<std::pair<uint32_t, uint8_t>> sent;
+        const bool admitted = limiter.admit(arbId, &value, 1, timestamp);
+        limiter.release(timestamp, [&](const CanRateLimiter::Frame& frame) { sent.emplace_back(frame.arbId, frame.data[0]); });
+        if (admitted)
+            sent.emplace_back(arbId, value);
+        return sent;
+    }
+
+    using Sent = std::vector<std::pair<uint32_t, uint8_t>>;
+}
+
+TEST(CanRateLimiterTest, Parse)
+{
+    EXPECT_TRUE(CanRateLimiter().isEmpty());
+    EXPECT_TRUE(CanRateLimiter(" , ").isEmpty());
+    EXPECT_FALSE(CanRateLimiter("0x7DF:100, 0x700-0x7FF : 20, 0x18DAF100:5").isEmpty());
+
+    EXPECT_THROW(CanRateLimiter("0x7DF"), std::invalid_argument);
+    EXPECT_THROW(CanRateLimiter("0x7DF:"), std::invalid_argument);
+    EXPECT_THROW(CanRateLimiter("0x7DF:0"), std::invalid_argument);
+    EXPECT_THROW(CanRateLimiter("0x7DF:1.5"), std::invalid_argument);
+    EXPECT_THROW(CanRateLimiter(":100"), std::invalid_argument);
+    EXPECT_THROW(CanRateLimiter("0x7G0:100"), std::invalid_argument);
+}
+
+TEST(CanRateLimiterTest, KeepsLatestFramePerInterval)
+{
+    CanRateLimiter limiter("0x100:10");
+
+    EXPECT_EQ(feed(limiter, 0x100, 1, 0), (Sent{{0x100, 1}}));
+    EXPECT_EQ(feed(limiter, 0x100, 2, 2 * ms), Sent{});
+    EXPECT_EQ(feed(limiter, 0x100, 3, 4 * ms), Sent{});
+    EXPECT_EQ(limiter.takeDroppedFrames(), 1u);
+    EXPECT_EQ(limiter.takeDroppedFrames(), 0u);
+
+    // Other IDs are not limited, a frame after the interval releases the latest pending frame
+    EXPECT_EQ(feed(limiter, 0x200, 9, 5 * ms), (Sent{{0x200, 9}}));
+    EXPECT_EQ(feed(limiter, 0x200, 9, 11 * ms), (Sent{{0x100, 3}, {0x200, 9}}));
+
+    // The interval restarts at the release
+    EXPECT_EQ(feed(limiter, 0x100, 4, 15 * ms), Sent{});
+    EXPECT_EQ(feed(limiter, 0x200, 9, 21 * ms), (Sent{{0x100, 4}, {0x200, 9}}));
+    EXPECT_EQ(limiter.takeDroppedFrames(), 0u);
+}
+
+TEST(CanRateLimiterTest, FrameAfterIntervalSupersedesPendingFrame)
+{
+    CanRateLimiter limiter("0x100:10");
+
+    EXPECT_EQ(feed(limiter, 0x100, 1, 0), (Sent{{0x100, 1}}));
+    EXPECT_EQ(feed(limiter, 0x100, 2, 5 * ms), Sent{});
+
+    // The newest value goes out at once instead of the stale pending one
+    EXPECT_EQ(feed(limiter, 0x100, 3, 12 * ms), (Sent{{0x100, 3}}));
+    EXPECT_EQ(limiter.takeDroppedFrames(), 1u);
+    EXPECT_EQ(feed(limiter, 0x100, 4, 30 * ms), (Sent{{0x100, 4}}));
+    EXPECT_EQ(limiter.takeDroppedFrames(), 0u);
+}
+
+TEST(CanRateLimiterTest, NewerFrameSupersedesPendingFrame)
+{
+    CanRateLimiter limiter("0x100-0x101:10");
+
+    EXPECT_EQ(feed(limiter, 0x100, 1, 0), (Sent{{0x100, 1}}));
+    EXPECT_EQ(feed(limiter, 0x101, 1, 0), (Sent{{0x101, 1}}));
+    EXPECT_EQ(feed(limiter, 0x100, 2, 5 * ms), Sent{});
+
+    // Without release, admitting a frame after the interval sends it and drops the older pending one
+    EXPECT_TRUE(limiter.admit(0x100, reinterpret_cast<const uint8_t*>("\x03"), 1, 12 * ms));
+    EXPECT_EQ(limiter.takeDroppedFrames(), 1u);
+    EXPECT_EQ(feed(limiter, 0x200, 9, 30 * ms), (Sent{{0x200, 9}}));
+}
+
+TEST(CanRateLimiterTest, NextRelease)
+{
+    CanRateLimiter limiter("0x100:10");
+    EXPECT_EQ(limiter.getNextRelease(), UINT64_MAX);
+
+    EXPECT_EQ(feed(limiter, 0x100, 1, 0), (Sent{{0x100, 1}}));
+    EXPECT_EQ(feed(limiter, 0x100, 2, 5 * ms), Sent{});
+    EXPECT_EQ(limiter.getNextRelease(), 10 * ms);
+
+    // A lone pending frame goes out when its owner releases at the next release time
+    Sent sent;
+    limiter.release(limiter.getNextRelease(), [&](const CanRateLimiter::Frame& frame) { sent.emplace_back(frame.arbId, frame.data[0]); });
+    EXPECT_EQ(sent, (Sent{{0x100, 2}}));
+    EXPECT_EQ(limiter.getNextRelease(), UINT64_MAX);
+}
@@ -27,7 +27,8 @@ protected:
         ON_CALL(*ethernetWrapper, sendPacket(_))
             .WillByDefault(WithArgs<0>(Invoke(
                 [&](const std::vector<uint8_t>& data){
-            this->onPacketSendCb(data);}
+            this->onPacketSendCb(data);
+            return true;}
         )));
 
         auto logger = Logger();
@@ -34,7 +34,7 @@ protected:
         ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
         ON_CALL(*ethernetWrapper, sendPacket(_))
             .WillByDefault(WithArgs<0>(Invoke(
-                [&](const std::vector<uint8_t>& data) { }
+                [&](const std::vector<uint8_t>& data) { return true; }
         )));
 
         captureModuleFb = createWithImplementation<IFunctionBlock, CaptureModuleFb>(moduleInfo, context, nullptr, "dummy_id", ethernetWrapper);
@@ -37,7 +37,7 @@ protected:
         EXPECT_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillRepeatedly(Return(descriptions));
         EXPECT_CALL(*ethernetWrapper, sendPacket(_))
             .WillRepeatedly(WithArgs<0>(Invoke(
-                [&](const std::vector<uint8_t>& data) { }
+                [&](const std::vector<uint8_t>& data) { return true; }
         )));
 
         captureModuleFb = createWithImplementation<IFunctionBlock, CaptureModuleFb>(moduleInfo, context, nullptr, "dummy_id", ethernetWrapper);
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/frame_pacer.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using daq::modules::asam_cmp_capture_module::FramePacer;
+using daq::modules::asam_cmp_capture_module::TrafficShaper;
+using daq::modules::asam_cmp_capture_module::TransmitQueue;
+using daq::modules::asam_cmp_capture_module::TransmitStatistics;
+using namespace testing;
+using namespace std::chrono_literals;
+
+class FramePacerTest : public testing::Test
+{
+protected:
+    using Clock = FramePacer::Clock;
+
+    FramePacerTest()
+        : ethernetWrapper(std::make_shared<daq::asam_cmp_common_lib::EthernetPcppMock>())
+        , queue(ethernetWrapper)
+    {
+        ON_CALL(*ethernetWrapper, sendPacket(_))
+            .WillByDefault(Invoke(
+                [this](const std::vector<uint8_t>& data)
+                {
+                    std::scoped_lock lock{sync};
+                    sent.emplace_back(data.front(), Clock::now());
+                    return true;
+                }));
+        EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+    }
+
+    std::vector<std::pair<uint8_t, Clock::time_point>> waitForFrames(size_t count)
+    {
+        const auto deadline = Clock::now() + 2s;
+        while (Clock::now() < deadline)
+        {
+            {
+                std::scoped_lock lock{sync};
+                if (sent.size() >= count)
+                    break;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+
+        std::scoped_lock lock{sync};
+        return sent;
+    }
+
+protected:
+    std::shared_ptr<daq::asam_cmp_common_lib::EthernetPcppMock> ethernetWrapper;
+    TransmitQueue queue;
+    TransmitStatistics statistics;
+
+    std::mutex sync;
+    std::vector<std::pair<uint8_t, Clock::time_point>> sent;
+};
+
+TEST_F(FramePacerTest, EnqueueDoesNotWaitForDeparture)
+{
+    FramePacer pacer(queue);
+    const auto now = Clock::now();
+
+    pacer.enqueue(TransmitQueue::Lane::analog, {{1}}, {now + 200ms}, statistics);
+    ASSERT_LT(Clock::now() - now, 100ms);
+    ASSERT_EQ(pacer.getQueuedCount(), 1u);
+
+    const auto frames = waitForFrames(1);
+    ASSERT_EQ(frames.size(), 1u);
+    ASSERT_GE(frames[0].second, now + 200ms - TrafficShaper::pacingSlot);
+}
+
+TEST_F(FramePacerTest, SendsInDepartureOrder)
+{
+    FramePacer pacer(queue);
+    const auto now = Clock::now();
+
+    pacer.enqueue(TransmitQueue::Lane::can, {{1}, {2}, {3}}, {now + 40ms, TrafficShaper::dropped, now + 40ms}, statistics);
+    pacer.enqueue(TransmitQueue::Lane::analog, {{4}}, {now + 20ms}, statistics);
+
+    const auto frames = waitForFrames(3);
+    ASSERT_EQ(frames.size(), 3u);
+    ASSERT_EQ(frames[0].first, 4);
+    ASSERT_EQ(frames[1].first, 1);
+    ASSERT_EQ(frames[2].first, 3);
+    ASSERT_GE(frames[1].second, now + 40ms - TrafficShaper::pacingSlot);
+    ASSERT_EQ(pacer.getQueuedCount(), 0u);
+}
+
+TEST_F(FramePacerTest, CancelDiscardsQueuedFrames)
+{
+    FramePacer pacer(queue);
+    TransmitStatistics removedStatistics;
+    const auto now = Clock::now();
+
+    pacer.enqueue(TransmitQueue::Lane::can, {{1}, {2}}, {now + 50ms, now + 60ms}, removedStatistics);
+    pacer.enqueue(TransmitQueue::Lane::can, {{3}}, {now + 70ms}, statistics);
+    pacer.cancel(removedStatistics);
+    ASSERT_EQ(pacer.getQueuedCount(), 1u);
+
+    // The frames of the cancelled statistics were due first
+    const auto frames = waitForFrames(1);
+    ASSERT_EQ(frames.size(), 1u);
+    ASSERT_EQ(frames[0].first, 3);
+}
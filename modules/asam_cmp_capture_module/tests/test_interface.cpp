@@ -27,7 +27,7 @@ class InterfaceFbTest: public testing::Test
         ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
         ON_CALL(*ethernetWrapper, sendPacket(_))
             .WillByDefault(WithArgs<0>(
-                Invoke([&](const std::vector<uint8_t>& data) { this->onPacketSendCb(data); })));
+                Invoke([&](const std::vector<uint8_t>& data) { this->onPacketSendCb(data); return true; })));
 
         auto logger = Logger();
         context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
@@ -0,0 +1,172 @@
+#include <asam_cmp_capture_module/can_data.h>
+#include <asam_cmp_capture_module/capture_fb.h>
+#include <asam_cmp_capture_module/load_generator_fb.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp/decoder.h>
+#include <asam_cmp/can_payload.h>
+
+#include <set>
+#include <thread>
+
+using namespace daq;
+using namespace testing;
+using daq::modules::asam_cmp_capture_module::CANData;
+using daq::modules::asam_cmp_capture_module::LoadGeneratorFb;
+
+namespace
+{
+    bool waitFor(const std::function<bool()>& condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+}
+
+class LoadGeneratorTest : public testing::Test
+{
+protected:
+    LoadGeneratorTest()
+        : ethernetWrapper(std::make_shared<asam_cmp_common_lib::EthernetPcppMock>())
+    {
+        ON_CALL(*ethernetWrapper, getEthernetDevicesNamesList()).WillByDefault(Return(List<IString>()));
+        ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(List<IString>()));
+        ON_CALL(*ethernetWrapper, sendPacket(_))
+            .WillByDefault(Invoke(
+                [this](const std::vector<uint8_t>& data)
+                {
+                    std::scoped_lock lock{decodedSync};
+                    for (const auto& packet : decoder.decode(data.data(), data.size()))
+                        decodedPackets.push_back(packet);
+                    return true;
+                }));
+
+        auto logger = Logger();
+        context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+        generator = createWithImplementation<IFunctionBlock, LoadGeneratorFb>(moduleInfo, context, nullptr, "load_generator");
+    }
+
+    size_t getDecodedCount()
+    {
+        std::scoped_lock lock{decodedSync};
+        return decodedPackets.size();
+    }
+
+protected:
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppMock> ethernetWrapper;
+    StringPtr selectedDevice{"device1"};
+    ContextPtr context;
+    ModuleInfoPtr moduleInfo;
+    FunctionBlockPtr generator;
+
+    std::mutex decodedSync;
+    ASAM::CMP::Decoder decoder;
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> decodedPackets;
+};
+
+TEST_F(LoadGeneratorTest, CanPatternSequentialIds)
+{
+    LoadGeneratorFb::Settings settings;
+    settings.samplesPerPacket = 10;
+    settings.firstArbId = 0x100;
+    settings.arbIdCount = 4;
+    settings.minPayloadSize = 2;
+    settings.maxPayloadSize = 6;
+
+    const auto pattern = LoadGeneratorFb::createPattern(settings, 3);
+    ASSERT_EQ(pattern.size(), 30 * sizeof(CANData));
+
+    const auto* frames = reinterpret_cast<const CANData*>(pattern.data());
+    for (size_t i = 0; i < 30; ++i)
+    {
+        EXPECT_EQ(static_cast<uint32_t>(frames[i].arbId), 0x100u + i % 4);
+        EXPECT_GE(frames[i].length, 2);
+        EXPECT_LE(frames[i].length, 6);
+    }
+}
+
+TEST_F(LoadGeneratorTest, CanFdLengthsAreValid)
+{
+    LoadGeneratorFb::Settings settings;
+    settings.payload = LoadGeneratorFb::Payload::canFd;
+    settings.arbIdDistribution = LoadGeneratorFb::ArbIdDistribution::uniform;
+    settings.firstArbId = 0x10;
+    settings.arbIdCount = 16;
+    settings.minPayloadSize = 9;
+    settings.maxPayloadSize = 64;
+
+    const auto pattern = LoadGeneratorFb::createPattern(settings, 100);
+    const auto* frames = reinterpret_cast<const CANData*>(pattern.data());
+    const std::set<uint8_t> validLengths{12, 16, 20, 24, 32, 48, 64};
+    for (size_t i = 0; i < 100 * settings.samplesPerPacket; ++i)
+    {
+        EXPECT_EQ(validLengths.count(frames[i].length), 1u);
+        EXPECT_GE(static_cast<uint32_t>(frames[i].arbId), 0x10u);
+        EXPECT_LT(static_cast<uint32_t>(frames[i].arbId), 0x20u);
+    }
+}
+
+TEST_F(LoadGeneratorTest, SampleTime)
+{
+    LoadGeneratorFb::Settings settings;
+    settings.messageRate = 3;
+    EXPECT_EQ(LoadGeneratorFb::getSampleTime(settings, 1), 333333u);
+    EXPECT_EQ(LoadGeneratorFb::getSampleTime(settings, 3), 1000000u);
+
+    settings.payload = LoadGeneratorFb::Payload::analog;
+    settings.messageRate = 20000;
+    EXPECT_EQ(LoadGeneratorFb::getSampleTime(settings, 7), 350u);
+}
+
+TEST_F(LoadGeneratorTest, GeneratesAtConfiguredRate)
+{
+    generator.setPropertyValue("MessageRate", 10000);
+    generator.setPropertyValue("SamplesPerPacket", 100);
+    generator.setPropertyValue("Active", true);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    generator.setPropertyValue("Active", false);
+
+    const Int samples = generator.getPropertyValue("GeneratedSamples");
+    EXPECT_GE(samples, 3000);
+    EXPECT_LE(samples, 5100);
+    EXPECT_EQ(static_cast<Int>(generator.getPropertyValue("GeneratedPackets")) * 100, samples);
+}
+
+TEST_F(LoadGeneratorTest, CaptureAcceptsCanAndAnalogSignals)
+{
+    modules::asam_cmp_capture_module::CaptureFbInit init = {ethernetWrapper, selectedDevice};
+    auto captureFb = createWithImplementation<IFunctionBlock, modules::asam_cmp_capture_module::CaptureFb>(
+        moduleInfo, context, nullptr, "capture", init);
+    ProcedurePtr addInterface = captureFb.getPropertyValue("AddInterface");
+    addInterface();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+
+    for (Int payloadType : {0, 2})
+    {
+        generator.setPropertyValue("Active", false);
+        generator.setPropertyValue("PayloadType", payloadType);
+        generator.setPropertyValue("MessageRate", 1000);
+        generator.setPropertyValue("SamplesPerPacket", 10);
+
+        interfaceFb.setPropertyValue("PayloadType", payloadType == 0 ? 1 : 3);
+        ProcedurePtr addStream = interfaceFb.getPropertyValue("AddStream");
+        addStream();
+        auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(interfaceFb.getFunctionBlocks().getCount() - 1);
+        streamFb.getInputPorts().getItemAt(0).connect(generator.getSignals().getItemAt(0));
+
+        const size_t decodedBefore = getDecodedCount();
+        generator.setPropertyValue("Active", true);
+        ASSERT_TRUE(waitFor([&] { return getDecodedCount() > decodedBefore; }));
+        streamFb.getInputPorts().getItemAt(0).disconnect();
+    }
+}
@@ -2,11 +2,16 @@
 #include <asam_cmp_capture_module/capture_fb.h>
 #include <asam_cmp_capture_module/interface_fb.h>
 #include <asam_cmp_capture_module/stream_fb.h>
+#include <coreobjects/unit_factory.h>
 #include <opendaq/context_factory.h>
+#include <opendaq/data_descriptor_factory.h>
 #include <opendaq/module_ptr.h>
+#include <opendaq/packet_factory.h>
 #include <opendaq/scheduler_factory.h>
+#include <opendaq/signal_factory.h>
 #include <gtest/gtest.h>
 
+#include <asam_cmp_common_lib/compact_can_layout.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
 #include <asam_cmp/decoder.h>
 #include <asam_cmp/interface_payload.h>
@@ -33,7 +38,7 @@ protected:
         ON_CALL(*ethernetWrapper, getEthernetDevicesDescriptionsList()).WillByDefault(Return(descriptions));
         ON_CALL(*ethernetWrapper, sendPacket(_))
             .WillByDefault(WithArgs<0>(
-                Invoke([&](const std::vector<uint8_t>& data) { this->onPacketSendCb(data); })));
+                Invoke([&](const std::vector<uint8_t>& data) { this->onPacketSendCb(data); return true; })));
 
         auto logger = Logger();
         context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
@@ -85,6 +90,7 @@ protected:
     }
 
     void testCanPacketWithParameter(bool isCanFd);
+    void testCompactCanInput(bool isCanFd);
 
 protected:
     TimeStub timeStub;
@@ -213,3 +219,233 @@ TEST_F(StreamFbTest, TestCanFdPacketsAreSent)
 {
     testCanPacketWithParameter(true);
 }
+
+TEST_F(StreamFbTest, TransmitStatistics)
+{
+    testCanPacketWithParameter(false);
+
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    ASSERT_GT(static_cast<Int>(streamFb.getPropertyValue("SamplesReceived")), 0);
+    ASSERT_GT(static_cast<Int>(streamFb.getPropertyValue("MessagesEncoded")), 0);
+    ASSERT_GT(static_cast<Int>(streamFb.getPropertyValue("FramesSent")), 0);
+    ASSERT_GT(static_cast<Int>(streamFb.getPropertyValue("BytesSent")), 0);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("SendFailures")), 0);
+    ASSERT_EQ(interfaceFb.getPropertyValue("FramesSent"), streamFb.getPropertyValue("FramesSent"));
+    ASSERT_EQ(interfaceFb.getPropertyValue("BytesSent"), streamFb.getPropertyValue("BytesSent"));
+    ASSERT_THROW(streamFb.setPropertyValue("FramesSent", 0), AccessDeniedException);
+
+    ProcedurePtr resetProc = streamFb.getPropertyValue("ResetStatistics");
+    resetProc();
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("FramesSent")), 0);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("BytesSent")), 0);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("EncodeTimeMax")), 0);
+}
+
+TEST_F(StreamFbTest, CanIdFilter)
+{
+    auto rawFramesCapture = [&](const CANData& data) { rawCanFrameCapture(data, false); };
+    RefCANChannelInit initCanCh{
+        timeStub.getMicroSecondsSinceDeviceStart(), timeStub.getMicroSecondsFromEpochToDeviceStart(), rawFramesCapture};
+    canChannel = createWithImplementation<IChannel, RefCANChannelImpl>(this->context, nullptr, "refcanch", initCanCh);
+
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = interfaceFb.getPropertyValue("AddStream");
+    interfaceFb.setPropertyValue("PayloadType", 1);
+    createProc();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+    // The reference channel sends all frames with ID 12
+    streamFb.setPropertyValue("CanIdFilter", "0x100-0x1FF, invalid");
+    ASSERT_EQ(streamFb.getPropertyValue("CanIdFilter"), "0x100-0x1FF, invalid");
+    streamFb.setPropertyValue("CanIdFilter", "12");
+    streamFb.setPropertyValue("CanIdFilterMode", 1);
+
+    streamFb.getInputPorts().getItemAt(0).connect(canChannel.getSignals().getItemAt(0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    triggerCanChannel(5);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+    while (static_cast<Int>(streamFb.getPropertyValue("SamplesReceived")) < 5 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("SamplesReceived")), 5);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("FilteredCanFrames")), 5);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("MessagesEncoded")), 0);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("FramesSent")), 0);
+}
+
+void StreamFbTest::testCompactCanInput(bool isCanFd)
+{
+    using namespace daq::asam_cmp_common_lib::compact_can;
+
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = interfaceFb.getPropertyValue("AddStream");
+    interfaceFb.setPropertyValue("PayloadType", 1 + isCanFd);
+    createProc();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+
+    const auto timeDescriptor = DataDescriptorBuilder()
+                                    .setSampleType(SampleType::Int64)
+                                    .setUnit(Unit("s", -1, "seconds", "time"))
+                                    .setTickResolution(RefCANChannelImpl::getResolution())
+                                    .setOrigin(RefCANChannelImpl::getEpoch())
+                                    .setName("Time CAN")
+                                    .build();
+    const auto timeSignal = SignalWithDescriptor(context, timeDescriptor, nullptr, "can_time");
+    const auto canSignal =
+        SignalWithDescriptor(context, isCanFd ? createCanFdDescriptor() : createClassicCanDescriptor(), nullptr, "can");
+    canSignal.setDomainSignal(timeSignal);
+
+    streamFb.getInputPorts().getItemAt(0).connect(canSignal);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    resetExpectedFramesCnt();
+    const std::vector<uint8_t> lengths = isCanFd ? std::vector<uint8_t>{12, 3, 64} : std::vector<uint8_t>{8, 3, 1};
+    for (size_t i = 0; i < lengths.size(); ++i)
+    {
+        CANData frame{};
+        frame.arbId = static_cast<uint32_t>(0x100 + i);
+        frame.length = lengths[i];
+        for (uint8_t j = 0; j < frame.length; ++j)
+            frame.data[j] = static_cast<uint8_t>(i * 16 + j);
+        capturedFrames.push_back(frame);
+        ++expectedFramesCnt;
+    }
+
+    const int64_t startTicks = timeStub.getMicroSecondsSinceDeviceStart().count();
+    if (isCanFd)
+    {
+        // All frames are packed into one binary sample
+        size_t sampleSize = sizeof(CanFdHeader);
+        for (const auto& frame : capturedFrames)
+            sampleSize += getCanFdFrameSize(frame.length);
+
+        const auto domainPacket = DataPacket(timeDescriptor, 1, startTicks);
+        *static_cast<int64_t*>(domainPacket.getRawData()) = startTicks;
+        const auto dataPacket = BinaryDataPacket(domainPacket, canSignal.getDescriptor(), sampleSize);
+
+        auto buffer = static_cast<uint8_t*>(dataPacket.getRawData());
+        const CanFdHeader header{static_cast<uint32_t>(capturedFrames.size()), 0};
+        memcpy(buffer, &header, sizeof(header));
+        buffer += sizeof(header);
+        uint64_t timestamp = startTicks;
+        for (const auto& frame : capturedFrames)
+            buffer = writeCanFdFrame(buffer, timestamp++, frame.arbId, frame.data, frame.length);
+
+        canSignal.sendPacket(dataPacket);
+        timeSignal.sendPacket(domainPacket);
+    }
+    else
+    {
+        const auto domainPacket = DataPacket(timeDescriptor, capturedFrames.size(), startTicks);
+        const auto dataPacket = DataPacketWithDomain(domainPacket, canSignal.getDescriptor(), capturedFrames.size());
+
+        auto dataBuffer = static_cast<ClassicCanData*>(dataPacket.getRawData());
+        auto timeBuffer = static_cast<int64_t*>(domainPacket.getRawData());
+        for (size_t i = 0; i < capturedFrames.size(); ++i, ++dataBuffer)
+        {
+            dataBuffer->arbId = capturedFrames[i].arbId;
+            dataBuffer->length = capturedFrames[i].length;
+            memcpy(dataBuffer->data, capturedFrames[i].data, sizeof(dataBuffer->data));
+            *timeBuffer++ = startTicks + static_cast<int64_t>(i);
+        }
+
+        canSignal.sendPacket(dataPacket);
+        timeSignal.sendPacket(domainPacket);
+    }
+
+    int receivedCanFrames = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+    while (receivedCanFrames < expectedFramesCnt && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        std::scoped_lock lock{packedReceivedSync};
+        while (!receivedPackets.empty() && receivedCanFrames < expectedFramesCnt)
+        {
+            auto packet = *(receivedPackets.front());
+            receivedPackets.pop();
+
+            ASSERT_EQ(packet.getPayload().getType(), isCanFd ? ASAM::CMP::PayloadType::canFd : ASAM::CMP::PayloadType::can);
+            auto& payload = static_cast<ASAM::CMP::CanPayload&>(packet.getPayload());
+            const CANData& referenceCanFrame = capturedFrames[receivedCanFrames++];
+            ASSERT_EQ(payload.getId(), referenceCanFrame.arbId);
+            ASSERT_EQ(payload.getDataLength(), referenceCanFrame.length);
+            ASSERT_EQ(memcmp(payload.getData(), referenceCanFrame.data, referenceCanFrame.length), 0);
+        }
+    }
+
+    ASSERT_EQ(receivedCanFrames, expectedFramesCnt);
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("SamplesReceived")), expectedFramesCnt);
+}
+
+TEST_F(StreamFbTest, CompactClassicCanInput)
+{
+    testCompactCanInput(false);
+}
+
+TEST_F(StreamFbTest, CompactCanFdInput)
+{
+    testCompactCanInput(true);
+}
+
+TEST_F(StreamFbTest, CanMinIntervalReleasesLastFrameWithoutTraffic)
+{
+    using namespace daq::asam_cmp_common_lib::compact_can;
+
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(AtLeast(0));
+
+    ProcedurePtr createProc = interfaceFb.getPropertyValue("AddStream");
+    interfaceFb.setPropertyValue("PayloadType", 1);
+    createProc();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    streamFb.setPropertyValue("CanMinIntervals", "0x100:100");
+
+    const auto timeDescriptor = DataDescriptorBuilder()
+                                    .setSampleType(SampleType::Int64)
+                                    .setUnit(Unit("s", -1, "seconds", "time"))
+                                    .setTickResolution(RefCANChannelImpl::getResolution())
+                                    .setOrigin(RefCANChannelImpl::getEpoch())
+                                    .setName("Time CAN")
+                                    .build();
+    const auto timeSignal = SignalWithDescriptor(context, timeDescriptor, nullptr, "can_time");
+    const auto canSignal = SignalWithDescriptor(context, createClassicCanDescriptor(), nullptr, "can");
+    canSignal.setDomainSignal(timeSignal);
+
+    streamFb.getInputPorts().getItemAt(0).connect(canSignal);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // The first frame is sent, the second is replaced by the third, which is the last one of the stream
+    constexpr size_t frameCount = 3;
+    const int64_t startTicks = timeStub.getMicroSecondsSinceDeviceStart().count();
+    const auto domainPacket = DataPacket(timeDescriptor, frameCount, startTicks);
+    const auto dataPacket = DataPacketWithDomain(domainPacket, canSignal.getDescriptor(), frameCount);
+    auto dataBuffer = static_cast<ClassicCanData*>(dataPacket.getRawData());
+    auto timeBuffer = static_cast<int64_t*>(domainPacket.getRawData());
+    for (size_t i = 0; i < frameCount; ++i, ++dataBuffer)
+    {
+        *dataBuffer = ClassicCanData{0x100, 1, {static_cast<uint8_t>(i + 1)}};
+        *timeBuffer++ = startTicks + static_cast<int64_t>(i) * 1000;
+    }
+
+    const auto sendTime = std::chrono::steady_clock::now();
+    canSignal.sendPacket(dataPacket);
+    timeSignal.sendPacket(domainPacket);
+
+    std::vector<uint8_t> values;
+    const auto deadline = sendTime + std::chrono::milliseconds(2500);
+    while (values.size() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        std::scoped_lock lock{packedReceivedSync};
+        for (; !receivedPackets.empty(); receivedPackets.pop())
+            values.push_back(static_cast<ASAM::CMP::CanPayload&>(receivedPackets.front()->getPayload()).getData()[0]);
+    }
+
+    ASSERT_EQ(values, (std::vector<uint8_t>{1, 3}));
+    ASSERT_GE(std::chrono::steady_clock::now() - sendTime, std::chrono::milliseconds(90));
+    ASSERT_EQ(static_cast<Int>(streamFb.getPropertyValue("ThrottledCanFrames")), 1);
+}
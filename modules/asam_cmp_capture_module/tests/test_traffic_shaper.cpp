@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/traffic_shaper.h>
+
+#include <vector>
+
+using daq::modules::asam_cmp_capture_module::TokenBucket;
+using daq::modules::asam_cmp_capture_module::TrafficShaper;
+using namespace std::chrono_literals;
+
+namespace
+{
+    const TokenBucket::Clock::time_point start = TokenBucket::Clock::time_point{} + 1h;
+
+    // Wire size of a frame of 1462 bytes
+    constexpr size_t wireFrameSize = 1500;
+    const std::vector<std::vector<uint8_t>> frames(10, std::vector<uint8_t>(wireFrameSize - 38));
+}
+
+TEST(TrafficShaperTest, TokenBucket)
+{
+    TokenBucket bucket;
+    EXPECT_FALSE(bucket.isLimited());
+    EXPECT_EQ(bucket.getDeparture(1'000'000, start), start);
+
+    // 8 Mbit/s sends one byte per microsecond, the burst lets two frames through at once
+    bucket.setRate(8e6, 2 * wireFrameSize);
+    ASSERT_TRUE(bucket.isLimited());
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(bucket.getDeparture(wireFrameSize, start), start);
+        bucket.consume(wireFrameSize, start);
+    }
+
+    ASSERT_EQ(bucket.getDeparture(wireFrameSize, start), start + 1500us);
+    bucket.consume(wireFrameSize, start + 1500us);
+    ASSERT_EQ(bucket.getDeparture(wireFrameSize, start + 1500us), start + 3000us);
+
+    // An idle bucket refills up to the burst size only
+    ASSERT_EQ(bucket.getDeparture(wireFrameSize, start + 1s), start + 1s);
+    bucket.consume(wireFrameSize, start + 1s);
+    bucket.consume(wireFrameSize, start + 1s);
+    ASSERT_EQ(bucket.getDeparture(wireFrameSize, start + 1s), start + 1s + 1500us);
+
+    bucket.setRate(0, 0);
+    EXPECT_EQ(bucket.getDeparture(wireFrameSize, start), start);
+}
+
+TEST(TrafficShaperTest, WireSize)
+{
+    EXPECT_EQ(TrafficShaper::getWireSize(1462), 1500u);
+    EXPECT_EQ(TrafficShaper::getWireSize(20), 84u);
+}
+
+TEST(TrafficShaperTest, PacesFrames)
+{
+    TrafficShaper shaper;
+    TokenBucket interfaceBucket;
+    EXPECT_FALSE(shaper.isLimited(interfaceBucket));
+
+    shaper.setRate(interfaceBucket, 8e6, wireFrameSize);
+    ASSERT_TRUE(shaper.isLimited(interfaceBucket));
+
+    std::vector<TrafficShaper::Clock::time_point> departures;
+    shaper.schedule(interfaceBucket, frames, start, departures);
+    ASSERT_EQ(departures.size(), frames.size());
+    for (size_t i = 0; i < departures.size(); ++i)
+        ASSERT_EQ(departures[i], start + i * 1500us);
+}
+
+TEST(TrafficShaperTest, SlowestBucketWins)
+{
+    TrafficShaper shaper;
+    TokenBucket interfaceBucket;
+    shaper.setRate(interfaceBucket, 80e6, wireFrameSize);
+    shaper.setRate(shaper.getAdapterBucket(), 8e6, wireFrameSize);
+
+    std::vector<TrafficShaper::Clock::time_point> departures;
+    shaper.schedule(interfaceBucket, frames, start, departures);
+    for (size_t i = 0; i < departures.size(); ++i)
+        ASSERT_EQ(departures[i], start + i * 1500us);
+
+    // The adapter bucket is shared by the interfaces
+    TokenBucket otherInterfaceBucket;
+    shaper.schedule(otherInterfaceBucket, {frames.front()}, start, departures);
+    ASSERT_EQ(departures.front(), start + frames.size() * 1500us);
+}
+
+TEST(TrafficShaperTest, DropsFramesOverMaxLatency)
+{
+    TrafficShaper shaper;
+    TokenBucket interfaceBucket;
+    shaper.setRate(interfaceBucket, 8e6, wireFrameSize);
+    shaper.setMaxLatency(5ms);
+
+    std::vector<TrafficShaper::Clock::time_point> departures;
+    shaper.schedule(interfaceBucket, frames, start, departures);
+    for (size_t i = 0; i < departures.size(); ++i)
+    {
+        if (i * 1500us <= 5ms)
+            ASSERT_EQ(departures[i], start + i * 1500us);
+        else
+            ASSERT_EQ(departures[i], TrafficShaper::dropped);
+    }
+
+    // Dropped frames took no tokens
+    shaper.schedule(interfaceBucket, {frames.front()}, start + 6ms, departures);
+    ASSERT_EQ(departures.front(), start + 6ms);
+}
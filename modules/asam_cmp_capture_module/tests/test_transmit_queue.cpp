@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_capture_module/transmit_queue.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using daq::modules::asam_cmp_capture_module::TransmitQueue;
+using namespace testing;
+
+// Records the batches handed to the adapter, their frames go through sendPacket()
+class BatchRecordingMock : public daq::asam_cmp_common_lib::EthernetPcppMock
+{
+public:
+    size_t sendPackets(const std::vector<std::vector<uint8_t>>& frames) override
+    {
+        {
+            std::scoped_lock lock{sync};
+            batchSizes.push_back(frames.size());
+        }
+        return EthernetPcppMock::sendPackets(frames);
+    }
+
+    std::vector<size_t> getBatchSizes()
+    {
+        std::scoped_lock lock{sync};
+        return batchSizes;
+    }
+
+private:
+    std::mutex sync;
+    std::vector<size_t> batchSizes;
+};
+
+class TransmitQueueTest : public testing::Test
+{
+protected:
+    using Lane = TransmitQueue::Lane;
+
+    TransmitQueueTest()
+        : ethernetWrapper(std::make_shared<BatchRecordingMock>())
+        , queue(ethernetWrapper)
+    {
+        ON_CALL(*ethernetWrapper, sendPacket(_))
+            .WillByDefault(Invoke(
+                [this](const std::vector<uint8_t>& data)
+                {
+                    if (data.front() == holdFrame)
+                    {
+                        holding.set_value();
+                        hold.wait();
+                    }
+                    std::scoped_lock lock{sync};
+                    sent.push_back(data.front());
+                    return true;
+                }));
+    }
+
+    // Sends a frame that keeps the adapter busy until release()
+    void holdAdapter(Lane lane)
+    {
+        threads.emplace_back([this, lane] { queue.send(lane, std::vector<uint8_t>{holdFrame}); });
+        holding.get_future().wait();
+    }
+
+    void sendWhenBusy(Lane lane, uint8_t frame)
+    {
+        const size_t waiting = queue.getWaitingCount(lane);
+        threads.emplace_back([this, lane, frame] { queue.send(lane, std::vector<uint8_t>{frame}); });
+        while (queue.getWaitingCount(lane) == waiting)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<uint8_t> releaseAndJoin()
+    {
+        release.set_value();
+        for (auto& thread : threads)
+            thread.join();
+        return sent;
+    }
+
+protected:
+    static constexpr uint8_t holdFrame = 0;
+
+    std::shared_ptr<BatchRecordingMock> ethernetWrapper;
+    TransmitQueue queue;
+
+    std::promise<void> holding;
+    std::promise<void> release;
+    std::shared_future<void> hold{release.get_future().share()};
+    std::mutex sync;
+    std::vector<uint8_t> sent;
+    std::vector<std::thread> threads;
+};
+
+TEST_F(TransmitQueueTest, StrictPriority)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(4);
+
+    holdAdapter(Lane::can);
+    sendWhenBusy(Lane::can, 3);
+    sendWhenBusy(Lane::analog, 2);
+    sendWhenBusy(Lane::status, 1);
+
+    ASSERT_EQ(releaseAndJoin(), (std::vector<uint8_t>{holdFrame, 1, 2, 3}));
+}
+
+TEST_F(TransmitQueueTest, WeightedScheduling)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(5);
+    queue.setScheduling(TransmitQueue::Scheduling::weighted, 1);
+
+    // CAN gets a turn after every analog grant, status still goes first
+    holdAdapter(Lane::status);
+    sendWhenBusy(Lane::analog, 2);
+    sendWhenBusy(Lane::analog, 2);
+    sendWhenBusy(Lane::can, 3);
+    sendWhenBusy(Lane::status, 1);
+
+    ASSERT_EQ(releaseAndJoin(), (std::vector<uint8_t>{holdFrame, 1, 2, 3, 2}));
+}
+
+TEST_F(TransmitQueueTest, WeightedSchedulingCountsBatchFrames)
+{
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(7);
+    queue.setScheduling(TransmitQueue::Scheduling::weighted, 2);
+
+    // The analog batch gets two frames per CAN frame while CAN waits
+    holdAdapter(Lane::status);
+    const size_t waiting = queue.getWaitingCount(Lane::analog);
+    threads.emplace_back([this] { queue.send(Lane::analog, std::vector<std::vector<uint8_t>>(4, std::vector<uint8_t>{2})); });
+    while (queue.getWaitingCount(Lane::analog) == waiting)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    sendWhenBusy(Lane::can, 3);
+    sendWhenBusy(Lane::can, 3);
+
+    ASSERT_EQ(releaseAndJoin(), (std::vector<uint8_t>{holdFrame, 2, 2, 3, 2, 2, 3}));
+    ASSERT_EQ(ethernetWrapper->getBatchSizes(), (std::vector<size_t>{2, 2}));
+}
+
+TEST_F(TransmitQueueTest, VlanTagging)
+{
+    queue.setVlanTagging(true, 10, {6, 5, 0});
+
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).Times(0);
+    EXPECT_CALL(*ethernetWrapper,
+                sendTaggedPacket(_, AllOf(Field(&daq::asam_cmp_common_lib::VlanTag::vlanId, 10),
+                                          Field(&daq::asam_cmp_common_lib::VlanTag::priority, 5))))
+        .Times(2)
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(queue.send(Lane::analog, std::vector<uint8_t>{1}));
+    ASSERT_EQ(queue.send(Lane::analog, std::vector<std::vector<uint8_t>>{{1}}), 1u);
+
+    queue.setVlanTagging(false, 10, {6, 5, 0});
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_)).WillOnce(Return(true));
+    ASSERT_TRUE(queue.send(Lane::analog, std::vector<uint8_t>{1}));
+}
+
+TEST_F(TransmitQueueTest, StatusLatencyDuringBatch)
+{
+    constexpr uint8_t dataFrame = 2, statusFrame = 1;
+    constexpr size_t batchSize = 200;
+    constexpr auto frameTime = std::chrono::milliseconds(1);
+
+    EXPECT_CALL(*ethernetWrapper, sendPacket(_))
+        .Times(batchSize + 1)
+        .WillRepeatedly(Invoke(
+            [this, frameTime](const std::vector<uint8_t>& data)
+            {
+                std::this_thread::sleep_for(frameTime);
+                std::scoped_lock lock{sync};
+                sent.push_back(data.front());
+                return true;
+            }));
+
+    const std::vector<std::vector<uint8_t>> batch(batchSize, std::vector<uint8_t>{dataFrame});
+    constexpr size_t runs = (batchSize + TransmitQueue::maxBatchRun - 1) / TransmitQueue::maxBatchRun;
+    std::thread batchThread([this, &batch] { ASSERT_EQ(queue.send(Lane::can, batch), batch.size()); });
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::scoped_lock lock{sync};
+        if (sent.size() >= 10)
+            break;
+    }
+
+    // The status frame waits for the run in progress, not for the rest of the batch
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(queue.send(Lane::status, std::vector<uint8_t>{statusFrame}));
+    const auto latency = std::chrono::steady_clock::now() - start;
+    batchThread.join();
+
+    ASSERT_LT(latency, (TransmitQueue::maxBatchRun + 10) * frameTime);
+    const auto statusPosition = static_cast<size_t>(std::find(sent.begin(), sent.end(), statusFrame) - sent.begin());
+    ASSERT_EQ(statusPosition, TransmitQueue::maxBatchRun);
+    ASSERT_EQ(sent.size(), batchSize + 1);
+
+    // The runs of the batch reach the adapter as batches
+    const auto batchSizes = ethernetWrapper->getBatchSizes();
+    ASSERT_EQ(batchSizes.size(), runs);
+    ASSERT_EQ(batchSizes.front(), TransmitQueue::maxBatchRun);
+    ASSERT_EQ(batchSizes.back(), batchSize - (runs - 1) * TransmitQueue::maxBatchRun);
+}
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_data_sink/sequence_counter_tracker.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
@@ -27,6 +28,7 @@ DECLARE_OPENDAQ_INTERFACE(IAsamCmpPacketsSubscriber, IBaseObject)
 {
     virtual void receive(const std::shared_ptr<ASAM::CMP::Packet>& packet) = 0;
     virtual void receive(const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& packets) = 0;
+    virtual void receive(const SequenceCounterStatistics& statistics) = 0;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
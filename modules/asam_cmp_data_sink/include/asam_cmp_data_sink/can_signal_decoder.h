@@ -0,0 +1,144 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <asam_cmp_common_lib/can_id_map.h>
+#include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_data_sink/dbc_file.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Decodes CAN frames into physical signal values. Each DBC signal is compiled into an extraction plan (byte
+// offset, shift, mask, byte order, sign bit, scale and offset) stored as structure of arrays, so decoding a
+// frame is a table lookup of its message followed by a loop over the plans of its signals.
+//
+// Signals are ordered into groups that are present in the same frames: the non-multiplexed signals of a
+// message (including its multiplexor) and, for every multiplexor value, the signals multiplexed by it.
+class CanSignalDecoder final
+{
+public:
+    static constexpr size_t maxFrameLength = 64;
+
+    struct Group
+    {
+        size_t message;
+        size_t firstSignal;
+        size_t signalCount;
+        bool multiplexed;
+        uint32_t multiplexValue;
+        // Minimal frame length covering all signals of the group, shorter frames are not decoded
+        size_t requiredLength;
+    };
+
+public:
+    explicit CanSignalDecoder(const std::vector<DbcFile::Message>& messages);
+
+    const std::vector<DbcFile::Message>& getMessages() const noexcept;
+    const std::vector<Group>& getGroups() const noexcept;
+    size_t getSignalCount() const noexcept;
+    // Definition of a signal by its index in the decoder
+    const DbcFile::Signal& getSignal(size_t signal) const;
+
+    // Decodes a frame and calls onGroup(groupIndex, const double* values) for each decoded group, values holds
+    // the physical values of the group signals. Returns false if the ID is not in the database.
+    template <typename OnGroup>
+    bool decode(uint32_t arbId, const uint8_t* data, size_t length, OnGroup&& onGroup);
+
+private:
+    struct MessagePlan
+    {
+        size_t mainGroup;
+        // Index of the multiplexor in the signal arrays, or notFound
+        size_t multiplexor;
+        // Groups of the multiplexed signals
+        std::vector<size_t> multiplexedGroups;
+    };
+
+    static constexpr size_t notFound = asam_cmp_common_lib::CanIdMap::notFound;
+
+    void addSignal(size_t message, size_t signal, Group& group);
+    void decodeGroup(const Group& group, const uint8_t* frame, double* values);
+    uint64_t extractRaw(size_t signal, const uint8_t* frame) const;
+
+private:
+    std::vector<DbcFile::Message> messages;
+    std::vector<MessagePlan> messagePlans;
+    std::vector<Group> groups;
+    asam_cmp_common_lib::CanIdMap messageIds;
+
+    // Extraction plans, one entry per signal
+    std::vector<size_t> signalMessages;
+    std::vector<size_t> signalIndices;
+    std::vector<uint8_t> byteOffsets;
+    std::vector<uint8_t> shifts;
+    std::vector<uint8_t> lengths;
+    std::vector<uint8_t> bigEndian;
+    std::vector<uint8_t> valueTypes;
+    std::vector<uint64_t> masks;
+    // Zero for unsigned signals
+    std::vector<uint64_t> signBits;
+    std::vector<double> scales;
+    std::vector<double> offsets;
+    std::vector<uint8_t> requiredLengths;
+
+    std::vector<double> values;
+    uint8_t frameBuffer[maxFrameLength + 8]{};
+};
+
+template <typename OnGroup>
+bool CanSignalDecoder::decode(uint32_t arbId, const uint8_t* data, size_t length, OnGroup&& onGroup)
+{
+    // CAN samples carry no IDE flag, so standard and extended messages share one ID space
+    const size_t message = messageIds.find(arbId);
+    if (message == notFound)
+        return false;
+
+    if (length > maxFrameLength)
+        length = maxFrameLength;
+    memcpy(frameBuffer, data, length);
+    memset(frameBuffer + length, 0, sizeof(frameBuffer) - length);
+
+    const auto& plan = messagePlans[message];
+    const auto& mainGroup = groups[plan.mainGroup];
+    if (length >= mainGroup.requiredLength && mainGroup.signalCount != 0)
+    {
+        decodeGroup(mainGroup, frameBuffer, values.data() + mainGroup.firstSignal);
+        onGroup(plan.mainGroup, values.data() + mainGroup.firstSignal);
+    }
+
+    if (plan.multiplexor != notFound && length >= requiredLengths[plan.multiplexor])
+    {
+        const auto multiplexValue = extractRaw(plan.multiplexor, frameBuffer);
+        for (const auto groupIndex : plan.multiplexedGroups)
+        {
+            const auto& group = groups[groupIndex];
+            if (group.multiplexValue != multiplexValue || length < group.requiredLength)
+                continue;
+
+            decodeGroup(group, frameBuffer, values.data() + group.firstSignal);
+            onGroup(groupIndex, values.data() + group.firstSignal);
+        }
+    }
+
+    return true;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -48,6 +48,7 @@ public:
     // IAsamCmpPacketsSubscriber
     void receive(const std::shared_ptr<ASAM::CMP::Packet>& packet) override;
     void receive(const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& packets) override{};
+    void receive(const SequenceCounterStatistics& statistics) override{};
 
 protected:
     void updateDeviceIdInternal() override;
@@ -22,6 +22,9 @@
 #include <asam_cmp_data_sink/capture_packets_publisher.h>
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/pcap_replay.h>
+#include <asam_cmp_data_sink/receive_telemetry.h>
+#include <asam_cmp_data_sink/sequence_counter_tracker.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
@@ -41,16 +44,24 @@ public:
 
 private:
     void createFbs();
+    void initReplayProperties();
     void startCapture();
     void stopCapture();
+    void startReplay();
+    void stopReplay();
     void onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie);
     std::vector<std::shared_ptr<ASAM::CMP::Packet>> decode(pcpp::RawPacket* packet);
+    void publish(const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& acPackets);
+    void checkSequenceCounter(const uint8_t* data, size_t size);
 
     void networkAdapterChangedInternal() override;
 
 private:
     bool captureStartedOnThisFb;
     ASAM::CMP::Decoder decoder;
+    SequenceCounterTracker sequenceCounterTracker;
+    std::shared_ptr<ReceiveTelemetry> telemetry;
+    PcapReplay replay;
 
     DataPacketsPublisher dataPacketsPublisher;
     CapturePacketsPublisher capturePacketsPublisher;
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_data_sink/can_signal_decoder.h>
+#include <asam_cmp_data_sink/common.h>
+#include <opendaq/function_block_impl.h>
+#include <opendaq/signal_config_ptr.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Decodes the CAN signal of a Stream FB into physical values of the signals defined in a DBC file. Every
+// message gets a domain signal and a Float64 value signal per DBC signal; multiplexed signals get a domain
+// signal per multiplexor value. The frames of an input packet are decoded in one pass and every output
+// receives at most one packet per input packet.
+class DbcDecoderFb final : public FunctionBlock
+{
+public:
+    explicit DbcDecoderFb(const ModuleInfoPtr& moduleInfo, const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+    ~DbcDecoderFb() override = default;
+
+    static FunctionBlockTypePtr CreateType(const ModuleInfoPtr& moduleInfo);
+
+    // Throws if the file can't be read or parsed, the current database is kept in that case.
+    // An empty file name removes the database and its signals.
+    void loadDbc(const std::string& fileName);
+
+private:
+    enum class InputLayout
+    {
+        invalid,
+        canData,
+        classicCanData,
+        compactCanFd
+    };
+
+    // Domain signal of a decoder group and the values collected for it from the current input packet
+    struct GroupOutput
+    {
+        SignalConfigPtr domainSignal;
+        std::vector<uint64_t> timestamps;
+    };
+
+    void initProperties();
+    void updateDbcFileInternal();
+    void removeOutputSignals();
+    void createOutputSignals();
+    DataDescriptorPtr createDomainDescriptor() const;
+
+    void onPacketReceived(const InputPortPtr& port) override;
+    void processEventPacket(const EventPacketPtr& packet);
+    void processDataPacket(const DataPacketPtr& packet);
+    template <typename CanSample>
+    void decodeStructSamples(const DataPacketPtr& packet);
+    void decodeCanFdCompactSamples(const DataPacketPtr& packet);
+    void decodeFrame(uint32_t arbId, const uint8_t* data, size_t length, uint64_t timestamp);
+    void sendOutputPackets();
+
+    static InputLayout getInputLayout(const DataDescriptorPtr& descriptor);
+
+private:
+    InputPortPtr inputPort;
+    InputLayout inputLayout{InputLayout::invalid};
+    DataDescriptorPtr inputDomainDescriptor;
+
+    std::unique_ptr<CanSignalDecoder> decoder;
+    std::vector<GroupOutput> groupOutputs;
+    // Indexed by the signal index of the decoder
+    std::vector<SignalConfigPtr> valueSignals;
+    std::vector<std::vector<double>> signalValues;
+
+    std::atomic<int64_t> decodedFrames{0};
+    std::atomic<int64_t> unknownFrames{0};
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
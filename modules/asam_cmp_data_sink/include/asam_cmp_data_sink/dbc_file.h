@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Message and signal definitions of a DBC file. Only BO_, SG_ and SIG_VALTYPE_ entries are read, other
+// sections (comments, attributes, value tables) are skipped.
+class DbcFile final
+{
+public:
+    enum class ValueType
+    {
+        integer,
+        float32,
+        float64
+    };
+
+    enum class Multiplex
+    {
+        none,
+        // Selects which multiplexed signals of the message are present
+        multiplexor,
+        // Present when the multiplexor has the value multiplexValue
+        multiplexed
+    };
+
+    struct Signal
+    {
+        std::string name;
+        // Intel (little endian) signals: position of the least significant bit, Motorola (big endian) signals:
+        // position of the most significant bit, both in DBC bit numbering
+        uint32_t startBit{0};
+        uint32_t length{0};
+        bool bigEndian{false};
+        bool isSigned{false};
+        ValueType valueType{ValueType::integer};
+        double scale{1.0};
+        double offset{0.0};
+        double minimum{0.0};
+        double maximum{0.0};
+        std::string unit;
+        Multiplex multiplex{Multiplex::none};
+        uint32_t multiplexValue{0};
+    };
+
+    struct Message
+    {
+        // Without the extended frame flag
+        uint32_t id{0};
+        bool extended{false};
+        std::string name;
+        uint32_t size{0};
+        std::vector<Signal> dbcSignals;
+    };
+
+public:
+    // Throws std::runtime_error if the file can't be read or a BO_ or SG_ entry is malformed
+    explicit DbcFile(const std::string& fileName);
+
+    static std::vector<Message> parse(std::string_view content);
+
+    const std::vector<Message>& getMessages() const noexcept;
+
+private:
+    std::vector<Message> messages;
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
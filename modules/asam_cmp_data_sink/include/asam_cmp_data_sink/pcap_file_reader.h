@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_common_lib/mapped_file.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Reads frames of a .pcap or .pcapng file. The file is memory mapped and frames point into the mapping,
+// so reading does not allocate. A truncated or malformed record ends the file.
+class PcapFileReader final
+{
+public:
+    struct Frame
+    {
+        const uint8_t* data;
+        uint32_t length;
+        // Nanoseconds since epoch
+        uint64_t timestamp;
+        uint16_t linkType;
+        // Position of the record in the file
+        uint64_t offset;
+    };
+
+public:
+    explicit PcapFileReader(const std::string& fileName);
+
+    // Returns false at the end of the file
+    bool next(Frame& frame);
+    // Reads the first frame at or after the record at the given offset, as reported in Frame::offset
+    bool readAt(uint64_t offset, Frame& frame);
+    void rewind();
+
+    bool isPcapNg() const noexcept;
+    uint64_t getFileSize() const noexcept;
+
+private:
+    struct Interface
+    {
+        uint16_t linkType;
+        uint32_t snapLength;
+        // Timestamp units per second as a power of ten or, if binary, a power of two
+        uint8_t resolutionExponent;
+        bool binaryResolution;
+    };
+
+    void readFileHeader();
+    void readInterfaceDescriptions();
+    bool nextPcap(Frame& frame);
+    bool nextPcapNg(Frame& frame);
+    bool readSectionHeader(size_t blockPosition);
+    void readInterfaceDescription(size_t blockLength);
+
+    uint16_t read16(size_t position) const noexcept;
+    uint32_t read32(size_t position) const noexcept;
+    uint64_t toNanoseconds(const Interface& itf, uint64_t timestamp) const noexcept;
+
+private:
+    const asam_cmp_common_lib::MappedFile file;
+    const uint8_t* const data;
+    const size_t size;
+
+    bool pcapNg{false};
+    bool swapped{false};
+    size_t position{0};
+    size_t firstRecord{0};
+
+    // Classic pcap
+    Interface pcapInterface{};
+
+    // pcapng section state
+    std::vector<Interface> interfaces;
+    uint64_t lastTimestamp{0};
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <asam_cmp_common_lib/pcap_index_format.h>
+#include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_common_lib/mapped_file.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Timestamp index of a recorded pcapng file, see asam_cmp_common_lib::pcap_index
+class PcapIndex final
+{
+public:
+    using Entry = asam_cmp_common_lib::pcap_index::Entry;
+
+public:
+    // Throws if the file can't be opened or is not an index file
+    explicit PcapIndex(const std::string& fileName);
+
+    // Index of the capture file, nullptr if it doesn't exist or is not valid
+    static std::unique_ptr<PcapIndex> openFor(const std::string& captureFileName);
+
+    size_t getCount() const noexcept;
+    Entry getEntry(size_t index) const noexcept;
+    // Position of the first entry with a timestamp not less than the given one, getCount() if there is none
+    size_t lowerBound(uint64_t timestamp) const noexcept;
+
+private:
+    asam_cmp_common_lib::MappedFile file;
+    const uint8_t* entries;
+    size_t count;
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
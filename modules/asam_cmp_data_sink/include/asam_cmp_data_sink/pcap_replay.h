@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/pcap_file_reader.h>
+#include <asam_cmp_data_sink/pcap_index.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Replays ASAM CMP frames of a .pcap or .pcapng file on a background thread through the same callback
+// as live capture. Frames that are not Ethernet frames with the ASAM CMP EtherType are skipped.
+// If the recorder wrote an index next to the file, the start of the time window and the frames of the
+// selected endpoints are found through the index instead of reading the file from the beginning.
+class PcapReplay final
+{
+public:
+    enum class Mode
+    {
+        AsFastAsPossible,
+        OriginalTiming
+    };
+
+    struct Options
+    {
+        Mode mode{Mode::AsFastAsPossible};
+        double speed{1.0};
+        // Time window relative to the first frame of the file, zero duration replays up to the end
+        std::chrono::nanoseconds startOffset{0};
+        std::chrono::nanoseconds duration{0};
+        // Empty replays all frames, otherwise Data Messages of these endpoints and other messages of their devices
+        std::vector<Endpoint> endpoints;
+    };
+
+public:
+    ~PcapReplay();
+
+    // Throws if the file can't be opened or is not a pcap or pcapng file
+    void start(const std::string& fileName, const Options& options, asam_cmp_common_lib::PcppPacketReceivedCallbackType packetReceivedCb);
+    void stop();
+
+    bool isRunning() const noexcept;
+    bool isIndexed() const noexcept;
+    uint64_t getReplayedFrames() const noexcept;
+    uint64_t getSkippedFrames() const noexcept;
+
+private:
+    struct Pacing
+    {
+        bool started{false};
+        uint64_t firstTimestamp{0};
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+    void replayLoop();
+    void replayIndexed();
+    void replaySequential();
+    bool deliver(const PcapFileReader::Frame& frame, Pacing& pacing);
+    bool matchesEndpoints(const PcapIndex::Entry& entry) const noexcept;
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+private:
+    Options options;
+    std::unique_ptr<PcapFileReader> reader;
+    std::unique_ptr<PcapIndex> index;
+    asam_cmp_common_lib::PcppPacketReceivedCallbackType callback;
+    std::thread replayThread;
+
+    // Set under stopSync so that a timed wait can't miss it, read without the lock between frames
+    std::mutex stopSync;
+    std::condition_variable stopCv;
+    std::atomic<bool> stopRequested{false};
+
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> replayedFrames{0};
+    std::atomic<uint64_t> skippedFrames{0};
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
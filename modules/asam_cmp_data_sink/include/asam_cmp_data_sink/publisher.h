@@ -22,6 +22,7 @@
 
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/asam_cmp_packets_subscriber.h>
+#include <asam_cmp_common_lib/trace.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
@@ -52,6 +53,7 @@ public:
 
     void publish(const Topic& topic, const std::shared_ptr<ASAM::CMP::Packet>& packet)
     {
+        ASAM_CMP_TRACE_SCOPE("sink::Publisher::publish");
         std::scoped_lock lock(subscribersMt);
 
         auto range = subscribers.equal_range(topic);
@@ -63,6 +65,7 @@ public:
 
     void publish(const Topic& topic, const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& packets)
     {
+        ASAM_CMP_TRACE_SCOPE("sink::Publisher::publish");
         std::scoped_lock lock(subscribersMt);
 
         auto range = subscribers.equal_range(topic);
@@ -72,6 +75,18 @@ public:
         }
     }
 
+    void publish(const Topic& topic, const SequenceCounterStatistics& statistics)
+    {
+        ASAM_CMP_TRACE_SCOPE("sink::Publisher::publish");
+        std::scoped_lock lock(subscribersMt);
+
+        auto range = subscribers.equal_range(topic);
+        for (auto& it = range.first; it != range.second; ++it)
+        {
+            it->second->receive(statistics);
+        }
+    }
+
     size_t size() const
     {
         std::scoped_lock lock(subscribersMt);
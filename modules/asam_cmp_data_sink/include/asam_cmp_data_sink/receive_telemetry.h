@@ -0,0 +1,49 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <memory>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_common_lib/latency_histogram.h>
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+// Counters of the receive path. Written by the capture thread with relaxed atomics and read by the Status FB.
+class ReceiveTelemetry final
+{
+public:
+    explicit ReceiveTelemetry(const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper = nullptr);
+
+    asam_cmp_common_lib::CaptureStatistics getCaptureStatistics() const;
+
+public:
+    std::atomic<uint64_t> framesReceived{0};
+    std::atomic<uint64_t> bytesReceived{0};
+    std::atomic<uint64_t> messagesDecoded{0};
+    std::atomic<uint64_t> decodeErrors{0};
+    std::atomic<uint64_t> unsupportedMessages{0};
+
+    asam_cmp_common_lib::LatencyHistogram decodeTime;
+    asam_cmp_common_lib::LatencyHistogram publishTime;
+
+private:
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ethernetWrapper;
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <asam_cmp_data_sink/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+struct SequenceCounterStatistics
+{
+    // Lost can be negative when a message counted as lost arrives late
+    int64_t lost{0};
+    int64_t duplicate{0};
+    int64_t outOfOrder{0};
+
+    bool empty() const
+    {
+        return lost == 0 && duplicate == 0 && outOfOrder == 0;
+    }
+};
+
+// Sequence counters are assigned by the sender per device ID and stream ID of the CMP header.
+// A message behind the last counter is out of order only if it fills a gap recorded within the reorder window,
+// a larger backward jump or a run of unexplained backward steps (e.g. a restarted sender) resynchronizes the stream.
+class SequenceCounterTracker final
+{
+public:
+    static constexpr uint16_t reorderWindow = 64;
+    static constexpr uint8_t resyncBackwardSteps = 4;
+
+    SequenceCounterStatistics update(uint16_t deviceId, uint8_t streamId, uint16_t sequenceCounter);
+    void reset();
+
+private:
+    struct alignas(64) DeviceState
+    {
+        std::array<uint16_t, 256> lastSequenceCounters{};
+        // Bit i is set while the message with counter last - 1 - i is counted as lost
+        std::array<uint64_t, 256> missingCounters{};
+        std::array<uint8_t, 256> backwardSteps{};
+        std::bitset<256> initialized;
+    };
+
+    static void resync(DeviceState& state, uint8_t streamId, uint16_t sequenceCounter);
+
+    DeviceState& getDeviceState(uint16_t deviceId);
+
+private:
+    std::unordered_map<uint16_t, std::unique_ptr<DeviceState>> devices;
+    DeviceState* lastDeviceState{nullptr};
+    uint16_t lastDeviceId{0};
+};
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
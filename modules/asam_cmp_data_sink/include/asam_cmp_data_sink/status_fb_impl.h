@@ -17,16 +17,22 @@
 #pragma once
 #include <asam_cmp/status.h>
 #include <opendaq/function_block_impl.h>
+#include <chrono>
 
 #include <asam_cmp_data_sink/status_handler.h>
 #include <asam_cmp_data_sink/common.h>
+#include <asam_cmp_data_sink/receive_telemetry.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
 class StatusFbImpl final : public FunctionBlockImpl<IFunctionBlock, IStatusHandler>
 {
 public:
-    explicit StatusFbImpl(const ModuleInfoPtr& moduleInfo, const ContextPtr& ctx, const ComponentPtr& parent, const StringPtr& localId);
+    explicit StatusFbImpl(const ModuleInfoPtr& moduleInfo,
+                          const ContextPtr& ctx,
+                          const ComponentPtr& parent,
+                          const StringPtr& localId,
+                          const std::shared_ptr<ReceiveTelemetry>& telemetry = nullptr);
     ~StatusFbImpl() override = default;
 
     static FunctionBlockTypePtr CreateType(const ModuleInfoPtr& moduleInfo);
@@ -36,12 +42,41 @@ public:
     StatusMt getStatusMt() const override;
 
 private:
+    struct TelemetrySnapshot
+    {
+        uint64_t framesReceived{0};
+        uint64_t bytesReceived{0};
+        uint64_t messagesDecoded{0};
+        uint64_t decodeErrors{0};
+        uint64_t unsupportedMessages{0};
+        uint64_t kernelDrops{0};
+        uint64_t interfaceDrops{0};
+        uint64_t decodeTimeP50{0};
+        uint64_t decodeTimeP99{0};
+        uint64_t decodeTimeP999{0};
+        uint64_t decodeTimeMax{0};
+        uint64_t publishTimeP50{0};
+        uint64_t publishTimeP99{0};
+        uint64_t publishTimeP999{0};
+        uint64_t publishTimeMax{0};
+    };
+
     void initProperties();
+    void initTelemetryProperties();
+    void addTelemetryProperty(const StringPtr& name, uint64_t TelemetrySnapshot::*field, const UnitPtr& unit = nullptr);
+    const TelemetrySnapshot& getTelemetrySnapshot();
     void clear();
 
 private:
     mutable std::mutex stMutex;
     ASAM::CMP::Status status;
+
+    std::shared_ptr<ReceiveTelemetry> telemetry;
+    std::mutex telemetrySync;
+    std::chrono::milliseconds telemetryRefreshInterval{1000};
+    std::chrono::steady_clock::time_point telemetrySnapshotTime;
+    bool telemetrySnapshotValid{false};
+    TelemetrySnapshot telemetrySnapshot;
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -20,7 +20,14 @@
 #include <asam_cmp/ethernet_payload.h>
 #include <asam_cmp/packet.h>
 #include <opendaq/packet_factory.h>
-
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <asam_cmp_common_lib/can_id_filter.h>
+#include <asam_cmp_common_lib/can_id_map.h>
 #include <asam_cmp_common_lib/stream_common_fb_impl.h>
 #include <asam_cmp_data_sink/asam_cmp_packets_subscriber.h>
 #include <asam_cmp_data_sink/common.h>
@@ -46,6 +53,23 @@ struct EthernetData
 };
 #pragma pack(pop)
 
+// Layout of a batched Ethernet sample: header, frameCount entries, then the frames back to back.
+// Entry offsets are relative to the beginning of the sample.
+#pragma pack(push, 1)
+struct EthernetBatchHeader
+{
+    uint32_t frameCount;
+    uint32_t reserved;
+};
+
+struct EthernetBatchEntry
+{
+    uint64_t timestamp;
+    uint32_t offset;
+    uint32_t length;
+};
+#pragma pack(pop)
+
 
 class StreamFb final : public asam_cmp_common_lib::StreamCommonFbImpl<IAsamCmpPacketsSubscriber>
 {
@@ -64,7 +88,7 @@ public:
                       DataPacketsPublisher& publisher,
                       const uint16_t& deviceId,
                       const uint32_t& interfaceId);
-    ~StreamFb() override = default;
+    ~StreamFb() override;
 
 protected:
     // IStreamCommon
@@ -73,19 +97,42 @@ protected:
     // IAsamCmpPacketsSubscriber
     void receive(const std::shared_ptr<Packet>& packet) override;
     void receive(const std::vector<std::shared_ptr<Packet>>& packets) override;
+    void receive(const SequenceCounterStatistics& statistics) override;
 
     void updateStreamIdInternal() override;
 
 private:
+    void initProperties();
+    void updateEthernetBatchingInternal();
+    void updateCanLayoutInternal();
+    void updateCanIdFilterInternal();
+    void updateCanDemuxInternal();
+    void addSequenceCounterProperty(const StringPtr& name, const std::atomic<int64_t>& counter);
     void createSignals();
     void buildDataDescriptor();
     void buildCanDescriptor();
     void buildEthernetDescriptor();
     void buildAnalogDescriptor(const AnalogPayload& payload);
     void buildAsyncDomainDescriptor();
+    [[nodiscard]] DataDescriptorPtr createAsyncDomainDescriptor();
     void buildSyncDomainDescriptor(const float sampleInterval);
     void processCanData(const std::vector<std::shared_ptr<Packet>>& packets);
+    const std::vector<std::shared_ptr<Packet>>& filterCanPackets(const std::vector<std::shared_ptr<Packet>>& packets);
+    void demuxCanPackets(const std::vector<std::shared_ptr<Packet>>& packets);
+    void sendCanPackets(const std::vector<std::shared_ptr<Packet>>& packets,
+                        const SignalConfigPtr& outputSignal,
+                        const SignalConfigPtr& outputDomainSignal);
+    template <typename CanSample>
+    void sendCanStructData(const std::vector<std::shared_ptr<Packet>>& packets,
+                           const SignalConfigPtr& outputSignal,
+                           const SignalConfigPtr& outputDomainSignal);
+    void sendCanFdCompactData(const std::vector<std::shared_ptr<Packet>>& packets,
+                              const SignalConfigPtr& outputSignal,
+                              const SignalConfigPtr& outputDomainSignal);
     void processEthernetData(const std::vector<std::shared_ptr<Packet>>& packets);
+    void processEthernetDataBatched(const std::vector<std::shared_ptr<Packet>>& packets);
+    void flushEthernetBatch();
+    void ethernetBatchFlushLoop();
     void processSyncData(const std::shared_ptr<Packet>& packet);
     bool domainChanged(const AnalogPayload& payload);
     bool dataChanged(const AnalogPayload& payload);
@@ -94,8 +141,17 @@ private:
     [[nodiscard]] RatioPtr getResolution();
     [[nodiscard]] Int getDeltaT(const float sampleInterval);
     [[nodiscard]] UnitPtr asamCmpToOpenDaqUnit(AnalogPayload::Unit asamCmpUnit);
+    [[nodiscard]] static size_t getEthernetFrameLength(const EthernetPayload& payload);
 
 private:
+    // Output signal pair of one CanDemuxIds entry, packets are collected per entry and sent as one packet
+    struct CanDemuxOutput
+    {
+        SignalConfigPtr dataSignal;
+        SignalConfigPtr domainSignal;
+        std::vector<std::shared_ptr<Packet>> packets;
+    };
+
     const uint16_t& deviceId;
     const uint32_t& interfaceId;
     DataPacketsPublisher& publisher;
@@ -104,6 +160,30 @@ private:
     SignalConfigPtr domainSignal;
     bool updateDescriptors{false};
     AnalogPayload::Header analogHeader{};
+
+    std::mutex canSettingsSync;
+    bool compactCanLayout{false};
+    asam_cmp_common_lib::CanIdFilter canIdFilter;
+    std::vector<std::shared_ptr<Packet>> filteredCanPackets;
+    asam_cmp_common_lib::CanIdMap canDemuxMap;
+    std::vector<CanDemuxOutput> canDemuxOutputs;
+    std::vector<std::shared_ptr<Packet>> unmatchedCanPackets;
+
+    std::mutex ethernetBatchSync;
+    bool ethernetBatching{false};
+    size_t ethernetBatchMaxSize{0};
+    std::chrono::milliseconds ethernetBatchMaxLatency{0};
+    std::vector<std::shared_ptr<Packet>> ethernetBatch;
+    size_t ethernetBatchSize{0};
+    std::chrono::steady_clock::time_point ethernetBatchStartTime;
+    // Flushes a batch whose latency budget expired while no further messages arrive, runs while batching is enabled
+    std::thread ethernetBatchFlushThread;
+    std::condition_variable ethernetBatchCv;
+
+    std::atomic<int64_t> lostMessages{0};
+    std::atomic<int64_t> duplicateMessages{0};
+    std::atomic<int64_t> outOfOrderMessages{0};
+    std::atomic<int64_t> filteredMessages{0};
 };
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,169 @@
+#include <asam_cmp_data_sink/can_signal_decoder.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    inline uint64_t loadLittleEndian(const uint8_t* data)
+    {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i)
+            value = (value << 8) | data[i];
+        return value;
+    }
+
+    inline uint64_t loadBigEndian(const uint8_t* data)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i)
+            value = (value << 8) | data[i];
+        return value;
+    }
+}
+
+CanSignalDecoder::CanSignalDecoder(const std::vector<DbcFile::Message>& messages)
+    : messages(messages)
+{
+    for (size_t message = 0; message < this->messages.size(); ++message)
+    {
+        const auto& definition = this->messages[message];
+
+        MessagePlan plan{groups.size(), notFound, {}};
+        groups.push_back({message, getSignalCount(), 0, false, 0, 0});
+        for (size_t signal = 0; signal < definition.dbcSignals.size(); ++signal)
+        {
+            if (definition.dbcSignals[signal].multiplex == DbcFile::Multiplex::multiplexed)
+                continue;
+            if (definition.dbcSignals[signal].multiplex == DbcFile::Multiplex::multiplexor)
+                plan.multiplexor = getSignalCount();
+            addSignal(message, signal, groups.back());
+        }
+
+        // Multiplexed signals are grouped by multiplexor value, ordered by value for a stable signal order
+        std::map<uint32_t, std::vector<size_t>> multiplexedSignals;
+        for (size_t signal = 0; signal < definition.dbcSignals.size(); ++signal)
+        {
+            if (definition.dbcSignals[signal].multiplex == DbcFile::Multiplex::multiplexed)
+                multiplexedSignals[definition.dbcSignals[signal].multiplexValue].push_back(signal);
+        }
+        if (!multiplexedSignals.empty() && plan.multiplexor == notFound)
+            throw std::runtime_error("Message \"" + definition.name + "\" has multiplexed signals but no multiplexor");
+
+        for (const auto& [value, signalList] : multiplexedSignals)
+        {
+            plan.multiplexedGroups.push_back(groups.size());
+            groups.push_back({message, getSignalCount(), 0, true, value, 0});
+            for (const auto signal : signalList)
+                addSignal(message, signal, groups.back());
+        }
+
+        messageIds.add(definition.id, definition.id, message);
+        messagePlans.push_back(std::move(plan));
+    }
+
+    values.resize(getSignalCount());
+}
+
+void CanSignalDecoder::addSignal(size_t message, size_t signal, Group& group)
+{
+    const auto& definition = messages[message].dbcSignals[signal];
+
+    // Motorola start bits count from the most significant bit of each byte, the plan uses the bit position
+    // counted from the most significant bit of the frame instead
+    const uint32_t firstBit = definition.bigEndian ? (definition.startBit / 8) * 8 + (7 - definition.startBit % 8) : definition.startBit;
+    const uint32_t lastBit = firstBit + definition.length - 1;
+    const uint32_t requiredLength = lastBit / 8 + 1;
+    if (requiredLength > maxFrameLength)
+        throw std::runtime_error("Signal \"" + definition.name + "\" of message \"" + messages[message].name + "\" exceeds 64 bytes");
+
+    signalMessages.push_back(message);
+    signalIndices.push_back(signal);
+    byteOffsets.push_back(static_cast<uint8_t>(firstBit / 8));
+    shifts.push_back(static_cast<uint8_t>(firstBit % 8));
+    lengths.push_back(static_cast<uint8_t>(definition.length));
+    bigEndian.push_back(definition.bigEndian);
+    valueTypes.push_back(static_cast<uint8_t>(definition.valueType));
+    masks.push_back(definition.length == 64 ? ~uint64_t{0} : (uint64_t{1} << definition.length) - 1);
+    signBits.push_back(definition.isSigned && definition.valueType == DbcFile::ValueType::integer ? uint64_t{1} << (definition.length - 1)
+                                                                                                    : 0);
+    scales.push_back(definition.scale);
+    offsets.push_back(definition.offset);
+    requiredLengths.push_back(static_cast<uint8_t>(requiredLength));
+
+    ++group.signalCount;
+    group.requiredLength = std::max<size_t>(group.requiredLength, requiredLength);
+}
+
+const std::vector<DbcFile::Message>& CanSignalDecoder::getMessages() const noexcept
+{
+    return messages;
+}
+
+const std::vector<CanSignalDecoder::Group>& CanSignalDecoder::getGroups() const noexcept
+{
+    return groups;
+}
+
+size_t CanSignalDecoder::getSignalCount() const noexcept
+{
+    return byteOffsets.size();
+}
+
+const DbcFile::Signal& CanSignalDecoder::getSignal(size_t signal) const
+{
+    return messages[signalMessages[signal]].dbcSignals[signalIndices[signal]];
+}
+
+uint64_t CanSignalDecoder::extractRaw(size_t signal, const uint8_t* frame) const
+{
+    const uint8_t* data = frame + byteOffsets[signal];
+    const unsigned shift = shifts[signal];
+
+    // A field starting in the middle of a byte may span nine bytes, the ninth byte supplies the missing bits
+    if (bigEndian[signal])
+    {
+        const uint64_t value = shift == 0 ? loadBigEndian(data) : (loadBigEndian(data) << shift) | (data[8] >> (8 - shift));
+        return value >> (64 - lengths[signal]);
+    }
+
+    const uint64_t value = shift == 0 ? loadLittleEndian(data) : (loadLittleEndian(data) >> shift) | (uint64_t{data[8]} << (64 - shift));
+    return value & masks[signal];
+}
+
+void CanSignalDecoder::decodeGroup(const Group& group, const uint8_t* frame, double* groupValues)
+{
+    for (size_t i = 0, signal = group.firstSignal; i < group.signalCount; ++i, ++signal)
+    {
+        const uint64_t raw = extractRaw(signal, frame);
+
+        double value;
+        switch (static_cast<DbcFile::ValueType>(valueTypes[signal]))
+        {
+            case DbcFile::ValueType::float32:
+            {
+                const auto bits = static_cast<uint32_t>(raw);
+                float floatValue;
+                memcpy(&floatValue, &bits, sizeof(floatValue));
+                value = floatValue;
+                break;
+            }
+            case DbcFile::ValueType::float64:
+                memcpy(&value, &raw, sizeof(value));
+                break;
+            default:
+            {
+                const uint64_t signBit = signBits[signal];
+                value = signBit != 0 ? static_cast<double>(static_cast<int64_t>((raw ^ signBit) - signBit)) : static_cast<double>(raw);
+                break;
+            }
+        }
+
+        groupValues[i] = value * scales[signal] + offsets[signal];
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -1,4 +1,5 @@
 #include <asam_cmp_data_sink/data_sink_module_fb.h>
+#include <asam_cmp_data_sink/dbc_decoder_fb.h>
 #include <asam_cmp_data_sink/data_sink_module.h>
 #include <asam_cmp_data_sink/version.h>
 #include <coretypes/version_info_factory.h>
@@ -21,6 +22,9 @@ DictPtr<IString, IFunctionBlockType> DataSinkModule::onGetAvailableFunctionBlock
     auto typeStatistics = DataSinkModuleFb::CreateType(moduleInfo);
     types.set(typeStatistics.getId(), typeStatistics);
 
+    auto typeDbcDecoder = DbcDecoderFb::CreateType(moduleInfo);
+    types.set(typeDbcDecoder.getId(), typeDbcDecoder);
+
     return types;
 }
 
@@ -35,6 +39,9 @@ FunctionBlockPtr DataSinkModule::onCreateFunctionBlock(const StringPtr& id,
         return fb;
     }
 
+    if (id == DbcDecoderFb::CreateType(moduleInfo).getId())
+        return createWithImplementation<IFunctionBlock, DbcDecoderFb>(moduleInfo, context, parent, localId);
+
     LOG_W("Function block \"{}\" not found", id);
     throw NotFoundException("Function block not found");
 }
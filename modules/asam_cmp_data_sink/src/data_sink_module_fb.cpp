@@ -1,6 +1,8 @@
 #include <EthLayer.h>
+#include <VlanLayer.h>
 #include <asam_cmp/cmp_header.h>
 #include <coreobjects/callable_info_factory.h>
+#include <coreobjects/unit_factory.h>
 #include <opendaq/component_type_private.h>
 
 #include <asam_cmp_data_sink/data_sink_fb.h>
@@ -8,21 +10,78 @@
 #include <asam_cmp_data_sink/status_fb_impl.h>
 
 #include <SystemUtils.h>
+#include <asam_cmp_common_lib/ethernet_composite_impl.h>
 #include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/trace.h>
 #include <Packet.h>
 
+#include <chrono>
+#include <cstddef>
 #include <iostream>
+#include <limits>
+#include <sstream>
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
+// CMP header followed by the beginning of the first Data Message header, all fields are big-endian
+#pragma pack(push, 1)
+struct CmpDataMessageHeader
+{
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t deviceId;
+    uint8_t messageType;
+    uint8_t streamId;
+    uint16_t sequenceCounter;
+    uint64_t timestamp;
+    uint32_t interfaceId;
+};
+#pragma pack(pop)
+
+namespace
+{
+    std::chrono::nanoseconds toNanoseconds(double seconds)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+    }
+
+    // Comma separated list of deviceId:interfaceId:streamId
+    std::vector<Endpoint> parseEndpoints(const std::string& text)
+    {
+        std::vector<Endpoint> endpoints;
+        std::istringstream list(text);
+        std::string item;
+        while (std::getline(list, item, ','))
+        {
+            if (item.find_first_not_of(" \t") == std::string::npos)
+                continue;
+
+            std::istringstream fields(item);
+            unsigned long deviceId, interfaceId, streamId;
+            char separator1, separator2;
+            if (!(fields >> deviceId >> separator1 >> interfaceId >> separator2 >> streamId) || separator1 != ':' || separator2 != ':' ||
+                !(fields >> std::ws).eof() || deviceId > std::numeric_limits<uint16_t>::max() ||
+                interfaceId > std::numeric_limits<uint32_t>::max() || streamId > std::numeric_limits<uint8_t>::max())
+                throw std::invalid_argument("Invalid replay endpoint \"" + item + "\", expected deviceId:interfaceId:streamId");
+
+            endpoints.push_back(
+                {static_cast<uint16_t>(deviceId), static_cast<uint32_t>(interfaceId), static_cast<uint8_t>(streamId)});
+        }
+
+        return endpoints;
+    }
+}
+
 DataSinkModuleFb::DataSinkModuleFb(const ModuleInfoPtr& moduleInfo,
                                    const ContextPtr& ctx,
                                    const ComponentPtr& parent,
                                    const StringPtr& localId,
                                    const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper)
     : asam_cmp_common_lib::NetworkManagerFb(CreateType(moduleInfo), ctx, parent, localId, ethernetWrapper)
+    , telemetry(std::make_shared<ReceiveTelemetry>(ethernetWrapper))
 {
     createFbs();
+    initReplayProperties();
     startCapture();
 }
 
@@ -31,26 +90,30 @@ FunctionBlockPtr DataSinkModuleFb::create(const ModuleInfoPtr& moduleInfo,
                                           const ComponentPtr& parent,
                                           const StringPtr& localId)
 {
-    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ptr = std::make_shared<asam_cmp_common_lib::EthernetPcppImpl>();
+    std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf> ptr = asam_cmp_common_lib::EthernetCompositeImpl::createDefault();
     auto fb = createWithImplementation<IFunctionBlock, DataSinkModuleFb>(moduleInfo, ctx, parent, localId, ptr);
     return fb;
 }
 
 DataSinkModuleFb::~DataSinkModuleFb()
 {
+    replay.stop();
     stopCapture();
 }
 
 ErrCode INTERFACE_FUNC DataSinkModuleFb::remove()
 {
+    replay.stop();
     stopCapture();
     return Super::remove();
 }
 
 void DataSinkModuleFb::networkAdapterChangedInternal()
 {
+    replay.stop();
     stopCapture();
     NetworkManagerFb::networkAdapterChangedInternal();
+    sequenceCounterTracker.reset();
     startCapture();
 }
 
@@ -65,7 +128,7 @@ void DataSinkModuleFb::createFbs()
 {
     const StringPtr statusId = "Status";
     auto newFb = createWithImplementation<IFunctionBlock, StatusFbImpl>(
-        this->type.getModuleInfo(), context, functionBlocks, statusId);
+        this->type.getModuleInfo(), context, functionBlocks, statusId, telemetry);
     functionBlocks.addItem(newFb);
     auto statusMt = functionBlocks.getItems()[0].asPtr<IStatusHandler>(true)->getStatusMt();
 
@@ -75,6 +138,91 @@ void DataSinkModuleFb::createFbs()
     functionBlocks.addItem(newFb);
 }
 
+void DataSinkModuleFb::initReplayProperties()
+{
+    StringPtr propName = "ReplayFile";
+    objPtr.addProperty(StringPropertyBuilder(propName, "").build());
+
+    propName = "ReplayMode";
+    objPtr.addProperty(SelectionPropertyBuilder(propName, List<IString>("AsFastAsPossible", "OriginalTiming"), 0).build());
+
+    propName = "ReplaySpeed";
+    objPtr.addProperty(FloatPropertyBuilder(propName, 1.0)
+                           .setMinValue(0.001)
+                           .setMaxValue(1000.0)
+                           .setVisible(EvalValue("$ReplayMode == 1"))
+                           .build());
+
+    propName = "ReplayStartOffset";
+    objPtr.addProperty(FloatPropertyBuilder(propName, 0.0).setMinValue(0.0).setUnit(Unit("s")).build());
+
+    propName = "ReplayDuration";
+    objPtr.addProperty(FloatPropertyBuilder(propName, 0.0).setMinValue(0.0).setUnit(Unit("s")).build());
+
+    propName = "ReplayEndpoints";
+    objPtr.addProperty(StringPropertyBuilder(propName, "").build());
+
+    propName = "StartReplay";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { startReplay(); }));
+
+    propName = "StopReplay";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { stopReplay(); }));
+
+    propName = "ReplayActive";
+    objPtr.addProperty(BoolPropertyBuilder(propName, false).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { args.setValue(replay.isRunning()); };
+
+    propName = "ReplayedFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { args.setValue(static_cast<Int>(replay.getReplayedFrames())); };
+}
+
+void DataSinkModuleFb::startReplay()
+{
+    auto lock = this->getRecursiveConfigLock();
+
+    const std::string fileName = objPtr.getPropertyValue("ReplayFile").asPtr<IString>().toStdString();
+
+    PcapReplay::Options options;
+    options.mode = static_cast<Int>(objPtr.getPropertyValue("ReplayMode")) == 1 ? PcapReplay::Mode::OriginalTiming
+                                                                                : PcapReplay::Mode::AsFastAsPossible;
+    options.speed = static_cast<Float>(objPtr.getPropertyValue("ReplaySpeed"));
+    options.startOffset = toNanoseconds(static_cast<Float>(objPtr.getPropertyValue("ReplayStartOffset")));
+    options.duration = toNanoseconds(static_cast<Float>(objPtr.getPropertyValue("ReplayDuration")));
+    options.endpoints = parseEndpoints(objPtr.getPropertyValue("ReplayEndpoints").asPtr<IString>().toStdString());
+
+    // Live frames would interleave with the recorded ones, so capture is paused while the file is replayed
+    replay.stop();
+    stopCapture();
+    sequenceCounterTracker.reset();
+    try
+    {
+        replay.start(fileName,
+                     options,
+                     [this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie) { onPacketArrives(packet, dev, cookie); });
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Replay of \"{}\" failed: {}", fileName, e.what());
+        startCapture();
+        throw;
+    }
+}
+
+void DataSinkModuleFb::stopReplay()
+{
+    auto lock = this->getRecursiveConfigLock();
+
+    replay.stop();
+    sequenceCounterTracker.reset();
+    if (!captureStartedOnThisFb)
+        startCapture();
+}
+
 void DataSinkModuleFb::startCapture()
 {
     auto lock = this->getRecursiveConfigLock();
@@ -95,10 +243,36 @@ void DataSinkModuleFb::stopCapture()
 
 void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
 {
-    auto acPackets = decode(packet);
+    ASAM_CMP_TRACE_SCOPE("sink::DataSinkModuleFb::onPacketArrives");
+    telemetry->framesReceived.fetch_add(1, std::memory_order_relaxed);
+    telemetry->bytesReceived.fetch_add(packet->getRawDataLen(), std::memory_order_relaxed);
+
+    const auto decodeStart = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<ASAM::CMP::Packet>> acPackets;
+    try
+    {
+        acPackets = decode(packet);
+    }
+    catch (const std::exception& e)
+    {
+        telemetry->decodeErrors.fetch_add(1, std::memory_order_relaxed);
+        LOG_D("ASAM CMP frame decoding failed: {}", e.what());
+        return;
+    }
+
+    const auto publishStart = std::chrono::steady_clock::now();
+    telemetry->decodeTime.record(publishStart - decodeStart);
     if (acPackets.empty())
         return;
 
+    telemetry->messagesDecoded.fetch_add(acPackets.size(), std::memory_order_relaxed);
+    publish(acPackets);
+    telemetry->publishTime.record(std::chrono::steady_clock::now() - publishStart);
+}
+
+void DataSinkModuleFb::publish(const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& acPackets)
+{
+    ASAM_CMP_TRACE_SCOPE("sink::DataSinkModuleFb::publish");
     // "Aggregation of multiple CMP Messages can be realized for different DATA_MESSAGE_PAYLOAD_TYPEs"
     // We can process multiple packets simultaneously only if they are of the same type and IDs
 
@@ -133,6 +307,7 @@ void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDe
                         capturePacketsPublisher.publish(deviceId, acPacket);
                     break;
                 default:
+                    telemetry->unsupportedMessages.fetch_add(1, std::memory_order_relaxed);
                     LOG_I("ASAM CMP Message Type {} is not supported", to_underlying(acPacket->getMessageType()));
             }
         }
@@ -141,11 +316,45 @@ void DataSinkModuleFb::onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDe
 
 std::vector<std::shared_ptr<ASAM::CMP::Packet>> DataSinkModuleFb::decode(pcpp::RawPacket* packet)
 {
+    ASAM_CMP_TRACE_SCOPE("sink::DataSinkModuleFb::decode");
     pcpp::Packet parsedPacket(packet);
     pcpp::EthLayer* ethLayer = static_cast<pcpp::EthLayer*>(parsedPacket.getLayerOfType(pcpp::Ethernet));
-    assert(pcpp::netToHost16(ethLayer->getEthHeader()->etherType) == asam_cmp_common_lib::EthernetPcppImpl::asamCmpEtherType);
+    if (ethLayer == nullptr)
+        throw std::runtime_error("Frame has no Ethernet layer");
+
+    // Capture modules may send frames with an 802.1Q priority tag
+    pcpp::Layer* cmpLayer = ethLayer;
+    if (auto vlanLayer = parsedPacket.getLayerOfType<pcpp::VlanLayer>())
+    {
+        assert(pcpp::netToHost16(vlanLayer->getVlanHeader()->etherType) == asam_cmp_common_lib::EthernetPcppImpl::asamCmpEtherType);
+        cmpLayer = vlanLayer;
+    }
+    else
+    {
+        assert(pcpp::netToHost16(ethLayer->getEthHeader()->etherType) == asam_cmp_common_lib::EthernetPcppImpl::asamCmpEtherType);
+    }
+
+    checkSequenceCounter(cmpLayer->getLayerPayload(), cmpLayer->getLayerPayloadSize());
+    return decoder.decode(cmpLayer->getLayerPayload(), cmpLayer->getLayerPayloadSize());
+}
+
+void DataSinkModuleFb::checkSequenceCounter(const uint8_t* data, size_t size)
+{
+    // Only the first CMP header of the frame is checked. Status messages share the counter of their stream ID,
+    // so they are tracked as well, but statistics are reported only to the Data Message endpoints.
+    constexpr size_t cmpHeaderSize = offsetof(CmpDataMessageHeader, timestamp);
+    if (size < cmpHeaderSize)
+        return;
+
+    CmpDataMessageHeader header{};
+    memcpy(&header, data, std::min(size, sizeof(header)));
+
+    const uint16_t deviceId = pcpp::netToHost16(header.deviceId);
+    const auto statistics = sequenceCounterTracker.update(deviceId, header.streamId, pcpp::netToHost16(header.sequenceCounter));
+    if (statistics.empty() || header.messageType != to_underlying(ASAM::CMP::CmpHeader::MessageType::data) || size < sizeof(header))
+        return;
 
-    return decoder.decode(ethLayer->getLayerPayload(), ethLayer->getLayerPayloadSize());
+    dataPacketsPublisher.publish({deviceId, pcpp::netToHost32(header.interfaceId), header.streamId}, statistics);
 }
 
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,338 @@
+#include <coreobjects/unit_factory.h>
+#include <opendaq/component_type_private.h>
+#include <opendaq/custom_log.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/event_packet_ids.h>
+#include <opendaq/event_packet_params.h>
+#include <opendaq/packet_factory.h>
+#include <opendaq/range_factory.h>
+
+#include <asam_cmp_common_lib/compact_can_layout.h>
+#include <asam_cmp_common_lib/trace.h>
+#include <asam_cmp_data_sink/dbc_decoder_fb.h>
+#include <asam_cmp_data_sink/stream_fb.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+DbcDecoderFb::DbcDecoderFb(const ModuleInfoPtr& moduleInfo,
+                           const ContextPtr& ctx,
+                           const ComponentPtr& parent,
+                           const StringPtr& localId)
+    : FunctionBlock(CreateType(moduleInfo), ctx, parent, localId)
+{
+    initProperties();
+    inputPort = createAndAddInputPort("input", PacketReadyNotification::Scheduler);
+}
+
+FunctionBlockTypePtr DbcDecoderFb::CreateType(const ModuleInfoPtr& moduleInfo)
+{
+    auto fbType = FunctionBlockType("AsamCmpDbcDecoder", "AsamCmpDbcDecoder", "Decoding of CAN signals described by a DBC file");
+
+    checkErrorInfo(fbType.asPtr<IComponentTypePrivate>(true)->setModuleInfo(moduleInfo));
+    return fbType;
+}
+
+void DbcDecoderFb::initProperties()
+{
+    StringPtr propName = "DbcFile";
+    objPtr.addProperty(StringPropertyBuilder(propName, "").build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateDbcFileInternal(); };
+
+    propName = "DecodedFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(decodedFrames.load(std::memory_order_relaxed)); };
+
+    propName = "UnknownFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(unknownFrames.load(std::memory_order_relaxed)); };
+}
+
+void DbcDecoderFb::updateDbcFileInternal()
+{
+    const std::string fileName = objPtr.getPropertyValue("DbcFile").asPtr<IString>().toStdString();
+    try
+    {
+        loadDbc(fileName);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("DBC file \"{}\" is not loaded: {}", fileName, e.what());
+    }
+}
+
+void DbcDecoderFb::loadDbc(const std::string& fileName)
+{
+    std::unique_ptr<CanSignalDecoder> newDecoder;
+    if (!fileName.empty())
+        newDecoder = std::make_unique<CanSignalDecoder>(DbcFile(fileName).getMessages());
+
+    auto lock = this->getRecursiveConfigLock2();
+    removeOutputSignals();
+    decoder = std::move(newDecoder);
+    createOutputSignals();
+}
+
+void DbcDecoderFb::removeOutputSignals()
+{
+    for (const auto& signal : valueSignals)
+        removeSignal(signal);
+    for (const auto& output : groupOutputs)
+        removeSignal(output.domainSignal);
+
+    valueSignals.clear();
+    signalValues.clear();
+    groupOutputs.clear();
+}
+
+void DbcDecoderFb::createOutputSignals()
+{
+    if (!decoder)
+        return;
+
+    const auto domainDescriptor = createDomainDescriptor();
+    const auto& messages = decoder->getMessages();
+    valueSignals.resize(decoder->getSignalCount());
+    signalValues.resize(decoder->getSignalCount());
+
+    for (const auto& group : decoder->getGroups())
+    {
+        const auto& message = messages[group.message];
+        auto suffix = message.name;
+        if (group.multiplexed)
+            suffix += "_m" + std::to_string(group.multiplexValue);
+
+        GroupOutput output;
+        output.domainSignal = createAndAddSignal("time_" + suffix, nullptr, false);
+        output.domainSignal.setName("Time " + suffix);
+        output.domainSignal.setDescriptor(domainDescriptor);
+
+        for (size_t i = group.firstSignal; i < group.firstSignal + group.signalCount; ++i)
+        {
+            const auto& dbcSignal = decoder->getSignal(i);
+            auto descriptorBuilder = DataDescriptorBuilder().setSampleType(SampleType::Float64).setName(dbcSignal.name);
+            if (!dbcSignal.unit.empty())
+                descriptorBuilder.setUnit(Unit(dbcSignal.unit));
+            if (dbcSignal.minimum < dbcSignal.maximum)
+                descriptorBuilder.setValueRange(Range(dbcSignal.minimum, dbcSignal.maximum));
+
+            auto& signal = valueSignals[i];
+            signal = createAndAddSignal(message.name + "_" + dbcSignal.name);
+            signal.setName(dbcSignal.name);
+            signal.setDescriptor(descriptorBuilder.build());
+            signal.setDomainSignal(output.domainSignal);
+        }
+
+        groupOutputs.push_back(std::move(output));
+    }
+}
+
+DataDescriptorPtr DbcDecoderFb::createDomainDescriptor() const
+{
+    // Output samples keep the timestamps of their frames, so the outputs use the time base of the input
+    auto builder = DataDescriptorBuilder()
+                       .setSampleType(SampleType::UInt64)
+                       .setUnit(Unit("s", -1, "seconds", "time"))
+                       .setTickResolution(Ratio(1, 1000000000))
+                       .setName("Time");
+    if (inputDomainDescriptor.assigned())
+    {
+        builder.setTickResolution(inputDomainDescriptor.getTickResolution());
+        if (inputDomainDescriptor.getUnit().assigned())
+            builder.setUnit(inputDomainDescriptor.getUnit());
+        if (inputDomainDescriptor.getOrigin().assigned())
+            builder.setOrigin(inputDomainDescriptor.getOrigin());
+    }
+    return builder.build();
+}
+
+void DbcDecoderFb::onPacketReceived(const InputPortPtr& port)
+{
+    ASAM_CMP_TRACE_SCOPE("sink::DbcDecoderFb::onPacketReceived");
+    auto lock = this->getRecursiveConfigLock2();
+
+    const auto connection = inputPort.getConnection();
+    if (!connection.assigned())
+        return;
+
+    PacketPtr packet = connection.dequeue();
+    while (packet.assigned())
+    {
+        switch (packet.getType())
+        {
+            case PacketType::Event:
+                processEventPacket(packet);
+                break;
+
+            case PacketType::Data:
+                processDataPacket(packet);
+                break;
+
+            default:
+                break;
+        }
+
+        packet = connection.dequeue();
+    }
+}
+
+void DbcDecoderFb::processEventPacket(const EventPacketPtr& packet)
+{
+    if (packet.getEventId() != event_packet_id::DATA_DESCRIPTOR_CHANGED)
+        return;
+
+    DataDescriptorPtr dataDescriptor = packet.getParameters().get(event_packet_param::DATA_DESCRIPTOR);
+    DataDescriptorPtr domainDescriptor = packet.getParameters().get(event_packet_param::DOMAIN_DATA_DESCRIPTOR);
+
+    if (dataDescriptor.assigned())
+    {
+        inputLayout = getInputLayout(dataDescriptor);
+        if (inputLayout == InputLayout::invalid)
+            LOG_W("Input signal is not a CAN signal, its packets are not decoded");
+    }
+
+    if (domainDescriptor.assigned())
+    {
+        inputDomainDescriptor = domainDescriptor;
+        const auto outputDomainDescriptor = createDomainDescriptor();
+        for (const auto& output : groupOutputs)
+            output.domainSignal.setDescriptor(outputDomainDescriptor);
+    }
+}
+
+DbcDecoderFb::InputLayout DbcDecoderFb::getInputLayout(const DataDescriptorPtr& descriptor)
+{
+    using namespace asam_cmp_common_lib::compact_can;
+
+    if (isCanFdDescriptor(descriptor))
+        return InputLayout::compactCanFd;
+
+    if (descriptor.getSampleType() != SampleType::Struct || descriptor.getStructFields().getCount() != 3)
+        return InputLayout::invalid;
+
+    // Both struct layouts consist of ArbId, Length and Data and differ only in the size of Data
+    const auto sampleSize = descriptor.getSampleSize();
+    if (sampleSize == sizeof(CANData))
+        return InputLayout::canData;
+    if (sampleSize == sizeof(ClassicCanData))
+        return InputLayout::classicCanData;
+
+    return InputLayout::invalid;
+}
+
+void DbcDecoderFb::processDataPacket(const DataPacketPtr& packet)
+{
+    if (!decoder || inputLayout == InputLayout::invalid)
+        return;
+
+    switch (inputLayout)
+    {
+        case InputLayout::canData:
+            decodeStructSamples<CANData>(packet);
+            break;
+        case InputLayout::classicCanData:
+            decodeStructSamples<asam_cmp_common_lib::compact_can::ClassicCanData>(packet);
+            break;
+        case InputLayout::compactCanFd:
+            decodeCanFdCompactSamples(packet);
+            break;
+        default:
+            break;
+    }
+
+    sendOutputPackets();
+}
+
+template <typename CanSample>
+void DbcDecoderFb::decodeStructSamples(const DataPacketPtr& packet)
+{
+    const auto domainPacket = packet.getDomainPacket();
+    if (!domainPacket.assigned())
+        return;
+
+    const auto timestamps = static_cast<const uint64_t*>(domainPacket.getRawData());
+    const auto samples = static_cast<const uint8_t*>(packet.getRawData());
+    if (timestamps == nullptr || samples == nullptr)
+        return;
+
+    const size_t sampleCount = packet.getSampleCount();
+    for (size_t i = 0; i < sampleCount; ++i)
+    {
+        // Samples are packed, copy them out instead of accessing the fields in place
+        CanSample sample;
+        memcpy(&sample, samples + i * sizeof(CanSample), sizeof(CanSample));
+        decodeFrame(sample.arbId, sample.data, std::min<size_t>(sample.length, sizeof(sample.data)), timestamps[i]);
+    }
+}
+
+void DbcDecoderFb::decodeCanFdCompactSamples(const DataPacketPtr& packet)
+{
+    const auto sample = static_cast<const uint8_t*>(packet.getRawData());
+    if (sample == nullptr)
+        return;
+
+    const bool valid = asam_cmp_common_lib::compact_can::forEachCanFdFrame(
+        sample,
+        packet.getDataSize(),
+        [this](const asam_cmp_common_lib::compact_can::CanFdFrame& frame, const uint8_t* data)
+        { decodeFrame(frame.arbId, data, frame.length, frame.timestamp); });
+
+    if (!valid)
+        LOG_W("Truncated CAN FD sample, the remaining frames are not decoded");
+}
+
+void DbcDecoderFb::decodeFrame(uint32_t arbId, const uint8_t* data, size_t length, uint64_t timestamp)
+{
+    const auto& groups = decoder->getGroups();
+    const bool known = decoder->decode(arbId,
+                                       data,
+                                       length,
+                                       [&](size_t groupIndex, const double* values)
+                                       {
+                                           const auto& group = groups[groupIndex];
+                                           groupOutputs[groupIndex].timestamps.push_back(timestamp);
+                                           for (size_t i = 0; i < group.signalCount; ++i)
+                                               signalValues[group.firstSignal + i].push_back(values[i]);
+                                       });
+
+    if (known)
+        decodedFrames.fetch_add(1, std::memory_order_relaxed);
+    else
+        unknownFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DbcDecoderFb::sendOutputPackets()
+{
+    const auto& groups = decoder->getGroups();
+    for (size_t groupIndex = 0; groupIndex < groupOutputs.size(); ++groupIndex)
+    {
+        auto& output = groupOutputs[groupIndex];
+        if (output.timestamps.empty())
+            continue;
+
+        const size_t sampleCount = output.timestamps.size();
+        const auto domainPacket = DataPacket(output.domainSignal.getDescriptor(), sampleCount, output.timestamps.front());
+        memcpy(domainPacket.getRawData(), output.timestamps.data(), sampleCount * sizeof(uint64_t));
+
+        const auto& group = groups[groupIndex];
+        for (size_t i = group.firstSignal; i < group.firstSignal + group.signalCount; ++i)
+        {
+            auto& values = signalValues[i];
+            const auto dataPacket = DataPacketWithDomain(domainPacket, valueSignals[i].getDescriptor(), sampleCount);
+            memcpy(dataPacket.getRawData(), values.data(), sampleCount * sizeof(double));
+            valueSignals[i].sendPacket(dataPacket);
+            values.clear();
+        }
+
+        output.domainSignal.sendPacket(domainPacket);
+        output.timestamps.clear();
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,281 @@
+#include <asam_cmp_data_sink/dbc_file.h>
+
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    constexpr uint32_t extendedIdFlag = 0x80000000;
+    constexpr uint32_t maxStandardId = 0x7FF;
+    // Holder of signals that belong to no message, written by Vector tools
+    constexpr std::string_view independentSignalsMessage{"VECTOR__INDEPENDENT_SIG_MSG"};
+
+    // Cursor over one line of the file
+    class LineParser
+    {
+    public:
+        LineParser(std::string_view line, size_t lineNumber)
+            : line(line)
+            , lineNumber(lineNumber)
+        {
+        }
+
+        void skipSpaces()
+        {
+            while (position < line.size() && (line[position] == ' ' || line[position] == '\t' || line[position] == '\r'))
+                ++position;
+        }
+
+        bool atEnd()
+        {
+            skipSpaces();
+            return position == line.size();
+        }
+
+        // Identifier, number or other run of characters up to a space or one of the delimiters
+        std::string_view token(std::string_view delimiters = "")
+        {
+            skipSpaces();
+            const size_t begin = position;
+            while (position < line.size() && line[position] != ' ' && line[position] != '\t' && line[position] != '\r' &&
+                   delimiters.find(line[position]) == std::string_view::npos)
+                ++position;
+            if (begin == position)
+                fail("unexpected end of entry");
+            return line.substr(begin, position - begin);
+        }
+
+        void expect(char c)
+        {
+            skipSpaces();
+            if (position == line.size() || line[position] != c)
+                fail(std::string("expected '") + c + "'");
+            ++position;
+        }
+
+        bool accept(char c)
+        {
+            skipSpaces();
+            if (position == line.size() || line[position] != c)
+                return false;
+            ++position;
+            return true;
+        }
+
+        uint32_t unsignedNumber(std::string_view delimiters = "")
+        {
+            const auto text = token(delimiters);
+            uint64_t value{};
+            const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec != std::errc() || result.ptr != text.data() + text.size() || value > UINT32_MAX)
+                fail("invalid number \"" + std::string(text) + "\"");
+            return static_cast<uint32_t>(value);
+        }
+
+        double floatNumber(std::string_view delimiters)
+        {
+            const std::string text(token(delimiters));
+            char* end = nullptr;
+            const double value = std::strtod(text.c_str(), &end);
+            if (end != text.c_str() + text.size())
+                fail("invalid number \"" + text + "\"");
+            return value;
+        }
+
+        std::string quoted()
+        {
+            expect('"');
+            const size_t end = line.find('"', position);
+            if (end == std::string_view::npos)
+                fail("unterminated string");
+            std::string text(line.substr(position, end - position));
+            position = end + 1;
+            return text;
+        }
+
+        [[noreturn]] void fail(const std::string& message) const
+        {
+            throw std::runtime_error("DBC line " + std::to_string(lineNumber) + ": " + message);
+        }
+
+    private:
+        std::string_view line;
+        size_t lineNumber;
+        size_t position{0};
+    };
+
+    DbcFile::Message parseMessage(LineParser& parser)
+    {
+        DbcFile::Message message;
+        const uint32_t id = parser.unsignedNumber();
+        message.id = id & ~extendedIdFlag;
+        message.extended = (id & extendedIdFlag) != 0 || message.id > maxStandardId;
+        message.name = parser.token(":");
+        parser.expect(':');
+        message.size = parser.unsignedNumber();
+        return message;
+    }
+
+    DbcFile::Signal parseSignal(LineParser& parser)
+    {
+        DbcFile::Signal signal;
+        signal.name = parser.token(":");
+
+        if (!parser.accept(':'))
+        {
+            const auto multiplexer = parser.token(":");
+            if (multiplexer == "M")
+            {
+                signal.multiplex = DbcFile::Multiplex::multiplexor;
+            }
+            else if (multiplexer.size() > 1 && multiplexer[0] == 'm')
+            {
+                // "m<n>M" marks a multiplexed multiplexor of extended multiplexing, it is decoded as multiplexed
+                auto value = multiplexer.substr(1);
+                if (value.back() == 'M')
+                    value.remove_suffix(1);
+                const auto result = std::from_chars(value.data(), value.data() + value.size(), signal.multiplexValue);
+                if (result.ec != std::errc() || result.ptr != value.data() + value.size())
+                    parser.fail("invalid multiplexer \"" + std::string(multiplexer) + "\"");
+                signal.multiplex = DbcFile::Multiplex::multiplexed;
+            }
+            else
+            {
+                parser.fail("invalid multiplexer \"" + std::string(multiplexer) + "\"");
+            }
+            parser.expect(':');
+        }
+
+        signal.startBit = parser.unsignedNumber("|");
+        parser.expect('|');
+        signal.length = parser.unsignedNumber("@");
+        parser.expect('@');
+        const auto format = parser.token("(");
+        if (format.size() != 2 || (format[0] != '0' && format[0] != '1') || (format[1] != '+' && format[1] != '-'))
+            parser.fail("invalid byte order and sign \"" + std::string(format) + "\"");
+        signal.bigEndian = format[0] == '0';
+        signal.isSigned = format[1] == '-';
+
+        parser.expect('(');
+        signal.scale = parser.floatNumber(",");
+        parser.expect(',');
+        signal.offset = parser.floatNumber(")");
+        parser.expect(')');
+        parser.expect('[');
+        signal.minimum = parser.floatNumber("|");
+        parser.expect('|');
+        signal.maximum = parser.floatNumber("]");
+        parser.expect(']');
+        signal.unit = parser.quoted();
+
+        if (signal.length == 0 || signal.length > 64)
+            parser.fail("invalid length of signal \"" + signal.name + "\"");
+        if (signal.startBit >= 512)
+            parser.fail("invalid start bit of signal \"" + signal.name + "\"");
+        return signal;
+    }
+
+    void parseValueType(LineParser& parser, std::vector<DbcFile::Message>& messages)
+    {
+        const uint32_t id = parser.unsignedNumber() & ~extendedIdFlag;
+        const auto name = parser.token(":;");
+        parser.expect(':');
+        const auto type = parser.unsignedNumber(";");
+
+        for (auto& message : messages)
+        {
+            if (message.id != id)
+                continue;
+            for (auto& signal : message.dbcSignals)
+            {
+                if (signal.name != name)
+                    continue;
+                if (type == 1 && signal.length == 32)
+                    signal.valueType = DbcFile::ValueType::float32;
+                else if (type == 2 && signal.length == 64)
+                    signal.valueType = DbcFile::ValueType::float64;
+                else if (type != 0)
+                    parser.fail("invalid value type of signal \"" + signal.name + "\"");
+            }
+        }
+    }
+}
+
+DbcFile::DbcFile(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Failed to open \"" + fileName + "\"");
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    messages = parse(content.str());
+}
+
+std::vector<DbcFile::Message> DbcFile::parse(std::string_view content)
+{
+    std::vector<Message> messages;
+    bool inMessage = false;
+
+    size_t lineNumber = 0;
+    size_t position = 0;
+    while (position < content.size())
+    {
+        size_t end = content.find('\n', position);
+        if (end == std::string_view::npos)
+            end = content.size();
+        const auto line = content.substr(position, end - position);
+        position = end + 1;
+        ++lineNumber;
+
+        LineParser parser(line, lineNumber);
+        if (parser.atEnd())
+        {
+            inMessage = false;
+            continue;
+        }
+
+        const auto keyword = parser.token();
+        if (keyword == "BO_")
+        {
+            messages.push_back(parseMessage(parser));
+            inMessage = true;
+        }
+        else if (keyword == "SG_")
+        {
+            if (!inMessage)
+                parser.fail("signal outside of a message");
+            messages.back().dbcSignals.push_back(parseSignal(parser));
+        }
+        else if (keyword == "SIG_VALTYPE_")
+        {
+            parseValueType(parser, messages);
+        }
+        else
+        {
+            inMessage = false;
+        }
+    }
+
+    for (auto it = messages.begin(); it != messages.end();)
+    {
+        if (it->name == independentSignalsMessage || it->dbcSignals.empty())
+            it = messages.erase(it);
+        else
+            ++it;
+    }
+
+    return messages;
+}
+
+const std::vector<DbcFile::Message>& DbcFile::getMessages() const noexcept
+{
+    return messages;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -0,0 +1,323 @@
+#include <asam_cmp_data_sink/pcap_file_reader.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace
+{
+    constexpr uint32_t pcapMagicMicroseconds = 0xA1B2C3D4;
+    constexpr uint32_t pcapMagicNanoseconds = 0xA1B23C4D;
+    constexpr size_t pcapFileHeaderSize = 24;
+    constexpr size_t pcapRecordHeaderSize = 16;
+
+    constexpr uint32_t sectionHeaderBlock = 0x0A0D0D0A;
+    constexpr uint32_t interfaceDescriptionBlock = 0x00000001;
+    constexpr uint32_t obsoletePacketBlock = 0x00000002;
+    constexpr uint32_t simplePacketBlock = 0x00000003;
+    constexpr uint32_t enhancedPacketBlock = 0x00000006;
+    constexpr uint32_t byteOrderMagic = 0x1A2B3C4D;
+    constexpr uint16_t timestampResolutionOption = 9;
+    constexpr size_t minBlockSize = 12;
+
+    constexpr std::array<uint64_t, 10> powersOfTen{
+        1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000};
+
+    uint32_t byteSwap32(uint32_t value) noexcept
+    {
+        return (value >> 24) | ((value >> 8) & 0x0000FF00) | ((value << 8) & 0x00FF0000) | (value << 24);
+    }
+
+    uint32_t readRaw32(const uint8_t* data) noexcept
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}
+
+PcapFileReader::PcapFileReader(const std::string& fileName)
+    : file(fileName, true)
+    , data(file.getData())
+    , size(file.getSize())
+{
+    readFileHeader();
+}
+
+void PcapFileReader::readFileHeader()
+{
+    if (size < minBlockSize)
+        throw std::runtime_error("File is too short to be a pcap or pcapng file");
+
+    const uint32_t magic = readRaw32(data);
+    if (magic == sectionHeaderBlock)
+    {
+        pcapNg = true;
+        if (!readSectionHeader(0))
+            throw std::runtime_error("Invalid pcapng section header");
+        firstRecord = 0;
+        rewind();
+        return;
+    }
+
+    bool nanoseconds;
+    if (magic == pcapMagicMicroseconds || magic == byteSwap32(pcapMagicMicroseconds))
+        nanoseconds = false;
+    else if (magic == pcapMagicNanoseconds || magic == byteSwap32(pcapMagicNanoseconds))
+        nanoseconds = true;
+    else
+        throw std::runtime_error("Unsupported file format, expected pcap or pcapng");
+
+    if (size < pcapFileHeaderSize)
+        throw std::runtime_error("Invalid pcap file header");
+
+    swapped = magic != pcapMagicMicroseconds && magic != pcapMagicNanoseconds;
+    pcapInterface.snapLength = read32(16);
+    // The upper bits of the link type field carry FCS information
+    pcapInterface.linkType = static_cast<uint16_t>(read32(20) & 0xFFFF);
+    pcapInterface.resolutionExponent = nanoseconds ? 9 : 6;
+    pcapInterface.binaryResolution = false;
+    firstRecord = pcapFileHeaderSize;
+    rewind();
+}
+
+void PcapFileReader::rewind()
+{
+    position = firstRecord;
+    interfaces.clear();
+    lastTimestamp = 0;
+}
+
+bool PcapFileReader::isPcapNg() const noexcept
+{
+    return pcapNg;
+}
+
+uint64_t PcapFileReader::getFileSize() const noexcept
+{
+    return size;
+}
+
+bool PcapFileReader::next(Frame& frame)
+{
+    return pcapNg ? nextPcapNg(frame) : nextPcap(frame);
+}
+
+bool PcapFileReader::readAt(uint64_t offset, Frame& frame)
+{
+    if (offset < firstRecord || offset >= size)
+        return false;
+
+    // Packets of a pcapng file refer to the interfaces described before them
+    if (pcapNg && interfaces.empty())
+        readInterfaceDescriptions();
+
+    position = static_cast<size_t>(offset);
+    return next(frame);
+}
+
+void PcapFileReader::readInterfaceDescriptions()
+{
+    position = firstRecord;
+    while (size - position >= minBlockSize)
+    {
+        const uint32_t rawType = readRaw32(data + position);
+        if (rawType == sectionHeaderBlock && !readSectionHeader(position))
+            return;
+
+        const uint32_t type = read32(position);
+        const size_t blockLength = read32(position + 4);
+        if (blockLength < minBlockSize || blockLength % 4 != 0 || blockLength > size - position)
+            return;
+
+        if (type != sectionHeaderBlock && type != interfaceDescriptionBlock)
+            return;
+
+        position += blockLength;
+        if (type == interfaceDescriptionBlock)
+            readInterfaceDescription(blockLength);
+    }
+}
+
+bool PcapFileReader::nextPcap(Frame& frame)
+{
+    if (size - position < pcapRecordHeaderSize)
+        return false;
+
+    const uint32_t capturedLength = read32(position + 8);
+    if (size - position - pcapRecordHeaderSize < capturedLength)
+        return false;
+
+    const uint64_t seconds = read32(position);
+    const uint64_t fraction = read32(position + 4);
+    frame.data = data + position + pcapRecordHeaderSize;
+    frame.length = capturedLength;
+    frame.timestamp = seconds * 1'000'000'000 + fraction * powersOfTen[9 - pcapInterface.resolutionExponent];
+    frame.linkType = pcapInterface.linkType;
+    frame.offset = position;
+
+    position += pcapRecordHeaderSize + capturedLength;
+    return true;
+}
+
+bool PcapFileReader::nextPcapNg(Frame& frame)
+{
+    while (size - position >= minBlockSize)
+    {
+        const uint32_t rawType = readRaw32(data + position);
+        if (rawType == sectionHeaderBlock && !readSectionHeader(position))
+            return false;
+
+        const uint32_t type = read32(position);
+        const size_t blockLength = read32(position + 4);
+        if (blockLength < minBlockSize || blockLength % 4 != 0 || blockLength > size - position)
+            return false;
+
+        const size_t block = position;
+        position += blockLength;
+
+        switch (type)
+        {
+            case sectionHeaderBlock:
+                interfaces.clear();
+                break;
+            case interfaceDescriptionBlock:
+                readInterfaceDescription(blockLength);
+                break;
+            case enhancedPacketBlock:
+            case obsoletePacketBlock:
+            {
+                constexpr size_t packetDataOffset = 28;
+                if (blockLength < packetDataOffset + 4)
+                    return false;
+
+                const uint32_t interfaceId = type == enhancedPacketBlock ? read32(block + 8) : read16(block + 8);
+                const uint32_t capturedLength = read32(block + 20);
+                if (capturedLength > blockLength - packetDataOffset - 4)
+                    return false;
+                if (interfaceId >= interfaces.size())
+                    break;
+
+                const Interface& itf = interfaces[interfaceId];
+                const uint64_t timestamp = (static_cast<uint64_t>(read32(block + 12)) << 32) | read32(block + 16);
+                lastTimestamp = toNanoseconds(itf, timestamp);
+
+                frame.data = data + block + packetDataOffset;
+                frame.length = capturedLength;
+                frame.timestamp = lastTimestamp;
+                frame.linkType = itf.linkType;
+                frame.offset = block;
+                return true;
+            }
+            case simplePacketBlock:
+            {
+                constexpr size_t packetDataOffset = 12;
+                if (blockLength < packetDataOffset + 4 || interfaces.empty())
+                    break;
+
+                const Interface& itf = interfaces.front();
+                uint32_t capturedLength = std::min<uint32_t>(read32(block + 8), static_cast<uint32_t>(blockLength - packetDataOffset - 4));
+                if (itf.snapLength != 0)
+                    capturedLength = std::min(capturedLength, itf.snapLength);
+
+                // Simple packet blocks carry no timestamp
+                frame.data = data + block + packetDataOffset;
+                frame.length = capturedLength;
+                frame.timestamp = lastTimestamp;
+                frame.linkType = itf.linkType;
+                frame.offset = block;
+                return true;
+            }
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+bool PcapFileReader::readSectionHeader(size_t blockPosition)
+{
+    if (size - blockPosition < minBlockSize + 4)
+        return false;
+
+    const uint32_t magic = readRaw32(data + blockPosition + 8);
+    if (magic == byteOrderMagic)
+        swapped = false;
+    else if (magic == byteSwap32(byteOrderMagic))
+        swapped = true;
+    else
+        return false;
+
+    return true;
+}
+
+void PcapFileReader::readInterfaceDescription(size_t blockLength)
+{
+    const size_t block = position - blockLength;
+    Interface itf{};
+    itf.resolutionExponent = 6;
+    if (blockLength >= 20)
+    {
+        itf.linkType = read16(block + 8);
+        itf.snapLength = read32(block + 12);
+    }
+
+    const size_t optionsEnd = block + blockLength - 4;
+    for (size_t option = block + 16; option + 4 <= optionsEnd;)
+    {
+        const uint16_t code = read16(option);
+        const uint16_t length = read16(option + 2);
+        if (code == 0 || option + 4 + length > optionsEnd)
+            break;
+
+        if (code == timestampResolutionOption && length >= 1)
+        {
+            const uint8_t value = data[option + 4];
+            itf.binaryResolution = (value & 0x80) != 0;
+            itf.resolutionExponent = value & 0x7F;
+        }
+        option += 4 + ((length + 3u) & ~3u);
+    }
+
+    interfaces.push_back(itf);
+}
+
+uint16_t PcapFileReader::read16(size_t position) const noexcept
+{
+    uint16_t value;
+    std::memcpy(&value, data + position, sizeof(value));
+    return swapped ? static_cast<uint16_t>((value >> 8) | (value << 8)) : value;
+}
+
+uint32_t PcapFileReader::read32(size_t position) const noexcept
+{
+    const uint32_t value = readRaw32(data + position);
+    return swapped ? byteSwap32(value) : value;
+}
+
+uint64_t PcapFileReader::toNanoseconds(const Interface& itf, uint64_t timestamp) const noexcept
+{
+    const uint8_t exponent = itf.resolutionExponent;
+    if (itf.binaryResolution)
+    {
+        if (exponent >= 64)
+            return 0;
+        const uint64_t seconds = timestamp >> exponent;
+        const uint64_t fraction = timestamp & ((uint64_t{1} << exponent) - 1);
+        return seconds * 1'000'000'000 + static_cast<uint64_t>(static_cast<long double>(fraction) * 1e9L / static_cast<long double>(uint64_t{1} << exponent));
+    }
+
+    if (exponent <= 9)
+        return timestamp * powersOfTen[9 - exponent];
+
+    uint64_t result = timestamp;
+    for (uint8_t i = 9; i < exponent && result != 0; ++i)
+        result /= 10;
+    return result;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
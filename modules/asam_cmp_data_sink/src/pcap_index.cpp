@@ -0,0 +1,68 @@
+#include <asam_cmp_data_sink/pcap_index.h>
+
+#include <cstring>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace pcap_index = asam_cmp_common_lib::pcap_index;
+
+PcapIndex::PcapIndex(const std::string& fileName)
+    : file(fileName)
+    , entries(file.getData() + pcap_index::magic.size())
+    , count(0)
+{
+    if (file.getSize() < pcap_index::magic.size() ||
+        std::memcmp(file.getData(), pcap_index::magic.data(), pcap_index::magic.size()) != 0)
+        throw std::runtime_error("File " + fileName + " is not an ASAM CMP recording index");
+
+    // A partially written last entry is ignored
+    count = (file.getSize() - pcap_index::magic.size()) / sizeof(Entry);
+}
+
+std::unique_ptr<PcapIndex> PcapIndex::openFor(const std::string& captureFileName)
+{
+    try
+    {
+        return std::make_unique<PcapIndex>(captureFileName + pcap_index::fileExtension);
+    }
+    catch (const std::runtime_error&)
+    {
+        return nullptr;
+    }
+}
+
+size_t PcapIndex::getCount() const noexcept
+{
+    return count;
+}
+
+PcapIndex::Entry PcapIndex::getEntry(size_t index) const noexcept
+{
+    Entry entry;
+    std::memcpy(&entry, entries + index * sizeof(Entry), sizeof(Entry));
+    return entry;
+}
+
+size_t PcapIndex::lowerBound(uint64_t timestamp) const noexcept
+{
+    size_t first = 0;
+    size_t length = count;
+    while (length > 0)
+    {
+        const size_t half = length / 2;
+        if (getEntry(first + half).timestamp < timestamp)
+        {
+            first += half + 1;
+            length -= half + 1;
+        }
+        else
+        {
+            length = half;
+        }
+    }
+
+    return first;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
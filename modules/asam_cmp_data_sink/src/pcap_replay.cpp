@@ -0,0 +1,245 @@
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <asam_cmp_data_sink/pcap_replay.h>
+
+#include <RawPacket.h>
+#include <limits>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+namespace pcap_index = asam_cmp_common_lib::pcap_index;
+
+namespace
+{
+    bool isAsamCmpFrame(const PcapFileReader::Frame& frame)
+    {
+        if (frame.linkType != pcpp::LINKTYPE_ETHERNET)
+            return false;
+
+        const size_t cmpOffset = pcap_index::getCmpMessageOffset(frame.data, frame.length);
+        return cmpOffset != 0 && frame.length > cmpOffset;
+    }
+
+    uint64_t windowEnd(uint64_t windowStart, std::chrono::nanoseconds duration)
+    {
+        if (duration.count() <= 0)
+            return std::numeric_limits<uint64_t>::max();
+        return windowStart + static_cast<uint64_t>(duration.count());
+    }
+}
+
+PcapReplay::~PcapReplay()
+{
+    stop();
+}
+
+void PcapReplay::start(const std::string& fileName,
+                       const Options& replayOptions,
+                       asam_cmp_common_lib::PcppPacketReceivedCallbackType packetReceivedCb)
+{
+    stop();
+
+    if (replayOptions.mode == Mode::OriginalTiming && !(replayOptions.speed > 0))
+        throw std::invalid_argument("Replay speed must be positive");
+    if (replayOptions.startOffset.count() < 0 || replayOptions.duration.count() < 0)
+        throw std::invalid_argument("Replay time window must not be negative");
+
+    reader = std::make_unique<PcapFileReader>(fileName);
+    index = reader->isPcapNg() ? PcapIndex::openFor(fileName) : nullptr;
+    options = replayOptions;
+    callback = std::move(packetReceivedCb);
+    stopRequested = false;
+    replayedFrames = 0;
+    skippedFrames = 0;
+    running = true;
+    replayThread = std::thread(&PcapReplay::replayLoop, this);
+}
+
+void PcapReplay::stop()
+{
+    {
+        std::scoped_lock lock{stopSync};
+        stopRequested = true;
+    }
+    stopCv.notify_all();
+
+    if (replayThread.joinable())
+        replayThread.join();
+
+    index.reset();
+    reader.reset();
+    callback = nullptr;
+}
+
+bool PcapReplay::isRunning() const noexcept
+{
+    return running.load(std::memory_order_acquire);
+}
+
+bool PcapReplay::isIndexed() const noexcept
+{
+    return index != nullptr;
+}
+
+uint64_t PcapReplay::getReplayedFrames() const noexcept
+{
+    return replayedFrames.load(std::memory_order_relaxed);
+}
+
+uint64_t PcapReplay::getSkippedFrames() const noexcept
+{
+    return skippedFrames.load(std::memory_order_relaxed);
+}
+
+void PcapReplay::replayLoop()
+{
+    if (index)
+        replayIndexed();
+    else
+        replaySequential();
+
+    running.store(false, std::memory_order_release);
+}
+
+void PcapReplay::replayIndexed()
+{
+    const size_t count = index->getCount();
+    if (count == 0)
+        return;
+
+    // Entry timestamps never decrease, so the window start is found by binary search
+    const uint64_t start = index->getEntry(0).timestamp + static_cast<uint64_t>(options.startOffset.count());
+    const uint64_t end = windowEnd(start, options.duration);
+
+    Pacing pacing;
+    PcapFileReader::Frame frame{};
+    for (size_t i = index->lowerBound(start); i < count; ++i)
+    {
+        const auto entry = index->getEntry(i);
+        if (entry.timestamp > end)
+            break;
+
+        if (!matchesEndpoints(entry))
+        {
+            skippedFrames.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (!reader->readAt(entry.offset, frame))
+            break;
+
+        if (!isAsamCmpFrame(frame))
+        {
+            skippedFrames.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (!deliver(frame, pacing))
+            break;
+    }
+}
+
+void PcapReplay::replaySequential()
+{
+    uint64_t start = 0;
+    uint64_t end = 0;
+    bool firstFrame = true;
+
+    Pacing pacing;
+    PcapFileReader::Frame frame{};
+    while (reader->next(frame))
+    {
+        if (firstFrame)
+        {
+            start = frame.timestamp + static_cast<uint64_t>(options.startOffset.count());
+            end = windowEnd(start, options.duration);
+            firstFrame = false;
+        }
+
+        if (frame.timestamp < start || frame.timestamp > end)
+            continue;
+
+        if (!isAsamCmpFrame(frame))
+        {
+            skippedFrames.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (!options.endpoints.empty())
+        {
+            PcapIndex::Entry entry{};
+            pcap_index::parseEndpoint(frame.data, frame.length, entry);
+            if (!matchesEndpoints(entry))
+            {
+                skippedFrames.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+        }
+
+        if (!deliver(frame, pacing))
+            break;
+    }
+}
+
+bool PcapReplay::deliver(const PcapFileReader::Frame& frame, Pacing& pacing)
+{
+    if (options.mode == Mode::OriginalTiming)
+    {
+        if (!pacing.started)
+        {
+            pacing.firstTimestamp = frame.timestamp;
+            pacing.startTime = std::chrono::steady_clock::now();
+            pacing.started = true;
+        }
+
+        // Timestamps going backwards are replayed immediately
+        const double offset =
+            frame.timestamp > pacing.firstTimestamp ? static_cast<double>(frame.timestamp - pacing.firstTimestamp) / options.speed : 0;
+        if (!waitUntil(pacing.startTime + std::chrono::nanoseconds(static_cast<int64_t>(offset))))
+            return false;
+    }
+    else if (stopRequested.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    // The packet refers to the mapped file, nothing is copied
+    pcpp::RawPacket packet(frame.data,
+                           static_cast<int>(frame.length),
+                           asam_cmp_common_lib::virtual_adapter::toTimespec(frame.timestamp),
+                           false,
+                           static_cast<pcpp::LinkLayerType>(frame.linkType));
+    callback(&packet, nullptr, nullptr);
+    replayedFrames.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool PcapReplay::matchesEndpoints(const PcapIndex::Entry& entry) const noexcept
+{
+    if (options.endpoints.empty())
+        return true;
+    if ((entry.flags & pcap_index::cmpMessage) == 0)
+        return false;
+
+    for (const auto& endpoint : options.endpoints)
+    {
+        if (endpoint.deviceId != entry.deviceId)
+            continue;
+
+        // Status messages are not bound to an interface, they are replayed for every selected device
+        if ((entry.flags & pcap_index::dataMessage) == 0)
+            return true;
+        if (endpoint.interfaceId == entry.interfaceId && endpoint.streamId == entry.streamId)
+            return true;
+    }
+
+    return false;
+}
+
+bool PcapReplay::waitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock lock{stopSync};
+    return !stopCv.wait_until(lock, deadline, [this] { return stopRequested.load(std::memory_order_relaxed); });
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
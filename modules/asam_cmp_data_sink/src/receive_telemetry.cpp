@@ -0,0 +1,18 @@
+#include <asam_cmp_data_sink/receive_telemetry.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+ReceiveTelemetry::ReceiveTelemetry(const std::shared_ptr<asam_cmp_common_lib::EthernetPcppItf>& ethernetWrapper)
+    : ethernetWrapper(ethernetWrapper)
+{
+}
+
+asam_cmp_common_lib::CaptureStatistics ReceiveTelemetry::getCaptureStatistics() const
+{
+    if (!ethernetWrapper)
+        return {};
+
+    return ethernetWrapper->getCaptureStatistics();
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
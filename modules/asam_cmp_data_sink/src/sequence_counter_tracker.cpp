@@ -0,0 +1,89 @@
+#include <asam_cmp_data_sink/sequence_counter_tracker.h>
+#include <algorithm>
+
+BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
+
+SequenceCounterStatistics SequenceCounterTracker::update(uint16_t deviceId, uint8_t streamId, uint16_t sequenceCounter)
+{
+    SequenceCounterStatistics statistics;
+
+    auto& state = getDeviceState(deviceId);
+    if (!state.initialized.test(streamId))
+    {
+        state.initialized.set(streamId);
+        resync(state, streamId, sequenceCounter);
+        return statistics;
+    }
+
+    auto& lastSequenceCounter = state.lastSequenceCounters[streamId];
+    auto& missingCounters = state.missingCounters[streamId];
+    auto& backwardSteps = state.backwardSteps[streamId];
+    const uint16_t diff = sequenceCounter - lastSequenceCounter;
+    if (diff == 0)
+    {
+        ++statistics.duplicate;
+    }
+    else if (diff < 0x8000)
+    {
+        statistics.lost += diff - 1;
+        lastSequenceCounter = sequenceCounter;
+        backwardSteps = 0;
+
+        // Counters skipped by this step become bits 0 to diff - 2, the previous last counter was received
+        missingCounters = diff < reorderWindow ? missingCounters << diff : 0;
+        const uint16_t skipped = std::min<uint16_t>(diff - 1, reorderWindow);
+        missingCounters |= skipped < reorderWindow ? (uint64_t{1} << skipped) - 1 : ~uint64_t{0};
+    }
+    else
+    {
+        const uint16_t back = lastSequenceCounter - sequenceCounter;
+        const uint64_t bit = back <= reorderWindow ? uint64_t{1} << (back - 1) : 0;
+        if (missingCounters & bit)
+        {
+            // The message was already counted as lost when the gap was detected
+            missingCounters &= ~bit;
+            ++statistics.outOfOrder;
+            --statistics.lost;
+        }
+        else if (bit == 0 || ++backwardSteps >= resyncBackwardSteps)
+        {
+            resync(state, streamId, sequenceCounter);
+        }
+        else
+        {
+            // A late copy of a message that was already received
+            ++statistics.duplicate;
+        }
+    }
+
+    return statistics;
+}
+
+void SequenceCounterTracker::resync(DeviceState& state, uint8_t streamId, uint16_t sequenceCounter)
+{
+    state.lastSequenceCounters[streamId] = sequenceCounter;
+    state.missingCounters[streamId] = 0;
+    state.backwardSteps[streamId] = 0;
+}
+
+void SequenceCounterTracker::reset()
+{
+    devices.clear();
+    lastDeviceState = nullptr;
+}
+
+SequenceCounterTracker::DeviceState& SequenceCounterTracker::getDeviceState(uint16_t deviceId)
+{
+    if (lastDeviceState != nullptr && lastDeviceId == deviceId)
+        return *lastDeviceState;
+
+    auto& state = devices[deviceId];
+    if (!state)
+        state = std::make_unique<DeviceState>();
+
+    lastDeviceId = deviceId;
+    lastDeviceState = state.get();
+    return *state;
+}
+
+END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
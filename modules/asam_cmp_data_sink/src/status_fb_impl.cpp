@@ -1,5 +1,6 @@
 #include <asam_cmp/capture_module_payload.h>
 #include <coreobjects/callable_info_factory.h>
+#include <coreobjects/unit_factory.h>
 #include <opendaq/component_type_private.h>
 #include <asam_cmp_data_sink/status_fb_impl.h>
 
@@ -8,10 +9,13 @@ BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 StatusFbImpl::StatusFbImpl(const ModuleInfoPtr& moduleInfo,
                            const ContextPtr& ctx,
                            const ComponentPtr& parent,
-                           const StringPtr& localId)
+                           const StringPtr& localId,
+                           const std::shared_ptr<ReceiveTelemetry>& telemetry)
     : FunctionBlockImpl(CreateType(moduleInfo), ctx, parent, localId)
+    , telemetry(telemetry ? telemetry : std::make_shared<ReceiveTelemetry>())
 {
     initProperties();
+    initTelemetryProperties();
 }
 
 FunctionBlockTypePtr StatusFbImpl::CreateType(const ModuleInfoPtr& moduleInfo)
@@ -67,6 +71,83 @@ void StatusFbImpl::initProperties()
     objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, proc);
 }
 
+void StatusFbImpl::initTelemetryProperties()
+{
+    StringPtr propName = "TelemetryRefreshInterval";
+    auto prop = IntPropertyBuilder(propName, telemetryRefreshInterval.count()).setMinValue(0).setMaxValue(60000).setUnit(Unit("ms")).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        std::scoped_lock lock{telemetrySync};
+        telemetryRefreshInterval = std::chrono::milliseconds(static_cast<Int>(args.getValue()));
+        telemetrySnapshotValid = false;
+    };
+
+    const auto ns = Unit("ns");
+    addTelemetryProperty("FramesReceived", &TelemetrySnapshot::framesReceived);
+    addTelemetryProperty("BytesReceived", &TelemetrySnapshot::bytesReceived, Unit("B"));
+    addTelemetryProperty("MessagesDecoded", &TelemetrySnapshot::messagesDecoded);
+    addTelemetryProperty("DecodeErrors", &TelemetrySnapshot::decodeErrors);
+    addTelemetryProperty("UnsupportedMessages", &TelemetrySnapshot::unsupportedMessages);
+    addTelemetryProperty("KernelDrops", &TelemetrySnapshot::kernelDrops);
+    addTelemetryProperty("InterfaceDrops", &TelemetrySnapshot::interfaceDrops);
+    addTelemetryProperty("DecodeTimeP50", &TelemetrySnapshot::decodeTimeP50, ns);
+    addTelemetryProperty("DecodeTimeP99", &TelemetrySnapshot::decodeTimeP99, ns);
+    addTelemetryProperty("DecodeTimeP999", &TelemetrySnapshot::decodeTimeP999, ns);
+    addTelemetryProperty("DecodeTimeMax", &TelemetrySnapshot::decodeTimeMax, ns);
+    addTelemetryProperty("PublishTimeP50", &TelemetrySnapshot::publishTimeP50, ns);
+    addTelemetryProperty("PublishTimeP99", &TelemetrySnapshot::publishTimeP99, ns);
+    addTelemetryProperty("PublishTimeP999", &TelemetrySnapshot::publishTimeP999, ns);
+    addTelemetryProperty("PublishTimeMax", &TelemetrySnapshot::publishTimeMax, ns);
+}
+
+void StatusFbImpl::addTelemetryProperty(const StringPtr& name, uint64_t TelemetrySnapshot::*field, const UnitPtr& unit)
+{
+    auto builder = IntPropertyBuilder(name, 0).setReadOnly(true);
+    if (unit.assigned())
+        builder.setUnit(unit);
+    objPtr.addProperty(builder.build());
+
+    // Values are taken from a snapshot, so all telemetry properties read within one refresh interval are consistent
+    objPtr.getOnPropertyValueRead(name) += [this, field](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        std::scoped_lock lock{telemetrySync};
+        args.setValue(static_cast<Int>(getTelemetrySnapshot().*field));
+    };
+}
+
+const StatusFbImpl::TelemetrySnapshot& StatusFbImpl::getTelemetrySnapshot()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (telemetrySnapshotValid && now - telemetrySnapshotTime < telemetryRefreshInterval)
+        return telemetrySnapshot;
+
+    TelemetrySnapshot snapshot;
+    snapshot.framesReceived = telemetry->framesReceived.load(std::memory_order_relaxed);
+    snapshot.bytesReceived = telemetry->bytesReceived.load(std::memory_order_relaxed);
+    snapshot.messagesDecoded = telemetry->messagesDecoded.load(std::memory_order_relaxed);
+    snapshot.decodeErrors = telemetry->decodeErrors.load(std::memory_order_relaxed);
+    snapshot.unsupportedMessages = telemetry->unsupportedMessages.load(std::memory_order_relaxed);
+
+    const auto captureStatistics = telemetry->getCaptureStatistics();
+    snapshot.kernelDrops = captureStatistics.packetsDropped;
+    snapshot.interfaceDrops = captureStatistics.packetsDroppedByInterface;
+
+    snapshot.decodeTimeP50 = telemetry->decodeTime.getValueAtPercentile(50.0);
+    snapshot.decodeTimeP99 = telemetry->decodeTime.getValueAtPercentile(99.0);
+    snapshot.decodeTimeP999 = telemetry->decodeTime.getValueAtPercentile(99.9);
+    snapshot.decodeTimeMax = telemetry->decodeTime.getMax();
+    snapshot.publishTimeP50 = telemetry->publishTime.getValueAtPercentile(50.0);
+    snapshot.publishTimeP99 = telemetry->publishTime.getValueAtPercentile(99.0);
+    snapshot.publishTimeP999 = telemetry->publishTime.getValueAtPercentile(99.9);
+    snapshot.publishTimeMax = telemetry->publishTime.getMax();
+
+    telemetrySnapshot = snapshot;
+    telemetrySnapshotTime = now;
+    telemetrySnapshotValid = true;
+    return telemetrySnapshot;
+}
+
 void StatusFbImpl::clear()
 {
     auto lock = this->getRecursiveConfigLock();
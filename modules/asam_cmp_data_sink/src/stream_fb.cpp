@@ -1,15 +1,34 @@
+#include <coreobjects/eval_value_factory.h>
 #include <opendaq/dimension_factory.h>
 
+#include <asam_cmp_common_lib/compact_can_layout.h>
+#include <asam_cmp_common_lib/trace.h>
 #include <asam_cmp_common_lib/unit_converter.h>
 #include <asam_cmp_data_sink/stream_fb.h>
 #include <opendaq/binary_data_packet_factory.h>
+#include <opendaq/custom_log.h>
 
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <sstream>
 
 
 BEGIN_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
 
+constexpr std::string_view IsEthernetBatching{"$EthernetBatching == true"};
+
+namespace
+{
+    std::string formatCanId(uint32_t id)
+    {
+        std::ostringstream text;
+        text << "0x" << std::uppercase << std::hex << id;
+        return text.str();
+    }
+}
+
 StreamFb::StreamFb(const ModuleInfoPtr& moduleInfo,
                    const ContextPtr& ctx,
                    const ComponentPtr& parent,
@@ -24,19 +43,203 @@ StreamFb::StreamFb(const ModuleInfoPtr& moduleInfo,
     , publisher(publisher)
     , updateDescriptors(init.payloadType == PayloadType::analog)
 {
+    initProperties();
     createSignals();
     buildDataDescriptor();
     buildAsyncDomainDescriptor();
 }
 
+StreamFb::~StreamFb()
+{
+    {
+        std::scoped_lock lock{ethernetBatchSync};
+        ethernetBatching = false;
+    }
+    ethernetBatchCv.notify_one();
+    if (ethernetBatchFlushThread.joinable())
+        ethernetBatchFlushThread.join();
+}
+
+void StreamFb::initProperties()
+{
+    StringPtr propName = "EthernetBatching";
+    auto prop = BoolPropertyBuilder(propName, false).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateEthernetBatchingInternal(); };
+
+    propName = "EthernetBatchMaxSize";
+    prop = IntPropertyBuilder(propName, 65536)
+               .setMinValue(static_cast<Int>(sizeof(EthernetBatchEntry)))
+               .setMaxValue(static_cast<Int>(std::numeric_limits<uint32_t>::max()))
+               .setVisible(EvalValue(IsEthernetBatching.data()))
+               .build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateEthernetBatchingInternal(); };
+
+    propName = "EthernetBatchMaxLatency";
+    prop = IntPropertyBuilder(propName, 10).setMinValue(0).setMaxValue(10000).setVisible(EvalValue(IsEthernetBatching.data())).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateEthernetBatchingInternal(); };
+
+    updateEthernetBatchingInternal();
+
+    propName = "CompactCanLayout";
+    prop = BoolPropertyBuilder(propName, false).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateCanLayoutInternal(); };
+
+    propName = "CanIdFilter";
+    prop = StringPropertyBuilder(propName, "").build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateCanIdFilterInternal(); };
+
+    propName = "CanDemuxIds";
+    prop = StringPropertyBuilder(propName, "").build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { updateCanDemuxInternal(); };
+
+    propName = "FilteredMessages";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    { args.setValue(filteredMessages.load(std::memory_order_relaxed)); };
+
+    addSequenceCounterProperty("LostMessages", lostMessages);
+    addSequenceCounterProperty("DuplicateMessages", duplicateMessages);
+    addSequenceCounterProperty("OutOfOrderMessages", outOfOrderMessages);
+}
+
+void StreamFb::addSequenceCounterProperty(const StringPtr& name, const std::atomic<int64_t>& counter)
+{
+    // Counters are updated on the receive thread without taking the component lock, the property reports them on read
+    objPtr.addProperty(IntPropertyBuilder(name, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(name) +=
+        [&counter](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { args.setValue(counter.load(std::memory_order_relaxed)); };
+}
+
+void StreamFb::updateEthernetBatchingInternal()
+{
+    const bool newBatching = objPtr.getPropertyValue("EthernetBatching");
+    {
+        std::scoped_lock lock{ethernetBatchSync};
+
+        ethernetBatchMaxSize = static_cast<Int>(objPtr.getPropertyValue("EthernetBatchMaxSize"));
+        ethernetBatchMaxLatency = std::chrono::milliseconds(static_cast<Int>(objPtr.getPropertyValue("EthernetBatchMaxLatency")));
+
+        if (newBatching != ethernetBatching)
+        {
+            flushEthernetBatch();
+            ethernetBatching = newBatching;
+            if (payloadType == PayloadType::ethernet)
+                buildEthernetDescriptor();
+        }
+    }
+    // Wakes the flush thread to apply a new latency budget or to stop
+    ethernetBatchCv.notify_one();
+
+    if (newBatching && !ethernetBatchFlushThread.joinable())
+        ethernetBatchFlushThread = std::thread(&StreamFb::ethernetBatchFlushLoop, this);
+    else if (!newBatching && ethernetBatchFlushThread.joinable())
+        ethernetBatchFlushThread.join();
+}
+
+void StreamFb::updateCanLayoutInternal()
+{
+    std::scoped_lock lock{canSettingsSync};
+
+    const bool newCompactCanLayout = objPtr.getPropertyValue("CompactCanLayout");
+    if (newCompactCanLayout == compactCanLayout)
+        return;
+
+    compactCanLayout = newCompactCanLayout;
+    if (payloadType == PayloadType::can || payloadType == PayloadType::canFd)
+        buildCanDescriptor();
+}
+
+void StreamFb::updateCanIdFilterInternal()
+{
+    const std::string list = objPtr.getPropertyValue("CanIdFilter").asPtr<IString>().toStdString();
+    try
+    {
+        asam_cmp_common_lib::CanIdFilter newFilter(list);
+
+        std::scoped_lock lock{canSettingsSync};
+        canIdFilter = std::move(newFilter);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        LOG_W("CAN ID filter \"{}\" is not applied: {}", list, e.what());
+    }
+}
+
+void StreamFb::updateCanDemuxInternal()
+{
+    const std::string list = objPtr.getPropertyValue("CanDemuxIds").asPtr<IString>().toStdString();
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    try
+    {
+        ranges = asam_cmp_common_lib::CanIdFilter::parseList(list);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        LOG_W("CAN demultiplexing \"{}\" is not applied: {}", list, e.what());
+        return;
+    }
+    std::sort(ranges.begin(), ranges.end());
+    ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+    std::scoped_lock lock{canSettingsSync};
+    for (const auto& output : canDemuxOutputs)
+    {
+        removeSignal(output.dataSignal);
+        removeSignal(output.domainSignal);
+    }
+    canDemuxOutputs.clear();
+    canDemuxMap.clear();
+
+    const bool isCan = payloadType == PayloadType::can || payloadType == PayloadType::canFd;
+    const auto domainDescriptor = createAsyncDomainDescriptor();
+    for (const auto& [first, last] : ranges)
+    {
+        const auto idText = first == last ? formatCanId(first) : formatCanId(first) + "-" + formatCanId(last);
+        const auto localIdSuffix = first == last ? formatCanId(first) : formatCanId(first) + "_" + formatCanId(last);
+
+        CanDemuxOutput output;
+        output.dataSignal = createAndAddSignal("data_" + localIdSuffix);
+        output.dataSignal.setName("Data " + idText);
+        output.domainSignal = createAndAddSignal("time_" + localIdSuffix, nullptr, false);
+        output.domainSignal.setName("Time " + idText);
+        output.domainSignal.setDescriptor(domainDescriptor);
+        if (isCan)
+            output.dataSignal.setDescriptor(dataSignal.getDescriptor());
+        output.dataSignal.setDomainSignal(output.domainSignal);
+
+        canDemuxMap.add(first, last, canDemuxOutputs.size());
+        canDemuxOutputs.push_back(std::move(output));
+    }
+}
+
 void StreamFb::setPayloadType(PayloadType type)
 {
+    {
+        std::scoped_lock lock{ethernetBatchSync};
+        flushEthernetBatch();
+    }
+
     updateDescriptors = payloadType == PayloadType::analog || type == PayloadType::analog;
     StreamCommonFbImpl::setPayloadType(type);
 
     if (payloadType != PayloadType::analog)
     {
-        buildDataDescriptor();
+        {
+            std::scoped_lock lock{canSettingsSync};
+            buildDataDescriptor();
+        }
         if (updateDescriptors)
         {
             buildAsyncDomainDescriptor();
@@ -60,6 +263,13 @@ void StreamFb::receive(const std::shared_ptr<Packet>& packet)
     }
 }
 
+void StreamFb::receive(const SequenceCounterStatistics& statistics)
+{
+    lostMessages.fetch_add(statistics.lost, std::memory_order_relaxed);
+    duplicateMessages.fetch_add(statistics.duplicate, std::memory_order_relaxed);
+    outOfOrderMessages.fetch_add(statistics.outOfOrder, std::memory_order_relaxed);
+}
+
 void StreamFb::receive(const std::vector<std::shared_ptr<Packet>>& packets)
 {
     if (packets.front()->getPayload().getType() != payloadType)
@@ -90,6 +300,10 @@ void StreamFb::updateStreamIdInternal()
 
     publisher.unsubscribe({deviceId, interfaceId, oldStreamId}, this);
     publisher.subscribe({deviceId, interfaceId, streamId}, this);
+
+    lostMessages = 0;
+    duplicateMessages = 0;
+    outOfOrderMessages = 0;
 }
 
 void StreamFb::createSignals()
@@ -119,29 +333,40 @@ void StreamFb::buildDataDescriptor()
 
 void StreamFb::buildCanDescriptor()
 {
-    const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
-    const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
-
-    const auto dataDescriptor =
-        DataDescriptorBuilder()
-            .setName("Data")
-            .setSampleType(SampleType::UInt8)
-            .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
-            .build();
-
-    const auto canMsgDescriptor = DataDescriptorBuilder()
-                                      .setSampleType(SampleType::Struct)
-                                      .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
-                                      .setName("CAN")
-                                      .build();
+    DataDescriptorPtr canMsgDescriptor;
+    if (compactCanLayout)
+    {
+        canMsgDescriptor = payloadType == PayloadType::can ? asam_cmp_common_lib::compact_can::createClassicCanDescriptor()
+                                                           : asam_cmp_common_lib::compact_can::createCanFdDescriptor();
+    }
+    else
+    {
+        const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+        const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+
+        const auto dataDescriptor =
+            DataDescriptorBuilder()
+                .setName("Data")
+                .setSampleType(SampleType::UInt8)
+                .setDimensions(List<IDimension>(DimensionBuilder().setRule(LinearDimensionRule(0, 1, 64)).setName("Dimension").build()))
+                .build();
+
+        canMsgDescriptor = DataDescriptorBuilder()
+                               .setSampleType(SampleType::Struct)
+                               .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+                               .setName("CAN")
+                               .build();
+    }
 
     dataSignal.setDescriptor(canMsgDescriptor);
+    for (const auto& output : canDemuxOutputs)
+        output.dataSignal.setDescriptor(canMsgDescriptor);
 }
 
 void StreamFb::buildEthernetDescriptor()
 {
     auto metadata = Dict<IString, IString>();
-    metadata["DataType"] = "Ethernet";
+    metadata["DataType"] = ethernetBatching ? "EthernetBatch" : "Ethernet";
     const auto ethernetMsgDescriptor =
         DataDescriptorBuilder()
         .setSampleType(SampleType::Binary)
@@ -154,11 +379,12 @@ void StreamFb::buildEthernetDescriptor()
 void StreamFb::buildAnalogDescriptor(const AnalogPayload& payload)
 {
     const auto inputDataType = payload.getSampleDt() == AnalogPayload::SampleDt::aInt16 ? SampleType::Int16 : SampleType::Int32;
-    const auto scalar = payload.getSampleScalar();
-    const auto offset = payload.getSampleOffset();
-    const auto minValue = offset;
-    const auto intSize = inputDataType == SampleType::Int16 ? 16 : 32;
-    const auto maxValue = scalar * pow(2, intSize) + offset;
+    const double scalar = payload.getSampleScalar();
+    const double offset = payload.getSampleOffset();
+    // Int16 samples use the full signed range, Int32 samples are sent in 2^24 steps above the offset
+    const auto minValue = inputDataType == SampleType::Int16 ? offset + scalar * std::numeric_limits<int16_t>::min() : offset;
+    const auto maxValue = inputDataType == SampleType::Int16 ? offset + scalar * std::numeric_limits<int16_t>::max()
+                                                             : offset + scalar * (1LL << 24);
 
     const auto analogDescriptor = DataDescriptorBuilder()
                                       .setName("Analog")
@@ -177,15 +403,18 @@ void StreamFb::buildAnalogDescriptor(const AnalogPayload& payload)
 
 void StreamFb::buildAsyncDomainDescriptor()
 {
-    const auto domainDescriptor = DataDescriptorBuilder()
-                                      .setSampleType(SampleType::UInt64)
-                                      .setUnit(Unit("s", -1, "seconds", "time"))
-                                      .setTickResolution(Ratio(1, 1000000000))
-                                      .setOrigin(getEpoch())
-                                      .setName("Time")
-                                      .build();
+    domainSignal.setDescriptor(createAsyncDomainDescriptor());
+}
 
-    domainSignal.setDescriptor(domainDescriptor);
+DataDescriptorPtr StreamFb::createAsyncDomainDescriptor()
+{
+    return DataDescriptorBuilder()
+        .setSampleType(SampleType::UInt64)
+        .setUnit(Unit("s", -1, "seconds", "time"))
+        .setTickResolution(Ratio(1, 1000000000))
+        .setOrigin(getEpoch())
+        .setName("Time")
+        .build();
 }
 
 void StreamFb::buildSyncDomainDescriptor(const float sampleInterval)
@@ -206,34 +435,144 @@ void StreamFb::buildSyncDomainDescriptor(const float sampleInterval)
 }
 
 void StreamFb::processCanData(const std::vector<std::shared_ptr<Packet>>& packets)
+{
+    ASAM_CMP_TRACE_SCOPE("sink::StreamFb::processCanData");
+    std::scoped_lock lock{canSettingsSync};
+    const auto& outputPackets = canIdFilter.isEmpty() ? packets : filterCanPackets(packets);
+    if (outputPackets.empty())
+        return;
+
+    if (canDemuxOutputs.empty())
+        sendCanPackets(outputPackets, dataSignal, domainSignal);
+    else
+        demuxCanPackets(outputPackets);
+}
+
+const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& StreamFb::filterCanPackets(const std::vector<std::shared_ptr<Packet>>& packets)
+{
+    filteredCanPackets.clear();
+    for (auto& packet : packets)
+    {
+        if (canIdFilter.contains(static_cast<const CanPayload&>(packet->getPayload()).getId()))
+            filteredCanPackets.push_back(packet);
+    }
+
+    filteredMessages.fetch_add(static_cast<int64_t>(packets.size() - filteredCanPackets.size()), std::memory_order_relaxed);
+    return filteredCanPackets;
+}
+
+void StreamFb::demuxCanPackets(const std::vector<std::shared_ptr<Packet>>& packets)
+{
+    // Messages of IDs without a demultiplexed output stay on the combined signal
+    unmatchedCanPackets.clear();
+    for (auto& packet : packets)
+    {
+        const auto index = canDemuxMap.find(static_cast<const CanPayload&>(packet->getPayload()).getId());
+        if (index == asam_cmp_common_lib::CanIdMap::notFound)
+            unmatchedCanPackets.push_back(packet);
+        else
+            canDemuxOutputs[index].packets.push_back(packet);
+    }
+
+    for (auto& output : canDemuxOutputs)
+    {
+        if (output.packets.empty())
+            continue;
+
+        sendCanPackets(output.packets, output.dataSignal, output.domainSignal);
+        output.packets.clear();
+    }
+
+    if (!unmatchedCanPackets.empty())
+        sendCanPackets(unmatchedCanPackets, dataSignal, domainSignal);
+}
+
+void StreamFb::sendCanPackets(const std::vector<std::shared_ptr<Packet>>& packets,
+                              const SignalConfigPtr& outputSignal,
+                              const SignalConfigPtr& outputDomainSignal)
+{
+    if (!compactCanLayout)
+        sendCanStructData<CANData>(packets, outputSignal, outputDomainSignal);
+    else if (payloadType == PayloadType::can)
+        sendCanStructData<asam_cmp_common_lib::compact_can::ClassicCanData>(packets, outputSignal, outputDomainSignal);
+    else
+        sendCanFdCompactData(packets, outputSignal, outputDomainSignal);
+}
+
+template <typename CanSample>
+void StreamFb::sendCanStructData(const std::vector<std::shared_ptr<Packet>>& packets,
+                                 const SignalConfigPtr& outputSignal,
+                                 const SignalConfigPtr& outputDomainSignal)
 {
     const uint64_t newSamples = packets.size();
     auto timestamp = packets.front()->getTimestamp();
 
-    const auto domainPacket = DataPacket(domainSignal.getDescriptor(), newSamples, timestamp);
+    const auto domainPacket = DataPacket(outputDomainSignal.getDescriptor(), newSamples, timestamp);
     auto domainBuffer = static_cast<uint64_t*>(domainPacket.getRawData());
 
-    const auto dataPacket = DataPacketWithDomain(domainPacket, dataSignal.getDescriptor(), newSamples);
-    auto buffer = reinterpret_cast<CANData*>(dataPacket.getRawData());
+    const auto dataPacket = DataPacketWithDomain(domainPacket, outputSignal.getDescriptor(), newSamples);
+    auto buffer = reinterpret_cast<CanSample*>(dataPacket.getRawData());
 
     for (auto& packet : packets)
     {
         auto& payload = static_cast<const CanPayload&>(packet->getPayload());
         buffer->arbId = payload.getId();
-        buffer->length = payload.getDataLength();
+        buffer->length = static_cast<uint8_t>(std::min<size_t>(payload.getDataLength(), sizeof(buffer->data)));
         memcpy(buffer->data, payload.getData(), buffer->length);
 
         *domainBuffer++ = packet->getTimestamp();
         buffer++;
     }
 
-    dataSignal.sendPacket(dataPacket);
-    domainSignal.sendPacket(domainPacket);
+    outputSignal.sendPacket(dataPacket);
+    outputDomainSignal.sendPacket(domainPacket);
+}
+
+void StreamFb::sendCanFdCompactData(const std::vector<std::shared_ptr<Packet>>& packets,
+                                    const SignalConfigPtr& outputSignal,
+                                    const SignalConfigPtr& outputDomainSignal)
+{
+    using namespace asam_cmp_common_lib::compact_can;
+
+    size_t sampleSize = sizeof(CanFdHeader);
+    for (auto& packet : packets)
+    {
+        auto& payload = static_cast<const CanPayload&>(packet->getPayload());
+        sampleSize += getCanFdFrameSize(static_cast<uint8_t>(std::min<size_t>(payload.getDataLength(), canFdMaxLength)));
+    }
+
+    auto timestamp = packets.front()->getTimestamp();
+    const auto domainPacket = DataPacket(outputDomainSignal.getDescriptor(), 1, timestamp);
+    *static_cast<uint64_t*>(domainPacket.getRawData()) = timestamp;
+
+    const auto dataPacket = BinaryDataPacket(domainPacket, outputSignal.getDescriptor(), sampleSize);
+    auto buffer = static_cast<uint8_t*>(dataPacket.getRawData());
+
+    const CanFdHeader header{static_cast<uint32_t>(packets.size()), 0};
+    memcpy(buffer, &header, sizeof(header));
+    buffer += sizeof(header);
+
+    for (auto& packet : packets)
+    {
+        auto& payload = static_cast<const CanPayload&>(packet->getPayload());
+        const auto length = static_cast<uint8_t>(std::min<size_t>(payload.getDataLength(), canFdMaxLength));
+        buffer = writeCanFdFrame(buffer, packet->getTimestamp(), payload.getId(), payload.getData(), length);
+    }
+
+    outputSignal.sendPacket(dataPacket);
+    outputDomainSignal.sendPacket(domainPacket);
 }
 
 void StreamFb::processEthernetData(const std::vector<std::shared_ptr<Packet>>& packets)
 {
-    static constexpr size_t analogMessagePayloadSize{6};
+    ASAM_CMP_TRACE_SCOPE("sink::StreamFb::processEthernetData");
+    std::scoped_lock lock{ethernetBatchSync};
+    if (ethernetBatching)
+    {
+        processEthernetDataBatched(packets);
+        return;
+    }
+
     for (auto& packet : packets)
     {
         auto timestamp = packet->getTimestamp();
@@ -242,7 +581,7 @@ void StreamFb::processEthernetData(const std::vector<std::shared_ptr<Packet>>& p
         auto domainBuffer = static_cast<uint64_t*>(domainPacket.getRawData());
 
         auto& payload = static_cast<const EthernetPayload&>(packet->getPayload());
-        auto payloadLen = payload.getLength() - analogMessagePayloadSize;
+        auto payloadLen = getEthernetFrameLength(payload);
 
         const auto dataPacket = BinaryDataPacket(domainPacket, dataSignal.getDescriptor(), payloadLen);
         auto buffer = static_cast<uint8_t*>(dataPacket.getRawData());
@@ -254,8 +593,95 @@ void StreamFb::processEthernetData(const std::vector<std::shared_ptr<Packet>>& p
     }
 }
 
+void StreamFb::processEthernetDataBatched(const std::vector<std::shared_ptr<Packet>>& packets)
+{
+    ASAM_CMP_TRACE_SCOPE("sink::StreamFb::processEthernetDataBatched");
+    // Decoded packets are kept alive until the batch is flushed, so frame data is copied only once
+    for (auto& packet : packets)
+    {
+        const auto entrySize = sizeof(EthernetBatchEntry) + getEthernetFrameLength(static_cast<const EthernetPayload&>(packet->getPayload()));
+        if (!ethernetBatch.empty() && sizeof(EthernetBatchHeader) + ethernetBatchSize + entrySize > ethernetBatchMaxSize)
+            flushEthernetBatch();
+
+        if (ethernetBatch.empty())
+        {
+            ethernetBatchStartTime = std::chrono::steady_clock::now();
+            ethernetBatchCv.notify_one();
+        }
+
+        ethernetBatch.push_back(packet);
+        ethernetBatchSize += entrySize;
+    }
+
+    // A batch that stays open after this is flushed by ethernetBatchFlushLoop when its latency budget expires
+    if (std::chrono::steady_clock::now() - ethernetBatchStartTime >= ethernetBatchMaxLatency)
+        flushEthernetBatch();
+}
+
+void StreamFb::ethernetBatchFlushLoop()
+{
+    std::unique_lock lock{ethernetBatchSync};
+    while (ethernetBatching)
+    {
+        if (ethernetBatch.empty())
+        {
+            ethernetBatchCv.wait(lock);
+            continue;
+        }
+
+        const auto deadline = ethernetBatchStartTime + ethernetBatchMaxLatency;
+        if (std::chrono::steady_clock::now() >= deadline)
+            flushEthernetBatch();
+        else
+            ethernetBatchCv.wait_until(lock, deadline);
+    }
+}
+
+void StreamFb::flushEthernetBatch()
+{
+    ASAM_CMP_TRACE_SCOPE("sink::StreamFb::flushEthernetBatch");
+    if (ethernetBatch.empty())
+        return;
+
+    const auto frameCount = ethernetBatch.size();
+    const auto timestamp = ethernetBatch.front()->getTimestamp();
+
+    const auto domainPacket = DataPacket(domainSignal.getDescriptor(), 1, timestamp);
+    *static_cast<uint64_t*>(domainPacket.getRawData()) = timestamp;
+
+    const auto dataPacket = BinaryDataPacket(domainPacket, dataSignal.getDescriptor(), sizeof(EthernetBatchHeader) + ethernetBatchSize);
+    auto buffer = static_cast<uint8_t*>(dataPacket.getRawData());
+
+    auto header = reinterpret_cast<EthernetBatchHeader*>(buffer);
+    header->frameCount = static_cast<uint32_t>(frameCount);
+    header->reserved = 0;
+
+    auto entry = reinterpret_cast<EthernetBatchEntry*>(buffer + sizeof(EthernetBatchHeader));
+    size_t offset = sizeof(EthernetBatchHeader) + frameCount * sizeof(EthernetBatchEntry);
+    for (const auto& packet : ethernetBatch)
+    {
+        const auto& payload = static_cast<const EthernetPayload&>(packet->getPayload());
+        const auto length = getEthernetFrameLength(payload);
+
+        entry->timestamp = packet->getTimestamp();
+        entry->offset = static_cast<uint32_t>(offset);
+        entry->length = static_cast<uint32_t>(length);
+        memcpy(buffer + offset, payload.getData(), length);
+
+        offset += length;
+        ++entry;
+    }
+
+    ethernetBatch.clear();
+    ethernetBatchSize = 0;
+
+    dataSignal.sendPacket(dataPacket);
+    domainSignal.sendPacket(domainPacket);
+}
+
 void StreamFb::processSyncData(const std::shared_ptr<Packet>& packet)
 {
+    ASAM_CMP_TRACE_SCOPE("sink::StreamFb::processSyncData");
     auto& analogPayload = static_cast<const AnalogPayload&>(packet->getPayload());
 
     if (updateDescriptors)
@@ -329,4 +755,9 @@ UnitPtr StreamFb::asamCmpToOpenDaqUnit(AnalogPayload::Unit asamCmpUnit)
     return Unit(symbol, -1, "", "");
 }
 
+size_t StreamFb::getEthernetFrameLength(const EthernetPayload& payload)
+{
+    return payload.getLength() - sizeof(EthernetData);
+}
+
 END_NAMESPACE_ASAM_CMP_DATA_SINK_MODULE
@@ -9,6 +9,7 @@ using namespace daq;
 using ASAM::CMP::Packet;
 using daq::modules::asam_cmp_data_sink_module::DataPacketsPublisher;
 using daq::modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+using daq::modules::asam_cmp_data_sink_module::SequenceCounterStatistics;
 
 using DataHandlerImpl = ImplementationOf<IAsamCmpPacketsSubscriber>;
 
@@ -16,6 +17,7 @@ struct DataHandlerMock : public DataHandlerImpl
 {
     MOCK_METHOD((void), receive, (const std::shared_ptr<ASAM::CMP::Packet>& packet), (override));
     MOCK_METHOD((void), receive, (const std::vector<std::shared_ptr<ASAM::CMP::Packet>>& packets), (override));
+    MOCK_METHOD((void), receive, (const SequenceCounterStatistics& statistics), (override));
 };
 
 class CallsMultiMapTest : public testing::Test
@@ -113,3 +115,17 @@ TEST_F(CallsMultiMapTest, Erase)
     EXPECT_CALL(handler2, receive(packet));
     publisher.publish({packet->getDeviceId(), packet->getInterfaceId(), packet->getStreamId()}, packet);
 }
+
+TEST_F(CallsMultiMapTest, ProcessSequenceCounterStatistics)
+{
+    DataHandlerMock handler1, handler2;
+    publisher.subscribe({deviceId, interfaceId, streamId}, &handler1);
+    publisher.subscribe({deviceId, interfaceId + 1, streamId}, &handler2);
+
+    SequenceCounterStatistics statistics;
+    statistics.lost = 2;
+
+    EXPECT_CALL(handler1, receive(testing::Matcher<const SequenceCounterStatistics&>(testing::Field(&SequenceCounterStatistics::lost, 2))));
+    EXPECT_CALL(handler2, receive(testing::An<const SequenceCounterStatistics&>())).Times(0);
+    publisher.publish({deviceId, interfaceId, streamId}, statistics);
+}
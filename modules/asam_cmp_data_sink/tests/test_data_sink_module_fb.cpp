@@ -1,4 +1,5 @@
 #include <EthLayer.h>
+#include <VlanLayer.h>
 #include <PayloadLayer.h>
 #include <gtest/gtest.h>
 #include <opendaq/context_factory.h>
@@ -14,6 +15,11 @@
 
 #include <Packet.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
 using namespace daq;
 using daq::asam_cmp_common_lib::PcppPacketReceivedCallbackType;
 
@@ -217,3 +223,125 @@ TEST_F(DataSinkModuleFbTest, ProcessAggregatedMessage)
     const size_t sampleCount = dataPacket.getSampleCount();
     ASSERT_EQ(sampleCount, messagesCount);
 }
+
+TEST_F(DataSinkModuleFbTest, ProcessVlanTaggedMessage)
+{
+    constexpr uint16_t asamCmpEtherType = 0x99FE;
+    constexpr int canPayloadType = 1;
+
+    // CAN Data Message of device 0, interface 1, stream 1 with an 8 byte payload
+    const std::vector<uint8_t> cmpData = {0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x17, 0xef, 0xf0, 0xeb, 0x13, 0x6b, 0xc1,
+                                          0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                          0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x00, 0x01, 0x02, 0x03, 0x04,
+                                          0x05, 0x06, 0x07};
+
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    auto captureFb = dataSinkFb.getFunctionBlocks().getItemAt(0);
+    captureFb.getPropertyValue("AddInterface").execute();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    interfaceFb.getPropertyValue("AddStream").execute();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    PacketReaderPtr reader = PacketReader(streamFb.getSignals()[0]);
+
+    pcpp::EthLayer ethernetLayer(pcpp::MacAddress("00:50:43:11:22:33"), pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), PCPP_ETHERTYPE_VLAN);
+    pcpp::VlanLayer vlanLayer(0, false, 5, asamCmpEtherType);
+    pcpp::PayloadLayer payloadLayer(cmpData.data(), cmpData.size());
+    pcpp::Packet newPacket;
+    newPacket.addLayer(&ethernetLayer);
+    newPacket.addLayer(&vlanLayer);
+    newPacket.addLayer(&payloadLayer);
+    newPacket.computeCalculateFields();
+
+    packetReceivedCallback(newPacket.getRawPacket(), nullptr, nullptr);
+
+    auto packet = reader.read();
+    ASSERT_NE(packet, nullptr);
+    ASSERT_EQ(packet.getType(), PacketType::Event);
+    packet = reader.read();
+    ASSERT_NE(packet, nullptr);
+    ASSERT_EQ(packet.getType(), PacketType::Data);
+    ASSERT_EQ(DataPacketPtr(packet).getSampleCount(), 1u);
+}
+
+TEST_F(DataSinkModuleFbTest, ReplayPcapFile)
+{
+    constexpr uint16_t asamCmpEtherType = 0x99FE;
+    constexpr int canPayloadType = 1;
+
+    // CAN Data Message of device 0, interface 1, stream 1 with an 8 byte payload
+    const std::vector<uint8_t> cmpData = {0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x17, 0xef, 0xf0, 0xeb, 0x13, 0x6b, 0xc1,
+                                          0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                          0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x00, 0x01, 0x02, 0x03, 0x04,
+                                          0x05, 0x06, 0x07};
+
+    pcpp::EthLayer cmpEthernetLayer(pcpp::MacAddress("00:50:43:11:22:33"), pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), asamCmpEtherType);
+    pcpp::PayloadLayer cmpPayloadLayer(cmpData.data(), cmpData.size());
+    pcpp::Packet cmpPacket;
+    cmpPacket.addLayer(&cmpEthernetLayer);
+    cmpPacket.addLayer(&cmpPayloadLayer);
+    cmpPacket.computeCalculateFields();
+
+    const auto fileName = (std::filesystem::temp_directory_path() / "asam_cmp_replay_test.pcap").string();
+    {
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        auto put32 = [&file](uint32_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        auto putRecord = [&](const uint8_t* data, uint32_t size)
+        {
+            put32(1);
+            put32(0);
+            put32(size);
+            put32(size);
+            file.write(reinterpret_cast<const char*>(data), size);
+        };
+
+        put32(0xA1B2C3D4);
+        put32(0x00040002);
+        put32(0);
+        put32(0);
+        put32(65535);
+        put32(1);
+
+        // IPv4 EtherType, skipped by the replay
+        std::vector<uint8_t> otherFrame(60, 0);
+        otherFrame[12] = 0x08;
+        putRecord(otherFrame.data(), static_cast<uint32_t>(otherFrame.size()));
+        putRecord(cmpPacket.getRawPacket()->getRawData(), static_cast<uint32_t>(cmpPacket.getRawPacket()->getRawDataLen()));
+    }
+
+    auto dataSinkFb = funcBlock.getFunctionBlocks().getItemAt(1);
+    dataSinkFb.getPropertyValue("AddCaptureModuleEmpty").execute();
+    auto captureFb = dataSinkFb.getFunctionBlocks().getItemAt(0);
+    captureFb.getPropertyValue("AddInterface").execute();
+    auto interfaceFb = captureFb.getFunctionBlocks().getItemAt(0);
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    interfaceFb.getPropertyValue("AddStream").execute();
+    auto streamFb = interfaceFb.getFunctionBlocks().getItemAt(0);
+    PacketReaderPtr reader = PacketReader(streamFb.getSignals()[0]);
+
+    funcBlock.setPropertyValue("ReplayFile", fileName);
+    funcBlock.getPropertyValue("StartReplay").execute();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (static_cast<bool>(funcBlock.getPropertyValue("ReplayActive")) && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_FALSE(static_cast<bool>(funcBlock.getPropertyValue("ReplayActive")));
+    ASSERT_EQ(static_cast<Int>(funcBlock.getPropertyValue("ReplayedFrames")), 1);
+
+    auto packet = reader.read();
+    ASSERT_EQ(packet.getType(), PacketType::Event);
+    packet = reader.read();
+    ASSERT_EQ(packet.getType(), PacketType::Data);
+
+    funcBlock.getPropertyValue("StopReplay").execute();
+    std::filesystem::remove(fileName);
+}
+
+TEST_F(DataSinkModuleFbTest, ReplayMissingFile)
+{
+    funcBlock.setPropertyValue("ReplayFile", "asam_cmp_missing_file.pcap");
+    ASSERT_ANY_THROW(funcBlock.getPropertyValue("StartReplay").execute());
+    ASSERT_FALSE(static_cast<bool>(funcBlock.getPropertyValue("ReplayActive")));
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/can_signal_decoder.h>
+#include <asam_cmp_data_sink/dbc_decoder_fb.h>
+#include <asam_cmp_data_sink/dbc_file.h>
+#include <opendaq/context_factory.h>
+#include <opendaq/scheduler_factory.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace daq;
+using daq::modules::asam_cmp_data_sink_module::CanSignalDecoder;
+using daq::modules::asam_cmp_data_sink_module::DbcDecoderFb;
+using daq::modules::asam_cmp_data_sink_module::DbcFile;
+
+namespace
+{
+    constexpr const char* dbcContent = R"(VERSION ""
+
+NS_ :
+    CM_
+    BA_
+
+BU_: ECU Dash
+
+BO_ 256 Engine: 8 ECU
+ SG_ Speed : 0|16@1+ (0.1,0) [0|6553.5] "km/h" Dash
+ SG_ Temp : 16|8@1- (1,-40) [-40|215] "degC" Dash
+ SG_ Motorola : 39|12@0+ (1,0) [0|4095] "" Dash
+ SG_ Flag : 63|1@1+ (1,0) [0|1] "" Dash
+
+BO_ 2566844926 Mux: 8 ECU
+ SG_ Selector M : 0|8@1+ (1,0) [0|255] "" Dash
+ SG_ A m1 : 8|16@1+ (1,0) [0|0] "" Dash
+ SG_ B m2 : 8|32@1- (0.5,0) [0|0] "" Dash
+ SG_ F m3 : 8|32@1- (1,0) [0|0] "" Dash
+
+BO_ 512 Wide: 16 ECU
+ SG_ W : 4|64@1+ (1,0) [0|0] "" Dash
+ SG_ Big : 71|16@0- (1,0) [0|0] "" Dash
+
+BO_ 3221225472 VECTOR__INDEPENDENT_SIG_MSG: 0 Vector__XXX
+ SG_ Orphan : 0|8@1+ (1,0) [0|0] "" Vector__XXX
+
+CM_ SG_ 256 Speed "Vehicle speed";
+SIG_VALTYPE_ 2566844926 F : 1;
+)";
+
+    // Decodes a frame and returns the values by signal name
+    std::map<std::string, double> decode(CanSignalDecoder& decoder, uint32_t arbId, const std::vector<uint8_t>& data)
+    {
+        std::map<std::string, double> result;
+        decoder.decode(arbId,
+                       data.data(),
+                       data.size(),
+                       [&](size_t groupIndex, const double* values)
+                       {
+                           const auto& group = decoder.getGroups()[groupIndex];
+                           for (size_t i = 0; i < group.signalCount; ++i)
+                               result[decoder.getSignal(group.firstSignal + i).name] = values[i];
+                       });
+        return result;
+    }
+}
+
+TEST(DbcDecoderTest, Parse)
+{
+    const auto messages = DbcFile::parse(dbcContent);
+    ASSERT_EQ(messages.size(), 3u);
+
+    EXPECT_EQ(messages[0].name, "Engine");
+    EXPECT_EQ(messages[0].id, 256u);
+    EXPECT_FALSE(messages[0].extended);
+    ASSERT_EQ(messages[0].dbcSignals.size(), 4u);
+    const auto& temp = messages[0].dbcSignals[1];
+    EXPECT_EQ(temp.name, "Temp");
+    EXPECT_EQ(temp.startBit, 16u);
+    EXPECT_EQ(temp.length, 8u);
+    EXPECT_TRUE(temp.isSigned);
+    EXPECT_FALSE(temp.bigEndian);
+    EXPECT_EQ(temp.offset, -40.0);
+    EXPECT_EQ(temp.unit, "degC");
+    EXPECT_TRUE(messages[0].dbcSignals[2].bigEndian);
+
+    EXPECT_EQ(messages[1].id, 0x18FEF1FEu);
+    EXPECT_TRUE(messages[1].extended);
+    EXPECT_EQ(messages[1].dbcSignals[0].multiplex, DbcFile::Multiplex::multiplexor);
+    EXPECT_EQ(messages[1].dbcSignals[2].multiplex, DbcFile::Multiplex::multiplexed);
+    EXPECT_EQ(messages[1].dbcSignals[2].multiplexValue, 2u);
+    EXPECT_EQ(messages[1].dbcSignals[3].valueType, DbcFile::ValueType::float32);
+}
+
+TEST(DbcDecoderTest, ParseErrors)
+{
+    EXPECT_THROW(DbcFile::parse("BO_ 1 M: 8 X\n SG_ S : 0|8@2+ (1,0) [0|0] \"\" X\n"), std::runtime_error);
+    EXPECT_THROW(DbcFile::parse("BO_ 1 M: 8 X\n SG_ S : 0|0@1+ (1,0) [0|0] \"\" X\n"), std::runtime_error);
+    EXPECT_THROW(DbcFile::parse("BO_ 1 M: 8 X\n SG_ S : 0|8@1+ (1,0 [0|0] \"\" X\n"), std::runtime_error);
+    EXPECT_THROW(DbcFile::parse(" SG_ S : 0|8@1+ (1,0) [0|0] \"\" X\n"), std::runtime_error);
+    EXPECT_THROW(DbcFile("nonexistent.dbc"), std::runtime_error);
+}
+
+TEST(DbcDecoderTest, DecodeIntelAndMotorola)
+{
+    CanSignalDecoder decoder(DbcFile::parse(dbcContent));
+    EXPECT_EQ(decoder.getSignalCount(), 10u);
+
+    auto values = decode(decoder, 256, {0xD2, 0x04, 0xFB, 0x00, 0xAB, 0xC0, 0x00, 0x80});
+    ASSERT_EQ(values.size(), 4u);
+    EXPECT_DOUBLE_EQ(values["Speed"], 123.4);
+    EXPECT_DOUBLE_EQ(values["Temp"], -45.0);
+    EXPECT_DOUBLE_EQ(values["Motorola"], 0xABC);
+    EXPECT_DOUBLE_EQ(values["Flag"], 1.0);
+
+    // Too short for the message signals
+    EXPECT_TRUE(decode(decoder, 256, {0xD2, 0x04, 0xFB}).empty());
+    size_t calls = 0;
+    EXPECT_FALSE(decoder.decode(0x123, nullptr, 0, [&](size_t, const double*) { ++calls; }));
+    EXPECT_EQ(calls, 0u);
+}
+
+TEST(DbcDecoderTest, DecodeMultiplexed)
+{
+    CanSignalDecoder decoder(DbcFile::parse(dbcContent));
+
+    auto values = decode(decoder, 0x18FEF1FE, {2, 0xF6, 0xFF, 0xFF, 0xFF, 0, 0, 0});
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_DOUBLE_EQ(values["Selector"], 2.0);
+    EXPECT_DOUBLE_EQ(values["B"], -5.0);
+
+    values = decode(decoder, 0x18FEF1FE, {3, 0x00, 0x00, 0xC0, 0x3F, 0, 0, 0});
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_DOUBLE_EQ(values["F"], 1.5);
+
+    values = decode(decoder, 0x18FEF1FE, {1, 0x34, 0x12, 0, 0, 0, 0, 0});
+    EXPECT_DOUBLE_EQ(values["A"], 0x1234);
+
+    values = decode(decoder, 0x18FEF1FE, {7, 0, 0, 0, 0, 0, 0, 0});
+    ASSERT_EQ(values.size(), 1u);
+}
+
+TEST(DbcDecoderTest, DecodeFieldsSpanningNineBytes)
+{
+    CanSignalDecoder decoder(DbcFile::parse(dbcContent));
+
+    std::vector<uint8_t> frame(16, 0);
+    // W: bits 4..67, value 2^60 + 1 sets bit 64 and bit 4
+    frame[0] = 0x10;
+    frame[8] = 0x01;
+    // Big: Motorola, starts at bit 71 (MSB of byte 8) and covers bytes 8 and 9
+    frame[8] |= 0x80;
+    frame[9] = 0x02;
+
+    const auto values = decode(decoder, 512, frame);
+    EXPECT_DOUBLE_EQ(values.at("W"), std::ldexp(1.0, 60) + 1);
+    EXPECT_DOUBLE_EQ(values.at("Big"), static_cast<int16_t>(0x8102));
+}
+
+TEST(DbcDecoderTest, DecoderFbSignals)
+{
+    const std::string fileName = "test_dbc_decoder.dbc";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file << dbcContent;
+    }
+
+    auto logger = Logger();
+    auto context = Context(Scheduler(logger), logger, TypeManager(), nullptr, nullptr);
+    FunctionBlockPtr decoderFb = createWithImplementation<IFunctionBlock, DbcDecoderFb>(ModuleInfoPtr(), context, nullptr, "dbc");
+    ASSERT_EQ(decoderFb.getInputPorts().getCount(), 1u);
+    ASSERT_EQ(decoderFb.getSignals().getCount(), 0u);
+
+    // 10 value signals and a domain signal for each of Engine, Mux, its 3 multiplexor values and Wide
+    decoderFb.setPropertyValue("DbcFile", fileName);
+    ASSERT_EQ(decoderFb.getSignals().getCount(), 16u);
+    SignalPtr speed;
+    for (const auto& signal : decoderFb.getSignals())
+    {
+        if (signal.getLocalId() == "Engine_Speed")
+            speed = signal;
+    }
+    ASSERT_TRUE(speed.assigned());
+    ASSERT_EQ(speed.getDescriptor().getSampleType(), SampleType::Float64);
+    ASSERT_EQ(speed.getDescriptor().getUnit().getSymbol(), "km/h");
+    ASSERT_EQ(speed.getDomainSignal().getLocalId(), "time_Engine");
+
+    decoderFb.setPropertyValue("DbcFile", "nonexistent.dbc");
+    ASSERT_EQ(decoderFb.getSignals().getCount(), 16u);
+
+    decoderFb.setPropertyValue("DbcFile", "");
+    ASSERT_EQ(decoderFb.getSignals().getCount(), 0u);
+
+    std::filesystem::remove(fileName);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <opendaq/instance_factory.h>
+
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace daq;
+using asam_cmp_common_lib::EthernetLoopbackImpl;
+
+namespace
+{
+    FunctionBlockPtr getChildFunctionBlock(const FunctionBlockPtr& parent, const std::string& localId)
+    {
+        for (const auto& fb : parent.getFunctionBlocks())
+        {
+            if (fb.getLocalId() == localId)
+                return fb;
+        }
+        return nullptr;
+    }
+
+    bool selectLoopbackAdapter(const FunctionBlockPtr& networkManager)
+    {
+        const ListPtr<IString> names = networkManager.getProperty("NetworkAdaptersNames").getSelectionValues();
+        for (SizeT i = 0; i < names.getCount(); ++i)
+        {
+            if (names[i].toStdString() == EthernetLoopbackImpl::deviceName)
+            {
+                networkManager.setPropertyValue("NetworkAdapters", static_cast<Int>(i));
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// Both modules are loaded as plugins, so each of them has its own copy of asam_cmp_common_lib
+TEST(LoopbackModulesTest, StatusMessageCrossesModules)
+{
+    const auto instance = Instance(ASAM_CMP_MODULE_PATH);
+    const FunctionBlockPtr dataSinkModuleFb = instance.addFunctionBlock("AsamCmpDataSinkModule");
+    const FunctionBlockPtr captureModuleFb = instance.addFunctionBlock("AsamCmpCaptureModule");
+    ASSERT_TRUE(selectLoopbackAdapter(dataSinkModuleFb));
+    ASSERT_TRUE(selectLoopbackAdapter(captureModuleFb));
+
+    const auto captureFb = getChildFunctionBlock(captureModuleFb, "Capture");
+    const auto statusFb = getChildFunctionBlock(dataSinkModuleFb, "Status");
+    ASSERT_TRUE(captureFb.assigned());
+    ASSERT_TRUE(statusFb.assigned());
+
+    // The capture module sends its status messages periodically
+    ListPtr<IString> captureModules;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        captureModules = statusFb.getPropertyValue("CaptureModuleList");
+    } while (captureModules.getCount() == 0 && std::chrono::steady_clock::now() < deadline);
+
+    ASSERT_EQ(captureModules.getCount(), 1u);
+    const std::string expectedPrefix = "Id: " + std::to_string(static_cast<Int>(captureFb.getPropertyValue("DeviceId"))) + ",";
+    ASSERT_EQ(captureModules[0].toStdString().rfind(expectedPrefix, 0), 0u);
+}
@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/pcap_file_reader.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using daq::modules::asam_cmp_data_sink_module::PcapFileReader;
+
+class PcapFileReaderTest : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        std::filesystem::remove(fileName);
+    }
+
+    void put16(uint16_t value)
+    {
+        if (bigEndian)
+            value = static_cast<uint16_t>((value >> 8) | (value << 8));
+        append(&value, sizeof(value));
+    }
+
+    void put32(uint32_t value)
+    {
+        if (bigEndian)
+            value = (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+        append(&value, sizeof(value));
+    }
+
+    void append(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        content.insert(content.end(), bytes, bytes + size);
+    }
+
+    void pad()
+    {
+        while (content.size() % 4 != 0)
+            content.push_back(0);
+    }
+
+    void writePcapHeader(uint32_t magic)
+    {
+        put32(magic);
+        put16(2);
+        put16(4);
+        put32(0);
+        put32(0);
+        put32(65535);
+        put32(1);
+    }
+
+    void writePcapRecord(uint32_t seconds, uint32_t fraction, const std::vector<uint8_t>& frame)
+    {
+        put32(seconds);
+        put32(fraction);
+        put32(static_cast<uint32_t>(frame.size()));
+        put32(static_cast<uint32_t>(frame.size()));
+        append(frame.data(), frame.size());
+    }
+
+    void writeSectionHeader()
+    {
+        put32(0x0A0D0D0A);
+        put32(28);
+        put32(0x1A2B3C4D);
+        put16(1);
+        put16(0);
+        put32(0xFFFFFFFF);
+        put32(0xFFFFFFFF);
+        put32(28);
+    }
+
+    void writeInterfaceDescription(uint16_t linkType, int tsResolution = -1)
+    {
+        const uint32_t length = tsResolution < 0 ? 20 : 32;
+        put32(1);
+        put32(length);
+        put16(linkType);
+        put16(0);
+        put32(0);
+        if (tsResolution >= 0)
+        {
+            put16(9);
+            put16(1);
+            content.push_back(static_cast<uint8_t>(tsResolution));
+            pad();
+            put32(0);
+        }
+        put32(length);
+    }
+
+    void writeEnhancedPacket(uint32_t interfaceId, uint64_t timestamp, const std::vector<uint8_t>& frame)
+    {
+        const uint32_t length = static_cast<uint32_t>(32 + ((frame.size() + 3) & ~size_t{3}));
+        put32(6);
+        put32(length);
+        put32(interfaceId);
+        put32(static_cast<uint32_t>(timestamp >> 32));
+        put32(static_cast<uint32_t>(timestamp));
+        put32(static_cast<uint32_t>(frame.size()));
+        put32(static_cast<uint32_t>(frame.size()));
+        append(frame.data(), frame.size());
+        pad();
+        put32(length);
+    }
+
+    void writeSimplePacket(const std::vector<uint8_t>& frame)
+    {
+        const uint32_t length = static_cast<uint32_t>(16 + ((frame.size() + 3) & ~size_t{3}));
+        put32(3);
+        put32(length);
+        put32(static_cast<uint32_t>(frame.size()));
+        append(frame.data(), frame.size());
+        pad();
+        put32(length);
+    }
+
+    void save()
+    {
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+    }
+
+    static std::vector<uint8_t> frameOf(size_t size, uint8_t first)
+    {
+        std::vector<uint8_t> frame(size);
+        for (size_t i = 0; i < size; ++i)
+            frame[i] = static_cast<uint8_t>(first + i);
+        return frame;
+    }
+
+protected:
+    std::string fileName = (std::filesystem::temp_directory_path() / "asam_cmp_pcap_file_reader_test.pcap").string();
+    std::vector<uint8_t> content;
+    bool bigEndian{false};
+};
+
+TEST_F(PcapFileReaderTest, PcapMicroseconds)
+{
+    const auto frame1 = frameOf(60, 1), frame2 = frameOf(99, 2);
+    writePcapHeader(0xA1B2C3D4);
+    writePcapRecord(10, 500, frame1);
+    writePcapRecord(11, 0, frame2);
+    save();
+
+    PcapFileReader reader(fileName);
+    ASSERT_FALSE(reader.isPcapNg());
+    ASSERT_EQ(reader.getFileSize(), content.size());
+
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(std::vector<uint8_t>(frame.data, frame.data + frame.length), frame1);
+    ASSERT_EQ(frame.timestamp, 10'000'500'000u);
+    ASSERT_EQ(frame.linkType, 1);
+    ASSERT_EQ(frame.offset, 24u);
+
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(std::vector<uint8_t>(frame.data, frame.data + frame.length), frame2);
+    ASSERT_EQ(frame.timestamp, 11'000'000'000u);
+    ASSERT_FALSE(reader.next(frame));
+}
+
+TEST_F(PcapFileReaderTest, PcapNanosecondsBigEndian)
+{
+    bigEndian = true;
+    writePcapHeader(0xA1B23C4D);
+    writePcapRecord(1, 123, frameOf(64, 0));
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(frame.length, 64u);
+    ASSERT_EQ(frame.timestamp, 1'000'000'123u);
+    ASSERT_FALSE(reader.next(frame));
+}
+
+TEST_F(PcapFileReaderTest, TruncatedRecordEndsFile)
+{
+    writePcapHeader(0xA1B2C3D4);
+    writePcapRecord(1, 0, frameOf(64, 0));
+    writePcapRecord(2, 0, frameOf(64, 0));
+    content.resize(content.size() - 10);
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_FALSE(reader.next(frame));
+}
+
+TEST_F(PcapFileReaderTest, Rewind)
+{
+    writePcapHeader(0xA1B2C3D4);
+    writePcapRecord(1, 0, frameOf(64, 0));
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_FALSE(reader.next(frame));
+    reader.rewind();
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(frame.timestamp, 1'000'000'000u);
+}
+
+TEST_F(PcapFileReaderTest, PcapNgEnhancedPackets)
+{
+    const auto frame1 = frameOf(61, 5), frame2 = frameOf(70, 6);
+    writeSectionHeader();
+    writeInterfaceDescription(1);
+    writeInterfaceDescription(1, 9);
+    writeEnhancedPacket(0, 2'000'001, frame1);
+    writeEnhancedPacket(1, 3'000'000'002, frame2);
+    save();
+
+    PcapFileReader reader(fileName);
+    ASSERT_TRUE(reader.isPcapNg());
+
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(std::vector<uint8_t>(frame.data, frame.data + frame.length), frame1);
+    ASSERT_EQ(frame.timestamp, 2'000'001'000u);
+    ASSERT_EQ(frame.linkType, 1);
+
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(std::vector<uint8_t>(frame.data, frame.data + frame.length), frame2);
+    ASSERT_EQ(frame.timestamp, 3'000'000'002u);
+    ASSERT_FALSE(reader.next(frame));
+}
+
+TEST_F(PcapFileReaderTest, PcapNgBinaryResolutionBigEndian)
+{
+    bigEndian = true;
+    writeSectionHeader();
+    writeInterfaceDescription(1, 0x80 | 10);
+    writeEnhancedPacket(0, (5ull << 10) | 512, frameOf(64, 0));
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(frame.timestamp, 5'500'000'000u);
+}
+
+TEST_F(PcapFileReaderTest, PcapNgSimplePacket)
+{
+    const auto frame1 = frameOf(62, 3);
+    writeSectionHeader();
+    writeInterfaceDescription(1);
+    writeEnhancedPacket(0, 7'000'000, frameOf(64, 0));
+    writeSimplePacket(frame1);
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(std::vector<uint8_t>(frame.data, frame.data + frame.length), frame1);
+    ASSERT_EQ(frame.timestamp, 7'000'000'000u);
+    ASSERT_FALSE(reader.next(frame));
+}
+
+TEST_F(PcapFileReaderTest, PacketOfUnknownInterfaceIsSkipped)
+{
+    writeSectionHeader();
+    writeInterfaceDescription(1);
+    writeEnhancedPacket(3, 1, frameOf(64, 0));
+    writeEnhancedPacket(0, 2, frameOf(64, 0));
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    ASSERT_TRUE(reader.next(frame));
+    ASSERT_EQ(frame.timestamp, 2'000u);
+    ASSERT_FALSE(reader.next(frame));
+}
+
+TEST_F(PcapFileReaderTest, InvalidFile)
+{
+    put32(0x12345678);
+    put32(0);
+    put32(0);
+    put32(0);
+    save();
+
+    ASSERT_THROW(PcapFileReader reader(fileName), std::runtime_error);
+    ASSERT_THROW(PcapFileReader reader(fileName + ".missing"), std::runtime_error);
+}
+
+TEST_F(PcapFileReaderTest, ReadAt)
+{
+    writeSectionHeader();
+    writeInterfaceDescription(1, 9);
+    writeEnhancedPacket(0, 1, frameOf(64, 0));
+    writeEnhancedPacket(0, 2, frameOf(64, 0));
+    writeEnhancedPacket(0, 3, frameOf(64, 0));
+    save();
+
+    PcapFileReader reader(fileName);
+    PcapFileReader::Frame frame{};
+    std::vector<uint64_t> offsets;
+    while (reader.next(frame))
+        offsets.push_back(frame.offset);
+    ASSERT_EQ(offsets.size(), 3u);
+
+    PcapFileReader seekingReader(fileName);
+    ASSERT_TRUE(seekingReader.readAt(offsets[1], frame));
+    ASSERT_EQ(frame.timestamp, 2u);
+    ASSERT_TRUE(seekingReader.readAt(offsets[0], frame));
+    ASSERT_EQ(frame.timestamp, 1u);
+    ASSERT_TRUE(seekingReader.next(frame));
+    ASSERT_EQ(frame.timestamp, 2u);
+    ASSERT_FALSE(seekingReader.readAt(content.size(), frame));
+}
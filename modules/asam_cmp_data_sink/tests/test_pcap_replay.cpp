@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/pcapng_recorder.h>
+#include <asam_cmp_data_sink/pcap_replay.h>
+
+#include <RawPacket.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+using daq::asam_cmp_common_lib::PcapNgRecorder;
+using daq::modules::asam_cmp_data_sink_module::Endpoint;
+using daq::modules::asam_cmp_data_sink_module::PcapReplay;
+
+class PcapReplayTest : public testing::Test
+{
+protected:
+    static constexpr uint64_t secondNs = 1'000'000'000;
+    static constexpr uint64_t startTimestamp = 1'700'000'000 * secondNs;
+
+    PcapReplayTest()
+    {
+        // One Data Message per 100 ms on two streams of device 1 and a status message of device 2 per second
+        PcapNgRecorder::Config config;
+        config.filePrefix = (std::filesystem::temp_directory_path() / "asam_cmp_replay_test").string();
+        PcapNgRecorder recorder(config);
+        for (uint64_t i = 0; i < 100; ++i)
+        {
+            const uint64_t timestamp = startTimestamp + i * secondNs / 10;
+            recordMessage(recorder, timestamp, 1, 1, static_cast<uint8_t>(1 + i % 2), dataMessageType);
+            if (i % 10 == 0)
+                recordMessage(recorder, timestamp, 2, 0, 0, statusMessageType);
+        }
+        recorder.stop();
+        fileName = recorder.getFileNames().front();
+    }
+
+    ~PcapReplayTest() override
+    {
+        std::filesystem::remove(fileName);
+        std::filesystem::remove(fileName + ".idx");
+    }
+
+    static void recordMessage(PcapNgRecorder& recorder, uint64_t timestamp, uint16_t deviceId, uint32_t interfaceId, uint8_t streamId, uint8_t messageType)
+    {
+        std::vector<uint8_t> frame(64, 0);
+        frame[12] = 0x99;
+        frame[13] = 0xFE;
+        frame[14] = 1;
+        frame[16] = static_cast<uint8_t>(deviceId >> 8);
+        frame[17] = static_cast<uint8_t>(deviceId);
+        frame[18] = messageType;
+        frame[19] = streamId;
+        frame[33] = static_cast<uint8_t>(interfaceId);
+        recorder.record(frame.data(), frame.size(), timestamp);
+    }
+
+    void replay(const PcapReplay::Options& options, bool removeIndex = false)
+    {
+        if (removeIndex)
+            std::filesystem::remove(fileName + ".idx");
+
+        PcapReplay pcapReplay;
+        pcapReplay.start(fileName,
+                         options,
+                         [this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice*, void*)
+                         {
+                             std::scoped_lock lock{replayedSync};
+                             const uint8_t* data = packet->getRawData();
+                             replayed.push_back({static_cast<uint16_t>((data[16] << 8) | data[17]), data[33], data[19]});
+                         });
+        ASSERT_EQ(pcapReplay.isIndexed(), !removeIndex);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pcapReplay.isRunning() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_FALSE(pcapReplay.isRunning());
+        ASSERT_EQ(pcapReplay.getReplayedFrames(), replayed.size());
+    }
+
+protected:
+    static constexpr uint8_t dataMessageType = 0x01;
+    static constexpr uint8_t statusMessageType = 0x02;
+
+    std::string fileName;
+    std::mutex replayedSync;
+    std::vector<Endpoint> replayed;
+};
+
+TEST_F(PcapReplayTest, ReplayAll)
+{
+    replay({});
+    ASSERT_EQ(replayed.size(), 110u);
+}
+
+TEST_F(PcapReplayTest, TimeWindow)
+{
+    PcapReplay::Options options;
+    options.startOffset = std::chrono::seconds(2);
+    options.duration = std::chrono::milliseconds(950);
+    replay(options);
+
+    // Data Messages from 2.0 s to 2.9 s and the status message at 2.0 s
+    ASSERT_EQ(replayed.size(), 11u);
+}
+
+TEST_F(PcapReplayTest, Endpoints)
+{
+    PcapReplay::Options options;
+    options.endpoints = {{1, 1, 2}};
+    replay(options);
+
+    ASSERT_EQ(replayed.size(), 50u);
+    for (const auto& endpoint : replayed)
+        ASSERT_TRUE(endpoint == Endpoint({1, 1, 2}));
+}
+
+TEST_F(PcapReplayTest, StatusMessagesOfSelectedDevices)
+{
+    PcapReplay::Options options;
+    options.endpoints = {{2, 5, 5}};
+    replay(options);
+
+    ASSERT_EQ(replayed.size(), 10u);
+}
+
+TEST_F(PcapReplayTest, WithoutIndex)
+{
+    PcapReplay::Options options;
+    options.startOffset = std::chrono::seconds(2);
+    options.duration = std::chrono::milliseconds(950);
+    options.endpoints = {{1, 1, 1}};
+    replay(options, true);
+
+    ASSERT_EQ(replayed.size(), 5u);
+}
+
+TEST_F(PcapReplayTest, InvalidOptions)
+{
+    PcapReplay pcapReplay;
+    PcapReplay::Options options;
+    options.mode = PcapReplay::Mode::OriginalTiming;
+    options.speed = 0;
+    ASSERT_THROW(pcapReplay.start(fileName, options, nullptr), std::invalid_argument);
+    ASSERT_FALSE(pcapReplay.isRunning());
+}
+
+TEST_F(PcapReplayTest, VlanTaggedFrames)
+{
+    PcapNgRecorder::Config config;
+    config.filePrefix = (std::filesystem::temp_directory_path() / "asam_cmp_replay_vlan_test").string();
+    PcapNgRecorder recorder(config);
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        // 802.1Q tag with priority 5 and VLAN ID 10 in front of the ASAM CMP EtherType
+        std::vector<uint8_t> frame(68, 0);
+        frame[12] = 0x81;
+        frame[14] = 0xA0;
+        frame[15] = 10;
+        frame[16] = 0x99;
+        frame[17] = 0xFE;
+        frame[18] = 1;
+        frame[21] = 1;
+        frame[22] = dataMessageType;
+        frame[23] = static_cast<uint8_t>(1 + i % 2);
+        frame[37] = 1;
+        recorder.record(frame.data(), frame.size(), startTimestamp + i * secondNs / 10);
+    }
+    recorder.stop();
+    const std::string vlanFileName = recorder.getFileNames().front();
+
+    PcapReplay::Options options;
+    options.endpoints = {{1, 1, 2}};
+
+    std::atomic<size_t> replayedCount{0};
+    PcapReplay pcapReplay;
+    pcapReplay.start(vlanFileName, options, [&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { ++replayedCount; });
+    ASSERT_TRUE(pcapReplay.isIndexed());
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pcapReplay.isRunning() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pcapReplay.stop();
+
+    std::filesystem::remove(vlanFileName);
+    std::filesystem::remove(vlanFileName + ".idx");
+
+    // The endpoints of tagged frames are found in the index as well
+    ASSERT_EQ(replayedCount, 5u);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_data_sink/sequence_counter_tracker.h>
+
+using daq::modules::asam_cmp_data_sink_module::SequenceCounterStatistics;
+using daq::modules::asam_cmp_data_sink_module::SequenceCounterTracker;
+
+class SequenceCounterTrackerTest : public testing::Test
+{
+protected:
+    static constexpr uint16_t deviceId = 3;
+    static constexpr uint8_t streamId = 7;
+
+    SequenceCounterTracker tracker;
+};
+
+TEST_F(SequenceCounterTrackerTest, InOrder)
+{
+    for (uint16_t counter = 0; counter < 10; ++counter)
+        ASSERT_TRUE(tracker.update(deviceId, streamId, counter).empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, FirstMessageIsNotChecked)
+{
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 100).empty());
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 101).empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, Wraparound)
+{
+    tracker.update(deviceId, streamId, 0xFFFE);
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 0xFFFF).empty());
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 0).empty());
+
+    auto statistics = tracker.update(deviceId, streamId, 3);
+    ASSERT_EQ(statistics.lost, 2);
+}
+
+TEST_F(SequenceCounterTrackerTest, Lost)
+{
+    tracker.update(deviceId, streamId, 1);
+
+    auto statistics = tracker.update(deviceId, streamId, 5);
+    ASSERT_EQ(statistics.lost, 3);
+    ASSERT_EQ(statistics.duplicate, 0);
+    ASSERT_EQ(statistics.outOfOrder, 0);
+}
+
+TEST_F(SequenceCounterTrackerTest, Duplicate)
+{
+    tracker.update(deviceId, streamId, 1);
+
+    auto statistics = tracker.update(deviceId, streamId, 1);
+    ASSERT_EQ(statistics.lost, 0);
+    ASSERT_EQ(statistics.duplicate, 1);
+    ASSERT_EQ(statistics.outOfOrder, 0);
+}
+
+TEST_F(SequenceCounterTrackerTest, OutOfOrder)
+{
+    tracker.update(deviceId, streamId, 1);
+    ASSERT_EQ(tracker.update(deviceId, streamId, 3).lost, 1);
+
+    auto statistics = tracker.update(deviceId, streamId, 2);
+    ASSERT_EQ(statistics.lost, -1);
+    ASSERT_EQ(statistics.duplicate, 0);
+    ASSERT_EQ(statistics.outOfOrder, 1);
+
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 4).empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, OutOfOrderOnlyCreditsRecordedGaps)
+{
+    tracker.update(deviceId, streamId, 1);
+    tracker.update(deviceId, streamId, 2);
+    ASSERT_EQ(tracker.update(deviceId, streamId, 4).lost, 1);
+    ASSERT_EQ(tracker.update(deviceId, streamId, 3).lost, -1);
+
+    // Late copies of received messages don't reduce the lost count
+    auto statistics = tracker.update(deviceId, streamId, 3);
+    ASSERT_EQ(statistics.lost, 0);
+    ASSERT_EQ(statistics.outOfOrder, 0);
+    ASSERT_EQ(statistics.duplicate, 1);
+    statistics = tracker.update(deviceId, streamId, 2);
+    ASSERT_EQ(statistics.lost, 0);
+    ASSERT_EQ(statistics.duplicate, 1);
+
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 5).empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, SenderRestart)
+{
+    for (uint16_t counter = 4990; counter <= 5000; ++counter)
+        tracker.update(deviceId, streamId, counter);
+
+    SequenceCounterStatistics total;
+    for (uint16_t counter = 0; counter < 100; ++counter)
+    {
+        const auto statistics = tracker.update(deviceId, streamId, counter);
+        total.lost += statistics.lost;
+        total.duplicate += statistics.duplicate;
+        total.outOfOrder += statistics.outOfOrder;
+    }
+
+    ASSERT_TRUE(total.empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, SenderRestartWithinReorderWindow)
+{
+    for (uint16_t counter = 0; counter <= 20; ++counter)
+        tracker.update(deviceId, streamId, counter);
+
+    int64_t lost = 0;
+    int64_t outOfOrder = 0;
+    for (uint16_t counter = 0; counter < 100; ++counter)
+    {
+        const auto statistics = tracker.update(deviceId, streamId, counter);
+        lost += statistics.lost;
+        outOfOrder += statistics.outOfOrder;
+    }
+
+    // The first messages after the restart look like late copies until the tracker resynchronizes
+    ASSERT_EQ(lost, 0);
+    ASSERT_EQ(outOfOrder, 0);
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 100).empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, IndependentStreams)
+{
+    tracker.update(deviceId, streamId, 1);
+    tracker.update(deviceId, streamId + 1, 10);
+    tracker.update(deviceId + 1, streamId, 20);
+
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 2).empty());
+    ASSERT_TRUE(tracker.update(deviceId, streamId + 1, 11).empty());
+    ASSERT_TRUE(tracker.update(deviceId + 1, streamId, 21).empty());
+}
+
+TEST_F(SequenceCounterTrackerTest, Reset)
+{
+    tracker.update(deviceId, streamId, 1);
+    tracker.reset();
+
+    ASSERT_TRUE(tracker.update(deviceId, streamId, 10).empty());
+}
@@ -133,3 +133,52 @@ TEST_F(StatusFbTest, Clear)
     ASSERT_EQ(cmList.getCount(), 0u);
     ASSERT_EQ(statusMt->getStatus().getDeviceStatusCount(), 0u);
 }
+
+TEST(StatusFbTelemetryTest, ReceiveTelemetry)
+{
+    using daq::modules::asam_cmp_data_sink_module::ReceiveTelemetry;
+
+    auto logger = Logger();
+    auto telemetry = std::make_shared<ReceiveTelemetry>();
+    const FunctionBlockPtr funcBlock = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::StatusFbImpl>(
+        ModuleInfoPtr{}, Context(Scheduler(logger), logger, TypeManager(), nullptr), nullptr, "asam_cmp_status", telemetry);
+
+    funcBlock.setPropertyValue("TelemetryRefreshInterval", 0);
+
+    telemetry->framesReceived = 3;
+    telemetry->bytesReceived = 300;
+    telemetry->messagesDecoded = 5;
+    telemetry->decodeErrors = 1;
+    telemetry->unsupportedMessages = 2;
+    telemetry->decodeTime.record(1000);
+    telemetry->publishTime.record(10);
+
+    EXPECT_EQ(funcBlock.getPropertyValue("FramesReceived"), 3);
+    EXPECT_EQ(funcBlock.getPropertyValue("BytesReceived"), 300);
+    EXPECT_EQ(funcBlock.getPropertyValue("MessagesDecoded"), 5);
+    EXPECT_EQ(funcBlock.getPropertyValue("DecodeErrors"), 1);
+    EXPECT_EQ(funcBlock.getPropertyValue("UnsupportedMessages"), 2);
+    EXPECT_EQ(funcBlock.getPropertyValue("KernelDrops"), 0);
+    EXPECT_EQ(funcBlock.getPropertyValue("DecodeTimeMax"), 1000);
+    EXPECT_EQ(funcBlock.getPropertyValue("PublishTimeP50"), 10);
+    EXPECT_THROW(funcBlock.setPropertyValue("FramesReceived", 0), daq::AccessDeniedException);
+}
+
+TEST(StatusFbTelemetryTest, RefreshInterval)
+{
+    using daq::modules::asam_cmp_data_sink_module::ReceiveTelemetry;
+
+    auto logger = Logger();
+    auto telemetry = std::make_shared<ReceiveTelemetry>();
+    const FunctionBlockPtr funcBlock = createWithImplementation<IFunctionBlock, modules::asam_cmp_data_sink_module::StatusFbImpl>(
+        ModuleInfoPtr{}, Context(Scheduler(logger), logger, TypeManager(), nullptr), nullptr, "asam_cmp_status", telemetry);
+
+    funcBlock.setPropertyValue("TelemetryRefreshInterval", 60000);
+
+    EXPECT_EQ(funcBlock.getPropertyValue("FramesReceived"), 0);
+    telemetry->framesReceived = 3;
+    EXPECT_EQ(funcBlock.getPropertyValue("FramesReceived"), 0);
+
+    funcBlock.setPropertyValue("TelemetryRefreshInterval", 0);
+    EXPECT_EQ(funcBlock.getPropertyValue("FramesReceived"), 3);
+}
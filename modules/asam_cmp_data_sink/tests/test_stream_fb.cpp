@@ -3,9 +3,13 @@
 #include <asam_cmp_data_sink/capture_packets_publisher.h>
 #include <asam_cmp_data_sink/common.h>
 #include <asam_cmp_data_sink/data_packets_publisher.h>
+#include <asam_cmp_data_sink/stream_fb.h>
+
+#include <asam_cmp_common_lib/compact_can_layout.h>
 
 #include <asam_cmp/analog_payload.h>
 #include <asam_cmp/can_payload.h>
+#include <asam_cmp/can_fd_payload.h>
 #include <asam_cmp/packet.h>
 #include <asam_cmp/ethernet_payload.h>
 #include <gtest/gtest.h>
@@ -18,17 +22,23 @@
 #include <opendaq/data_packet_ptr.h>
 #include <thread>
 #include <chrono>
+#include <limits>
+#include <type_traits>
 
 using namespace std::literals;
 
 using namespace daq;
 using ASAM::CMP::AnalogPayload;
+using ASAM::CMP::CanFdPayload;
 using ASAM::CMP::CanPayload;
 using ASAM::CMP::EthernetPayload;
 using ASAM::CMP::Packet;
 using daq::modules::asam_cmp_data_sink_module::CapturePacketsPublisher;
 using daq::modules::asam_cmp_data_sink_module::DataPacketsPublisher;
+using daq::modules::asam_cmp_data_sink_module::EthernetBatchEntry;
+using daq::modules::asam_cmp_data_sink_module::EthernetBatchHeader;
 using daq::modules::asam_cmp_data_sink_module::IAsamCmpPacketsSubscriber;
+using daq::modules::asam_cmp_data_sink_module::SequenceCounterStatistics;
 
 size_t waitForSamples(const GenericReaderPtr<IReader>& reader, std::chrono::milliseconds timeout = 100ms)
 {
@@ -76,6 +86,7 @@ protected:
     static constexpr uint64_t timeResolution = 1e9;
 
     static constexpr int canPayloadType = 1;
+    static constexpr int canFdPayloadType = 2;
     static constexpr int analogPayloadType = 3;
     static constexpr int ethernetPayloadType = 4;
 
@@ -323,6 +334,31 @@ TEST_F(StreamFbCanPayloadTest, CanSignalDescriptors)
     ASSERT_EQ(domainDescr.getTickResolution(), Ratio(1, timeResolution));
 }
 
+TEST_F(StreamFbTest, SequenceCounterStatistics)
+{
+    const auto dataHandler = funcBlock.as<IAsamCmpPacketsSubscriber>(true);
+
+    SequenceCounterStatistics statistics;
+    statistics.lost = 3;
+    statistics.duplicate = 1;
+    dataHandler->receive(statistics);
+
+    statistics.lost = -1;
+    statistics.duplicate = 0;
+    statistics.outOfOrder = 1;
+    dataHandler->receive(statistics);
+
+    EXPECT_EQ(funcBlock.getPropertyValue("LostMessages"), 2);
+    EXPECT_EQ(funcBlock.getPropertyValue("DuplicateMessages"), 1);
+    EXPECT_EQ(funcBlock.getPropertyValue("OutOfOrderMessages"), 1);
+    ASSERT_THROW(funcBlock.setPropertyValue("LostMessages", 0), AccessDeniedException);
+
+    funcBlock.setPropertyValue("StreamId", static_cast<Int>(streamId + 1));
+    EXPECT_EQ(funcBlock.getPropertyValue("LostMessages"), 0);
+    EXPECT_EQ(funcBlock.getPropertyValue("DuplicateMessages"), 0);
+    EXPECT_EQ(funcBlock.getPropertyValue("OutOfOrderMessages"), 0);
+}
+
 TEST_F(StreamFbCanPayloadTest, ReceivePacketWithWrongPayloadType)
 {
     interfaceFb.setPropertyValue("PayloadType", analogPayloadType);
@@ -358,6 +394,160 @@ TEST_F(StreamFbCanPayloadTest, ReadOutputCanSignal)
     ASSERT_EQ(checkData, canData);
 }
 
+TEST_F(StreamFbCanPayloadTest, ReadCompactCanSignal)
+{
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    funcBlock.setPropertyValue("CompactCanLayout", true);
+    const auto outputSignal = funcBlock.getSignalsRecursive()[0];
+    ASSERT_EQ(outputSignal.getDescriptor().getSampleSize(), sizeof(asam_cmp_common_lib::compact_can::ClassicCanData));
+    const StreamReaderPtr reader = StreamReaderSkipEvents(outputSignal, SampleType::Struct, SampleType::UInt64);
+
+    publisher.publish({canPacket->getDeviceId(), canPacket->getInterfaceId(), canPacket->getStreamId()}, canPacket);
+    const auto samplesCount = waitForSamples(reader);
+    ASSERT_EQ(samplesCount, 1u);
+
+    asam_cmp_common_lib::compact_can::ClassicCanData sample;
+    uint64_t domainSample;
+    size_t count = 1;
+    reader.readWithDomain(&sample, &domainSample, &count);
+    ASSERT_EQ(count, 1u);
+    ASSERT_EQ(domainSample, canPacket->getTimestamp());
+    ASSERT_EQ(static_cast<uint32_t>(sample.arbId), arbId);
+    ASSERT_EQ(sample.length, sizeof(canData));
+    uint32_t checkData;
+    memcpy(&checkData, sample.data, sizeof(checkData));
+    ASSERT_EQ(checkData, canData);
+
+    funcBlock.setPropertyValue("CompactCanLayout", false);
+    ASSERT_EQ(outputSignal.getDescriptor().getSampleSize(), sizeof(CANData));
+}
+
+TEST_F(StreamFbCanPayloadTest, ReadCompactCanFdSignal)
+{
+    using namespace asam_cmp_common_lib::compact_can;
+
+    std::vector<uint8_t> fdData(12);
+    for (size_t i = 0; i < fdData.size(); ++i)
+        fdData[i] = static_cast<uint8_t>(i + 1);
+
+    auto createFdPacket = [&](size_t length, uint64_t timestamp)
+    {
+        CanFdPayload canFdPayload;
+        canFdPayload.setData(fdData.data(), length);
+        canFdPayload.setId(arbId);
+
+        auto packet = std::make_shared<Packet>();
+        packet->setPayload(canFdPayload);
+        packet->setTimestamp(timestamp);
+        packet->setDeviceId(deviceId);
+        packet->setInterfaceId(interfaceId);
+        packet->setStreamId(streamId);
+        return packet;
+    };
+    const auto fdPacket = createFdPacket(fdData.size(), canPacket->getTimestamp());
+    const auto shortPacket = createFdPacket(3, canPacket->getTimestamp() + 1000);
+
+    interfaceFb.setPropertyValue("PayloadType", canFdPayloadType);
+    funcBlock.setPropertyValue("CompactCanLayout", true);
+    const auto outputSignal = funcBlock.getSignalsRecursive()[0];
+    ASSERT_TRUE(isCanFdDescriptor(outputSignal.getDescriptor()));
+
+    auto inputPort = InputPort(interfaceFb.getContext(), nullptr, "testinput");
+    inputPort.connect(outputSignal);
+    auto connection = inputPort.getConnection();
+    connection.dequeue();
+
+    // Both frames of a batch are packed into one binary sample
+    publisher.publish({fdPacket->getDeviceId(), fdPacket->getInterfaceId(), fdPacket->getStreamId()},
+                      std::vector<std::shared_ptr<Packet>>{fdPacket, shortPacket});
+
+    PacketPtr received;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+    while (!received.assigned() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        received = connection.dequeue();
+    }
+
+    ASSERT_TRUE(received.assigned());
+    const DataPacketPtr packet = received;
+    ASSERT_EQ(packet.getSampleCount(), 1u);
+    ASSERT_EQ(packet.getDataSize(), sizeof(CanFdHeader) + getCanFdFrameSize(12) + getCanFdFrameSize(3));
+    ASSERT_EQ(*static_cast<uint64_t*>(packet.getDomainPacket().getRawData()), fdPacket->getTimestamp());
+
+    std::vector<CanFdFrame> frames;
+    std::vector<std::vector<uint8_t>> frameData;
+    const bool valid = forEachCanFdFrame(static_cast<const uint8_t*>(packet.getRawData()),
+                                         packet.getDataSize(),
+                                         [&](const CanFdFrame& frame, const uint8_t* data)
+                                         {
+                                             frames.push_back(frame);
+                                             frameData.emplace_back(data, data + frame.length);
+                                         });
+    ASSERT_TRUE(valid);
+    ASSERT_EQ(frames.size(), 2u);
+    ASSERT_EQ(frames[0].arbId, arbId);
+    ASSERT_EQ(frames[0].timestamp, fdPacket->getTimestamp());
+    ASSERT_EQ(frameData[0], fdData);
+    ASSERT_EQ(frames[1].timestamp, shortPacket->getTimestamp());
+    ASSERT_EQ(frameData[1], std::vector<uint8_t>(fdData.begin(), fdData.begin() + 3));
+}
+
+TEST_F(StreamFbCanPayloadTest, CanIdFilter)
+{
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    const auto outputSignal = funcBlock.getSignalsRecursive()[0];
+    const StreamReaderPtr reader = StreamReaderSkipEvents(outputSignal, SampleType::Struct, SampleType::UInt64);
+    const auto dataHandler = funcBlock.as<IAsamCmpPacketsSubscriber>(true);
+
+    funcBlock.setPropertyValue("CanIdFilter", "0x100-0x1FF");
+    dataHandler->receive(canPacket);
+    ASSERT_EQ(waitForSamples(reader), 0u);
+    ASSERT_EQ(funcBlock.getPropertyValue("FilteredMessages"), 1);
+
+    funcBlock.setPropertyValue("CanIdFilter", "0x100-0x1FF, " + std::to_string(arbId));
+    dataHandler->receive(canPacket);
+    ASSERT_EQ(waitForSamples(reader), 1u);
+    ASSERT_EQ(funcBlock.getPropertyValue("FilteredMessages"), 1);
+
+    // An invalid list keeps the previous filter
+    funcBlock.setPropertyValue("CanIdFilter", "0x100-");
+    dataHandler->receive(canPacket);
+    ASSERT_EQ(waitForSamples(reader), 2u);
+}
+
+TEST_F(StreamFbCanPayloadTest, CanDemuxIds)
+{
+    interfaceFb.setPropertyValue("PayloadType", canPayloadType);
+    const auto signalsCount = funcBlock.getSignals().getCount();
+
+    funcBlock.setPropertyValue("CanDemuxIds", "0x10-0x20, 0x2D");
+    ASSERT_EQ(funcBlock.getSignals().getCount(), signalsCount + 4);
+
+    SignalPtr demuxSignal;
+    for (const auto& signal : funcBlock.getSignals())
+    {
+        if (signal.getLocalId() == "data_0x2D")
+            demuxSignal = signal;
+    }
+    ASSERT_TRUE(demuxSignal.assigned());
+    ASSERT_EQ(demuxSignal.getDescriptor(), funcBlock.getSignalsRecursive()[0].getDescriptor());
+
+    const StreamReaderPtr combinedReader =
+        StreamReaderSkipEvents(funcBlock.getSignalsRecursive()[0], SampleType::Struct, SampleType::UInt64);
+    const StreamReaderPtr demuxReader = StreamReaderSkipEvents(demuxSignal, SampleType::Struct, SampleType::UInt64);
+
+    const auto dataHandler = funcBlock.as<IAsamCmpPacketsSubscriber>(true);
+    dataHandler->receive(canPacket);
+    ASSERT_EQ(waitForSamples(demuxReader), 1u);
+    ASSERT_EQ(waitForSamples(combinedReader), 0u);
+
+    funcBlock.setPropertyValue("CanDemuxIds", "");
+    ASSERT_EQ(funcBlock.getSignals().getCount(), signalsCount);
+    dataHandler->receive(canPacket);
+    ASSERT_EQ(waitForSamples(combinedReader), 1u);
+}
+
 template <typename AnalogType>
 class StreamFbAnalogPayloadTest : public StreamFbTest
 {
@@ -409,6 +599,14 @@ protected:
         return descriptor;
     }
 
+    // Values covered by the samples as the capture module encodes them
+    static RangePtr encodedValueRange(double scalar, double offset)
+    {
+        if constexpr (std::is_same_v<AnalogType, int16_t>)
+            return Range(offset + scalar * std::numeric_limits<int16_t>::min(), offset + scalar * std::numeric_limits<int16_t>::max());
+        return Range(offset, offset + scalar * (1LL << 24));
+    }
+
 protected:
     static constexpr size_t analogDataSize = 80;
     static constexpr float sampleInterval = 20.f * 1e-6f;
@@ -430,9 +628,6 @@ TYPED_TEST(StreamFbAnalogPayloadTest, AnalogSignalDescriptor)
     constexpr auto rawSampleType = SampleTypeFromType<TypeParam>::SampleType;
     constexpr auto domainSampleType = SampleType::UInt64;
     const auto unit = Unit("kg", -1, "", "");
-    constexpr auto intSize = rawSampleType == SampleType::Int16 ? 16 : 32;
-    const auto minValue = this->sampleOffset;
-    const auto maxValue = this->sampleScalar * pow(2, intSize) + this->sampleOffset;
 
     this->interfaceFb.setPropertyValue("PayloadType", this->analogPayloadType);
     this->funcBlock.template as<IAsamCmpPacketsSubscriber>(true)->receive(this->analogPacket);
@@ -442,7 +637,7 @@ TYPED_TEST(StreamFbAnalogPayloadTest, AnalogSignalDescriptor)
     ASSERT_EQ(descriptor.getSampleType(), sampleType);
     ASSERT_EQ(descriptor.getSampleSize(), sizeof(double));
     ASSERT_EQ(descriptor.getPostScaling(), LinearScaling(this->sampleScalar, this->sampleOffset, rawSampleType));
-    ASSERT_EQ(descriptor.getValueRange(), Range(minValue, maxValue));
+    ASSERT_EQ(descriptor.getValueRange(), this->encodedValueRange(this->sampleScalar, this->sampleOffset));
     ASSERT_EQ(descriptor.getUnit(), unit);
 
     const auto domainDescr = this->funcBlock.getSignalsRecursive()[0].getDomainSignal().getDescriptor();
@@ -607,9 +802,6 @@ TYPED_TEST(StreamFbAnalogPayloadTest, PostScalingChanged)
     const float newSampleScalar = this->sampleScalar * 2;
 
     constexpr auto rawSampleType = SampleTypeFromType<TypeParam>::SampleType;
-    constexpr auto intSize = rawSampleType == SampleType::Int16 ? 16 : 32;
-    const auto minValue = newSampleOffset;
-    const auto maxValue = newSampleScalar * pow(2, intSize) + newSampleOffset;
 
     this->interfaceFb.setPropertyValue("PayloadType", this->analogPayloadType);
     const auto outputSignal = this->funcBlock.getSignalsRecursive()[0];
@@ -634,7 +826,29 @@ TYPED_TEST(StreamFbAnalogPayloadTest, PostScalingChanged)
     auto descriptor = this->readDataDescriptor(reader, "DataDescriptor");
 
     ASSERT_EQ(descriptor.getPostScaling(), LinearScaling(newSampleScalar, newSampleOffset, rawSampleType));
-    ASSERT_EQ(descriptor.getValueRange(), Range(minValue, maxValue));
+    ASSERT_EQ(descriptor.getValueRange(), this->encodedValueRange(newSampleScalar, newSampleOffset));
+}
+
+using StreamFbInt16AnalogPayloadTest = StreamFbAnalogPayloadTest<int16_t>;
+
+TEST_F(StreamFbInt16AnalogPayloadTest, ValueRangeOfCaptureEncoding)
+{
+    // Int16 encoding of the capture module for values in [-10, 10]
+    constexpr double minValue = -10;
+    constexpr double maxValue = 10;
+    const double scalar = (maxValue - minValue) / std::numeric_limits<uint16_t>::max();
+    const double offset = minValue - std::numeric_limits<int16_t>::min() * scalar;
+
+    auto& payload = static_cast<AnalogPayload&>(analogPacket->getPayload());
+    payload.setSampleScalar(static_cast<float>(scalar));
+    payload.setSampleOffset(static_cast<float>(offset));
+
+    interfaceFb.setPropertyValue("PayloadType", analogPayloadType);
+    funcBlock.as<IAsamCmpPacketsSubscriber>(true)->receive(analogPacket);
+
+    const RangePtr range = funcBlock.getSignalsRecursive()[0].getDescriptor().getValueRange();
+    ASSERT_NEAR(range.getLowValue(), minValue, 1e-3);
+    ASSERT_NEAR(range.getHighValue(), maxValue, 1e-3);
 }
 
 class StreamFbEthernetPayloadTest : public StreamFbTest
@@ -708,3 +922,82 @@ TEST_F(StreamFbEthernetPayloadTest, ReadOutputEthernetSignal)
 
     checkData(connection.dequeue());
 }
+
+TEST_F(StreamFbEthernetPayloadTest, ReadOutputEthernetSignalBatched)
+{
+    constexpr uint32_t frameCount = 3;
+
+    interfaceFb.setPropertyValue("PayloadType", ethernetPayloadType);
+    funcBlock.setPropertyValue("EthernetBatchMaxLatency", 0);
+    funcBlock.setPropertyValue("EthernetBatching", true);
+    const auto outputSignal = funcBlock.getSignalsRecursive()[0];
+
+    auto inputPort = InputPort(interfaceFb.getContext(), nullptr, "testinput");
+    inputPort.connect(outputSignal);
+
+    std::vector<std::shared_ptr<Packet>> packets;
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+        auto packet = std::make_shared<Packet>(*ethernetPacket);
+        packet->setTimestamp(ethernetPacket->getTimestamp() + i);
+        packets.push_back(packet);
+    }
+    publisher.publish({ethernetPacket->getDeviceId(), ethernetPacket->getInterfaceId(), ethernetPacket->getStreamId()}, packets);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto connection = inputPort.getConnection();
+    connection.dequeue();
+    DataPacketPtr packet = connection.dequeue();
+    ASSERT_TRUE(packet.assigned());
+    ASSERT_EQ(packet.getDataDescriptor().getMetadata().get("DataType"), "EthernetBatch");
+
+    const size_t headerSize = sizeof(EthernetBatchHeader) + frameCount * sizeof(EthernetBatchEntry);
+    ASSERT_EQ(packet.getDataSize(), headerSize + frameCount * binaryData.size());
+
+    auto receivedData = reinterpret_cast<uint8_t*>(packet.getRawData());
+    auto header = reinterpret_cast<EthernetBatchHeader*>(receivedData);
+    ASSERT_EQ(header->frameCount, frameCount);
+
+    auto entries = reinterpret_cast<EthernetBatchEntry*>(receivedData + sizeof(EthernetBatchHeader));
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+        EXPECT_EQ(entries[i].timestamp, static_cast<uint64_t>(ethernetPacket->getTimestamp() + i));
+        EXPECT_EQ(entries[i].offset, headerSize + i * binaryData.size());
+        ASSERT_EQ(entries[i].length, binaryData.size());
+
+        std::vector<uint8_t> frame(receivedData + entries[i].offset, receivedData + entries[i].offset + entries[i].length);
+        EXPECT_EQ(frame, binaryData);
+    }
+}
+
+TEST_F(StreamFbEthernetPayloadTest, BatchFlushedAfterLatencyWithoutTraffic)
+{
+    constexpr uint32_t frameCount = 2;
+
+    interfaceFb.setPropertyValue("PayloadType", ethernetPayloadType);
+    funcBlock.setPropertyValue("EthernetBatchMaxLatency", 50);
+    funcBlock.setPropertyValue("EthernetBatching", true);
+    const auto outputSignal = funcBlock.getSignalsRecursive()[0];
+
+    auto inputPort = InputPort(interfaceFb.getContext(), nullptr, "testinput");
+    inputPort.connect(outputSignal);
+    auto connection = inputPort.getConnection();
+    connection.dequeue();
+
+    // The last frames of a burst, no message follows that could close the batch
+    std::vector<std::shared_ptr<Packet>> packets(frameCount, ethernetPacket);
+    publisher.publish({ethernetPacket->getDeviceId(), ethernetPacket->getInterfaceId(), ethernetPacket->getStreamId()}, packets);
+    ASSERT_FALSE(connection.dequeue().assigned());
+
+    PacketPtr received;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+    while (!received.assigned() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        received = connection.dequeue();
+    }
+
+    ASSERT_TRUE(received.assigned());
+    const DataPacketPtr packet = received;
+    ASSERT_EQ(reinterpret_cast<EthernetBatchHeader*>(packet.getRawData())->frameCount, frameCount);
+}
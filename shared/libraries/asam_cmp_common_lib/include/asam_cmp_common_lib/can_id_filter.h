@@ -0,0 +1,75 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Set of CAN arbitration IDs. Standard IDs are kept in a 2048 bit bitmap, extended IDs in a hash set, and
+// large extended ranges as sorted intervals, so a lookup is a single bit test for the common case.
+class CanIdFilter
+{
+public:
+    static constexpr uint32_t maxStandardId = 0x7FF;
+    static constexpr uint32_t maxExtendedId = 0x1FFFFFFF;
+    // Extended ranges up to this size are expanded into the hash set
+    static constexpr uint32_t maxExpandedRange = 4096;
+
+    CanIdFilter() = default;
+    // Comma or space separated IDs and inclusive ranges, e.g. "0x100-0x1FF, 0x7DF, 2024". Hex values need the
+    // 0x prefix. Throws std::invalid_argument for malformed items and IDs above maxExtendedId.
+    explicit CanIdFilter(const std::string& list);
+
+    // Splits a list in the format above into inclusive ranges, single IDs have equal bounds
+    static std::vector<std::pair<uint32_t, uint32_t>> parseList(const std::string& list);
+
+    void add(uint32_t id);
+    void addRange(uint32_t first, uint32_t last);
+    void clear();
+
+    bool isEmpty() const noexcept
+    {
+        return empty;
+    }
+
+    bool contains(uint32_t id) const noexcept
+    {
+        if (id <= maxStandardId)
+            return (standardIds[id >> 6] >> (id & 63)) & 1;
+        if (extendedIds.count(id) != 0)
+            return true;
+        return !extendedRanges.empty() && containsExtendedRange(id);
+    }
+
+private:
+    bool containsExtendedRange(uint32_t id) const noexcept;
+
+private:
+    std::array<uint64_t, (maxStandardId + 1) / 64> standardIds{};
+    std::unordered_set<uint32_t> extendedIds;
+    // Sorted and non-overlapping
+    std::vector<std::pair<uint32_t, uint32_t>> extendedRanges;
+    bool empty{true};
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Maps CAN arbitration IDs and ID ranges to output indices. Standard IDs are looked up in a 2048 entry table,
+// extended IDs in a hash map, and large extended ranges in sorted intervals. Where ranges overlap the range
+// added first wins.
+class CanIdMap
+{
+public:
+    static constexpr size_t notFound = static_cast<size_t>(-1);
+
+    void add(uint32_t first, uint32_t last, size_t index);
+    void clear();
+
+    bool isEmpty() const noexcept
+    {
+        return empty;
+    }
+
+    size_t find(uint32_t id) const noexcept
+    {
+        if (id <= maxStandardId)
+            return standardIds[id];
+        if (const auto it = extendedIds.find(id); it != extendedIds.end())
+            return it->second;
+        return extendedRanges.empty() ? notFound : findExtendedRange(id);
+    }
+
+private:
+    static constexpr uint32_t maxStandardId = 0x7FF;
+    static constexpr uint32_t maxExpandedRange = 4096;
+
+    size_t findExtendedRange(uint32_t id) const noexcept;
+
+private:
+    std::array<size_t, maxStandardId + 1> standardIds{initStandardIds()};
+    std::unordered_map<uint32_t, size_t> extendedIds;
+    // first, last and index, in the order of adding
+    std::vector<std::tuple<uint32_t, uint32_t, size_t>> extendedRanges;
+    bool empty{true};
+
+    static constexpr std::array<size_t, maxStandardId + 1> initStandardIds()
+    {
+        std::array<size_t, maxStandardId + 1> ids{};
+        for (auto& id : ids)
+            id = notFound;
+        return ids;
+    }
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+#include <opendaq/data_descriptor_ptr.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Compact alternatives to the CAN struct sample with a fixed Data[64] field. Classic CAN samples use a struct
+// with Data[8]. CAN FD frames are packed into one binary sample per packet: a header followed by frameCount
+// frames, each directly followed by its length data bytes. All fields are in host byte order.
+namespace compact_can
+{
+    // Value of the "DataType" metadata entry of the binary CAN FD descriptor
+    constexpr std::string_view canFdDataType{"CanFdCompact"};
+    constexpr size_t classicMaxLength = 8;
+    constexpr size_t canFdMaxLength = 64;
+
+#pragma pack(push, 1)
+    struct ClassicCanData
+    {
+        uint32_t arbId;
+        uint8_t length;
+        uint8_t data[classicMaxLength];
+    };
+
+    struct CanFdHeader
+    {
+        uint32_t frameCount;
+        uint32_t reserved;
+    };
+
+    struct CanFdFrame
+    {
+        // In ticks of the domain signal
+        uint64_t timestamp;
+        uint32_t arbId;
+        uint8_t length;
+    };
+#pragma pack(pop)
+    static_assert(sizeof(ClassicCanData) == 13, "Compact CAN samples must be packed");
+    static_assert(sizeof(CanFdFrame) == 13, "Compact CAN FD frames must be packed");
+
+    // Struct of ArbId, Length and Data[8] fields matching ClassicCanData
+    DataDescriptorPtr createClassicCanDescriptor();
+    DataDescriptorPtr createCanFdDescriptor();
+    bool isCanFdDescriptor(const DataDescriptorPtr& descriptor);
+
+    inline size_t getCanFdFrameSize(uint8_t length)
+    {
+        return sizeof(CanFdFrame) + length;
+    }
+
+    // Writes a frame at position and returns the position after its data
+    inline uint8_t* writeCanFdFrame(uint8_t* position, uint64_t timestamp, uint32_t arbId, const uint8_t* data, uint8_t length)
+    {
+        const CanFdFrame frame{timestamp, arbId, length};
+        memcpy(position, &frame, sizeof(frame));
+        memcpy(position + sizeof(frame), data, length);
+        return position + getCanFdFrameSize(length);
+    }
+
+    // Calls callback(const CanFdFrame&, const uint8_t* data) for each frame of a binary sample.
+    // Returns false if the sample is truncated or a frame is longer than a CAN FD frame.
+    template <typename Callback>
+    bool forEachCanFdFrame(const uint8_t* sample, size_t size, Callback&& callback)
+    {
+        if (size < sizeof(CanFdHeader))
+            return false;
+
+        CanFdHeader header;
+        memcpy(&header, sample, sizeof(header));
+
+        size_t position = sizeof(header);
+        for (uint32_t i = 0; i < header.frameCount; ++i)
+        {
+            if (size - position < sizeof(CanFdFrame))
+                return false;
+
+            CanFdFrame frame;
+            memcpy(&frame, sample + position, sizeof(frame));
+            position += sizeof(frame);
+            if (frame.length > canFdMaxLength || size - position < frame.length)
+                return false;
+
+            callback(frame, sample + position);
+            position += frame.length;
+        }
+        return true;
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Combines the adapters of several transports into one list and forwards all calls to the transport
+// that owns the selected adapter.
+class EthernetCompositeImpl : public EthernetPcppItf
+{
+public:
+    explicit EthernetCompositeImpl(std::vector<std::shared_ptr<EthernetPcppItf>> transports);
+
+    // Network adapters available through libpcap followed by the in-process loopback adapter
+    // and, on Linux, the shared memory and UDP adapters
+    static std::shared_ptr<EthernetPcppItf> createDefault();
+
+    ListPtr<StringPtr> getEthernetDevicesNamesList() override;
+    ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
+    bool sendPacket(const std::vector<uint8_t>& data) override;
+    size_t sendPackets(const std::vector<std::vector<uint8_t>>& frames) override;
+    bool sendTaggedPacket(const std::vector<uint8_t>& data, const VlanTag& tag) override;
+    size_t sendTaggedPackets(const std::vector<std::vector<uint8_t>>& frames, const VlanTag& tag) override;
+    void startCapture(PcppPacketReceivedCallbackType packetReceivedCb) override;
+    void stopCapture() override;
+    bool isDeviceCapturing() const override;
+    bool setDevice(const StringPtr& deviceName) override;
+    CaptureStatistics getCaptureStatistics() const override;
+    bool setUdpEndpoint(const std::string& address, uint16_t port) override;
+    bool setRecorder(const std::shared_ptr<PcapNgRecorder>& newRecorder) override;
+
+private:
+    EthernetPcppItf* findTransport(const StringPtr& deviceName) const;
+    void recordSent(const std::vector<uint8_t>& data) const;
+
+private:
+    const std::vector<std::shared_ptr<EthernetPcppItf>> transports;
+    std::atomic<EthernetPcppItf*> activeTransport{nullptr};
+    // Accessed with std::atomic_load/atomic_store, the send and receive paths don't take a lock
+    std::shared_ptr<PcapNgRecorder> recorder;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -18,9 +18,14 @@
 #include <asam_cmp_common_lib/common.h>
 #include <coretypes/listobject_factory.h>
 #include <coretypes/stringobject_factory.h>
+#include <memory>
+#include <string>
+#include <vector>
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
+class PcapNgRecorder;
+
 template <typename T>
 struct is_callable
 {
@@ -33,6 +38,21 @@ struct is_callable
     static const bool value = std::is_function<T>::value || std::is_member_function_pointer<T>::value || decltype(test<T>(nullptr))::value;
 };
 
+// IEEE 802.1Q tag of a sent frame
+struct VlanTag
+{
+    uint16_t vlanId;
+    // Priority code point, 0 (best effort) to 7 (highest)
+    uint8_t priority;
+};
+
+struct CaptureStatistics
+{
+    uint64_t packetsReceived{0};
+    uint64_t packetsDropped{0};
+    uint64_t packetsDroppedByInterface{0};
+};
+
 template <typename OnPacketReceivedCallbackType>
 class EthernetItf
 {
@@ -42,11 +62,50 @@ public:
     virtual ~EthernetItf() = default;
     virtual ListPtr<StringPtr> getEthernetDevicesNamesList() = 0;
     virtual ListPtr<StringPtr> getEthernetDevicesDescriptionsList() = 0;
-    virtual void sendPacket(const std::vector<uint8_t>& data) = 0;
+    virtual bool sendPacket(const std::vector<uint8_t>& data) = 0;
     virtual void startCapture(OnPacketReceivedCallbackType packetReceivedCb) = 0;
     virtual void stopCapture() = 0;
     virtual bool isDeviceCapturing() const = 0;
     virtual bool setDevice(const StringPtr& deviceName) = 0;
+    virtual CaptureStatistics getCaptureStatistics() const = 0;
+
+    // Sends frames in order and stops at the first failure, returns the number of frames sent.
+    // Transports that can hand several frames to the system at once override it.
+    virtual size_t sendPackets(const std::vector<std::vector<uint8_t>>& frames)
+    {
+        size_t sent = 0;
+        while (sent < frames.size() && sendPacket(frames[sent]))
+            ++sent;
+        return sent;
+    }
+
+    // Send frames with an 802.1Q tag. Transports without Ethernet framing send them untagged.
+    virtual bool sendTaggedPacket(const std::vector<uint8_t>& data, [[maybe_unused]] const VlanTag& tag)
+    {
+        return sendPacket(data);
+    }
+
+    virtual size_t sendTaggedPackets(const std::vector<std::vector<uint8_t>>& frames, const VlanTag& tag)
+    {
+        size_t sent = 0;
+        while (sent < frames.size() && sendTaggedPacket(frames[sent], tag))
+            ++sent;
+        return sent;
+    }
+
+    // Sets the destination and the listening port of the UDP transport, returns false if the
+    // wrapper has no UDP transport or the address is invalid
+    virtual bool setUdpEndpoint([[maybe_unused]] const std::string& address, [[maybe_unused]] uint16_t port)
+    {
+        return false;
+    }
+
+    // Records sent and received frames with the given recorder, nullptr stops recording.
+    // Returns false if the wrapper can't record.
+    virtual bool setRecorder([[maybe_unused]] const std::shared_ptr<PcapNgRecorder>& recorder)
+    {
+        return false;
+    }
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
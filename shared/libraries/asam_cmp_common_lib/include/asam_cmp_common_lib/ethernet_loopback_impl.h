@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <memory>
+#include <mutex>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+struct LoopbackReceiver;
+
+// Virtual network adapter that delivers frames sent through any EthernetLoopbackImpl to every capturing
+// EthernetLoopbackImpl of the process, without a network interface or elevated privileges. Instances meet
+// in the hub of the asam_cmp_loopback_hub shared library, so modules loaded as separate plugins see each other.
+// Each capturing instance owns a lock-free ring that is drained by its own delivery thread.
+class EthernetLoopbackImpl : public EthernetPcppItf
+{
+public:
+    explicit EthernetLoopbackImpl(size_t ringCapacity = defaultRingCapacity);
+    ~EthernetLoopbackImpl() override;
+
+    ListPtr<StringPtr> getEthernetDevicesNamesList() override;
+    ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
+    bool sendPacket(const std::vector<uint8_t>& data) override;
+    void startCapture(PcppPacketReceivedCallbackType packetReceivedCb) override;
+    void stopCapture() override;
+    bool isDeviceCapturing() const override;
+    bool setDevice(const StringPtr& deviceName) override;
+    CaptureStatistics getCaptureStatistics() const override;
+
+public:
+    static constexpr size_t defaultRingCapacity = 1024;
+    static constexpr const char* deviceName = "asam_cmp_loopback";
+    static constexpr const char* deviceDescription = "ASAM CMP In-Process Loopback";
+
+private:
+    const size_t ringCapacity;
+    mutable std::mutex receiverSync;
+    std::shared_ptr<LoopbackReceiver> receiver;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -16,6 +16,13 @@
 
 #pragma once
 #include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <functional>
+
+namespace pcpp
+{
+    class Packet;
+}
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
@@ -25,11 +32,21 @@ public:
     EthernetPcppImpl();
     ListPtr<StringPtr> getEthernetDevicesNamesList() override;
     ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
-    void sendPacket(const std::vector<uint8_t>& data) override;
+    bool sendPacket(const std::vector<uint8_t>& data) override;
+    bool sendTaggedPacket(const std::vector<uint8_t>& data, const VlanTag& tag) override;
     void startCapture(std::function<void(pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*)> onPacketReceivedCb) override;
     void stopCapture() override;
     bool isDeviceCapturing() const override;
     bool setDevice(const StringPtr& deviceName) override;
+    CaptureStatistics getCaptureStatistics() const override;
+
+    // Builds the Ethernet frame transmitted by sendPacket, with an 802.1Q tag if vlanTag is given, and passes it
+    // to frameHandler. The packet is only valid during the call. Used to measure the framing without a device.
+    static bool buildFrame(const pcpp::MacAddress& sourceMac,
+                           const uint8_t* data,
+                           size_t size,
+                           const std::function<bool(pcpp::Packet&)>& frameHandler,
+                           const VlanTag* vlanTag = nullptr);
 
 private:
     std::vector<pcpp::PcapLiveDevice*> createAvailableDevicesList() const;
@@ -37,7 +54,7 @@ private:
     pcpp::PcapLiveDevice* getPcapLiveDevice(const StringPtr& deviceName) const;
 
 public:
-    static constexpr uint16_t asamCmpEtherType = 0x99FE;
+    static constexpr uint16_t asamCmpEtherType = virtual_adapter::asamCmpEtherType;
 
 private:
     pcpp::PcapLiveDeviceList& pcapDeviceList{pcpp::PcapLiveDeviceList::getInstance()};
@@ -25,7 +25,8 @@ class EthernetPcppMock : public EthernetPcppItf
 public:
     MOCK_METHOD(ListPtr<StringPtr>, getEthernetDevicesNamesList, (), (override));
     MOCK_METHOD(ListPtr<StringPtr>, getEthernetDevicesDescriptionsList, (), (override));
-    MOCK_METHOD(void, sendPacket, (const std::vector<uint8_t>& data), (override));
+    MOCK_METHOD(bool, sendPacket, (const std::vector<uint8_t>& data), (override));
+    MOCK_METHOD(bool, sendTaggedPacket, (const std::vector<uint8_t>& data, const VlanTag& tag), (override));
     MOCK_METHOD(void,
                 startCapture,
                 ((std::function<void(pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*)> onPacketReceivedCb)),
@@ -33,6 +34,7 @@ public:
     MOCK_METHOD(void, stopCapture, (), (override));
     MOCK_METHOD(bool, isDeviceCapturing, (), (const, override));
     MOCK_METHOD(bool, setDevice, (const StringPtr& deviceName), (override));
+    MOCK_METHOD(CaptureStatistics, getCaptureStatistics, (), (const, override));
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
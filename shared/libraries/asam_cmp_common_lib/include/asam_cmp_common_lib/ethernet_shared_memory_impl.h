@@ -0,0 +1,81 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+struct SharedMemorySegment;
+
+// Virtual network adapter connecting processes on the same machine through a POSIX shared memory ring.
+// Senders in any process publish frames into the ring without blocking, every capturing instance reads
+// all frames published after its capture started. Idle readers sleep on a futex in the shared segment
+// which senders only signal when somebody is waiting, so a loaded ring costs no system calls.
+// Readers that fall more than a ring capacity behind skip the overwritten frames and report them as dropped.
+// A slot that a writer claimed but didn't publish within stalledSlotTimeout while later slots are claimed
+// (the writer stalled or died) is skipped and reported as dropped as well.
+class EthernetSharedMemoryImpl : public EthernetPcppItf
+{
+public:
+    explicit EthernetSharedMemoryImpl(std::string segmentName = defaultSegmentName, size_t capacity = defaultCapacity);
+    ~EthernetSharedMemoryImpl() override;
+
+    ListPtr<StringPtr> getEthernetDevicesNamesList() override;
+    ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
+    bool sendPacket(const std::vector<uint8_t>& data) override;
+    void startCapture(PcppPacketReceivedCallbackType packetReceivedCb) override;
+    void stopCapture() override;
+    bool isDeviceCapturing() const override;
+    bool setDevice(const StringPtr& deviceName) override;
+    CaptureStatistics getCaptureStatistics() const override;
+
+    // Removes the segment name from the system, processes that mapped it keep using it
+    static void removeSegment(const std::string& segmentName);
+
+public:
+    static constexpr const char* defaultSegmentName = "/asam_cmp_shm";
+    static constexpr size_t defaultCapacity = 4096;
+    static constexpr size_t batchSize = 64;
+    static constexpr std::chrono::milliseconds stalledSlotTimeout{10};
+    static constexpr const char* deviceName = "asam_cmp_shm";
+    static constexpr const char* deviceDescription = "ASAM CMP Shared Memory";
+
+private:
+    bool openSegment();
+    void captureLoop(uint64_t readPos);
+
+private:
+    const std::string segmentName;
+    const size_t capacity;
+    std::mutex segmentSync;
+    std::atomic<SharedMemorySegment*> segment{nullptr};
+    std::unique_ptr<SharedMemorySegment> segmentOwner;
+
+    PcppPacketReceivedCallbackType packetReceivedCb;
+    std::atomic<bool> capturing{false};
+    std::atomic<uint64_t> packetsReceived{0};
+    std::atomic<uint64_t> packetsDropped{0};
+    std::thread captureThread;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
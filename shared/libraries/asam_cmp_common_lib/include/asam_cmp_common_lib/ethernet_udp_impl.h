@@ -0,0 +1,75 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/ethernet_pcpp_itf.h>
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Transports CMP messages as UDP datagrams so they can be routed across subnets.
+// The destination can be a unicast or a multicast address, capturing listens on the same port and joins
+// the multicast group if needed. Batches are sent with sendmmsg where runs of equally sized frames are
+// merged into UDP GSO messages, receiving uses recvmmsg with UDP GRO so one system call moves many frames.
+// Received datagrams are handed to the capture callback with a synthesized Ethernet header.
+class EthernetUdpImpl : public EthernetPcppItf
+{
+public:
+    explicit EthernetUdpImpl(std::string address = defaultAddress, uint16_t port = defaultPort);
+    ~EthernetUdpImpl() override;
+
+    ListPtr<StringPtr> getEthernetDevicesNamesList() override;
+    ListPtr<StringPtr> getEthernetDevicesDescriptionsList() override;
+    bool sendPacket(const std::vector<uint8_t>& data) override;
+    size_t sendPackets(const std::vector<std::vector<uint8_t>>& frames) override;
+    void startCapture(PcppPacketReceivedCallbackType packetReceivedCb) override;
+    void stopCapture() override;
+    bool isDeviceCapturing() const override;
+    bool setDevice(const StringPtr& deviceName) override;
+    CaptureStatistics getCaptureStatistics() const override;
+    bool setUdpEndpoint(const std::string& address, uint16_t port) override;
+
+public:
+    static constexpr const char* defaultAddress = "239.255.67.77";
+    static constexpr uint16_t defaultPort = 50000;
+    static constexpr const char* deviceName = "asam_cmp_udp";
+    static constexpr const char* deviceDescription = "ASAM CMP over UDP";
+
+private:
+    bool openSendSocket();
+    int openReceiveSocket() const;
+    size_t sendBatch(const std::vector<std::vector<uint8_t>>& frames, size_t first);
+    void captureLoop();
+
+private:
+    mutable std::shared_mutex socketSync;
+    std::string address;
+    uint16_t port;
+    int sendSocket{-1};
+    std::atomic<bool> gsoEnabled{true};
+
+    PcppPacketReceivedCallbackType packetReceivedCb;
+    int receiveSocket{-1};
+    std::atomic<bool> capturing{false};
+    std::atomic<uint64_t> packetsReceived{0};
+    std::atomic<uint64_t> packetsDropped{0};
+    std::thread captureThread;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
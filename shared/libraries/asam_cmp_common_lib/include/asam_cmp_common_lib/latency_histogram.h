@@ -0,0 +1,55 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#pragma once
+
+#include <asam_cmp_common_lib/common.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Log-linear histogram of durations in nanoseconds. Every power of two range is split into
+// subBucketCount linear buckets, so a reported value is within 1/subBucketCount of the recorded one.
+// Recording is lock-free and wait-free, readers see a relaxed snapshot.
+class LatencyHistogram final
+{
+public:
+    void record(uint64_t valueNs) noexcept;
+    void record(std::chrono::steady_clock::duration duration) noexcept;
+
+    uint64_t getCount() const noexcept;
+    uint64_t getMax() const noexcept;
+    uint64_t getValueAtPercentile(double percentile) const noexcept;
+    void reset() noexcept;
+
+private:
+    static size_t getBucketIndex(uint64_t value) noexcept;
+    static uint64_t getBucketHighestValue(size_t index) noexcept;
+
+private:
+    static constexpr size_t subBucketBits = 4;
+    static constexpr size_t subBucketCount = size_t{1} << subBucketBits;
+    static constexpr size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+    std::array<std::atomic<uint64_t>, bucketCount> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> max{0};
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
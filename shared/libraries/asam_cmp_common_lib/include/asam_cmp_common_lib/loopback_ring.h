@@ -0,0 +1,67 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Bounded lock-free ring of Ethernet frames with multiple producers and a single consumer.
+// Frames are copied once into a preallocated slot and read by the consumer in place.
+class LoopbackRing final
+{
+public:
+    static constexpr size_t maxFrameSize = virtual_adapter::maxFrameSize;
+
+    struct alignas(64) Slot
+    {
+        std::atomic<size_t> sequence;
+        uint64_t timestamp;
+        uint32_t size;
+        std::array<uint8_t, maxFrameSize> data;
+    };
+
+public:
+    // Capacity is rounded up to the next power of two
+    explicit LoopbackRing(size_t capacity);
+
+    size_t getCapacity() const noexcept;
+
+    // Copies header and payload into the next free slot. Returns false if the ring is full or the frame is too large.
+    bool tryPush(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept;
+
+    // Consumer side: returns the oldest published slot or nullptr if the ring is empty.
+    // The slot stays valid until pop() is called.
+    const Slot* front() const noexcept;
+    void pop() noexcept;
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) noexcept;
+
+private:
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos{0};
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
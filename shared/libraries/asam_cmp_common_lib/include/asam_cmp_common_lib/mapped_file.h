@@ -0,0 +1,49 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <asam_cmp_common_lib/common.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Read-only memory mapping of a whole file
+class MappedFile final
+{
+public:
+    // Throws if the file can't be opened or is empty
+    explicit MappedFile(const std::string& fileName, bool sequentialAccess = false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* getData() const noexcept;
+    size_t getSize() const noexcept;
+
+private:
+    const uint8_t* data{nullptr};
+    size_t size{0};
+#ifdef _WIN32
+    void* fileHandle{nullptr};
+    void* mappingHandle{nullptr};
+#endif
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
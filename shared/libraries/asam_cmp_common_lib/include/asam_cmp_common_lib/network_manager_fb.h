@@ -21,6 +21,7 @@
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
 class EthernetPcppItf;
+class PcapNgRecorder;
 
 class NetworkManagerFb : public FunctionBlock
 {
@@ -35,6 +36,15 @@ public:
 private:
     void initProperties();
     void addNetworkAdaptersProperty();
+    void addUdpEndpointProperties();
+    void udpEndpointChangedInternal();
+    void addRecordingProperties();
+    void recordingChangedInternal();
+    void stopRecording();
+#ifdef ASAM_CMP_ENABLE_TRACING
+    void addTracingProperties();
+    void dumpTrace();
+#endif
 
 protected:
     virtual void networkAdapterChangedInternal();
@@ -42,6 +52,12 @@ protected:
 protected:
     std::shared_ptr<EthernetPcppItf> ethernetWrapper;
     StringPtr selectedEthernetDeviceName;
+
+private:
+    std::string udpAddress;
+    uint16_t udpPort{0};
+    // Kept after recording is stopped so that its counters stay readable, read events use std::atomic_load
+    std::shared_ptr<PcapNgRecorder> recorder;
 };
 
 END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Sidecar index written next to each recorded pcapng file (<file>.idx): an 8 byte magic followed by one
+// entry per frame, in host byte order. Entry timestamps never decrease so the index can be binary searched.
+namespace pcap_index
+{
+    constexpr std::array<char, 8> magic{'C', 'M', 'P', 'I', 'D', 'X', '0', '1'};
+    constexpr const char* fileExtension = ".idx";
+
+    enum EntryFlags : uint8_t
+    {
+        // deviceId and streamId are valid
+        cmpMessage = 0x01,
+        // The first message is a Data Message, interfaceId is valid
+        dataMessage = 0x02
+    };
+
+#pragma pack(push, 1)
+    struct Entry
+    {
+        // Nanoseconds since epoch, the maximum of the frame timestamps so far
+        uint64_t timestamp;
+        // Position of the packet block in the pcapng file
+        uint64_t offset;
+        uint32_t interfaceId;
+        uint16_t deviceId;
+        uint8_t streamId;
+        uint8_t flags;
+    };
+#pragma pack(pop)
+    static_assert(sizeof(Entry) == 24, "Index entries must be packed");
+
+    // Returns the offset of the first CMP message of an Ethernet frame with at most one 802.1Q tag,
+    // 0 if the frame doesn't carry ASAM CMP
+    inline size_t getCmpMessageOffset(const uint8_t* frame, size_t size) noexcept
+    {
+        constexpr uint16_t vlanEtherType = 0x8100;
+        constexpr size_t vlanTagSize = 4;
+
+        size_t etherTypeOffset = 12;
+        auto etherTypeAt = [frame](size_t offset) { return static_cast<uint16_t>((frame[offset] << 8) | frame[offset + 1]); };
+        if (size < virtual_adapter::ethernetHeaderSize)
+            return 0;
+
+        if (etherTypeAt(etherTypeOffset) == vlanEtherType)
+        {
+            etherTypeOffset += vlanTagSize;
+            if (size < virtual_adapter::ethernetHeaderSize + vlanTagSize)
+                return 0;
+        }
+
+        return etherTypeAt(etherTypeOffset) == virtual_adapter::asamCmpEtherType ? etherTypeOffset + 2 : 0;
+    }
+
+    // Fills the endpoint fields of the entry from the first CMP message of an Ethernet frame
+    inline void parseEndpoint(const uint8_t* frame, size_t size, Entry& entry) noexcept
+    {
+        constexpr size_t cmpHeaderSize = 8;
+        constexpr uint8_t dataMessageType = 0x01;
+
+        entry.deviceId = 0;
+        entry.streamId = 0;
+        entry.interfaceId = 0;
+        entry.flags = 0;
+
+        const size_t cmp = getCmpMessageOffset(frame, size);
+        const size_t interfaceIdOffset = cmp + cmpHeaderSize + 8;
+        if (cmp == 0 || size < cmp + cmpHeaderSize)
+            return;
+
+        entry.deviceId = static_cast<uint16_t>((frame[cmp + 2] << 8) | frame[cmp + 3]);
+        entry.streamId = frame[cmp + 5];
+        entry.flags = cmpMessage;
+
+        if (frame[cmp + 4] == dataMessageType && size >= interfaceIdOffset + 4)
+        {
+            const uint8_t* id = frame + interfaceIdOffset;
+            entry.interfaceId = (static_cast<uint32_t>(id[0]) << 24) | (static_cast<uint32_t>(id[1]) << 16) |
+                                (static_cast<uint32_t>(id[2]) << 8) | id[3];
+            entry.flags |= dataMessage;
+        }
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
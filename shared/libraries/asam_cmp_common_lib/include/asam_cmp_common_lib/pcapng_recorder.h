@@ -0,0 +1,118 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+#include <asam_cmp_common_lib/pcap_index_format.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Writes Ethernet frames into pcapng files with nanosecond timestamps. Frames are copied into one of two
+// buffers and a background thread writes the other one, so recording never waits for the disk: when both
+// buffers are full the frame is dropped and counted. Files are rotated by size and by duration.
+class PcapNgRecorder
+{
+public:
+    static constexpr size_t defaultBufferSize = 4 * 1024 * 1024;
+
+    struct Config
+    {
+        // Files are named <filePrefix>_<start time>_<index>.pcapng
+        std::string filePrefix;
+        // 0 disables the limit
+        uint64_t maxFileSize{0};
+        std::chrono::seconds maxFileDuration{0};
+        size_t bufferSize{defaultBufferSize};
+        // Writes a pcap_index sidecar file next to each recording file
+        bool writeIndex{true};
+    };
+
+public:
+    // Throws if the first file can't be created
+    explicit PcapNgRecorder(Config config);
+    ~PcapNgRecorder();
+
+    PcapNgRecorder(const PcapNgRecorder&) = delete;
+    PcapNgRecorder& operator=(const PcapNgRecorder&) = delete;
+
+    // Timestamp in nanoseconds since epoch
+    void record(const uint8_t* data, size_t size, uint64_t timestamp) noexcept;
+    // Records the concatenation of header and payload as one frame
+    void record(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept;
+    // Writes the buffered frames and closes the file, frames recorded afterwards are ignored
+    void stop();
+
+    uint64_t getRecordedFrames() const noexcept;
+    uint64_t getDroppedFrames() const noexcept;
+    std::vector<std::string> getFileNames() const;
+
+private:
+    struct Buffer
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t used{0};
+    };
+
+    void writerLoop();
+    void writeBuffer(const Buffer& buffer);
+    void writeRun(const uint8_t* data, size_t size, uint64_t frames);
+    void addIndexEntry(const uint8_t* block, uint64_t timestamp);
+    bool openFile();
+    void closeFile();
+
+private:
+    const Config config;
+    std::string sessionName;
+
+    std::mutex bufferSync;
+    std::condition_variable bufferCv;
+    std::array<Buffer, 2> buffers;
+    size_t activeBuffer{0};
+    // The other buffer is full and waits for the writer thread
+    bool pendingBuffer{false};
+    bool stopRequested{false};
+    std::thread writerThread;
+
+    // Owned by the writer thread
+    std::FILE* file{nullptr};
+    std::FILE* indexFile{nullptr};
+    uint64_t indexTimestamp{0};
+    // Index entries of the frames of the run being written, written to the index once the frames are in the file
+    std::vector<pcap_index::Entry> runIndexEntries;
+    uint64_t fileSize{0};
+    uint64_t fileFrames{0};
+    uint64_t fileStartTimestamp{0};
+    size_t fileIndex{0};
+
+    std::atomic<uint64_t> recordedFrames{0};
+    std::atomic<uint64_t> droppedFrames{0};
+
+    mutable std::mutex fileNamesSync;
+    std::vector<std::string> fileNames;
+};
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+
+// Scoped trace points are compiled in only when the ASAM_CMP_ENABLE_TRACING CMake option is on.
+// Otherwise ASAM_CMP_TRACE_SCOPE expands to nothing and the trace API is not declared at all.
+#ifdef ASAM_CMP_ENABLE_TRACING
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace trace
+{
+    struct Event
+    {
+        const char* name;
+        uint64_t start;
+        uint64_t duration;
+        uint32_t threadId;
+    };
+
+    // Number of events kept per thread, older events are overwritten
+    constexpr size_t eventsPerThread = size_t{1} << 16;
+
+    uint64_t now() noexcept;
+
+    // Appends a complete event to the ring buffer of the calling thread. The name must have static storage duration.
+    void record(const char* name, uint64_t start, uint64_t end) noexcept;
+
+    // Snapshot of the events of all threads sorted by start time. Events being overwritten while collecting are skipped.
+    std::vector<Event> collect();
+    void clear();
+
+    void writeChromeTrace(std::ostream& stream, const std::vector<Event>& events);
+    // Writes the collected events as Chrome trace JSON, loadable in chrome://tracing and Perfetto
+    void dumpChromeTrace(const std::string& fileName);
+
+    class Scope final
+    {
+    public:
+        explicit Scope(const char* name) noexcept
+            : name(name)
+            , start(now())
+        {
+        }
+
+        ~Scope()
+        {
+            record(name, start, now());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        uint64_t start;
+    };
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
+
+#define ASAM_CMP_TRACE_CONCAT_IMPL(a, b) a##b
+#define ASAM_CMP_TRACE_CONCAT(a, b) ASAM_CMP_TRACE_CONCAT_IMPL(a, b)
+#define ASAM_CMP_TRACE_SCOPE(name) \
+    const daq::asam_cmp_common_lib::trace::Scope ASAM_CMP_TRACE_CONCAT(asamCmpTraceScope, __LINE__)(name)
+
+#else
+
+#define ASAM_CMP_TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif
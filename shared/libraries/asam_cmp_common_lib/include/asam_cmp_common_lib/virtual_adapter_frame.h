@@ -0,0 +1,52 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <asam_cmp_common_lib/common.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+// Ethernet framing shared by the transports that do not go through a network interface
+// and therefore have to synthesize the Ethernet layer expected by the receive callbacks.
+namespace virtual_adapter
+{
+    constexpr uint16_t asamCmpEtherType = 0x99FE;
+    constexpr size_t ethernetHeaderSize = 14;
+    constexpr size_t maxFrameSize = 1514;
+
+    // Broadcast destination, locally administered source address, ASAM CMP EtherType
+    constexpr std::array<uint8_t, ethernetHeaderSize> ethernetHeader{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                                                     0x02, 0x00, 0x00, 0x00, 0x00, 0x01,
+                                                                     asamCmpEtherType >> 8, asamCmpEtherType & 0xFF};
+
+    inline uint64_t getTimestamp() noexcept
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    inline timespec toTimespec(uint64_t timestampNs) noexcept
+    {
+        return timespec{static_cast<time_t>(timestampNs / 1'000'000'000), static_cast<long>(timestampNs % 1'000'000'000)};
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
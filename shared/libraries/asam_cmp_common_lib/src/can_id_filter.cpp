@@ -0,0 +1,119 @@
+#include <asam_cmp_common_lib/can_id_filter.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    uint32_t parseId(const std::string& text, const std::string& item)
+    {
+        const bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+        const auto digits = hex ? text.substr(2) : text;
+        if (digits.empty() || digits.find_first_not_of(hex ? "0123456789abcdefABCDEF" : "0123456789") != std::string::npos ||
+            digits.size() > 10)
+            throw std::invalid_argument("Invalid CAN ID \"" + item + "\"");
+
+        const auto id = std::stoull(digits, nullptr, hex ? 16 : 10);
+        if (id > CanIdFilter::maxExtendedId)
+            throw std::invalid_argument("CAN ID \"" + item + "\" is out of range");
+        return static_cast<uint32_t>(id);
+    }
+}
+
+CanIdFilter::CanIdFilter(const std::string& list)
+{
+    for (const auto& [first, last] : parseList(list))
+        addRange(first, last);
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> CanIdFilter::parseList(const std::string& list)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    size_t position = 0;
+    while (position < list.size())
+    {
+        const auto begin = list.find_first_not_of(", \t", position);
+        if (begin == std::string::npos)
+            break;
+        position = list.find_first_of(", \t", begin);
+        const auto item = list.substr(begin, position == std::string::npos ? std::string::npos : position - begin);
+
+        const auto separator = item.find('-');
+        if (separator == std::string::npos)
+        {
+            const auto id = parseId(item, item);
+            ranges.emplace_back(id, id);
+        }
+        else
+        {
+            const auto first = parseId(item.substr(0, separator), item);
+            const auto last = parseId(item.substr(separator + 1), item);
+            if (first > last)
+                throw std::invalid_argument("Invalid CAN ID range \"" + item + "\"");
+            ranges.emplace_back(first, last);
+        }
+    }
+
+    return ranges;
+}
+
+void CanIdFilter::add(uint32_t id)
+{
+    addRange(id, id);
+}
+
+void CanIdFilter::addRange(uint32_t first, uint32_t last)
+{
+    if (first > last || last > maxExtendedId)
+        throw std::invalid_argument("Invalid CAN ID range");
+
+    empty = false;
+    for (; first <= last && first <= maxStandardId; ++first)
+        standardIds[first >> 6] |= uint64_t{1} << (first & 63);
+    if (first > last)
+        return;
+
+    if (last - first < maxExpandedRange)
+    {
+        for (uint32_t id = first; id <= last; ++id)
+            extendedIds.insert(id);
+        return;
+    }
+
+    extendedRanges.emplace_back(first, last);
+    std::sort(extendedRanges.begin(), extendedRanges.end());
+
+    std::vector<std::pair<uint32_t, uint32_t>> merged;
+    for (const auto& range : extendedRanges)
+    {
+        if (!merged.empty() && range.first <= merged.back().second + 1)
+            merged.back().second = std::max(merged.back().second, range.second);
+        else
+            merged.push_back(range);
+    }
+    extendedRanges = std::move(merged);
+}
+
+void CanIdFilter::clear()
+{
+    standardIds.fill(0);
+    extendedIds.clear();
+    extendedRanges.clear();
+    empty = true;
+}
+
+bool CanIdFilter::containsExtendedRange(uint32_t id) const noexcept
+{
+    auto range = std::upper_bound(extendedRanges.begin(),
+                                  extendedRanges.end(),
+                                  id,
+                                  [](uint32_t value, const std::pair<uint32_t, uint32_t>& range) { return value < range.first; });
+    if (range == extendedRanges.begin())
+        return false;
+    --range;
+    return id <= range->second;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
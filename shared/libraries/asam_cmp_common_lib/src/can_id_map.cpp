@@ -0,0 +1,53 @@
+#include <asam_cmp_common_lib/can_id_map.h>
+
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+void CanIdMap::add(uint32_t first, uint32_t last, size_t index)
+{
+    if (first > last || index == notFound)
+        throw std::invalid_argument("Invalid CAN ID range");
+
+    empty = false;
+    for (; first <= last && first <= maxStandardId; ++first)
+    {
+        if (standardIds[first] == notFound)
+            standardIds[first] = index;
+    }
+    if (first > last)
+        return;
+
+    if (last - first < maxExpandedRange)
+    {
+        for (uint32_t id = first; id <= last; ++id)
+        {
+            if (findExtendedRange(id) == notFound)
+                extendedIds.emplace(id, index);
+        }
+        return;
+    }
+
+    extendedRanges.emplace_back(first, last, index);
+}
+
+void CanIdMap::clear()
+{
+    standardIds = initStandardIds();
+    extendedIds.clear();
+    extendedRanges.clear();
+    empty = true;
+}
+
+size_t CanIdMap::findExtendedRange(uint32_t id) const noexcept
+{
+    // Only a few large ranges are expected, a linear scan keeps the first added range winning
+    for (const auto& [first, last, index] : extendedRanges)
+    {
+        if (id >= first && id <= last)
+            return index;
+    }
+    return notFound;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,45 @@
+#include <asam_cmp_common_lib/compact_can_layout.h>
+#include <opendaq/data_descriptor_factory.h>
+#include <opendaq/dimension_factory.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace compact_can
+{
+    DataDescriptorPtr createClassicCanDescriptor()
+    {
+        const auto arbIdDescriptor = DataDescriptorBuilder().setName("ArbId").setSampleType(SampleType::Int32).build();
+        const auto lengthDescriptor = DataDescriptorBuilder().setName("Length").setSampleType(SampleType::Int8).build();
+
+        const auto dataDescriptor = DataDescriptorBuilder()
+                                        .setName("Data")
+                                        .setSampleType(SampleType::UInt8)
+                                        .setDimensions(List<IDimension>(
+                                            DimensionBuilder().setRule(LinearDimensionRule(0, 1, classicMaxLength)).setName("Dimension").build()))
+                                        .build();
+
+        return DataDescriptorBuilder()
+            .setSampleType(SampleType::Struct)
+            .setStructFields(List<IDataDescriptor>(arbIdDescriptor, lengthDescriptor, dataDescriptor))
+            .setName("CAN")
+            .build();
+    }
+
+    DataDescriptorPtr createCanFdDescriptor()
+    {
+        auto metadata = Dict<IString, IString>();
+        metadata["DataType"] = String(canFdDataType.data());
+        return DataDescriptorBuilder().setSampleType(SampleType::Binary).setMetadata(metadata).setName("CAN FD").build();
+    }
+
+    bool isCanFdDescriptor(const DataDescriptorPtr& descriptor)
+    {
+        if (!descriptor.assigned() || descriptor.getSampleType() != SampleType::Binary)
+            return false;
+
+        const auto metadata = descriptor.getMetadata();
+        return metadata.assigned() && metadata.hasKey("DataType") && metadata.get("DataType") == canFdDataType.data();
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,194 @@
+#include <asam_cmp_common_lib/ethernet_composite_impl.h>
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/pcapng_recorder.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#ifdef __linux__
+#include <asam_cmp_common_lib/ethernet_shared_memory_impl.h>
+#include <asam_cmp_common_lib/ethernet_udp_impl.h>
+#endif
+
+#include <algorithm>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+EthernetCompositeImpl::EthernetCompositeImpl(std::vector<std::shared_ptr<EthernetPcppItf>> transports)
+    : transports(std::move(transports))
+{
+}
+
+std::shared_ptr<EthernetPcppItf> EthernetCompositeImpl::createDefault()
+{
+    std::vector<std::shared_ptr<EthernetPcppItf>> transports{std::make_shared<EthernetPcppImpl>(),
+                                                             std::make_shared<EthernetLoopbackImpl>()};
+#ifdef __linux__
+    transports.push_back(std::make_shared<EthernetSharedMemoryImpl>());
+    transports.push_back(std::make_shared<EthernetUdpImpl>());
+#endif
+    return std::make_shared<EthernetCompositeImpl>(std::move(transports));
+}
+
+EthernetPcppItf* EthernetCompositeImpl::findTransport(const StringPtr& deviceName) const
+{
+    for (const auto& transport : transports)
+    {
+        auto names = transport->getEthernetDevicesNamesList();
+        if (std::find(names.begin(), names.end(), deviceName) != names.end())
+            return transport.get();
+    }
+
+    return nullptr;
+}
+
+ListPtr<StringPtr> EthernetCompositeImpl::getEthernetDevicesNamesList()
+{
+    ListPtr<StringPtr> devicesNames = List<IString>();
+    for (const auto& transport : transports)
+    {
+        for (const auto& name : transport->getEthernetDevicesNamesList())
+            devicesNames.pushBack(name);
+    }
+
+    return devicesNames;
+}
+
+ListPtr<StringPtr> EthernetCompositeImpl::getEthernetDevicesDescriptionsList()
+{
+    ListPtr<StringPtr> devicesDescriptions = List<IString>();
+    for (const auto& transport : transports)
+    {
+        for (const auto& description : transport->getEthernetDevicesDescriptionsList())
+            devicesDescriptions.pushBack(description);
+    }
+
+    return devicesDescriptions;
+}
+
+bool EthernetCompositeImpl::setDevice(const StringPtr& deviceName)
+{
+    auto transport = findTransport(deviceName);
+    if (!transport || !transport->setDevice(deviceName))
+        return false;
+
+    activeTransport = transport;
+    return true;
+}
+
+bool EthernetCompositeImpl::sendPacket(const std::vector<uint8_t>& data)
+{
+    auto transport = activeTransport.load();
+    if (!transport || !transport->sendPacket(data))
+        return false;
+
+    recordSent(data);
+    return true;
+}
+
+size_t EthernetCompositeImpl::sendPackets(const std::vector<std::vector<uint8_t>>& frames)
+{
+    auto transport = activeTransport.load();
+    if (!transport)
+        return 0;
+
+    const size_t sent = transport->sendPackets(frames);
+    for (size_t i = 0; i < sent; ++i)
+        recordSent(frames[i]);
+
+    return sent;
+}
+
+bool EthernetCompositeImpl::sendTaggedPacket(const std::vector<uint8_t>& data, const VlanTag& tag)
+{
+    auto transport = activeTransport.load();
+    if (!transport || !transport->sendTaggedPacket(data, tag))
+        return false;
+
+    recordSent(data);
+    return true;
+}
+
+size_t EthernetCompositeImpl::sendTaggedPackets(const std::vector<std::vector<uint8_t>>& frames, const VlanTag& tag)
+{
+    auto transport = activeTransport.load();
+    if (!transport)
+        return 0;
+
+    const size_t sent = transport->sendTaggedPackets(frames, tag);
+    for (size_t i = 0; i < sent; ++i)
+        recordSent(frames[i]);
+
+    return sent;
+}
+
+void EthernetCompositeImpl::recordSent(const std::vector<uint8_t>& data) const
+{
+    // Transports get the CMP message only, the recording needs the Ethernet frame
+    if (auto activeRecorder = std::atomic_load(&recorder))
+    {
+        activeRecorder->record(virtual_adapter::ethernetHeader.data(),
+                               virtual_adapter::ethernetHeader.size(),
+                               data.data(),
+                               data.size(),
+                               virtual_adapter::getTimestamp());
+    }
+}
+
+void EthernetCompositeImpl::startCapture(PcppPacketReceivedCallbackType packetReceivedCb)
+{
+    stopCapture();
+
+    auto transport = activeTransport.load();
+    if (!transport)
+        return;
+
+    transport->startCapture(
+        [this, packetReceivedCb = std::move(packetReceivedCb)](pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
+        {
+            if (auto activeRecorder = std::atomic_load(&recorder))
+            {
+                const timespec ts = packet->getPacketTimeStamp();
+                activeRecorder->record(packet->getRawData(),
+                                       static_cast<size_t>(packet->getRawDataLen()),
+                                       static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec));
+            }
+            packetReceivedCb(packet, dev, cookie);
+        });
+}
+
+void EthernetCompositeImpl::stopCapture()
+{
+    for (const auto& transport : transports)
+    {
+        if (transport->isDeviceCapturing())
+            transport->stopCapture();
+    }
+}
+
+bool EthernetCompositeImpl::isDeviceCapturing() const
+{
+    auto transport = activeTransport.load();
+    return transport && transport->isDeviceCapturing();
+}
+
+CaptureStatistics EthernetCompositeImpl::getCaptureStatistics() const
+{
+    auto transport = activeTransport.load();
+    return transport ? transport->getCaptureStatistics() : CaptureStatistics{};
+}
+
+bool EthernetCompositeImpl::setUdpEndpoint(const std::string& address, uint16_t port)
+{
+    bool accepted = false;
+    for (const auto& transport : transports)
+        accepted = transport->setUdpEndpoint(address, port) || accepted;
+
+    return accepted;
+}
+
+bool EthernetCompositeImpl::setRecorder(const std::shared_ptr<PcapNgRecorder>& newRecorder)
+{
+    std::atomic_store(&recorder, newRecorder);
+    return true;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,176 @@
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+#include <asam_cmp_common_lib/loopback_ring.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <asam_cmp_loopback_hub/loopback_hub.h>
+#include <RawPacket.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <stdexcept>
+#include <thread>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+struct LoopbackReceiver final : asam_cmp_loopback_hub::LoopbackSubscriber
+{
+    LoopbackReceiver(size_t capacity, PcppPacketReceivedCallbackType callback)
+        : ring(capacity)
+        , callback(std::move(callback))
+    {
+        thread = std::thread([this] { deliverLoop(); });
+    }
+
+    ~LoopbackReceiver()
+    {
+        stop();
+    }
+
+    void push(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept override
+    {
+        if (!ring.tryPush(header, headerSize, payload, payloadSize, timestamp))
+        {
+            packetsDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        packetsReceived.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in deliverLoop so either the consumer sees the frame or we see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed))
+        {
+            std::scoped_lock lock(wakeupSync);
+            wakeup.notify_one();
+        }
+    }
+
+    void stop()
+    {
+        {
+            std::scoped_lock lock(wakeupSync);
+            running = false;
+        }
+        wakeup.notify_one();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void deliverLoop()
+    {
+        while (running.load(std::memory_order_relaxed))
+        {
+            if (const auto* slot = ring.front())
+            {
+                pcpp::RawPacket rawPacket(
+                    slot->data.data(), static_cast<int>(slot->size), virtual_adapter::toTimespec(slot->timestamp), false);
+                callback(&rawPacket, nullptr, nullptr);
+                ring.pop();
+                continue;
+            }
+
+            std::unique_lock lock(wakeupSync);
+            waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (running && ring.front() == nullptr)
+                wakeup.wait_for(lock, std::chrono::milliseconds(100));
+            waiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    LoopbackRing ring;
+    PcppPacketReceivedCallbackType callback;
+    std::atomic<uint64_t> packetsReceived{0};
+    std::atomic<uint64_t> packetsDropped{0};
+    std::atomic<bool> running{true};
+    std::atomic<bool> waiting{false};
+    std::mutex wakeupSync;
+    std::condition_variable wakeup;
+    std::thread thread;
+};
+
+EthernetLoopbackImpl::EthernetLoopbackImpl(size_t ringCapacity)
+    : ringCapacity(ringCapacity)
+{
+    if (ringCapacity == 0)
+        throw std::invalid_argument("Loopback ring capacity must be greater than zero");
+}
+
+EthernetLoopbackImpl::~EthernetLoopbackImpl()
+{
+    stopCapture();
+}
+
+ListPtr<StringPtr> EthernetLoopbackImpl::getEthernetDevicesNamesList()
+{
+    ListPtr<StringPtr> devicesNames = List<IString>();
+    devicesNames.pushBack(deviceName);
+    return devicesNames;
+}
+
+ListPtr<StringPtr> EthernetLoopbackImpl::getEthernetDevicesDescriptionsList()
+{
+    ListPtr<StringPtr> devicesDescriptions = List<IString>();
+    devicesDescriptions.pushBack(deviceDescription);
+    return devicesDescriptions;
+}
+
+bool EthernetLoopbackImpl::setDevice(const StringPtr& deviceName)
+{
+    return deviceName.toStdString() == EthernetLoopbackImpl::deviceName;
+}
+
+bool EthernetLoopbackImpl::sendPacket(const std::vector<uint8_t>& data)
+{
+    if (virtual_adapter::ethernetHeaderSize + data.size() > virtual_adapter::maxFrameSize)
+        return false;
+
+    asam_cmp_loopback_hub::publish(virtual_adapter::ethernetHeader.data(),
+                                   virtual_adapter::ethernetHeaderSize,
+                                   data.data(),
+                                   data.size(),
+                                   virtual_adapter::getTimestamp());
+    return true;
+}
+
+void EthernetLoopbackImpl::startCapture(PcppPacketReceivedCallbackType packetReceivedCb)
+{
+    stopCapture();
+
+    std::scoped_lock lock(receiverSync);
+    receiver = std::make_shared<LoopbackReceiver>(ringCapacity, std::move(packetReceivedCb));
+    asam_cmp_loopback_hub::subscribe(receiver.get());
+}
+
+void EthernetLoopbackImpl::stopCapture()
+{
+    std::shared_ptr<LoopbackReceiver> stoppedReceiver;
+    {
+        std::scoped_lock lock(receiverSync);
+        if (!receiver)
+            return;
+        stoppedReceiver = std::move(receiver);
+    }
+
+    asam_cmp_loopback_hub::unsubscribe(stoppedReceiver.get());
+    stoppedReceiver->stop();
+}
+
+bool EthernetLoopbackImpl::isDeviceCapturing() const
+{
+    std::scoped_lock lock(receiverSync);
+    return receiver != nullptr;
+}
+
+CaptureStatistics EthernetLoopbackImpl::getCaptureStatistics() const
+{
+    CaptureStatistics statistics;
+    std::scoped_lock lock(receiverSync);
+    if (!receiver)
+        return statistics;
+
+    statistics.packetsReceived = receiver->packetsReceived.load(std::memory_order_relaxed);
+    statistics.packetsDropped = receiver->packetsDropped.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
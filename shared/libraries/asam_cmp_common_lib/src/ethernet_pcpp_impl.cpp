@@ -1,10 +1,14 @@
 #include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/trace.h>
 #include <PcapLiveDeviceList.h>
 #include <SystemUtils.h>
 #include <EthLayer.h>
+#include <VlanLayer.h>
 #include <PayloadLayer.h>
 #include <Packet.h>
 
+#include <optional>
+
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
 EthernetPcppImpl::EthernetPcppImpl()
@@ -38,14 +42,10 @@ pcpp::PcapLiveDevice* EthernetPcppImpl::getFirstAvailableDevice() const
 
 void setFilters(pcpp::PcapLiveDevice* device)
 {
-    // create a filters
-    pcpp::EtherTypeFilter ethernetTypeFilter(EthernetPcppImpl::asamCmpEtherType);
-
-    // create an AND filter to combine both filters
-    pcpp::AndFilter andFilter;
-    andFilter.addFilter(&ethernetTypeFilter);
-    // set the filter on the device
-    device->setFilter(andFilter);
+    // ASAM CMP frames with and without an 802.1Q tag
+    const auto etherType = fmt::format("ether proto {:#06x}", EthernetPcppImpl::asamCmpEtherType);
+    pcpp::BPFStringFilter filter(fmt::format("{} or (vlan and {})", etherType, etherType));
+    device->setFilter(filter);
 }
 
 pcpp::PcapLiveDevice* EthernetPcppImpl::getPcapLiveDevice(const StringPtr& deviceName) const
@@ -107,27 +107,67 @@ bool EthernetPcppImpl::setDevice(const StringPtr& deviceName)
     return true;
 }
 
-void EthernetPcppImpl::sendPacket(const std::vector<uint8_t>& data)
+bool EthernetPcppImpl::sendPacket(const std::vector<uint8_t>& data)
+{
+    ASAM_CMP_TRACE_SCOPE("EthernetPcppImpl::sendPacket");
+    if (!activeDevice)
+        return false;
+
+    return buildFrame(activeDevice->getMacAddress(),
+                      data.data(),
+                      data.size(),
+                      [device = activeDevice](pcpp::Packet& packet) { return device->sendPacket(&packet); });
+}
+
+bool EthernetPcppImpl::sendTaggedPacket(const std::vector<uint8_t>& data, const VlanTag& tag)
+{
+    ASAM_CMP_TRACE_SCOPE("EthernetPcppImpl::sendTaggedPacket");
+    if (!activeDevice)
+        return false;
+
+    return buildFrame(
+        activeDevice->getMacAddress(),
+        data.data(),
+        data.size(),
+        [device = activeDevice](pcpp::Packet& packet) { return device->sendPacket(&packet); },
+        &tag);
+}
+
+bool EthernetPcppImpl::buildFrame(const pcpp::MacAddress& sourceMac,
+                                  const uint8_t* data,
+                                  size_t size,
+                                  const std::function<bool(pcpp::Packet&)>& frameHandler,
+                                  const VlanTag* vlanTag)
 {
     // create a new Ethernet layer
     pcpp::EthLayer newEthernetLayer(
-        pcpp::MacAddress(activeDevice->getMacAddress()), pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), asamCmpEtherType);
-    pcpp::PayloadLayer payloadLayer(data.data(), data.size());
+        sourceMac, pcpp::MacAddress("FF:FF:FF:FF:FF:FF"), vlanTag ? PCPP_ETHERTYPE_VLAN : asamCmpEtherType);
+    pcpp::PayloadLayer payloadLayer(data, size);
     // create a packet with initial capacity of 100 bytes (will grow automatically if needed)
     pcpp::Packet newPacket(100);
     [[maybe_unused]] bool res = newPacket.addLayer(&newEthernetLayer);
     assert(res);
+    std::optional<pcpp::VlanLayer> vlanLayer;
+    if (vlanTag)
+    {
+        vlanLayer.emplace(vlanTag->vlanId, false, vlanTag->priority, asamCmpEtherType);
+        res = newPacket.addLayer(&*vlanLayer);
+        assert(res);
+    }
     res = newPacket.addLayer(&payloadLayer);
     assert(res);
     // compute all calculated fields
     newPacket.computeCalculateFields();
 
-    activeDevice->sendPacket(&newPacket);
+    return frameHandler(newPacket);
 }
 
 void EthernetPcppImpl::startCapture(std::function<void(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)> onPacketReceivedCb)
 {
     stopCapture();
+    if (!activeDevice)
+        return;
+
     setFilters(activeDevice);
 
     activeDevice->startCapture(onPacketReceivedCb, nullptr);
@@ -141,7 +181,21 @@ void EthernetPcppImpl::stopCapture()
 
 bool EthernetPcppImpl::isDeviceCapturing() const
 {
-    return activeDevice->captureActive();
+    return activeDevice && activeDevice->captureActive();
+}
+
+CaptureStatistics EthernetPcppImpl::getCaptureStatistics() const
+{
+    CaptureStatistics statistics;
+    if (!isDeviceCapturing())
+        return statistics;
+
+    pcpp::IPcapDevice::PcapStats stats{};
+    activeDevice->getStatistics(stats);
+    statistics.packetsReceived = stats.packetsRecv;
+    statistics.packetsDropped = stats.packetsDrop;
+    statistics.packetsDroppedByInterface = stats.packetsDropByInterface;
+    return statistics;
 }
 
 END_NAMESPACE_ASAM_CMP_COMMON
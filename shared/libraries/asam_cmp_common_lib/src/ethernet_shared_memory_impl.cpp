@@ -0,0 +1,356 @@
+#include <asam_cmp_common_lib/ethernet_shared_memory_impl.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <RawPacket.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    constexpr uint32_t segmentMagic = 0x434D5052;  // "CMPR"
+    constexpr uint32_t segmentVersion = 1;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "Shared memory ring requires address-free atomics");
+
+    struct SegmentHeader
+    {
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint64_t capacity;
+        alignas(64) std::atomic<uint64_t> writePos;
+        alignas(64) std::atomic<uint32_t> wakeupCounter;
+        std::atomic<uint32_t> waiters;
+    };
+
+    // A slot holding the frame published at position pos has sequence (pos + 1) * 2,
+    // an odd sequence marks a slot that is being written
+    struct alignas(64) SegmentSlot
+    {
+        std::atomic<uint64_t> sequence;
+        uint64_t timestamp;
+        uint32_t size;
+        uint8_t data[virtual_adapter::maxFrameSize];
+    };
+
+    constexpr size_t headerSize = (sizeof(SegmentHeader) + alignof(SegmentSlot) - 1) / alignof(SegmentSlot) * alignof(SegmentSlot);
+
+    size_t getSegmentSize(size_t capacity)
+    {
+        return headerSize + capacity * sizeof(SegmentSlot);
+    }
+
+    long futex(std::atomic<uint32_t>* address, int operation, uint32_t value, const timespec* timeout)
+    {
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), operation, value, timeout, nullptr, 0);
+    }
+}
+
+struct SharedMemorySegment
+{
+    SharedMemorySegment(void* address, size_t size)
+        : address(address)
+        , size(size)
+        , header(static_cast<SegmentHeader*>(address))
+        , slots(reinterpret_cast<SegmentSlot*>(static_cast<uint8_t*>(address) + headerSize))
+        , mask(header->capacity - 1)
+    {
+    }
+
+    ~SharedMemorySegment()
+    {
+        munmap(address, size);
+    }
+
+    void publish(const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept
+    {
+        const uint64_t pos = header->writePos.fetch_add(1, std::memory_order_relaxed);
+        SegmentSlot& slot = slots[pos & mask];
+
+        slot.sequence.store(pos * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(slot.data, virtual_adapter::ethernetHeader.data(), virtual_adapter::ethernetHeaderSize);
+        std::memcpy(slot.data + virtual_adapter::ethernetHeaderSize, payload, payloadSize);
+        slot.size = static_cast<uint32_t>(virtual_adapter::ethernetHeaderSize + payloadSize);
+        slot.timestamp = timestamp;
+        slot.sequence.store((pos + 1) * 2, std::memory_order_release);
+
+        header->wakeupCounter.fetch_add(1, std::memory_order_seq_cst);
+        if (header->waiters.load(std::memory_order_seq_cst) != 0)
+            futex(&header->wakeupCounter, FUTEX_WAKE, INT_MAX, nullptr);
+    }
+
+    void* address;
+    size_t size;
+    SegmentHeader* header;
+    SegmentSlot* slots;
+    uint64_t mask;
+};
+
+EthernetSharedMemoryImpl::EthernetSharedMemoryImpl(std::string segmentName, size_t capacity)
+    : segmentName(std::move(segmentName))
+    , capacity(capacity)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+        throw std::invalid_argument("Shared memory ring capacity must be a power of two");
+}
+
+EthernetSharedMemoryImpl::~EthernetSharedMemoryImpl()
+{
+    stopCapture();
+}
+
+void EthernetSharedMemoryImpl::removeSegment(const std::string& segmentName)
+{
+    shm_unlink(segmentName.c_str());
+}
+
+bool EthernetSharedMemoryImpl::openSegment()
+{
+    std::scoped_lock lock(segmentSync);
+    if (segment.load())
+        return true;
+
+    bool created = true;
+    int fd = shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0660);
+    if (fd == -1 && errno == EEXIST)
+    {
+        created = false;
+        fd = shm_open(segmentName.c_str(), O_RDWR, 0660);
+    }
+    if (fd == -1)
+        return false;
+
+    size_t size = getSegmentSize(capacity);
+    if (created)
+    {
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            close(fd);
+            shm_unlink(segmentName.c_str());
+            return false;
+        }
+    }
+    else
+    {
+        // The creator may still be sizing the segment, the existing ring capacity wins over ours
+        struct stat segmentStat{};
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            if (fstat(fd, &segmentStat) == 0 && static_cast<size_t>(segmentStat.st_size) > headerSize)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        size = static_cast<size_t>(segmentStat.st_size);
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+        return false;
+
+    auto header = static_cast<SegmentHeader*>(address);
+    if (created)
+    {
+        header->version = segmentVersion;
+        header->capacity = capacity;
+        header->magic.store(segmentMagic, std::memory_order_release);
+    }
+    else
+    {
+        for (int attempt = 0; attempt < 100 && header->magic.load(std::memory_order_acquire) != segmentMagic; ++attempt)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        const uint64_t existingCapacity = header->capacity;
+        if (header->magic.load(std::memory_order_acquire) != segmentMagic || header->version != segmentVersion ||
+            existingCapacity == 0 || (existingCapacity & (existingCapacity - 1)) != 0 || getSegmentSize(existingCapacity) > size)
+        {
+            munmap(address, size);
+            return false;
+        }
+    }
+
+    segmentOwner = std::make_unique<SharedMemorySegment>(address, size);
+    segment = segmentOwner.get();
+    return true;
+}
+
+ListPtr<StringPtr> EthernetSharedMemoryImpl::getEthernetDevicesNamesList()
+{
+    ListPtr<StringPtr> devicesNames = List<IString>();
+    devicesNames.pushBack(deviceName);
+    return devicesNames;
+}
+
+ListPtr<StringPtr> EthernetSharedMemoryImpl::getEthernetDevicesDescriptionsList()
+{
+    ListPtr<StringPtr> devicesDescriptions = List<IString>();
+    devicesDescriptions.pushBack(deviceDescription);
+    return devicesDescriptions;
+}
+
+bool EthernetSharedMemoryImpl::setDevice(const StringPtr& deviceName)
+{
+    return deviceName.toStdString() == EthernetSharedMemoryImpl::deviceName && openSegment();
+}
+
+bool EthernetSharedMemoryImpl::sendPacket(const std::vector<uint8_t>& data)
+{
+    auto currentSegment = segment.load(std::memory_order_acquire);
+    if (!currentSegment || virtual_adapter::ethernetHeaderSize + data.size() > virtual_adapter::maxFrameSize)
+        return false;
+
+    currentSegment->publish(data.data(), data.size(), virtual_adapter::getTimestamp());
+    return true;
+}
+
+void EthernetSharedMemoryImpl::startCapture(PcppPacketReceivedCallbackType packetReceivedCb)
+{
+    stopCapture();
+    if (!openSegment())
+        return;
+
+    this->packetReceivedCb = std::move(packetReceivedCb);
+    packetsReceived = 0;
+    packetsDropped = 0;
+    capturing = true;
+    // Read here rather than on the capture thread, frames published after startCapture returns are delivered
+    const uint64_t readPos = segment.load()->header->writePos.load(std::memory_order_acquire);
+    captureThread = std::thread([this, readPos] { captureLoop(readPos); });
+}
+
+void EthernetSharedMemoryImpl::stopCapture()
+{
+    if (!capturing.exchange(false))
+        return;
+
+    // Wakes every reader of the segment, the others go back to sleep after finding nothing new
+    auto header = segment.load()->header;
+    header->wakeupCounter.fetch_add(1, std::memory_order_seq_cst);
+    futex(&header->wakeupCounter, FUTEX_WAKE, INT_MAX, nullptr);
+
+    if (captureThread.joinable())
+        captureThread.join();
+}
+
+bool EthernetSharedMemoryImpl::isDeviceCapturing() const
+{
+    return capturing;
+}
+
+CaptureStatistics EthernetSharedMemoryImpl::getCaptureStatistics() const
+{
+    CaptureStatistics statistics;
+    if (!capturing)
+        return statistics;
+
+    statistics.packetsReceived = packetsReceived.load(std::memory_order_relaxed);
+    statistics.packetsDropped = packetsDropped.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void EthernetSharedMemoryImpl::captureLoop(uint64_t readPos)
+{
+    const SharedMemorySegment& ring = *segment.load();
+    SegmentHeader& header = *ring.header;
+    const uint64_t ringCapacity = ring.mask + 1;
+
+    std::array<uint8_t, virtual_adapter::maxFrameSize> frame;
+    // Set while the slot at readPos is claimed but unpublished and later slots are claimed as well
+    bool stalled = false;
+    std::chrono::steady_clock::time_point stalledSince;
+
+    // Returns true if a frame was delivered or skipped, false if the ring has nothing new
+    auto readNext = [&]() -> bool
+    {
+        const SegmentSlot& slot = ring.slots[readPos & ring.mask];
+        const uint64_t expected = (readPos + 1) * 2;
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence < expected)
+        {
+            if (header.writePos.load(std::memory_order_acquire) <= readPos + 1)
+                return false;
+
+            // Frames published after this slot are held back by its writer, give up on it after a timeout
+            const auto now = std::chrono::steady_clock::now();
+            if (!stalled)
+            {
+                stalled = true;
+                stalledSince = now;
+            }
+            if (now - stalledSince < stalledSlotTimeout)
+                return false;
+
+            stalled = false;
+            ++readPos;
+            packetsDropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        stalled = false;
+
+        bool valid = sequence == expected;
+        uint32_t size = 0;
+        uint64_t timestamp = 0;
+        if (valid)
+        {
+            size = std::min<uint32_t>(slot.size, virtual_adapter::maxFrameSize);
+            timestamp = slot.timestamp;
+            std::memcpy(frame.data(), slot.data, size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            valid = slot.sequence.load(std::memory_order_relaxed) == expected;
+        }
+
+        if (!valid)
+        {
+            // Overtaken by the writers, continue with the oldest frame that is still intact
+            const uint64_t writePos = header.writePos.load(std::memory_order_acquire);
+            const uint64_t newReadPos = writePos > ringCapacity ? writePos - ringCapacity + 1 : readPos + 1;
+            packetsDropped.fetch_add(std::max(newReadPos, readPos + 1) - readPos, std::memory_order_relaxed);
+            readPos = std::max(newReadPos, readPos + 1);
+            return true;
+        }
+
+        ++readPos;
+        packetsReceived.fetch_add(1, std::memory_order_relaxed);
+        pcpp::RawPacket rawPacket(frame.data(), static_cast<int>(size), virtual_adapter::toTimespec(timestamp), false);
+        packetReceivedCb(&rawPacket, nullptr, nullptr);
+        return true;
+    };
+
+    while (capturing.load(std::memory_order_relaxed))
+    {
+        size_t processed = 0;
+        while (processed < batchSize && readNext())
+            ++processed;
+
+        if (processed != 0)
+            continue;
+
+        header.waiters.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t wakeupCounter = header.wakeupCounter.load(std::memory_order_seq_cst);
+        const SegmentSlot& slot = ring.slots[readPos & ring.mask];
+        if (capturing.load(std::memory_order_relaxed) && slot.sequence.load(std::memory_order_acquire) < (readPos + 1) * 2)
+        {
+            const auto waitTime = stalled ? std::chrono::nanoseconds(stalledSlotTimeout) : std::chrono::nanoseconds(100'000'000);
+            const timespec timeout{0, static_cast<long>(waitTime.count())};
+            futex(&header.wakeupCounter, FUTEX_WAIT, wakeupCounter, &timeout);
+        }
+        header.waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,420 @@
+#include <asam_cmp_common_lib/ethernet_udp_impl.h>
+#include <asam_cmp_common_lib/virtual_adapter_frame.h>
+#include <RawPacket.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    constexpr size_t maxDatagramSize = 65507;
+    // Kernel limit of segments per GSO message
+    constexpr size_t maxGsoSegments = 64;
+    // Largest segment that fits into a standard Ethernet MTU together with the IP and UDP headers
+    constexpr size_t maxGsoSegmentSize = 1472;
+    constexpr size_t sendBatchSize = 64;
+    constexpr size_t receiveBatchSize = 32;
+    constexpr size_t receiveBufferSize = 65536;
+
+    struct SendBatchStorage
+    {
+        std::array<mmsghdr, sendBatchSize> messages;
+        std::array<iovec, sendBatchSize * maxGsoSegments> iovecs;
+        std::array<std::array<uint8_t, CMSG_SPACE(sizeof(uint16_t))>, sendBatchSize> controls;
+        std::array<size_t, sendBatchSize> framesCount;
+    };
+
+    bool parseAddress(const std::string& address, in_addr& result)
+    {
+        return inet_pton(AF_INET, address.c_str(), &result) == 1;
+    }
+
+    bool isMulticast(const in_addr& address)
+    {
+        return IN_MULTICAST(ntohl(address.s_addr));
+    }
+}
+
+EthernetUdpImpl::EthernetUdpImpl(std::string address, uint16_t port)
+    : address(std::move(address))
+    , port(port)
+{
+    in_addr parsedAddress{};
+    if (!parseAddress(this->address, parsedAddress) || port == 0)
+        throw std::invalid_argument(fmt::format("Invalid UDP endpoint {}:{}", this->address, port));
+}
+
+EthernetUdpImpl::~EthernetUdpImpl()
+{
+    stopCapture();
+    if (sendSocket != -1)
+        close(sendSocket);
+}
+
+ListPtr<StringPtr> EthernetUdpImpl::getEthernetDevicesNamesList()
+{
+    ListPtr<StringPtr> devicesNames = List<IString>();
+    devicesNames.pushBack(deviceName);
+    return devicesNames;
+}
+
+ListPtr<StringPtr> EthernetUdpImpl::getEthernetDevicesDescriptionsList()
+{
+    ListPtr<StringPtr> devicesDescriptions = List<IString>();
+    devicesDescriptions.pushBack(deviceDescription);
+    return devicesDescriptions;
+}
+
+bool EthernetUdpImpl::setDevice(const StringPtr& deviceName)
+{
+    if (deviceName.toStdString() != EthernetUdpImpl::deviceName)
+        return false;
+
+    std::unique_lock lock(socketSync);
+    return openSendSocket();
+}
+
+bool EthernetUdpImpl::setUdpEndpoint(const std::string& address, uint16_t port)
+{
+    in_addr parsedAddress{};
+    if (!parseAddress(address, parsedAddress) || port == 0)
+        return false;
+
+    std::unique_lock lock(socketSync);
+    this->address = address;
+    this->port = port;
+    // The receiving side picks up the new endpoint on the next startCapture
+    return sendSocket == -1 || openSendSocket();
+}
+
+bool EthernetUdpImpl::openSendSocket()
+{
+    if (sendSocket != -1)
+    {
+        close(sendSocket);
+        sendSocket = -1;
+    }
+
+    sockaddr_in destination{};
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    if (!parseAddress(address, destination.sin_addr))
+        return false;
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+        return false;
+
+    if (isMulticast(destination.sin_addr))
+    {
+        const int loop = 1;
+        const int ttl = 16;
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    }
+
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&destination), sizeof(destination)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    sendSocket = fd;
+    return true;
+}
+
+bool EthernetUdpImpl::sendPacket(const std::vector<uint8_t>& data)
+{
+    std::shared_lock lock(socketSync);
+    if (sendSocket == -1 || data.size() > maxDatagramSize)
+        return false;
+
+    return send(sendSocket, data.data(), data.size(), 0) == static_cast<ssize_t>(data.size());
+}
+
+size_t EthernetUdpImpl::sendPackets(const std::vector<std::vector<uint8_t>>& frames)
+{
+    std::shared_lock lock(socketSync);
+    if (sendSocket == -1)
+        return 0;
+
+    size_t sent = 0;
+    while (sent < frames.size())
+    {
+        const size_t batchSent = sendBatch(frames, sent);
+        if (batchSent == 0)
+            break;
+        sent += batchSent;
+    }
+
+    return sent;
+}
+
+size_t EthernetUdpImpl::sendBatch(const std::vector<std::vector<uint8_t>>& frames, size_t first)
+{
+    thread_local SendBatchStorage storage;
+    const bool useGso = gsoEnabled.load(std::memory_order_relaxed);
+
+    size_t messagesCount = 0;
+    size_t iovecsCount = 0;
+    bool gsoUsed = false;
+    for (size_t index = first; index < frames.size() && messagesCount < sendBatchSize;)
+    {
+        const size_t segmentSize = frames[index].size();
+        if (segmentSize > maxDatagramSize)
+            break;
+
+        // A GSO message is a run of equally sized segments, only the last one may be shorter
+        size_t runLength = 1;
+        size_t runSize = segmentSize;
+        if (useGso && segmentSize != 0 && segmentSize <= maxGsoSegmentSize)
+        {
+            while (index + runLength < frames.size() && runLength < maxGsoSegments)
+            {
+                const size_t nextSize = frames[index + runLength].size();
+                if (nextSize == 0 || nextSize > segmentSize || runSize + nextSize > maxDatagramSize)
+                    break;
+                ++runLength;
+                runSize += nextSize;
+                if (nextSize < segmentSize)
+                    break;
+            }
+        }
+
+        mmsghdr& message = storage.messages[messagesCount];
+        message = {};
+        message.msg_hdr.msg_iov = &storage.iovecs[iovecsCount];
+        message.msg_hdr.msg_iovlen = runLength;
+        for (size_t i = 0; i < runLength; ++i)
+        {
+            auto& frame = frames[index + i];
+            storage.iovecs[iovecsCount + i] = {const_cast<uint8_t*>(frame.data()), frame.size()};
+        }
+
+        if (runLength > 1)
+        {
+            auto& control = storage.controls[messagesCount];
+            message.msg_hdr.msg_control = control.data();
+            message.msg_hdr.msg_controllen = control.size();
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&message.msg_hdr);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            const auto gsoSize = static_cast<uint16_t>(segmentSize);
+            std::memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+            gsoUsed = true;
+        }
+
+        storage.framesCount[messagesCount] = runLength;
+        iovecsCount += runLength;
+        index += runLength;
+        ++messagesCount;
+    }
+
+    if (messagesCount == 0)
+        return 0;
+
+    const int result = sendmmsg(sendSocket, storage.messages.data(), static_cast<unsigned int>(messagesCount), 0);
+    if (result <= 0)
+    {
+        // Kernels or routes without UDP GSO support reject the segmentation request
+        if (gsoUsed && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT))
+        {
+            gsoEnabled = false;
+            return sendBatch(frames, first);
+        }
+        return 0;
+    }
+
+    size_t sentFrames = 0;
+    for (int i = 0; i < result; ++i)
+        sentFrames += storage.framesCount[i];
+    return sentFrames;
+}
+
+int EthernetUdpImpl::openReceiveSocket() const
+{
+    std::shared_lock lock(socketSync);
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    in_addr group{};
+    if (!parseAddress(address, group))
+        return -1;
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+        return -1;
+
+    const int enable = 1;
+    const int receiveBuffer = 4 * 1024 * 1024;
+    const timeval timeout{0, 100'000};
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    // Optional, without GRO every datagram arrives on its own
+    setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable));
+
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    if (isMulticast(group))
+    {
+        ip_mreq membership{};
+        membership.imr_multiaddr = group;
+        membership.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+    }
+
+    return fd;
+}
+
+void EthernetUdpImpl::startCapture(PcppPacketReceivedCallbackType packetReceivedCb)
+{
+    stopCapture();
+
+    receiveSocket = openReceiveSocket();
+    if (receiveSocket == -1)
+        return;
+
+    this->packetReceivedCb = std::move(packetReceivedCb);
+    packetsReceived = 0;
+    packetsDropped = 0;
+    capturing = true;
+    captureThread = std::thread([this] { captureLoop(); });
+}
+
+void EthernetUdpImpl::stopCapture()
+{
+    if (!capturing.exchange(false))
+        return;
+
+    if (captureThread.joinable())
+        captureThread.join();
+
+    close(receiveSocket);
+    receiveSocket = -1;
+}
+
+bool EthernetUdpImpl::isDeviceCapturing() const
+{
+    return capturing;
+}
+
+CaptureStatistics EthernetUdpImpl::getCaptureStatistics() const
+{
+    CaptureStatistics statistics;
+    if (!capturing)
+        return statistics;
+
+    statistics.packetsReceived = packetsReceived.load(std::memory_order_relaxed);
+    statistics.packetsDropped = packetsDropped.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void EthernetUdpImpl::captureLoop()
+{
+    // Every datagram is received behind room for the Ethernet header. Coalesced GRO segments are delivered
+    // in order, so the header of a segment is written over the tail of the already delivered previous one.
+    constexpr size_t headerSize = virtual_adapter::ethernetHeaderSize;
+    constexpr size_t slotSize = headerSize + receiveBufferSize;
+    constexpr size_t controlSize = CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(timespec));
+
+    std::vector<uint8_t> buffers(receiveBatchSize * slotSize);
+    std::vector<uint8_t> controls(receiveBatchSize * controlSize);
+    std::array<mmsghdr, receiveBatchSize> messages{};
+    std::array<iovec, receiveBatchSize> iovecs{};
+
+    while (capturing.load(std::memory_order_relaxed))
+    {
+        for (size_t i = 0; i < receiveBatchSize; ++i)
+        {
+            iovecs[i] = {buffers.data() + i * slotSize + headerSize, receiveBufferSize};
+            messages[i] = {};
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_control = controls.data() + i * controlSize;
+            messages[i].msg_hdr.msg_controllen = controlSize;
+        }
+
+        const int received = recvmmsg(receiveSocket, messages.data(), receiveBatchSize, MSG_WAITFORONE, nullptr);
+        if (received <= 0)
+            continue;
+
+        for (int i = 0; i < received; ++i)
+        {
+            const size_t length = messages[i].msg_len;
+            size_t segmentSize = length;
+            uint64_t timestamp = 0;
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr); cmsg; cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+                {
+                    int gsoSize;
+                    std::memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+                    if (gsoSize > 0)
+                        segmentSize = static_cast<size_t>(gsoSize);
+                }
+                else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+                {
+                    uint32_t dropped;
+                    std::memcpy(&dropped, CMSG_DATA(cmsg), sizeof(dropped));
+                    packetsDropped.store(dropped, std::memory_order_relaxed);
+                }
+                else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+                {
+                    timespec kernelTime;
+                    std::memcpy(&kernelTime, CMSG_DATA(cmsg), sizeof(kernelTime));
+                    timestamp = static_cast<uint64_t>(kernelTime.tv_sec) * 1'000'000'000 + kernelTime.tv_nsec;
+                }
+            }
+            if (timestamp == 0)
+                timestamp = virtual_adapter::getTimestamp();
+
+            uint8_t* datagram = buffers.data() + i * slotSize;
+            for (size_t offset = 0; offset < length && segmentSize != 0; offset += segmentSize)
+            {
+                const size_t size = std::min(segmentSize, length - offset);
+                uint8_t* frame = datagram + offset;
+                std::memcpy(frame, virtual_adapter::ethernetHeader.data(), headerSize);
+
+                packetsReceived.fetch_add(1, std::memory_order_relaxed);
+                pcpp::RawPacket rawPacket(frame, static_cast<int>(headerSize + size), virtual_adapter::toTimespec(timestamp), false);
+                packetReceivedCb(&rawPacket, nullptr, nullptr);
+            }
+        }
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
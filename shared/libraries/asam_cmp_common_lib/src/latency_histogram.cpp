@@ -0,0 +1,100 @@
+#include <asam_cmp_common_lib/latency_histogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    size_t getMostSignificantBit(uint64_t value) noexcept
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+}
+
+void LatencyHistogram::record(uint64_t valueNs) noexcept
+{
+    buckets[getBucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t currentMax = max.load(std::memory_order_relaxed);
+    while (valueNs > currentMax && !max.compare_exchange_weak(currentMax, valueNs, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration duration) noexcept
+{
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+}
+
+uint64_t LatencyHistogram::getCount() const noexcept
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax() const noexcept
+{
+    return max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const noexcept
+{
+    const auto total = getCount();
+    if (total == 0)
+        return 0;
+
+    const auto clamped = std::min(std::max(percentile, 0.0), 100.0);
+    const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * total)));
+
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < bucketCount; ++i)
+    {
+        accumulated += buckets[i].load(std::memory_order_relaxed);
+        if (accumulated >= target)
+            return std::min(getBucketHighestValue(i), getMax());
+    }
+
+    return getMax();
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    for (auto& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value) noexcept
+{
+    if (value < subBucketCount)
+        return static_cast<size_t>(value);
+
+    const size_t shift = getMostSignificantBit(value) - subBucketBits;
+    return (shift + 1) * subBucketCount + static_cast<size_t>(value >> shift) - subBucketCount;
+}
+
+uint64_t LatencyHistogram::getBucketHighestValue(size_t index) noexcept
+{
+    if (index < subBucketCount)
+        return index;
+
+    const size_t shift = index / subBucketCount - 1;
+    const uint64_t mantissa = index % subBucketCount + subBucketCount;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,82 @@
+#include <asam_cmp_common_lib/loopback_ring.h>
+
+#include <cstring>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+LoopbackRing::LoopbackRing(size_t capacity)
+    : capacity(roundUpToPowerOfTwo(capacity))
+    , mask(this->capacity - 1)
+    , slots(std::make_unique<Slot[]>(this->capacity))
+{
+    if (capacity == 0)
+        throw std::invalid_argument("Loopback ring capacity must be greater than zero");
+
+    for (size_t i = 0; i < this->capacity; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+size_t LoopbackRing::roundUpToPowerOfTwo(size_t value) noexcept
+{
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+size_t LoopbackRing::getCapacity() const noexcept
+{
+    return capacity;
+}
+
+bool LoopbackRing::tryPush(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept
+{
+    if (headerSize + payloadSize > maxFrameSize)
+        return false;
+
+    Slot* slot;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        slot = &slots[pos & mask];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::memcpy(slot->data.data(), header, headerSize);
+    std::memcpy(slot->data.data() + headerSize, payload, payloadSize);
+    slot->size = static_cast<uint32_t>(headerSize + payloadSize);
+    slot->timestamp = timestamp;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+const LoopbackRing::Slot* LoopbackRing::front() const noexcept
+{
+    const Slot* slot = &slots[dequeuePos & mask];
+    if (slot->sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+        return nullptr;
+    return slot;
+}
+
+void LoopbackRing::pop() noexcept
+{
+    slots[dequeuePos & mask].sequence.store(dequeuePos + capacity, std::memory_order_release);
+    ++dequeuePos;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,95 @@
+#include <asam_cmp_common_lib/mapped_file.h>
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+MappedFile::MappedFile(const std::string& fileName, bool sequentialAccess)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              sequentialAccess ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Can't open file " + fileName);
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("File " + fileName + " is empty");
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Can't map file " + fileName);
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        throw std::runtime_error("Can't open file " + fileName);
+
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fd);
+        throw std::runtime_error("File " + fileName + " is empty");
+    }
+
+    void* address = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+        throw std::runtime_error("Can't map file " + fileName);
+
+    if (sequentialAccess)
+        madvise(address, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+    data = static_cast<const uint8_t*>(address);
+    size = static_cast<size_t>(fileStat.st_size);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+#endif
+}
+
+const uint8_t* MappedFile::getData() const noexcept
+{
+    return data;
+}
+
+size_t MappedFile::getSize() const noexcept
+{
+    return size;
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -1,5 +1,11 @@
+#include <coreobjects/callable_info_factory.h>
+#include <coreobjects/unit_factory.h>
+
 #include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/ethernet_udp_impl.h>
 #include <asam_cmp_common_lib/network_manager_fb.h>
+#include <asam_cmp_common_lib/pcapng_recorder.h>
+#include <asam_cmp_common_lib/trace.h>
 
 BEGIN_NAMESPACE_ASAM_CMP_COMMON
 
@@ -17,11 +23,17 @@ NetworkManagerFb::NetworkManagerFb(const FunctionBlockTypePtr& type,
 
 NetworkManagerFb::~NetworkManagerFb()
 {
+    stopRecording();
 }
 
 void NetworkManagerFb::initProperties()
 {
     addNetworkAdaptersProperty();
+    addUdpEndpointProperties();
+    addRecordingProperties();
+#ifdef ASAM_CMP_ENABLE_TRACING
+    addTracingProperties();
+#endif
 }
 
 void NetworkManagerFb::addNetworkAdaptersProperty()
@@ -29,26 +41,178 @@ void NetworkManagerFb::addNetworkAdaptersProperty()
     ListPtr<StringPtr> devicesNames = ethernetWrapper->getEthernetDevicesNamesList();
     ListPtr<StringPtr> devicesDescriptions = ethernetWrapper->getEthernetDevicesDescriptionsList();
 
+    SizeT selectedIndex = 0;
     for (SizeT i = 0; i < devicesNames.getCount(); ++i)
     {
         if (ethernetWrapper->setDevice(devicesNames[i]))
         {
             selectedEthernetDeviceName = devicesNames[i];
+            selectedIndex = i;
             break;
         }
     }
 
     StringPtr propName = "NetworkAdaptersNames";
-    auto prop = SelectionPropertyBuilder(propName, devicesNames, 0).setVisible(false).build();
+    auto prop = SelectionPropertyBuilder(propName, devicesNames, selectedIndex).setVisible(false).build();
     objPtr.addProperty(prop);
 
     propName = "NetworkAdapters";
-    prop = SelectionPropertyBuilder(propName, devicesDescriptions, 0).build();
+    prop = SelectionPropertyBuilder(propName, devicesDescriptions, selectedIndex).build();
     objPtr.addProperty(prop);
     objPtr.getOnPropertyValueWrite(propName) +=
         [this, propName](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { networkAdapterChangedInternal(); };
 }
 
+void NetworkManagerFb::addUdpEndpointProperties()
+{
+    if (!ethernetWrapper->setUdpEndpoint(EthernetUdpImpl::defaultAddress, EthernetUdpImpl::defaultPort))
+        return;
+
+    udpAddress = EthernetUdpImpl::defaultAddress;
+    udpPort = EthernetUdpImpl::defaultPort;
+
+    StringPtr propName = "UdpAddress";
+    auto prop = StringPropertyBuilder(propName, udpAddress).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { udpEndpointChangedInternal(); };
+
+    propName = "UdpPort";
+    prop = IntPropertyBuilder(propName, static_cast<Int>(udpPort)).setMinValue(1).setMaxValue(65535).build();
+    objPtr.addProperty(prop);
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { udpEndpointChangedInternal(); };
+}
+
+void NetworkManagerFb::udpEndpointChangedInternal()
+{
+    std::string newAddress = objPtr.getPropertyValue("UdpAddress").asPtr<IString>().toStdString();
+    Int newPort = objPtr.getPropertyValue("UdpPort");
+
+    if (newAddress == udpAddress && newPort == udpPort)
+        return;
+
+    if (newPort < 1 || newPort > 65535 || !ethernetWrapper->setUdpEndpoint(newAddress, static_cast<uint16_t>(newPort)))
+    {
+        objPtr.setPropertyValue("UdpAddress", String(udpAddress));
+        objPtr.setPropertyValue("UdpPort", static_cast<Int>(udpPort));
+        return;
+    }
+
+    udpAddress = newAddress;
+    udpPort = static_cast<uint16_t>(newPort);
+
+    if (selectedEthernetDeviceName.assigned() && selectedEthernetDeviceName.toStdString() == EthernetUdpImpl::deviceName)
+        networkAdapterChangedInternal();
+}
+
+void NetworkManagerFb::addRecordingProperties()
+{
+    if (!ethernetWrapper->setRecorder(nullptr))
+        return;
+
+    StringPtr propName = "Recording";
+    objPtr.addProperty(BoolPropertyBuilder(propName, false).build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { recordingChangedInternal(); };
+
+    propName = "RecordingFilePrefix";
+    objPtr.addProperty(StringPropertyBuilder(propName, "asam_cmp").build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { recordingChangedInternal(); };
+
+    propName = "RecordingMaxFileSize";
+    objPtr.addProperty(IntPropertyBuilder(propName, 1024).setMinValue(0).setMaxValue(1024 * 1024).setUnit(Unit("MB")).build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { recordingChangedInternal(); };
+
+    propName = "RecordingMaxFileDuration";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setMinValue(0).setMaxValue(7 * 24 * 3600).setUnit(Unit("s")).build());
+    objPtr.getOnPropertyValueWrite(propName) +=
+        [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args) { recordingChangedInternal(); };
+
+    propName = "RecordedFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        auto current = std::atomic_load(&recorder);
+        args.setValue(current ? static_cast<Int>(current->getRecordedFrames()) : 0);
+    };
+
+    propName = "RecordingDroppedFrames";
+    objPtr.addProperty(IntPropertyBuilder(propName, 0).setReadOnly(true).build());
+    objPtr.getOnPropertyValueRead(propName) += [this](PropertyObjectPtr& obj, PropertyValueEventArgsPtr& args)
+    {
+        auto current = std::atomic_load(&recorder);
+        args.setValue(current ? static_cast<Int>(current->getDroppedFrames()) : 0);
+    };
+}
+
+void NetworkManagerFb::recordingChangedInternal()
+{
+    // Any change of the settings starts a new set of files
+    stopRecording();
+    if (!static_cast<bool>(objPtr.getPropertyValue("Recording")))
+        return;
+
+    PcapNgRecorder::Config config;
+    config.filePrefix = objPtr.getPropertyValue("RecordingFilePrefix").asPtr<IString>().toStdString();
+    config.maxFileSize = static_cast<uint64_t>(static_cast<Int>(objPtr.getPropertyValue("RecordingMaxFileSize"))) * 1024 * 1024;
+    config.maxFileDuration = std::chrono::seconds(static_cast<Int>(objPtr.getPropertyValue("RecordingMaxFileDuration")));
+
+    try
+    {
+        std::atomic_store(&recorder, std::make_shared<PcapNgRecorder>(std::move(config)));
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Recording can't be started: {}", e.what());
+        objPtr.setPropertyValue("Recording", false);
+        return;
+    }
+
+    ethernetWrapper->setRecorder(recorder);
+}
+
+void NetworkManagerFb::stopRecording()
+{
+    if (!recorder)
+        return;
+
+    ethernetWrapper->setRecorder(nullptr);
+    recorder->stop();
+}
+
+#ifdef ASAM_CMP_ENABLE_TRACING
+void NetworkManagerFb::addTracingProperties()
+{
+    StringPtr propName = "TraceFile";
+    objPtr.addProperty(StringPropertyBuilder(propName, "asam_cmp_trace.json").build());
+
+    propName = "DumpTrace";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([this] { dumpTrace(); }));
+
+    propName = "ClearTrace";
+    objPtr.addProperty(FunctionPropertyBuilder(propName, ProcedureInfo()).setReadOnly(true).build());
+    objPtr.asPtr<IPropertyObjectProtected>().setProtectedPropertyValue(propName, Procedure([] { trace::clear(); }));
+}
+
+void NetworkManagerFb::dumpTrace()
+{
+    const std::string fileName = objPtr.getPropertyValue("TraceFile").asPtr<IString>().toStdString();
+    try
+    {
+        trace::dumpChromeTrace(fileName);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_W("Trace can't be dumped: {}", e.what());
+        throw;
+    }
+}
+#endif
+
 void NetworkManagerFb::networkAdapterChangedInternal()
 {
     int oldInd = objPtr.getPropertyValue("NetworkAdaptersNames");
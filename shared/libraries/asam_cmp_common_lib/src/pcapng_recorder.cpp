@@ -0,0 +1,345 @@
+#include <asam_cmp_common_lib/pcap_index_format.h>
+#include <asam_cmp_common_lib/pcapng_recorder.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace
+{
+    constexpr uint32_t sectionHeaderBlock = 0x0A0D0D0A;
+    constexpr uint32_t interfaceDescriptionBlock = 0x00000001;
+    constexpr uint32_t enhancedPacketBlock = 0x00000006;
+    constexpr uint32_t byteOrderMagic = 0x1A2B3C4D;
+    constexpr uint16_t linkTypeEthernet = 1;
+    constexpr uint16_t timestampResolutionOption = 9;
+    constexpr uint8_t nanosecondResolution = 9;
+
+    constexpr size_t enhancedPacketHeaderSize = 28;
+    constexpr auto flushInterval = std::chrono::milliseconds(500);
+
+    constexpr size_t padded(size_t size)
+    {
+        return (size + 3) & ~size_t{3};
+    }
+
+    constexpr size_t enhancedPacketBlockSize(size_t frameSize)
+    {
+        return enhancedPacketHeaderSize + padded(frameSize) + 4;
+    }
+
+    template <typename T>
+    uint8_t* put(uint8_t* out, T value)
+    {
+        std::memcpy(out, &value, sizeof(value));
+        return out + sizeof(value);
+    }
+
+    template <typename T>
+    T get(const uint8_t* in)
+    {
+        T value;
+        std::memcpy(&value, in, sizeof(value));
+        return value;
+    }
+
+    // Section header and an Ethernet interface with nanosecond timestamps, in host byte order
+    std::vector<uint8_t> makeFileHeader()
+    {
+        std::vector<uint8_t> header(28 + 32);
+        uint8_t* out = header.data();
+
+        out = put<uint32_t>(out, sectionHeaderBlock);
+        out = put<uint32_t>(out, 28);
+        out = put<uint32_t>(out, byteOrderMagic);
+        out = put<uint16_t>(out, 1);
+        out = put<uint16_t>(out, 0);
+        out = put<int64_t>(out, -1);
+        out = put<uint32_t>(out, 28);
+
+        out = put<uint32_t>(out, interfaceDescriptionBlock);
+        out = put<uint32_t>(out, 32);
+        out = put<uint16_t>(out, linkTypeEthernet);
+        out = put<uint16_t>(out, 0);
+        out = put<uint32_t>(out, 0);
+        out = put<uint16_t>(out, timestampResolutionOption);
+        out = put<uint16_t>(out, 1);
+        out = put<uint32_t>(out, nanosecondResolution);
+        out = put<uint32_t>(out, 0);
+        put<uint32_t>(out, 32);
+
+        return header;
+    }
+}
+
+PcapNgRecorder::PcapNgRecorder(Config config)
+    : config(std::move(config))
+{
+    if (this->config.bufferSize < enhancedPacketBlockSize(0))
+        throw std::invalid_argument("Recording buffer is too small");
+
+    const std::time_t now = std::time(nullptr);
+    std::ostringstream name;
+    name << std::put_time(std::gmtime(&now), "%Y%m%dT%H%M%S");
+    sessionName = name.str();
+
+    for (auto& buffer : buffers)
+        buffer.data = std::make_unique<uint8_t[]>(this->config.bufferSize);
+
+    if (!openFile())
+        throw std::runtime_error("Can't create recording file " + fileNames.back());
+
+    writerThread = std::thread(&PcapNgRecorder::writerLoop, this);
+}
+
+PcapNgRecorder::~PcapNgRecorder()
+{
+    stop();
+}
+
+void PcapNgRecorder::record(const uint8_t* data, size_t size, uint64_t timestamp) noexcept
+{
+    record(nullptr, 0, data, size, timestamp);
+}
+
+void PcapNgRecorder::record(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept
+{
+    const size_t size = headerSize + payloadSize;
+    const size_t blockSize = enhancedPacketBlockSize(size);
+    if (blockSize > config.bufferSize)
+    {
+        droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::scoped_lock lock{bufferSync};
+    if (stopRequested)
+        return;
+
+    Buffer* buffer = &buffers[activeBuffer];
+    if (buffer->used + blockSize > config.bufferSize)
+    {
+        if (pendingBuffer)
+        {
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        activeBuffer ^= 1;
+        pendingBuffer = true;
+        bufferCv.notify_one();
+        buffer = &buffers[activeBuffer];
+    }
+
+    uint8_t* out = buffer->data.get() + buffer->used;
+    out = put<uint32_t>(out, enhancedPacketBlock);
+    out = put<uint32_t>(out, static_cast<uint32_t>(blockSize));
+    out = put<uint32_t>(out, 0);
+    out = put<uint32_t>(out, static_cast<uint32_t>(timestamp >> 32));
+    out = put<uint32_t>(out, static_cast<uint32_t>(timestamp));
+    out = put<uint32_t>(out, static_cast<uint32_t>(size));
+    out = put<uint32_t>(out, static_cast<uint32_t>(size));
+    if (headerSize != 0)
+        std::memcpy(out, header, headerSize);
+    std::memcpy(out + headerSize, payload, payloadSize);
+    out += size;
+    std::memset(out, 0, padded(size) - size);
+    out += padded(size) - size;
+    put<uint32_t>(out, static_cast<uint32_t>(blockSize));
+
+    buffer->used += blockSize;
+    recordedFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PcapNgRecorder::stop()
+{
+    {
+        std::scoped_lock lock{bufferSync};
+        stopRequested = true;
+    }
+    bufferCv.notify_one();
+
+    if (writerThread.joinable())
+        writerThread.join();
+
+    closeFile();
+}
+
+uint64_t PcapNgRecorder::getRecordedFrames() const noexcept
+{
+    return recordedFrames.load(std::memory_order_relaxed);
+}
+
+uint64_t PcapNgRecorder::getDroppedFrames() const noexcept
+{
+    return droppedFrames.load(std::memory_order_relaxed);
+}
+
+std::vector<std::string> PcapNgRecorder::getFileNames() const
+{
+    std::scoped_lock lock{fileNamesSync};
+    return fileNames;
+}
+
+void PcapNgRecorder::writerLoop()
+{
+    std::unique_lock lock{bufferSync};
+    while (true)
+    {
+        bufferCv.wait_for(lock, flushInterval, [this] { return pendingBuffer || stopRequested; });
+
+        // Partially filled buffers are written periodically and on stop so that the files stay up to date
+        if (!pendingBuffer && buffers[activeBuffer].used != 0)
+        {
+            activeBuffer ^= 1;
+            pendingBuffer = true;
+        }
+
+        if (pendingBuffer)
+        {
+            Buffer& buffer = buffers[activeBuffer ^ 1];
+            lock.unlock();
+            writeBuffer(buffer);
+            buffer.used = 0;
+            lock.lock();
+            pendingBuffer = false;
+            continue;
+        }
+
+        if (stopRequested)
+            break;
+    }
+}
+
+void PcapNgRecorder::writeBuffer(const Buffer& buffer)
+{
+    const uint8_t* data = buffer.data.get();
+    const uint64_t maxDuration = static_cast<uint64_t>(std::chrono::nanoseconds(config.maxFileDuration).count());
+
+    size_t runStart = 0;
+    uint64_t runFrames = 0;
+    for (size_t position = 0; position < buffer.used;)
+    {
+        const uint32_t blockSize = get<uint32_t>(data + position + 4);
+        const uint64_t timestamp = (static_cast<uint64_t>(get<uint32_t>(data + position + 12)) << 32) | get<uint32_t>(data + position + 16);
+
+        // A file always receives at least one frame, so an oversized frame can't cause endless rotation
+        const bool sizeExceeded = config.maxFileSize != 0 && fileSize + blockSize > config.maxFileSize;
+        const bool durationExceeded = maxDuration != 0 && timestamp >= fileStartTimestamp + maxDuration;
+        if (fileFrames != 0 && (sizeExceeded || durationExceeded))
+        {
+            writeRun(data + runStart, position - runStart, runFrames);
+            closeFile();
+            openFile();
+            runStart = position;
+            runFrames = 0;
+        }
+
+        if (fileFrames == 0)
+            fileStartTimestamp = timestamp;
+        if (indexFile)
+            addIndexEntry(data + position, timestamp);
+        fileSize += blockSize;
+        ++fileFrames;
+        ++runFrames;
+        position += blockSize;
+    }
+
+    writeRun(data + runStart, buffer.used - runStart, runFrames);
+}
+
+void PcapNgRecorder::writeRun(const uint8_t* data, size_t size, uint64_t frames)
+{
+    if (size == 0)
+        return;
+
+    const size_t written = file ? std::fwrite(data, 1, size, file) : 0;
+    if (written != size)
+    {
+        // The index must not point past the frames that are in the file
+        fileSize -= size - written;
+        runIndexEntries.clear();
+        recordedFrames.fetch_sub(frames, std::memory_order_relaxed);
+        droppedFrames.fetch_add(frames, std::memory_order_relaxed);
+        return;
+    }
+
+    if (indexFile && !runIndexEntries.empty())
+        std::fwrite(runIndexEntries.data(), sizeof(pcap_index::Entry), runIndexEntries.size(), indexFile);
+    runIndexEntries.clear();
+}
+
+void PcapNgRecorder::addIndexEntry(const uint8_t* block, uint64_t timestamp)
+{
+    pcap_index::Entry entry{};
+    pcap_index::parseEndpoint(block + enhancedPacketHeaderSize, get<uint32_t>(block + 20), entry);
+
+    indexTimestamp = std::max(indexTimestamp, timestamp);
+    entry.timestamp = indexTimestamp;
+    entry.offset = fileSize;
+    runIndexEntries.push_back(entry);
+}
+
+bool PcapNgRecorder::openFile()
+{
+    std::ostringstream name;
+    name << config.filePrefix << '_' << sessionName << '_' << std::setw(4) << std::setfill('0') << fileIndex++ << ".pcapng";
+    {
+        std::scoped_lock lock{fileNamesSync};
+        fileNames.push_back(name.str());
+    }
+
+    fileFrames = 0;
+    fileSize = 0;
+    file = std::fopen(name.str().c_str(), "wb");
+    if (!file)
+        return false;
+
+    // Frames are written in large blocks, stdio buffering would only add a copy
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    const auto header = makeFileHeader();
+    if (std::fwrite(header.data(), 1, header.size(), file) != header.size())
+    {
+        closeFile();
+        return false;
+    }
+
+    fileSize = header.size();
+
+    // A missing index only slows down seeking, so failing to create it doesn't stop the recording
+    indexTimestamp = 0;
+    if (config.writeIndex)
+    {
+        indexFile = std::fopen((name.str() + pcap_index::fileExtension).c_str(), "wb");
+        if (indexFile && std::fwrite(pcap_index::magic.data(), 1, pcap_index::magic.size(), indexFile) != pcap_index::magic.size())
+        {
+            std::fclose(indexFile);
+            indexFile = nullptr;
+        }
+    }
+
+    return true;
+}
+
+void PcapNgRecorder::closeFile()
+{
+    if (file)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    if (indexFile)
+    {
+        std::fclose(indexFile);
+        indexFile = nullptr;
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,240 @@
+#include <asam_cmp_common_lib/trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+BEGIN_NAMESPACE_ASAM_CMP_COMMON
+
+namespace trace
+{
+    namespace
+    {
+        // Single producer ring owned by one thread at a time. The collector reads it without locking and
+        // uses writePos as a sequence counter to drop slots that were overwritten while they were copied.
+        class ThreadBuffer final
+        {
+        public:
+            ThreadBuffer()
+                : slots(std::make_unique<Slot[]>(eventsPerThread))
+            {
+            }
+
+            void push(const char* name, uint64_t start, uint64_t duration) noexcept
+            {
+                const uint64_t pos = head.load(std::memory_order_relaxed);
+                writePos.store(pos + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                Slot& slot = slots[pos & mask];
+                slot.name.store(name, std::memory_order_relaxed);
+                slot.start.store(start, std::memory_order_relaxed);
+                slot.duration.store(duration, std::memory_order_relaxed);
+                slot.threadId.store(threadId, std::memory_order_relaxed);
+
+                head.store(pos + 1, std::memory_order_release);
+            }
+
+            void collect(std::vector<Event>& events) const
+            {
+                const uint64_t end = head.load(std::memory_order_acquire);
+                uint64_t begin = std::max(tail.load(std::memory_order_relaxed), end > eventsPerThread ? end - eventsPerThread : 0);
+
+                const size_t first = events.size();
+                for (uint64_t pos = begin; pos < end; ++pos)
+                {
+                    const Slot& slot = slots[pos & mask];
+                    events.push_back({slot.name.load(std::memory_order_relaxed),
+                                      slot.start.load(std::memory_order_relaxed),
+                                      slot.duration.load(std::memory_order_relaxed),
+                                      slot.threadId.load(std::memory_order_relaxed)});
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const uint64_t written = writePos.load(std::memory_order_relaxed);
+                if (written > begin + eventsPerThread)
+                {
+                    const uint64_t overwritten = std::min(written - eventsPerThread - begin, end - begin);
+                    events.erase(events.begin() + first, events.begin() + first + static_cast<ptrdiff_t>(overwritten));
+                }
+            }
+
+            void clear() noexcept
+            {
+                tail.store(head.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+
+            bool tryClaim(uint32_t newThreadId) noexcept
+            {
+                bool expected = false;
+                if (!owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return false;
+                threadId = newThreadId;
+                return true;
+            }
+
+            void release() noexcept
+            {
+                owned.store(false, std::memory_order_release);
+            }
+
+        private:
+            struct Slot
+            {
+                std::atomic<const char*> name{nullptr};
+                std::atomic<uint64_t> start{0};
+                std::atomic<uint64_t> duration{0};
+                std::atomic<uint32_t> threadId{0};
+            };
+
+            static constexpr uint64_t mask = eventsPerThread - 1;
+            static_assert((eventsPerThread & mask) == 0, "eventsPerThread must be a power of two");
+
+            std::unique_ptr<Slot[]> slots;
+            alignas(64) std::atomic<uint64_t> head{0};
+            std::atomic<uint64_t> writePos{0};
+            uint32_t threadId{0};
+            alignas(64) std::atomic<uint64_t> tail{0};
+            std::atomic<bool> owned{false};
+        };
+
+        // Buffers of finished threads are kept, so that their events can still be dumped, and are reused by new threads
+        class Registry final
+        {
+        public:
+            std::shared_ptr<ThreadBuffer> acquire()
+            {
+                std::scoped_lock lock{mutex};
+                const uint32_t threadId = ++lastThreadId;
+                for (const auto& buffer : buffers)
+                {
+                    if (buffer->tryClaim(threadId))
+                        return buffer;
+                }
+
+                auto buffer = std::make_shared<ThreadBuffer>();
+                buffer->tryClaim(threadId);
+                buffers.push_back(buffer);
+                return buffer;
+            }
+
+            std::vector<std::shared_ptr<ThreadBuffer>> getBuffers()
+            {
+                std::scoped_lock lock{mutex};
+                return buffers;
+            }
+
+        private:
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            uint32_t lastThreadId{0};
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        class ThreadBufferHolder final
+        {
+        public:
+            ThreadBufferHolder()
+                : buffer(getRegistry().acquire())
+            {
+            }
+
+            ~ThreadBufferHolder()
+            {
+                buffer->release();
+            }
+
+            ThreadBuffer& get() noexcept
+            {
+                return *buffer;
+            }
+
+        private:
+            std::shared_ptr<ThreadBuffer> buffer;
+        };
+
+        void writeMicroseconds(std::ostream& stream, uint64_t ns)
+        {
+            const uint64_t fraction = ns % 1000;
+            stream << ns / 1000 << '.' << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + fraction / 10 % 10)
+                   << static_cast<char>('0' + fraction % 10);
+        }
+
+        void writeEscaped(std::ostream& stream, const char* text)
+        {
+            for (; *text != '\0'; ++text)
+            {
+                if (*text == '"' || *text == '\\')
+                    stream << '\\';
+                stream << *text;
+            }
+        }
+    }
+
+    uint64_t now() noexcept
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void record(const char* name, uint64_t start, uint64_t end) noexcept
+    {
+        thread_local ThreadBufferHolder holder;
+        holder.get().push(name, start, end - start);
+    }
+
+    std::vector<Event> collect()
+    {
+        std::vector<Event> events;
+        for (const auto& buffer : getRegistry().getBuffers())
+            buffer->collect(events);
+
+        std::stable_sort(events.begin(), events.end(), [](const Event& lhs, const Event& rhs) { return lhs.start < rhs.start; });
+        return events;
+    }
+
+    void clear()
+    {
+        for (const auto& buffer : getRegistry().getBuffers())
+            buffer->clear();
+    }
+
+    void writeChromeTrace(std::ostream& stream, const std::vector<Event>& events)
+    {
+        stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const Event& event = events[i];
+            stream << (i == 0 ? "\n" : ",\n") << "{\"name\":\"";
+            writeEscaped(stream, event.name);
+            stream << "\",\"cat\":\"asam_cmp\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":";
+            writeMicroseconds(stream, event.start);
+            stream << ",\"dur\":";
+            writeMicroseconds(stream, event.duration);
+            stream << '}';
+        }
+        stream << "\n]}\n";
+    }
+
+    void dumpChromeTrace(const std::string& fileName)
+    {
+        std::ofstream file(fileName, std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Can't open trace file " + fileName);
+
+        writeChromeTrace(file, collect());
+        if (!file.flush())
+            throw std::runtime_error("Can't write trace file " + fileName);
+    }
+}
+
+END_NAMESPACE_ASAM_CMP_COMMON
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/can_id_filter.h>
+
+using daq::asam_cmp_common_lib::CanIdFilter;
+
+TEST(CanIdFilterTest, EmptyFilter)
+{
+    CanIdFilter filter("  , ");
+    EXPECT_TRUE(filter.isEmpty());
+    EXPECT_FALSE(filter.contains(0));
+    EXPECT_FALSE(filter.contains(0x12345));
+}
+
+TEST(CanIdFilterTest, StandardIds)
+{
+    CanIdFilter filter("0x100-0x10F, 0x7DF 42");
+    EXPECT_FALSE(filter.isEmpty());
+    EXPECT_TRUE(filter.contains(0x100));
+    EXPECT_TRUE(filter.contains(0x10F));
+    EXPECT_FALSE(filter.contains(0x110));
+    EXPECT_FALSE(filter.contains(0xFF));
+    EXPECT_TRUE(filter.contains(0x7DF));
+    EXPECT_TRUE(filter.contains(42));
+    EXPECT_FALSE(filter.contains(0x7DF + 0x800));
+}
+
+TEST(CanIdFilterTest, ExtendedIds)
+{
+    CanIdFilter filter("0x18DAF110, 0x700-0x900, 0x10000000-0x10FFFFFF, 0x10FFFF00-0x11000010");
+    EXPECT_TRUE(filter.contains(0x18DAF110));
+    EXPECT_FALSE(filter.contains(0x18DAF111));
+    EXPECT_TRUE(filter.contains(0x7FF));
+    EXPECT_TRUE(filter.contains(0x800));
+    EXPECT_TRUE(filter.contains(0x900));
+    EXPECT_FALSE(filter.contains(0x901));
+    EXPECT_FALSE(filter.contains(0x0FFFFFFF));
+    EXPECT_TRUE(filter.contains(0x10000000));
+    EXPECT_TRUE(filter.contains(0x10ABCDEF));
+    EXPECT_TRUE(filter.contains(0x11000010));
+    EXPECT_FALSE(filter.contains(0x11000011));
+    EXPECT_FALSE(filter.contains(CanIdFilter::maxExtendedId));
+
+    filter.clear();
+    EXPECT_TRUE(filter.isEmpty());
+    EXPECT_FALSE(filter.contains(0x10ABCDEF));
+}
+
+TEST(CanIdFilterTest, InvalidLists)
+{
+    EXPECT_THROW(CanIdFilter("0x"), std::invalid_argument);
+    EXPECT_THROW(CanIdFilter("12a"), std::invalid_argument);
+    EXPECT_THROW(CanIdFilter("0x200-0x100"), std::invalid_argument);
+    EXPECT_THROW(CanIdFilter("0x20000000"), std::invalid_argument);
+    EXPECT_THROW(CanIdFilter("1-"), std::invalid_argument);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/can_id_map.h>
+
+using daq::asam_cmp_common_lib::CanIdMap;
+
+TEST(CanIdMapTest, Empty)
+{
+    CanIdMap map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.find(0), CanIdMap::notFound);
+    EXPECT_EQ(map.find(0x18DAF110), CanIdMap::notFound);
+}
+
+TEST(CanIdMapTest, Lookup)
+{
+    CanIdMap map;
+    map.add(0x100, 0x100, 0);
+    map.add(0x7F0, 0x80F, 1);
+    map.add(0x10000000, 0x10FFFFFF, 2);
+    map.add(0x18DAF110, 0x18DAF110, 3);
+    EXPECT_FALSE(map.isEmpty());
+
+    EXPECT_EQ(map.find(0x100), 0u);
+    EXPECT_EQ(map.find(0x101), CanIdMap::notFound);
+    EXPECT_EQ(map.find(0x7F0), 1u);
+    EXPECT_EQ(map.find(0x80F), 1u);
+    EXPECT_EQ(map.find(0x810), CanIdMap::notFound);
+    EXPECT_EQ(map.find(0x10123456), 2u);
+    EXPECT_EQ(map.find(0x18DAF110), 3u);
+
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.find(0x100), CanIdMap::notFound);
+    EXPECT_EQ(map.find(0x10123456), CanIdMap::notFound);
+}
+
+TEST(CanIdMapTest, FirstRangeWins)
+{
+    CanIdMap map;
+    map.add(0x100, 0x1FF, 0);
+    map.add(0x10000000, 0x10FFFFFF, 1);
+    map.add(0x180, 0x280, 2);
+    map.add(0x10FFFFF0, 0x11000010, 3);
+
+    EXPECT_EQ(map.find(0x180), 0u);
+    EXPECT_EQ(map.find(0x200), 2u);
+    EXPECT_EQ(map.find(0x10FFFFF0), 1u);
+    EXPECT_EQ(map.find(0x11000000), 3u);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/compact_can_layout.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace daq::asam_cmp_common_lib::compact_can;
+
+namespace
+{
+    std::vector<uint8_t> createSample(const std::vector<std::vector<uint8_t>>& frames)
+    {
+        size_t size = sizeof(CanFdHeader);
+        for (const auto& data : frames)
+            size += getCanFdFrameSize(static_cast<uint8_t>(data.size()));
+
+        std::vector<uint8_t> sample(size);
+        const CanFdHeader header{static_cast<uint32_t>(frames.size()), 0};
+        memcpy(sample.data(), &header, sizeof(header));
+
+        uint8_t* position = sample.data() + sizeof(header);
+        for (size_t i = 0; i < frames.size(); ++i)
+            position = writeCanFdFrame(position, 1000 + i, 0x100 + static_cast<uint32_t>(i), frames[i].data(), static_cast<uint8_t>(frames[i].size()));
+        EXPECT_EQ(position, sample.data() + sample.size());
+        return sample;
+    }
+}
+
+TEST(CompactCanLayoutTest, CanFdRoundTrip)
+{
+    const std::vector<std::vector<uint8_t>> frames{{1, 2, 3}, {}, std::vector<uint8_t>(64, 0xAB)};
+    const auto sample = createSample(frames);
+    EXPECT_EQ(sample.size(), sizeof(CanFdHeader) + 3 * sizeof(CanFdFrame) + 67);
+
+    size_t index = 0;
+    ASSERT_TRUE(forEachCanFdFrame(sample.data(),
+                                  sample.size(),
+                                  [&](const CanFdFrame& frame, const uint8_t* data)
+                                  {
+                                      EXPECT_EQ(frame.timestamp, 1000 + index);
+                                      EXPECT_EQ(frame.arbId, 0x100 + index);
+                                      ASSERT_EQ(frame.length, frames[index].size());
+                                      EXPECT_TRUE(std::equal(data, data + frame.length, frames[index].begin()));
+                                      ++index;
+                                  }));
+    EXPECT_EQ(index, frames.size());
+}
+
+TEST(CompactCanLayoutTest, TruncatedSample)
+{
+    const auto sample = createSample({{1, 2, 3}, {4, 5}});
+
+    size_t count = 0;
+    auto counter = [&count](const CanFdFrame&, const uint8_t*) { ++count; };
+    EXPECT_FALSE(forEachCanFdFrame(sample.data(), sample.size() - 1, counter));
+    EXPECT_EQ(count, 1u);
+    EXPECT_FALSE(forEachCanFdFrame(sample.data(), sizeof(CanFdHeader) - 1, counter));
+    EXPECT_EQ(count, 1u);
+}
+
+TEST(CompactCanLayoutTest, InvalidLength)
+{
+    auto sample = createSample({{1, 2, 3}});
+    sample[sizeof(CanFdHeader) + offsetof(CanFdFrame, length)] = 65;
+
+    size_t count = 0;
+    EXPECT_FALSE(forEachCanFdFrame(sample.data(), sample.size(), [&count](const CanFdFrame&, const uint8_t*) { ++count; }));
+    EXPECT_EQ(count, 0u);
+}
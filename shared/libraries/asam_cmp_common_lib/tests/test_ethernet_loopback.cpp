@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/ethernet_composite_impl.h>
+#include <asam_cmp_common_lib/ethernet_loopback_impl.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/ethernet_pcpp_mock.h>
+#include <asam_cmp_common_lib/pcapng_recorder.h>
+#include <EthLayer.h>
+#include <Packet.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+using namespace daq;
+using namespace testing;
+using asam_cmp_common_lib::EthernetCompositeImpl;
+using asam_cmp_common_lib::EthernetLoopbackImpl;
+using asam_cmp_common_lib::EthernetPcppImpl;
+using asam_cmp_common_lib::EthernetPcppMock;
+using asam_cmp_common_lib::PcapNgRecorder;
+
+class EthernetLoopbackTest : public testing::Test
+{
+protected:
+    void onPacketReceived(pcpp::RawPacket* packet)
+    {
+        pcpp::Packet parsedPacket(packet);
+        auto ethLayer = parsedPacket.getLayerOfType<pcpp::EthLayer>();
+        ASSERT_NE(ethLayer, nullptr);
+        ASSERT_EQ(pcpp::netToHost16(ethLayer->getEthHeader()->etherType), EthernetPcppImpl::asamCmpEtherType);
+
+        std::scoped_lock lock(receivedSync);
+        received.emplace_back(ethLayer->getLayerPayload(), ethLayer->getLayerPayload() + ethLayer->getLayerPayloadSize());
+        receivedCv.notify_all();
+    }
+
+    bool waitForPackets(size_t count)
+    {
+        std::unique_lock lock(receivedSync);
+        return receivedCv.wait_for(lock, std::chrono::seconds(2), [&] { return received.size() >= count; });
+    }
+
+    auto makeCallback()
+    {
+        return [this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice*, void*) { onPacketReceived(packet); };
+    }
+
+protected:
+    std::mutex receivedSync;
+    std::condition_variable receivedCv;
+    std::vector<std::vector<uint8_t>> received;
+};
+
+TEST_F(EthernetLoopbackTest, DeviceList)
+{
+    EthernetLoopbackImpl loopback;
+    ASSERT_EQ(loopback.getEthernetDevicesNamesList().getCount(), 1u);
+    ASSERT_EQ(loopback.getEthernetDevicesNamesList()[0].toStdString(), EthernetLoopbackImpl::deviceName);
+    ASSERT_EQ(loopback.getEthernetDevicesDescriptionsList()[0].toStdString(), EthernetLoopbackImpl::deviceDescription);
+    ASSERT_TRUE(loopback.setDevice(EthernetLoopbackImpl::deviceName));
+    ASSERT_FALSE(loopback.setDevice("eth0"));
+}
+
+TEST_F(EthernetLoopbackTest, SentPacketsAreDelivered)
+{
+    EthernetLoopbackImpl sender;
+    EthernetLoopbackImpl receiver;
+
+    receiver.startCapture(makeCallback());
+    ASSERT_TRUE(receiver.isDeviceCapturing());
+
+    const std::vector<uint8_t> first{1, 2, 3, 4};
+    const std::vector<uint8_t> second(1500, 0xAB);
+    ASSERT_TRUE(sender.sendPacket(first));
+    ASSERT_TRUE(sender.sendPacket(second));
+
+    ASSERT_TRUE(waitForPackets(2));
+    {
+        std::scoped_lock lock(receivedSync);
+        ASSERT_EQ(received[0], first);
+        ASSERT_EQ(received[1], second);
+    }
+    ASSERT_EQ(receiver.getCaptureStatistics().packetsReceived, 2u);
+    ASSERT_EQ(receiver.getCaptureStatistics().packetsDropped, 0u);
+
+    receiver.stopCapture();
+    ASSERT_FALSE(receiver.isDeviceCapturing());
+    ASSERT_TRUE(sender.sendPacket(first));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::scoped_lock lock(receivedSync);
+    ASSERT_EQ(received.size(), 2u);
+}
+
+TEST_F(EthernetLoopbackTest, OversizedPacketIsNotSent)
+{
+    EthernetLoopbackImpl sender;
+    ASSERT_FALSE(sender.sendPacket(std::vector<uint8_t>(1501)));
+}
+
+TEST_F(EthernetLoopbackTest, FullRingDropsPackets)
+{
+    EthernetLoopbackImpl sender;
+    EthernetLoopbackImpl receiver(1);
+
+    std::mutex blockSync;
+    std::unique_lock block(blockSync);
+    receiver.startCapture([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { std::scoped_lock lock(blockSync); });
+
+    // The first packet blocks the delivery thread, the second one fills the ring
+    for (int i = 0; i < 10; ++i)
+        sender.sendPacket({1});
+
+    ASSERT_GT(receiver.getCaptureStatistics().packetsDropped, 0u);
+    block.unlock();
+    receiver.stopCapture();
+}
+
+TEST_F(EthernetLoopbackTest, CompositeRoutesToSelectedTransport)
+{
+    auto nic = std::make_shared<NiceMock<EthernetPcppMock>>();
+    ListPtr<StringPtr> nicNames = List<IString>();
+    nicNames.pushBack("eth0");
+    ListPtr<StringPtr> nicDescriptions = List<IString>();
+    nicDescriptions.pushBack("Ethernet");
+    ON_CALL(*nic, getEthernetDevicesNamesList()).WillByDefault(Return(nicNames));
+    ON_CALL(*nic, getEthernetDevicesDescriptionsList()).WillByDefault(Return(nicDescriptions));
+    ON_CALL(*nic, setDevice(_)).WillByDefault(Return(true));
+
+    EthernetCompositeImpl composite({nic, std::make_shared<EthernetLoopbackImpl>()});
+    auto names = composite.getEthernetDevicesNamesList();
+    ASSERT_EQ(names.getCount(), 2u);
+    ASSERT_EQ(names[0].toStdString(), "eth0");
+    ASSERT_EQ(names[1].toStdString(), EthernetLoopbackImpl::deviceName);
+    ASSERT_EQ(composite.getEthernetDevicesDescriptionsList()[1].toStdString(), EthernetLoopbackImpl::deviceDescription);
+
+    ASSERT_FALSE(composite.sendPacket({1}));
+    ASSERT_FALSE(composite.setDevice("unknown"));
+
+    ASSERT_TRUE(composite.setDevice("eth0"));
+    EXPECT_CALL(*nic, sendPacket(_)).WillOnce(Return(true));
+    ASSERT_TRUE(composite.sendPacket({1}));
+
+    // Default batch sending stops at the first failed frame
+    EXPECT_CALL(*nic, sendPacket(_)).WillOnce(Return(true)).WillOnce(Return(false));
+    ASSERT_EQ(composite.sendPackets({{1}, {2}, {3}}), 1u);
+    ASSERT_FALSE(composite.setUdpEndpoint("127.0.0.1", 50000));
+
+    ASSERT_TRUE(composite.setDevice(EthernetLoopbackImpl::deviceName));
+    EXPECT_CALL(*nic, sendPacket(_)).Times(0);
+    composite.startCapture(makeCallback());
+    ASSERT_TRUE(composite.sendPacket({5, 6}));
+    ASSERT_TRUE(waitForPackets(1));
+    composite.stopCapture();
+    ASSERT_FALSE(composite.isDeviceCapturing());
+}
+
+TEST_F(EthernetLoopbackTest, CompositeRecordsFrames)
+{
+    EthernetCompositeImpl composite({std::make_shared<EthernetLoopbackImpl>()});
+    ASSERT_TRUE(composite.setDevice(EthernetLoopbackImpl::deviceName));
+
+    PcapNgRecorder::Config config;
+    config.filePrefix = (std::filesystem::temp_directory_path() / "asam_cmp_composite_recording").string();
+    auto recorder = std::make_shared<PcapNgRecorder>(config);
+    ASSERT_TRUE(composite.setRecorder(recorder));
+
+    composite.startCapture(makeCallback());
+    ASSERT_TRUE(composite.sendPacket({5, 6}));
+    ASSERT_TRUE(waitForPackets(1));
+    composite.stopCapture();
+
+    ASSERT_TRUE(composite.setRecorder(nullptr));
+    ASSERT_TRUE(composite.sendPacket({7}));
+    recorder->stop();
+
+    // The sent and the received frame
+    ASSERT_EQ(recorder->getRecordedFrames(), 2u);
+    for (const auto& fileName : recorder->getFileNames())
+    {
+        std::filesystem::remove(fileName);
+        std::filesystem::remove(fileName + ".idx");
+    }
+}
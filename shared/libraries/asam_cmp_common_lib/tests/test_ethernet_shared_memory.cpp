@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/ethernet_shared_memory_impl.h>
+#include <EthLayer.h>
+#include <Packet.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace daq;
+using asam_cmp_common_lib::EthernetPcppImpl;
+using asam_cmp_common_lib::EthernetSharedMemoryImpl;
+
+class EthernetSharedMemoryTest : public testing::Test
+{
+protected:
+    EthernetSharedMemoryTest()
+        : segmentName("/asam_cmp_test_" + std::to_string(getpid()))
+    {
+        EthernetSharedMemoryImpl::removeSegment(segmentName);
+    }
+
+    ~EthernetSharedMemoryTest() override
+    {
+        EthernetSharedMemoryImpl::removeSegment(segmentName);
+    }
+
+    auto makeCallback()
+    {
+        return [this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice*, void*)
+        {
+            pcpp::Packet parsedPacket(packet);
+            auto ethLayer = parsedPacket.getLayerOfType<pcpp::EthLayer>();
+            ASSERT_NE(ethLayer, nullptr);
+            ASSERT_EQ(pcpp::netToHost16(ethLayer->getEthHeader()->etherType), EthernetPcppImpl::asamCmpEtherType);
+
+            std::scoped_lock lock(receivedSync);
+            received.emplace_back(ethLayer->getLayerPayload(), ethLayer->getLayerPayload() + ethLayer->getLayerPayloadSize());
+            receivedCv.notify_all();
+        };
+    }
+
+    bool waitForPackets(size_t count)
+    {
+        std::unique_lock lock(receivedSync);
+        return receivedCv.wait_for(lock, std::chrono::seconds(2), [&] { return received.size() >= count; });
+    }
+
+protected:
+    std::string segmentName;
+    std::mutex receivedSync;
+    std::condition_variable receivedCv;
+    std::vector<std::vector<uint8_t>> received;
+};
+
+TEST_F(EthernetSharedMemoryTest, DeviceList)
+{
+    EthernetSharedMemoryImpl adapter(segmentName);
+    ASSERT_EQ(adapter.getEthernetDevicesNamesList().getCount(), 1u);
+    ASSERT_EQ(adapter.getEthernetDevicesNamesList()[0].toStdString(), EthernetSharedMemoryImpl::deviceName);
+    ASSERT_EQ(adapter.getEthernetDevicesDescriptionsList()[0].toStdString(), EthernetSharedMemoryImpl::deviceDescription);
+    ASSERT_FALSE(adapter.setDevice("eth0"));
+    ASSERT_TRUE(adapter.setDevice(EthernetSharedMemoryImpl::deviceName));
+    ASSERT_THROW(EthernetSharedMemoryImpl(segmentName, 1000), std::invalid_argument);
+}
+
+TEST_F(EthernetSharedMemoryTest, NotSentBeforeDeviceIsSet)
+{
+    EthernetSharedMemoryImpl adapter(segmentName);
+    ASSERT_FALSE(adapter.sendPacket({1, 2, 3}));
+}
+
+TEST_F(EthernetSharedMemoryTest, SentPacketsAreDelivered)
+{
+    EthernetSharedMemoryImpl sender(segmentName, 16);
+    EthernetSharedMemoryImpl receiver(segmentName, 16);
+    ASSERT_TRUE(sender.setDevice(EthernetSharedMemoryImpl::deviceName));
+    ASSERT_TRUE(receiver.setDevice(EthernetSharedMemoryImpl::deviceName));
+
+    // Published before the capture started, must not be delivered
+    ASSERT_TRUE(sender.sendPacket({0}));
+
+    receiver.startCapture(makeCallback());
+    ASSERT_TRUE(receiver.isDeviceCapturing());
+
+    const std::vector<uint8_t> first{1, 2, 3, 4};
+    const std::vector<uint8_t> second(1500, 0xAB);
+    ASSERT_TRUE(sender.sendPacket(first));
+    ASSERT_TRUE(sender.sendPacket(second));
+    ASSERT_FALSE(sender.sendPacket(std::vector<uint8_t>(1501)));
+
+    ASSERT_TRUE(waitForPackets(2));
+    {
+        std::scoped_lock lock(receivedSync);
+        ASSERT_EQ(received.size(), 2u);
+        ASSERT_EQ(received[0], first);
+        ASSERT_EQ(received[1], second);
+    }
+    ASSERT_EQ(receiver.getCaptureStatistics().packetsReceived, 2u);
+
+    receiver.stopCapture();
+    ASSERT_FALSE(receiver.isDeviceCapturing());
+}
+
+TEST_F(EthernetSharedMemoryTest, SlowReaderDropsOverwrittenPackets)
+{
+    EthernetSharedMemoryImpl sender(segmentName, 16);
+    EthernetSharedMemoryImpl receiver(segmentName, 16);
+    ASSERT_TRUE(sender.setDevice(EthernetSharedMemoryImpl::deviceName));
+    ASSERT_TRUE(receiver.setDevice(EthernetSharedMemoryImpl::deviceName));
+
+    std::mutex blockSync;
+    std::unique_lock block(blockSync);
+    receiver.startCapture([&](pcpp::RawPacket*, pcpp::PcapLiveDevice*, void*) { std::scoped_lock lock(blockSync); });
+
+    constexpr uint64_t packetsCount = 100;
+    for (uint64_t i = 0; i < packetsCount; ++i)
+        ASSERT_TRUE(sender.sendPacket({1}));
+    block.unlock();
+
+    auto statistics = receiver.getCaptureStatistics();
+    for (int i = 0; i < 20 && statistics.packetsReceived + statistics.packetsDropped < packetsCount; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        statistics = receiver.getCaptureStatistics();
+    }
+
+    ASSERT_GT(statistics.packetsDropped, 0u);
+    ASSERT_EQ(statistics.packetsReceived + statistics.packetsDropped, packetsCount);
+    receiver.stopCapture();
+}
+
+TEST_F(EthernetSharedMemoryTest, StalledWriterIsSkipped)
+{
+    EthernetSharedMemoryImpl sender(segmentName, 16);
+    EthernetSharedMemoryImpl receiver(segmentName, 16);
+    ASSERT_TRUE(sender.setDevice(EthernetSharedMemoryImpl::deviceName));
+    ASSERT_TRUE(receiver.setDevice(EthernetSharedMemoryImpl::deviceName));
+    receiver.startCapture(makeCallback());
+
+    // Claims a slot like a writer that dies before publishing it, writePos is the second cache line of the segment
+    const int fd = shm_open(segmentName.c_str(), O_RDWR, 0660);
+    ASSERT_NE(fd, -1);
+    void* address = mmap(nullptr, 128, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(address, MAP_FAILED);
+    reinterpret_cast<std::atomic<uint64_t>*>(static_cast<uint8_t*>(address) + 64)->fetch_add(1);
+    munmap(address, 128);
+
+    const std::vector<uint8_t> data{1, 2, 3};
+    ASSERT_TRUE(sender.sendPacket(data));
+    ASSERT_TRUE(waitForPackets(1));
+    {
+        std::scoped_lock lock(receivedSync);
+        ASSERT_EQ(received[0], data);
+    }
+
+    const auto statistics = receiver.getCaptureStatistics();
+    ASSERT_EQ(statistics.packetsReceived, 1u);
+    ASSERT_EQ(statistics.packetsDropped, 1u);
+    receiver.stopCapture();
+}
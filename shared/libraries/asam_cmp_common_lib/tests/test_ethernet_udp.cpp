@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/ethernet_pcpp_impl.h>
+#include <asam_cmp_common_lib/ethernet_udp_impl.h>
+#include <EthLayer.h>
+#include <Packet.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+using namespace daq;
+using asam_cmp_common_lib::EthernetPcppImpl;
+using asam_cmp_common_lib::EthernetUdpImpl;
+
+class EthernetUdpTest : public testing::Test
+{
+protected:
+    static constexpr const char* address = "127.0.0.1";
+    static constexpr uint16_t port = 50123;
+
+    auto makeCallback()
+    {
+        return [this](pcpp::RawPacket* packet, pcpp::PcapLiveDevice*, void*)
+        {
+            pcpp::Packet parsedPacket(packet);
+            auto ethLayer = parsedPacket.getLayerOfType<pcpp::EthLayer>();
+            ASSERT_NE(ethLayer, nullptr);
+            ASSERT_EQ(pcpp::netToHost16(ethLayer->getEthHeader()->etherType), EthernetPcppImpl::asamCmpEtherType);
+
+            std::scoped_lock lock(receivedSync);
+            received.emplace_back(ethLayer->getLayerPayload(), ethLayer->getLayerPayload() + ethLayer->getLayerPayloadSize());
+            receivedCv.notify_all();
+        };
+    }
+
+    bool waitForPackets(size_t count)
+    {
+        std::unique_lock lock(receivedSync);
+        return receivedCv.wait_for(lock, std::chrono::seconds(2), [&] { return received.size() >= count; });
+    }
+
+protected:
+    std::mutex receivedSync;
+    std::condition_variable receivedCv;
+    std::vector<std::vector<uint8_t>> received;
+};
+
+TEST_F(EthernetUdpTest, DeviceList)
+{
+    EthernetUdpImpl adapter(address, port);
+    ASSERT_EQ(adapter.getEthernetDevicesNamesList().getCount(), 1u);
+    ASSERT_EQ(adapter.getEthernetDevicesNamesList()[0].toStdString(), EthernetUdpImpl::deviceName);
+    ASSERT_EQ(adapter.getEthernetDevicesDescriptionsList()[0].toStdString(), EthernetUdpImpl::deviceDescription);
+    ASSERT_FALSE(adapter.setDevice("eth0"));
+    ASSERT_TRUE(adapter.setDevice(EthernetUdpImpl::deviceName));
+}
+
+TEST_F(EthernetUdpTest, InvalidEndpoint)
+{
+    ASSERT_THROW(EthernetUdpImpl("not an address", port), std::invalid_argument);
+    ASSERT_THROW(EthernetUdpImpl(address, 0), std::invalid_argument);
+
+    EthernetUdpImpl adapter(address, port);
+    ASSERT_FALSE(adapter.setUdpEndpoint("256.0.0.1", port));
+    ASSERT_FALSE(adapter.setUdpEndpoint(address, 0));
+    ASSERT_TRUE(adapter.setUdpEndpoint("239.255.0.1", port));
+}
+
+TEST_F(EthernetUdpTest, NotSentBeforeDeviceIsSet)
+{
+    EthernetUdpImpl adapter(address, port);
+    ASSERT_FALSE(adapter.sendPacket({1, 2, 3}));
+    ASSERT_EQ(adapter.sendPackets({{1}, {2}}), 0u);
+}
+
+TEST_F(EthernetUdpTest, SentPacketsAreDelivered)
+{
+    EthernetUdpImpl sender(address, port);
+    EthernetUdpImpl receiver(address, port);
+    ASSERT_TRUE(sender.setDevice(EthernetUdpImpl::deviceName));
+
+    receiver.startCapture(makeCallback());
+    ASSERT_TRUE(receiver.isDeviceCapturing());
+
+    const std::vector<uint8_t> single{1, 2, 3, 4};
+    ASSERT_TRUE(sender.sendPacket(single));
+
+    // Equally sized frames are merged into GSO messages, differently sized ones split the runs
+    std::vector<std::vector<uint8_t>> batch;
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        std::vector<uint8_t> frame(i % 50 == 49 ? 300 : 100);
+        std::memcpy(frame.data(), &i, sizeof(i));
+        batch.push_back(std::move(frame));
+    }
+    ASSERT_EQ(sender.sendPackets(batch), batch.size());
+
+    ASSERT_TRUE(waitForPackets(batch.size() + 1));
+    {
+        std::scoped_lock lock(receivedSync);
+        ASSERT_EQ(received.size(), batch.size() + 1);
+        ASSERT_EQ(received[0], single);
+        for (size_t i = 0; i < batch.size(); ++i)
+            ASSERT_EQ(received[i + 1], batch[i]);
+    }
+    ASSERT_EQ(receiver.getCaptureStatistics().packetsReceived, batch.size() + 1);
+
+    receiver.stopCapture();
+    ASSERT_FALSE(receiver.isDeviceCapturing());
+}
+
+TEST_F(EthernetUdpTest, EndpointChangeReopensSocket)
+{
+    constexpr uint16_t otherPort = port + 1;
+    EthernetUdpImpl sender(address, port);
+    EthernetUdpImpl receiver(address, otherPort);
+    ASSERT_TRUE(sender.setDevice(EthernetUdpImpl::deviceName));
+    receiver.startCapture(makeCallback());
+
+    ASSERT_TRUE(sender.setUdpEndpoint(address, otherPort));
+    ASSERT_TRUE(sender.sendPacket({7}));
+    ASSERT_TRUE(waitForPackets(1));
+    receiver.stopCapture();
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/latency_histogram.h>
+
+using daq::asam_cmp_common_lib::LatencyHistogram;
+
+class LatencyHistogramTest : public testing::Test
+{
+protected:
+    LatencyHistogram histogram;
+};
+
+TEST_F(LatencyHistogramTest, Empty)
+{
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getMax(), 0u);
+    EXPECT_EQ(histogram.getValueAtPercentile(99.0), 0u);
+}
+
+TEST_F(LatencyHistogramTest, SmallValuesAreExact)
+{
+    for (uint64_t value = 0; value < 16; ++value)
+        histogram.record(value);
+
+    EXPECT_EQ(histogram.getCount(), 16u);
+    EXPECT_EQ(histogram.getMax(), 15u);
+    EXPECT_EQ(histogram.getValueAtPercentile(50.0), 7u);
+    EXPECT_EQ(histogram.getValueAtPercentile(100.0), 15u);
+}
+
+TEST_F(LatencyHistogramTest, Percentiles)
+{
+    for (uint64_t value = 1; value <= 1000; ++value)
+        histogram.record(value * 1000);
+
+    constexpr double precision = 1.0 / 16;
+    EXPECT_NEAR(histogram.getValueAtPercentile(50.0), 500000.0, 500000.0 * precision);
+    EXPECT_NEAR(histogram.getValueAtPercentile(99.0), 990000.0, 990000.0 * precision);
+    EXPECT_LE(histogram.getValueAtPercentile(99.9), 1000000u);
+    EXPECT_EQ(histogram.getValueAtPercentile(100.0), 1000000u);
+    EXPECT_EQ(histogram.getMax(), 1000000u);
+}
+
+TEST_F(LatencyHistogramTest, Duration)
+{
+    histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::steady_clock::duration(-1));
+
+    EXPECT_EQ(histogram.getCount(), 2u);
+    EXPECT_EQ(histogram.getMax(), 3000u);
+}
+
+TEST_F(LatencyHistogramTest, Reset)
+{
+    histogram.record(100);
+    histogram.reset();
+
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getMax(), 0u);
+    EXPECT_EQ(histogram.getValueAtPercentile(50.0), 0u);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/loopback_ring.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using daq::asam_cmp_common_lib::LoopbackRing;
+
+TEST(LoopbackRingTest, CapacityIsPowerOfTwo)
+{
+    EXPECT_EQ(LoopbackRing(1).getCapacity(), 1u);
+    EXPECT_EQ(LoopbackRing(5).getCapacity(), 8u);
+    EXPECT_EQ(LoopbackRing(1024).getCapacity(), 1024u);
+    EXPECT_THROW(LoopbackRing(0), std::invalid_argument);
+}
+
+TEST(LoopbackRingTest, PushPop)
+{
+    LoopbackRing ring(4);
+    EXPECT_EQ(ring.front(), nullptr);
+
+    const uint8_t header[] = {1, 2};
+    const uint8_t payload[] = {3, 4, 5};
+    ASSERT_TRUE(ring.tryPush(header, sizeof(header), payload, sizeof(payload), 42));
+
+    auto slot = ring.front();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(slot->size, 5u);
+    EXPECT_EQ(slot->timestamp, 42u);
+    EXPECT_EQ(std::vector<uint8_t>(slot->data.begin(), slot->data.begin() + slot->size), (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+
+    ring.pop();
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(LoopbackRingTest, FullRingRejectsFrames)
+{
+    LoopbackRing ring(2);
+    const uint8_t data = 0;
+    EXPECT_TRUE(ring.tryPush(&data, 1, nullptr, 0, 0));
+    EXPECT_TRUE(ring.tryPush(&data, 1, nullptr, 0, 0));
+    EXPECT_FALSE(ring.tryPush(&data, 1, nullptr, 0, 0));
+
+    ring.pop();
+    EXPECT_TRUE(ring.tryPush(&data, 1, nullptr, 0, 0));
+}
+
+TEST(LoopbackRingTest, OversizedFrameIsRejected)
+{
+    LoopbackRing ring(2);
+    std::vector<uint8_t> payload(LoopbackRing::maxFrameSize);
+    const uint8_t header = 0;
+    EXPECT_FALSE(ring.tryPush(&header, 1, payload.data(), payload.size(), 0));
+    EXPECT_TRUE(ring.tryPush(nullptr, 0, payload.data(), payload.size(), 0));
+}
+
+TEST(LoopbackRingTest, MultipleProducersKeepPerProducerOrder)
+{
+    constexpr uint8_t producersCount = 4;
+    constexpr uint32_t framesPerProducer = 10000;
+    LoopbackRing ring(64);
+
+    std::vector<std::thread> producers;
+    for (uint8_t producer = 0; producer < producersCount; ++producer)
+    {
+        producers.emplace_back(
+            [&ring, producer]
+            {
+                for (uint32_t i = 0; i < framesPerProducer;)
+                {
+                    if (ring.tryPush(&producer, 1, reinterpret_cast<const uint8_t*>(&i), sizeof(i), i))
+                        ++i;
+                    else
+                        std::this_thread::yield();
+                }
+            });
+    }
+
+    std::vector<uint32_t> expected(producersCount, 0);
+    for (uint32_t received = 0; received < producersCount * framesPerProducer;)
+    {
+        auto slot = ring.front();
+        if (!slot)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint8_t producer = slot->data[0];
+        uint32_t value;
+        std::memcpy(&value, slot->data.data() + 1, sizeof(value));
+        ASSERT_LT(producer, producersCount);
+        ASSERT_EQ(value, expected[producer]);
+        ++expected[producer];
+        ring.pop();
+        ++received;
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+}
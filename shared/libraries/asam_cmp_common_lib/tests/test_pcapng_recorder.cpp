@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/pcap_index_format.h>
+#include <asam_cmp_common_lib/pcapng_recorder.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using daq::asam_cmp_common_lib::PcapNgRecorder;
+namespace pcap_index = daq::asam_cmp_common_lib::pcap_index;
+
+class PcapNgRecorderTest : public testing::Test
+{
+protected:
+    struct RecordedFrame
+    {
+        uint64_t timestamp;
+        std::vector<uint8_t> data;
+    };
+
+    void TearDown() override
+    {
+        for (const auto& fileName : fileNames)
+        {
+            std::filesystem::remove(fileName);
+            std::filesystem::remove(fileName + pcap_index::fileExtension);
+        }
+    }
+
+    PcapNgRecorder::Config makeConfig() const
+    {
+        PcapNgRecorder::Config config;
+        config.filePrefix = (std::filesystem::temp_directory_path() / "asam_cmp_recorder_test").string();
+        return config;
+    }
+
+    static uint32_t get32(const std::vector<uint8_t>& content, size_t position)
+    {
+        uint32_t value;
+        std::memcpy(&value, content.data() + position, sizeof(value));
+        return value;
+    }
+
+    // Checks the block structure of the file and returns its packets
+    static std::vector<RecordedFrame> readFile(const std::string& fileName)
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        std::vector<uint8_t> content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        EXPECT_GE(content.size(), 60u);
+        EXPECT_EQ(get32(content, 0), 0x0A0D0D0Au);
+        EXPECT_EQ(get32(content, 8), 0x1A2B3C4Du);
+        EXPECT_EQ(get32(content, 28), 1u);
+
+        std::vector<RecordedFrame> frames;
+        for (size_t position = 0; position + 12 <= content.size();)
+        {
+            const uint32_t type = get32(content, position);
+            const uint32_t length = get32(content, position + 4);
+            EXPECT_EQ(get32(content, position + length - 4), length);
+            if (type == 6)
+            {
+                const uint64_t timestamp = (static_cast<uint64_t>(get32(content, position + 12)) << 32) | get32(content, position + 16);
+                const auto data = content.data() + position + 28;
+                frames.push_back({timestamp, std::vector<uint8_t>(data, data + get32(content, position + 20))});
+            }
+            position += length;
+        }
+        return frames;
+    }
+
+protected:
+    std::vector<std::string> fileNames;
+};
+
+TEST_F(PcapNgRecorderTest, RecordFrames)
+{
+    const std::vector<uint8_t> frame1(60, 0xAB), frame2(73, 0xCD);
+
+    PcapNgRecorder recorder(makeConfig());
+    recorder.record(frame1.data(), frame1.size(), 1'000'000'001);
+    recorder.record(frame2.data(), frame2.size(), 0x1'0000'0002);
+    recorder.stop();
+    fileNames = recorder.getFileNames();
+
+    ASSERT_EQ(fileNames.size(), 1u);
+    ASSERT_EQ(recorder.getRecordedFrames(), 2u);
+    ASSERT_EQ(recorder.getDroppedFrames(), 0u);
+
+    const auto frames = readFile(fileNames[0]);
+    ASSERT_EQ(frames.size(), 2u);
+    ASSERT_EQ(frames[0].timestamp, 1'000'000'001u);
+    ASSERT_EQ(frames[0].data, frame1);
+    ASSERT_EQ(frames[1].timestamp, 0x1'0000'0002u);
+    ASSERT_EQ(frames[1].data, frame2);
+}
+
+TEST_F(PcapNgRecorderTest, RecordAfterStopIsIgnored)
+{
+    const std::vector<uint8_t> frame(60, 1);
+
+    PcapNgRecorder recorder(makeConfig());
+    recorder.stop();
+    recorder.record(frame.data(), frame.size(), 1);
+    fileNames = recorder.getFileNames();
+
+    ASSERT_EQ(recorder.getRecordedFrames(), 0u);
+    ASSERT_TRUE(readFile(fileNames[0]).empty());
+}
+
+TEST_F(PcapNgRecorderTest, RotateBySize)
+{
+    constexpr size_t framesCount = 100;
+    const std::vector<uint8_t> frame(1000, 2);
+
+    auto config = makeConfig();
+    config.maxFileSize = 10 * 1024;
+    PcapNgRecorder recorder(config);
+    for (size_t i = 0; i < framesCount; ++i)
+        recorder.record(frame.data(), frame.size(), i);
+    recorder.stop();
+    fileNames = recorder.getFileNames();
+
+    ASSERT_GT(fileNames.size(), 1u);
+    size_t framesRead = 0;
+    for (const auto& fileName : fileNames)
+    {
+        ASSERT_LE(std::filesystem::file_size(fileName), config.maxFileSize);
+        for (const auto& recorded : readFile(fileName))
+            ASSERT_EQ(recorded.timestamp, framesRead++);
+    }
+    ASSERT_EQ(framesRead, framesCount);
+}
+
+TEST_F(PcapNgRecorderTest, RotateByDuration)
+{
+    const std::vector<uint8_t> frame(60, 3);
+
+    auto config = makeConfig();
+    config.maxFileDuration = std::chrono::seconds(1);
+    PcapNgRecorder recorder(config);
+    for (uint64_t timestamp : {0ull, 500'000'000ull, 1'000'000'000ull, 1'900'000'000ull, 2'500'000'000ull})
+        recorder.record(frame.data(), frame.size(), timestamp);
+    recorder.stop();
+    fileNames = recorder.getFileNames();
+
+    ASSERT_EQ(fileNames.size(), 3u);
+    ASSERT_EQ(readFile(fileNames[0]).size(), 2u);
+    ASSERT_EQ(readFile(fileNames[1]).size(), 2u);
+    ASSERT_EQ(readFile(fileNames[2]).size(), 1u);
+}
+
+TEST_F(PcapNgRecorderTest, OversizedFrameIsDropped)
+{
+    auto config = makeConfig();
+    config.bufferSize = 1024;
+    const std::vector<uint8_t> frame(config.bufferSize, 4);
+
+    PcapNgRecorder recorder(config);
+    recorder.record(frame.data(), frame.size(), 1);
+    recorder.stop();
+    fileNames = recorder.getFileNames();
+
+    ASSERT_EQ(recorder.getRecordedFrames(), 0u);
+    ASSERT_EQ(recorder.getDroppedFrames(), 1u);
+}
+
+TEST_F(PcapNgRecorderTest, InvalidPrefix)
+{
+    auto config = makeConfig();
+    config.filePrefix = (std::filesystem::temp_directory_path() / "asam_cmp_missing_directory" / "recording").string();
+    ASSERT_THROW(PcapNgRecorder recorder(config), std::runtime_error);
+}
+
+TEST_F(PcapNgRecorderTest, IndexFile)
+{
+    // Ethernet header, CMP header of a Data Message from device 0x0102 stream 3, Data Message header of interface 0x0A0B0C0D
+    std::vector<uint8_t> cmpFrame(60, 0);
+    cmpFrame[12] = 0x99;
+    cmpFrame[13] = 0xFE;
+    cmpFrame[16] = 0x01;
+    cmpFrame[17] = 0x02;
+    cmpFrame[18] = 0x01;
+    cmpFrame[19] = 0x03;
+    cmpFrame[30] = 0x0A;
+    cmpFrame[31] = 0x0B;
+    cmpFrame[32] = 0x0C;
+    cmpFrame[33] = 0x0D;
+    const std::vector<uint8_t> otherFrame(60, 0);
+
+    PcapNgRecorder recorder(makeConfig());
+    recorder.record(cmpFrame.data(), cmpFrame.size(), 100);
+    recorder.record(otherFrame.data(), otherFrame.size(), 300);
+    recorder.record(cmpFrame.data(), cmpFrame.size(), 200);
+    recorder.stop();
+    fileNames = recorder.getFileNames();
+
+    std::ifstream file(fileNames[0] + pcap_index::fileExtension, std::ios::binary);
+    std::vector<uint8_t> content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    ASSERT_EQ(content.size(), pcap_index::magic.size() + 3 * sizeof(pcap_index::Entry));
+    ASSERT_EQ(std::memcmp(content.data(), pcap_index::magic.data(), pcap_index::magic.size()), 0);
+
+    std::vector<pcap_index::Entry> entries(3);
+    std::memcpy(entries.data(), content.data() + pcap_index::magic.size(), 3 * sizeof(pcap_index::Entry));
+
+    ASSERT_EQ(entries[0].timestamp, 100u);
+    ASSERT_EQ(entries[0].offset, 60u);
+    ASSERT_EQ(entries[0].flags, pcap_index::cmpMessage | pcap_index::dataMessage);
+    ASSERT_EQ(entries[0].deviceId, 0x0102);
+    ASSERT_EQ(entries[0].streamId, 3);
+    ASSERT_EQ(entries[0].interfaceId, 0x0A0B0C0Du);
+
+    ASSERT_EQ(entries[1].flags, 0);
+    ASSERT_EQ(entries[1].offset, 60u + 92u);
+
+    // Timestamps in the index never decrease
+    ASSERT_EQ(entries[2].timestamp, 300u);
+    ASSERT_EQ(entries[2].offset, 60u + 2 * 92u);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <asam_cmp_common_lib/trace.h>
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace trace = daq::asam_cmp_common_lib::trace;
+
+class TraceTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        trace::clear();
+    }
+};
+
+TEST_F(TraceTest, ScopeRecordsEvent)
+{
+    {
+        ASAM_CMP_TRACE_SCOPE("TraceTest::scope");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto events = trace::collect();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_STREQ(events[0].name, "TraceTest::scope");
+    EXPECT_GE(events[0].duration, 1000000u);
+}
+
+TEST_F(TraceTest, EventsOfAllThreads)
+{
+    trace::record("main", 10, 20);
+    std::thread([] { trace::record("worker", 15, 30); }).join();
+
+    auto events = trace::collect();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_STREQ(events[0].name, "main");
+    EXPECT_STREQ(events[1].name, "worker");
+    EXPECT_NE(events[0].threadId, events[1].threadId);
+}
+
+TEST_F(TraceTest, OldEventsAreOverwritten)
+{
+    const size_t count = trace::eventsPerThread + 10;
+    for (size_t i = 0; i < count; ++i)
+        trace::record("event", i, i + 1);
+
+    auto events = trace::collect();
+    ASSERT_EQ(events.size(), trace::eventsPerThread);
+    EXPECT_EQ(events.front().start, 10u);
+    EXPECT_EQ(events.back().start, count - 1);
+}
+
+TEST_F(TraceTest, Clear)
+{
+    trace::record("event", 0, 1);
+    trace::clear();
+    EXPECT_TRUE(trace::collect().empty());
+}
+
+TEST_F(TraceTest, ChromeTraceJson)
+{
+    std::vector<trace::Event> events{{"first", 1234567, 1500, 1}, {"sec\"ond", 2000000, 7, 2}};
+    std::ostringstream stream;
+    trace::writeChromeTrace(stream, events);
+
+    const std::string expected = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                                 "{\"name\":\"first\",\"cat\":\"asam_cmp\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":1234.567,\"dur\":1.500},\n"
+                                 "{\"name\":\"sec\\\"ond\",\"cat\":\"asam_cmp\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":2000.000,\"dur\":0.007}\n"
+                                 "]}\n";
+    EXPECT_EQ(stream.str(), expected);
+}
+
+TEST_F(TraceTest, DumpToInvalidPathThrows)
+{
+    ASSERT_THROW(trace::dumpChromeTrace("/nonexistent_dir/trace.json"), std::runtime_error);
+}
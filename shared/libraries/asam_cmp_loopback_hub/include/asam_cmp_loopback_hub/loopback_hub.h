@@ -0,0 +1,50 @@
+/*
+ * Copyright 2022-2024 openDAQ d.o.o.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+    #if defined(ASAM_CMP_LOOPBACK_HUB_EXPORTS)
+        #define ASAM_CMP_LOOPBACK_HUB_API __declspec(dllexport)
+    #else
+        #define ASAM_CMP_LOOPBACK_HUB_API __declspec(dllimport)
+    #endif
+#else
+    #define ASAM_CMP_LOOPBACK_HUB_API __attribute__((visibility("default")))
+#endif
+
+// Process-wide hub of the in-process loopback adapter. It lives in its own shared library, so the capture module
+// and the data sink module exchange frames even though each of them links its own copy of asam_cmp_common_lib.
+namespace daq::asam_cmp_loopback_hub
+{
+    // Receiving end of the hub, implemented by each capturing loopback adapter
+    class LoopbackSubscriber
+    {
+    public:
+        virtual void push(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp) noexcept = 0;
+
+    protected:
+        ~LoopbackSubscriber() = default;
+    };
+
+    ASAM_CMP_LOOPBACK_HUB_API void subscribe(LoopbackSubscriber* subscriber);
+    // No push to the subscriber is in progress or started after this returns
+    ASAM_CMP_LOOPBACK_HUB_API void unsubscribe(LoopbackSubscriber* subscriber);
+    // Delivers one frame, built from an Ethernet header and a payload, to every subscriber
+    ASAM_CMP_LOOPBACK_HUB_API void publish(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp);
+}
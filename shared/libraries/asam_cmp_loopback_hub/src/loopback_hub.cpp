@@ -0,0 +1,46 @@
+#include <asam_cmp_loopback_hub/loopback_hub.h>
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace daq::asam_cmp_loopback_hub
+{
+    namespace
+    {
+        struct Hub
+        {
+            std::shared_mutex subscribersSync;
+            std::vector<LoopbackSubscriber*> subscribers;
+        };
+
+        Hub& getHub()
+        {
+            static Hub hub;
+            return hub;
+        }
+    }
+
+    void subscribe(LoopbackSubscriber* subscriber)
+    {
+        auto& hub = getHub();
+        std::unique_lock lock(hub.subscribersSync);
+        hub.subscribers.push_back(subscriber);
+    }
+
+    void unsubscribe(LoopbackSubscriber* subscriber)
+    {
+        auto& hub = getHub();
+        std::unique_lock lock(hub.subscribersSync);
+        hub.subscribers.erase(std::remove(hub.subscribers.begin(), hub.subscribers.end(), subscriber), hub.subscribers.end());
+    }
+
+    void publish(const uint8_t* header, size_t headerSize, const uint8_t* payload, size_t payloadSize, uint64_t timestamp)
+    {
+        auto& hub = getHub();
+        std::shared_lock lock(hub.subscribersSync);
+        for (auto subscriber : hub.subscribers)
+            subscriber->push(header, headerSize, payload, payloadSize, timestamp);
+    }
+}